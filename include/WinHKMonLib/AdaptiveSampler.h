@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Types.h"
+#include <map>
+#include <string>
+
+/**
+ * @file AdaptiveSampler.h
+ * @brief Activity-driven sampling interval controller
+ *
+ * Chooses the next sampling interval for continuous mode from how much the
+ * most recent sample differs from its recent history.
+ */
+
+namespace WinHKMon {
+
+/**
+ * @brief Adjusts the continuous-mode interval between lower and upper bounds
+ *
+ * Each sample is compared against an exponentially weighted moving average
+ * (EWMA) of the previous samples:
+ * - CPU: |usage - EWMA| / max(EWMA, 10 percentage points)
+ * - Network and disk I/O rates: |rate - EWMA| / max(EWMA, 64 KB/s)
+ *
+ * The floors keep idle-level noise (0.5% -> 1% CPU) from counting as activity.
+ * If any signal exceeds the sensitivity threshold the interval is halved
+ * (fast reaction to transients); otherwise it grows by 25% per quiet sample
+ * (slow back-off), always clamped to [minInterval, maxInterval].
+ *
+ * @note Not thread-safe; intended to be owned by the monitoring loop
+ */
+class AdaptiveSampler {
+public:
+    /**
+     * @brief Construct sampler with interval bounds
+     *
+     * @param minIntervalSeconds Shortest interval used during activity
+     * @param maxIntervalSeconds Longest interval used when idle
+     * @param sensitivity Relative change (0.2 = 20%) that counts as activity
+     * @param initialIntervalSeconds Starting interval (clamped to bounds)
+     * @throws std::invalid_argument if bounds or sensitivity are invalid
+     */
+    AdaptiveSampler(double minIntervalSeconds, double maxIntervalSeconds,
+                    double sensitivity, double initialIntervalSeconds);
+
+    /**
+     * @brief Feed a new sample and compute the interval until the next one
+     *
+     * The first sample only seeds the averages and keeps the current interval.
+     *
+     * @param metrics Latest collected metrics (rates already calculated)
+     * @return Interval in seconds to wait before the next sample
+     */
+    double update(const SystemMetrics& metrics);
+
+    /**
+     * @brief Current interval in seconds
+     */
+    double currentInterval() const { return interval_; }
+
+    /**
+     * @brief Largest relative change observed in the last update()
+     */
+    double lastChangeScore() const { return lastScore_; }
+
+    static constexpr double EWMA_ALPHA = 0.3;              ///< Weight of the newest sample
+    static constexpr double CPU_FLOOR_PERCENT = 10.0;      ///< CPU change floor (percentage points)
+    static constexpr double RATE_FLOOR_BYTES = 65536.0;    ///< Rate change floor (bytes/sec)
+    static constexpr double SHRINK_FACTOR = 0.5;           ///< Interval multiplier on activity
+    static constexpr double GROW_FACTOR = 1.25;            ///< Interval multiplier when quiet
+
+private:
+    /**
+     * @brief Score one signal against its EWMA and fold it into the average
+     *
+     * @param key Signal identifier (e.g., "cpu", "net:Ethernet:in")
+     * @param value Latest value
+     * @param floor Minimum denominator for the relative change
+     * @return Relative change versus the previous EWMA (0 for a new signal)
+     */
+    double scoreSignal(const std::string& key, double value, double floor);
+
+    double minInterval_;
+    double maxInterval_;
+    double sensitivity_;
+    double interval_;
+    double lastScore_;
+    std::map<std::string, double> ewma_;  ///< EWMA per signal key
+};
+
+}  // namespace WinHKMon
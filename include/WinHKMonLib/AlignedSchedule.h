@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file AlignedSchedule.h
+ * @brief Wall-clock-aligned tick schedule for continuous mode (--align)
+ *
+ * Ticks fall on Unix-epoch multiples of the interval (every second on the
+ * second, every 5 s at :00, :05, ...), so hosts sampling at the same
+ * interval produce samples for the same instants and can be joined on the
+ * nominal tick time.
+ */
+
+namespace WinHKMon {
+
+/**
+ * @brief Next tick: the wall-clock boundary and when to wake for it
+ */
+struct AlignedTick {
+    uint64_t nominalMs;        ///< Wall-clock boundary (Unix epoch milliseconds)
+    int64_t steadyDeadlineMs;  ///< Monotonic clock reading at which to take the sample
+};
+
+/**
+ * @brief Plans ticks on wall-clock boundaries, waits on the monotonic clock
+ *
+ * The distance to the next boundary is measured on the wall clock, but the
+ * wait itself is a monotonic deadline, so waits neither drift nor stretch
+ * when the wall clock is adjusted mid-wait. The difference between the two
+ * clocks is re-read on every tick; a change larger than the step threshold
+ * (50 ms, or 0.1% of the interval for long intervals, twice the fastest NTP
+ * slew rate) is a wall-clock step (manual change, NTP step, resume from sleep):
+ * - Forward: boundaries that were jumped over are skipped
+ * - Backward: ticks follow the wall clock, so nominal times may repeat
+ * Smaller changes (NTP slewing) are absorbed tick by tick.
+ *
+ * Clock readings are passed in, so the schedule is testable and clock-agnostic.
+ *
+ * @note Not thread-safe; intended to be owned by the monitoring loop
+ */
+class AlignedSchedule {
+public:
+    static constexpr int64_t MIN_STEP_THRESHOLD_MS = 50;   ///< Smallest clock difference change treated as a step
+
+    /**
+     * @brief Construct schedule
+     *
+     * @param intervalSeconds Tick spacing (rounded to whole milliseconds)
+     * @throws std::invalid_argument if the interval rounds to less than 1 ms
+     */
+    explicit AlignedSchedule(double intervalSeconds);
+
+    /**
+     * @brief Plan the next tick after now
+     *
+     * Never returns the same boundary twice unless the wall clock stepped back.
+     *
+     * @param steadyNowMs Monotonic clock reading (milliseconds)
+     * @param wallNowMs Wall clock reading (Unix epoch milliseconds)
+     * @return Next boundary and its monotonic deadline
+     */
+    AlignedTick next(int64_t steadyNowMs, uint64_t wallNowMs);
+
+    /**
+     * @brief Whether the wall clock stepped since the last next() call
+     *
+     * Checked after waking: a tick whose wait spanned a step would carry the
+     * wrong nominal time, so the caller plans again instead of sampling.
+     */
+    bool clockStepped(int64_t steadyNowMs, uint64_t wallNowMs) const;
+
+    uint64_t intervalMs() const { return intervalMs_; }
+    uint64_t clockSteps() const { return clockSteps_; }   ///< Steps detected so far
+
+private:
+    uint64_t intervalMs_;
+    int64_t stepThresholdMs_;
+    bool anchored_;
+    int64_t wallMinusSteady_;   ///< Clock difference at the last next() call
+    uint64_t lastNominal_;
+    uint64_t clockSteps_;
+};
+
+}  // namespace WinHKMon
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+/**
+ * @file CachedFile.h
+ * @brief Small pseudo-files (sysfs, procfs, cgroupfs) read through a kept-open handle
+ *
+ * Kernel attribute files are regenerated on every read from offset 0, so a
+ * collector can keep the handle open and pay one seek plus one read per
+ * tick instead of an open/read/close triple and a path lookup.
+ */
+
+namespace WinHKMon {
+
+constexpr const char* PROC_ROOT = "/proc";   ///< procfs mount point of the Linux sources
+
+/**
+ * @brief One file opened on first use and re-read from the start each time
+ *
+ * If the file disappears (a removed cgroup, an unplugged device), read()
+ * fails, the handle is dropped and the next read() tries to open it again.
+ */
+class CachedFile {
+public:
+    explicit CachedFile(std::string path);
+    ~CachedFile();
+
+    CachedFile(const CachedFile&) = delete;
+    CachedFile& operator=(const CachedFile&) = delete;
+
+    /**
+     * @brief Read the whole file into contents (buffer reused between calls)
+     *
+     * @return false if the file cannot be opened or read
+     */
+    bool read(std::string& contents);
+
+    const std::string& path() const { return path_; }
+
+private:
+    void close();
+
+    std::string path_;
+    std::FILE* file_;
+};
+
+}  // namespace WinHKMon
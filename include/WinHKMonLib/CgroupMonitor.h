@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Types.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file CgroupMonitor.h
+ * @brief Linux cgroup v2 group statistics (CGROUP metric)
+ *
+ * Reads the unified hierarchy under a configurable root (normally
+ * /sys/fs/cgroup, or a WSL or container mount). Per group:
+ *
+ *   cpu.stat          usage_usec, nr_throttled, throttled_usec
+ *   memory.current    bytes charged
+ *   memory.events     high, max, oom, oom_kill
+ *   io.stat           rbytes, wbytes, rios, wios per device
+ *   cpu/memory/io.pressure   PSI some/full avg10 and total
+ *
+ * On hosts without cgroup v2 (including Windows) initialize() fails and the
+ * metric is reported as unavailable.
+ */
+
+namespace WinHKMon {
+
+constexpr std::chrono::milliseconds CGROUP_RESCAN_INTERVAL{10000};  ///< Directory walk period
+constexpr size_t CGROUP_PARALLEL_MIN_GROUPS = 64;   ///< Below this, one thread reads every group
+constexpr size_t CGROUP_MAX_WORKERS = 4;            ///< Threads reading groups in parallel
+constexpr size_t CGROUP_MAX_GROUPS = 4096;          ///< Most groups kept open at once
+
+/**
+ * @brief Match a cgroup path against a --cgroup glob
+ *
+ * '*' matches any run of characters including '/', so "system.slice/"
+ * followed by '*' selects every group below system.slice; '?' matches one
+ * character.
+ */
+bool matchCgroupGlob(const std::string& pattern, const std::string& path);
+
+/**
+ * @brief cgroup v2 monitor with cached per-group file handles
+ *
+ * Discovery is incremental: the hierarchy is walked at most once per
+ * rescan interval (and right after a group disappears); known groups keep
+ * their open files and counters, new groups are opened, and removed ones
+ * are closed. Each sample is then one seek and one read per file, spread
+ * over up to CGROUP_MAX_WORKERS threads when there are many groups. The
+ * reader threads start with the first large sample and wait between ticks.
+ *
+ * Every tracked group holds up to seven files open, so no more groups are
+ * tracked than the process's open-file limit allows (the monitor never
+ * raises it); the rest are counted in untrackedGroups(). A group whose
+ * files exist but cannot be opened (EMFILE) stays tracked and is left out
+ * of that sample; only a group whose files are gone is dropped.
+ */
+class CgroupMonitor {
+public:
+    /**
+     * @param root cgroup v2 mount point
+     * @param filter Glob over group paths relative to root ("*" = all)
+     * @param rescanInterval How often new groups are looked for
+     * @param maxGroups Most groups to track; 0 = as many as the open-file
+     *                  limit leaves room for, up to CGROUP_MAX_GROUPS
+     */
+    CgroupMonitor(std::string root, std::string filter,
+                  std::chrono::milliseconds rescanInterval = CGROUP_RESCAN_INTERVAL,
+                  size_t maxGroups = 0);
+    ~CgroupMonitor();
+
+    CgroupMonitor(const CgroupMonitor&) = delete;
+    CgroupMonitor& operator=(const CgroupMonitor&) = delete;
+
+    /**
+     * @brief Check the root and take the baseline sample
+     *
+     * @throws std::runtime_error if root is not a cgroup v2 hierarchy
+     */
+    void initialize();
+
+    /**
+     * @brief Statistics of every matching group, sorted by path
+     *
+     * Rates cover the time since the previous call; a group's first sample
+     * (including groups found since then) reports 0 rates.
+     */
+    std::vector<CgroupStats> getCurrentStats();
+
+    /**
+     * @brief As getCurrentStats(), sampled as of now (tests control elapsed time)
+     */
+    std::vector<CgroupStats> getCurrentStats(std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Groups currently tracked (after the last discovery)
+     */
+    size_t groupCount() const { return groups_.size(); }
+
+    /**
+     * @brief Matching groups the last discovery left out because of maxGroups
+     */
+    size_t untrackedGroups() const { return untracked_; }
+
+    size_t groupLimit() const { return maxGroups_; }   ///< Most groups tracked at once
+
+private:
+    struct Group;
+    enum class ReadResult : uint8_t { OK, REMOVED, UNREADABLE };
+
+    void discover(std::chrono::steady_clock::time_point now);
+    void readShare(size_t first);    ///< Sample every workers_-th group of the tick from first
+    void runReader(size_t index);    ///< Reader thread: one share per tick until stopped
+
+    std::string root_;
+    std::string filter_;
+    std::chrono::milliseconds rescanInterval_;
+    std::map<std::string, std::unique_ptr<Group>> groups_;   ///< By path; sorted output order
+    std::chrono::steady_clock::time_point lastScan_;
+    bool rescanDue_;
+    size_t maxGroups_;
+    size_t untracked_;
+
+    // One tick's work, shared with the reader threads
+    std::vector<Group*> tickGroups_;
+    std::vector<CgroupStats> tickStats_;
+    std::vector<ReadResult> tickResults_;
+    std::chrono::steady_clock::time_point tickNow_;
+    size_t workers_;                 ///< Shares per tick (the calling thread takes share 0)
+
+    std::mutex readersMutex_;
+    std::condition_variable readersChanged_;
+    uint64_t tickNumber_;            ///< Bumped to hand the readers a tick
+    size_t readersBusy_;             ///< Readers still working on the current tick
+    bool readersStopping_;
+    std::vector<std::thread> readers_;
+};
+
+}  // namespace WinHKMon
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "FrameSlots.h"
+#include "Types.h"
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file CollectorModule.h
+ * @brief Collector modules loaded at run time (--module)
+ *
+ * Loads a shared library implementing the WinHKMonModule.h ABI with
+ * LoadLibrary (Windows) or dlopen (Linux), checks its descriptor, and
+ * samples it once per tick. Each module's counters own frame slots (see
+ * FrameSlots.h) and the module writes straight into them, so a tick costs
+ * one call into the module, no copies and no allocation.
+ */
+
+struct whk_module;
+
+namespace WinHKMon {
+
+/**
+ * @brief Path of a --module argument
+ *
+ * A bare name (gpu) resolves to <moduleDir>/whk_gpu.dll on Windows and
+ * <moduleDir>/whk_gpu.so elsewhere; anything with a path separator or an
+ * extension is taken as a path.
+ *
+ * @param module --module argument
+ * @param moduleDir Directory bare names are looked up in
+ */
+std::string resolveModulePath(const std::string& module, const std::string& moduleDir);
+
+/**
+ * @brief One loaded collector module
+ */
+class CollectorModule {
+public:
+    /**
+     * @param path Shared library to load (see resolveModulePath)
+     */
+    explicit CollectorModule(std::string path);
+    ~CollectorModule();
+
+    CollectorModule(const CollectorModule&) = delete;
+    CollectorModule& operator=(const CollectorModule&) = delete;
+
+    /**
+     * @brief Load the library, check its descriptor and open it
+     *
+     * @throws std::runtime_error if the library cannot be loaded, has no
+     *         entry point, was built for another ABI version, declares
+     *         invalid counters, or fails to open
+     */
+    void initialize();
+
+    /**
+     * @brief Counters the module declared (valid after initialize())
+     */
+    const std::shared_ptr<const ModuleSchema>& schema() const { return schema_; }
+
+    /**
+     * @brief Frame slot of the module's first counter
+     *
+     * @param firstSlot Slot from SlotLayout::addModule()
+     */
+    void bindSlots(uint32_t firstSlot) { firstSlot_ = firstSlot; }
+
+    /**
+     * @brief Take one sample into the module's slots of a frame
+     *
+     * Sets the frame's valid bits of the counters the module reported;
+     * the bits of its other counters are cleared.
+     *
+     * @throws std::runtime_error if the module is not initialized or
+     *         reports a failure (its valid bits are then left clear)
+     */
+    void sample(ModuleFrame& frame);
+
+private:
+    void unload();
+
+    std::string path_;
+    void* library_;                  ///< HMODULE or dlopen handle
+    const whk_module* descriptor_;
+    void* state_;                    ///< Set by the module's open()
+    bool opened_;
+    std::shared_ptr<const ModuleSchema> schema_;
+    uint32_t firstSlot_;             ///< Frame slot of counter 0
+};
+
+/**
+ * @brief Loaded collector modules and the frame slots they were given
+ */
+class ModuleSet {
+public:
+    /**
+     * @brief Load a module and give its counters the next free slots
+     *
+     * @param path Shared library to load (see resolveModulePath)
+     * @return First slot of the module
+     * @throws std::runtime_error if the module fails to load (see
+     *         CollectorModule::initialize()) or exports a name that is
+     *         already taken (see SlotLayout::addModule()); the set is
+     *         unchanged then
+     */
+    uint32_t load(const std::string& path);
+
+    bool empty() const { return modules_.empty(); }
+
+    const SlotLayout& layout() const { return layout_; }
+
+    /**
+     * @brief Sample every module into a frame
+     *
+     * A module that fails leaves its slots invalid and is reported to
+     * onError; the others are still sampled.
+     *
+     * @param frame Frame to fill (its schemas are set to the current layout)
+     * @param onError Called with each module failure (may be empty)
+     */
+    void sample(ModuleFrame& frame, const std::function<void(const std::exception&)>& onError = nullptr);
+
+private:
+    std::vector<std::unique_ptr<CollectorModule>> modules_;
+    SlotLayout layout_;
+};
+
+}  // namespace WinHKMon
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "WinHKMonLib/Types.h"
+#include <string>
+#include <vector>
+
+/**
+ * @file ConfigProfile.h
+ * @brief Named option profiles from an INI-style config file
+ *
+ * Keys are the long command-line options without the leading dashes, plus
+ * `metrics` for the metric list. Keys before the first section apply to
+ * every profile; a section's keys are applied after them.
+ *
+ *   # Shared by all profiles
+ *   interval = 5
+ *
+ *   [server]
+ *   metrics = CPU RAM NET IO
+ *   continuous = true
+ *   push = tcp:monitor01:9410
+ *
+ * Options given on the command line are applied after the profile, so they
+ * override its values (metrics add to the profile's list).
+ */
+
+namespace WinHKMon {
+
+constexpr const char* DEFAULT_CONFIG_FILE = "WinHKMon.ini";   ///< Used by --profile without --config
+
+/**
+ * @brief Turn a profile into the equivalent command-line arguments
+ *
+ * @param text Config file contents
+ * @param profile Section to use (empty = only the shared keys)
+ * @return Arguments in the order they appear (shared keys first)
+ * @throws std::invalid_argument on a syntax error or unknown key (with line
+ *         number), or if the profile has no section
+ */
+std::vector<std::string> profileArguments(const std::string& text, const std::string& profile);
+
+/**
+ * @brief Read a config file and turn a profile into command-line arguments
+ *
+ * @throws std::invalid_argument if the file cannot be read or is invalid
+ */
+std::vector<std::string> loadProfileArguments(const std::string& path, const std::string& profile);
+
+/**
+ * @brief Options that differ but cannot be changed without a restart
+ *
+ * Endpoints, the frame ring, low-impact scheduling, tracing and the mode are
+ * set up once at start; everything else is applied by a live reload.
+ *
+ * @return Comma-separated option names, or empty if next can be applied live
+ */
+std::string restartOnlyChanges(const CliOptions& current, const CliOptions& next);
+
+}  // namespace WinHKMon
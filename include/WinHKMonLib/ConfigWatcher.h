@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+/**
+ * @file ConfigWatcher.h
+ * @brief Change notification for the config file (live reload)
+ */
+
+namespace WinHKMon {
+
+/**
+ * @brief Calls back when a file is rewritten, renamed over or recreated
+ *
+ * A helper thread waits on a directory change notification and compares the
+ * file's size and last-write time, so changes to other files in the same
+ * directory are ignored. Bursts of writes (editors often save in several
+ * steps) are coalesced into one callback.
+ *
+ * @note The callback runs on the watcher thread; hand the work to the event
+ *       loop with EventLoop::post().
+ */
+class ConfigWatcher {
+public:
+    using Callback = std::function<void()>;
+
+    /**
+     * @brief Start watching
+     *
+     * @param path File to watch
+     * @param onChange Called after each settled change
+     * @throws std::runtime_error if the directory cannot be watched
+     */
+    ConfigWatcher(const std::string& path, Callback onChange);
+
+    /**
+     * @brief Stop and join the watcher thread
+     */
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+private:
+    void run();
+
+    std::string path_;
+    Callback onChange_;
+    void* changeHandle_;   ///< FindFirstChangeNotification handle
+    void* stopEvent_;      ///< Signalled by the destructor
+    std::thread thread_;
+};
+
+}  // namespace WinHKMon
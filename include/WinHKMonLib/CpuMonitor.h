@@ -10,11 +10,20 @@
  * @brief CPU usage and frequency monitoring component
  * 
  * Provides real-time CPU usage statistics using Windows Performance Data Helper (PDH) API
- * and CPU frequency information using CallNtPowerInformation.
+ * and CPU frequency information using CallNtPowerInformation. High-rate mode
+ * reads the kernel's processor times instead, which needs no wait between samples.
  */
 
 namespace WinHKMon {
 
+/**
+ * @brief Where CpuMonitor gets usage from
+ */
+enum class CpuSampling {
+    PDH,        ///< PDH counters; each sample collects twice, 100 ms apart
+    RAW_TIMES   ///< Processor times (GetSystemTimes, NtQuerySystemInformation) since the previous sample
+};
+
 /**
  * @brief Monitors CPU usage and frequency for overall system and per-core
  * 
@@ -29,6 +38,10 @@ namespace WinHKMon {
  * @note This class maintains PDH query handles and requires initialization/cleanup
  * @note Thread-safe after initialization (read-only operations)
  * @note PDH requires two samples to calculate percentages (minimum 100ms between samples)
+ * @note RAW_TIMES samples return at once: usage covers the time since the
+ *       previous sample (or initialize()). Processor times advance at the
+ *       scheduler tick (15.6 ms by default), so a sample taken before the
+ *       next tick repeats the previous usage. Frequencies are not read (0).
  */
 class CpuMonitor {
 public:
@@ -36,8 +49,10 @@ public:
      * @brief Constructor
      * 
      * Creates a CpuMonitor instance. Call initialize() before using.
+     * 
+     * @param sampling PDH (default) or RAW_TIMES (high-rate mode)
      */
-    CpuMonitor();
+    explicit CpuMonitor(CpuSampling sampling = CpuSampling::PDH);
 
     /**
      * @brief Destructor
@@ -121,11 +136,46 @@ private:
      */
     uint64_t calculateAverageFrequency(const std::vector<uint64_t>& frequencies);
 
+    /**
+     * @brief Cumulative processor times in 100 ns units (kernel includes idle)
+     */
+    struct ProcessorTimes {
+        uint64_t idle;
+        uint64_t kernel;
+        uint64_t user;
+    };
+
+    /**
+     * @brief Take the RAW_TIMES baseline (no PDH query is opened)
+     */
+    void initializeRawTimes();
+
+    /**
+     * @brief RAW_TIMES sample: usage since the previous one, without waiting
+     */
+    CpuStats getRawTimesStats();
+
+    /**
+     * @brief Read the system-wide and per-processor times
+     * 
+     * @throws std::runtime_error if either call fails
+     */
+    void readProcessorTimes(ProcessorTimes& total, std::vector<ProcessorTimes>& cores);
+
+    CpuSampling sampling_;           ///< PDH or RAW_TIMES
     PDH_HQUERY hQuery_;              ///< PDH query handle
     PDH_HCOUNTER hCpuTotal_;         ///< Total CPU usage counter
     std::vector<PDH_HCOUNTER> hCpuCores_;  ///< Per-core CPU usage counters
     bool initialized_;               ///< Initialization state
     int coreCount_;                  ///< Number of logical processors
+
+    // RAW_TIMES state
+    FARPROC queryProcessorTimes_;    ///< NtQuerySystemInformation from ntdll
+    std::vector<unsigned char> queryBuffer_;     ///< Per-processor records, sized once
+    ProcessorTimes previousTotal_;
+    std::vector<ProcessorTimes> previousCores_;
+    std::vector<ProcessorTimes> currentCores_;
+    CpuStats lastRawStats_;          ///< Repeated while processor times have not advanced
 };
 
 }  // namespace WinHKMon
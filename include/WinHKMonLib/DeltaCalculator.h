@@ -1,6 +1,8 @@
 #pragma once
 
+#include "Types.h"
 #include <cstdint>
+#include <vector>
 
 /**
  * @file DeltaCalculator.h
@@ -50,6 +52,49 @@ public:
      */
     double calculateRate(uint64_t current, uint64_t previous, double elapsedSeconds);
 
+    /**
+     * @brief Calculate rate from a counter that wraps at a known range
+     * 
+     * For counters that restart from 0 at range instead of at 2^64, such
+     * as RAPL energy_uj (range = max_energy_range_uj). A value below the
+     * previous one is taken as one wrap: (range - previous) + current.
+     * 
+     * @param current Current counter value
+     * @param previous Previous counter value
+     * @param range Value at which the counter wraps (0 = unknown)
+     * @param elapsedSeconds Time elapsed between samples
+     * @return Rate in units/second
+     * 
+     * @note Returns 0 if:
+     *   - elapsedSeconds is 0 (avoid division by zero)
+     *   - current < previous and the range is unknown, or either value
+     *     exceeds the range (counter reset rather than a wrap)
+     * @note Sample at least once per wrap period; two wraps between samples
+     *       look like one
+     * 
+     * @par Example:
+     * @code
+     * DeltaCalculator calc;
+     * // 262143328850 uJ range: 1000 uJ before the wrap, 500 after it
+     * double rate = calc.calculateWrappingRate(500, 262143327850, 262143328850, 1.0);  // 1500 uJ/s
+     * @endcode
+     */
+    double calculateWrappingRate(uint64_t current, uint64_t previous, uint64_t range, double elapsedSeconds);
+
+    /**
+     * @brief Fill interface rates from the octet counters of a previous sample
+     * 
+     * Interfaces are matched by name. Ones without a previous entry, and
+     * every interface when elapsedSeconds is not positive, keep their rates.
+     * 
+     * @param interfaces Current sample (inBytesPerSec/outBytesPerSec are set)
+     * @param previous Previous sample of the same interfaces
+     * @param elapsedSeconds Time between the two samples
+     */
+    void applyInterfaceRates(std::vector<InterfaceStats>& interfaces,
+                             const std::vector<InterfaceStats>& previous,
+                             double elapsedSeconds);
+
     /**
      * @brief Calculate elapsed time from monotonic timestamps
      * 
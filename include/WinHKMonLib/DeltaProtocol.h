@@ -0,0 +1,157 @@
+#pragma once
+
+#include "FrameSlots.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file DeltaProtocol.h
+ * @brief Delta-compressed snapshots for clients that pull from an agent
+ *
+ * The client sends the agent epoch and the last sequence it holds; the
+ * agent answers with only the scalar slots that changed since that frame.
+ * A full keyframe is sent on first contact, after an agent restart (epoch
+ * changed) or when the client's frame has already left the agent's ring.
+ *
+ * Request:  varint epoch, varint lastSequence (0 = no frame held)
+ *
+ * Response (u32 little-endian length prefix, then):
+ *   u8      version << 4 | kind (NONE, KEYFRAME, DELTA)
+ *   varint  epoch
+ *   varint  sequence
+ *   varint  baseSequence                         (DELTA only)
+ *   varint  timestampMs                          (KEYFRAME: absolute; DELTA: zigzag change from base)
+ *   varint  validMask
+ *   varint  changed slot count, then per slot:
+ *     varint  slot
+ *     u8      leading zero bytes << 4 | trailing zero bytes of (bits XOR base bits)
+ *     bytes   the remaining middle bytes, most significant first
+ *
+ * Slowly moving counters share sign, exponent and high mantissa bits with
+ * their previous value, so a changed slot typically costs 4-7 bytes and an
+ * unchanged one costs nothing.
+ */
+
+namespace WinHKMon {
+
+constexpr uint8_t PULL_VERSION = 1;
+constexpr size_t MAX_SNAPSHOT_MESSAGE_BYTES = 4096;   ///< Larger responses are rejected
+
+/**
+ * @brief Response kinds
+ */
+enum class SnapshotKind : uint8_t {
+    NONE = 0,       ///< Agent has no frame yet
+    KEYFRAME = 1,   ///< Every valid slot, no base
+    DELTA = 2       ///< Changed slots relative to baseSequence
+};
+
+/**
+ * @brief One scalar snapshot as seen by the pull protocol
+ */
+struct SnapshotFrame {
+    uint64_t sequence = 0;                       ///< Agent sample number (starts at 1)
+    uint64_t timestampMs = 0;                    ///< Unix epoch milliseconds
+    uint64_t validMask = 0;                      ///< Bit N set when values[N] holds data
+    std::array<double, MAX_FRAME_SLOTS> values{};  ///< Scalar slots (see FrameSlots.h)
+};
+
+/**
+ * @brief Fixed-capacity ring of the agent's most recent frames
+ */
+class FrameRing {
+public:
+    /**
+     * @brief Construct ring
+     *
+     * @param capacity Frames kept (deltas can be served against any of them)
+     * @throws std::invalid_argument if capacity is 0
+     */
+    explicit FrameRing(size_t capacity);
+
+    /**
+     * @brief Store a frame as the newest (assigns its sequence number)
+     *
+     * @return Assigned sequence number
+     */
+    uint64_t push(SnapshotFrame frame);
+
+    /**
+     * @brief Frame with the given sequence, or nullptr if not (or no longer) held
+     */
+    const SnapshotFrame* find(uint64_t sequence) const;
+
+    /**
+     * @brief Newest frame, or nullptr if empty
+     */
+    const SnapshotFrame* latest() const;
+
+    size_t capacity() const { return frames_.size(); }
+
+private:
+    std::vector<SnapshotFrame> frames_;
+    uint64_t lastSequence_;
+};
+
+/**
+ * @brief Append one pull request to a buffer
+ */
+void encodePullRequest(uint64_t epoch, uint64_t lastSequence, std::string& out);
+
+/**
+ * @brief Decode a pull request from the front of a buffer
+ *
+ * @param data Received bytes
+ * @param size Byte count
+ * @param epoch Receives the client's epoch
+ * @param lastSequence Receives the client's last sequence
+ * @return Bytes consumed, or 0 if the request is incomplete
+ * @throws std::runtime_error on a malformed request
+ */
+size_t decodePullRequest(const char* data, size_t size, uint64_t& epoch, uint64_t& lastSequence);
+
+/**
+ * @brief Append the response to a pull request (with length prefix)
+ *
+ * @param ring Agent's recent frames
+ * @param epoch Agent run identifier
+ * @param clientEpoch Epoch from the request
+ * @param clientSequence Last sequence from the request
+ * @param out Buffer to append to
+ * @return Kind of response written
+ */
+SnapshotKind encodeSnapshotResponse(const FrameRing& ring, uint64_t epoch, uint64_t clientEpoch,
+                                    uint64_t clientSequence, std::string& out);
+
+/**
+ * @brief Client-side state: applies responses to the last frame held
+ */
+class SnapshotDecoder {
+public:
+    /**
+     * @brief Apply one response message (without its length prefix)
+     *
+     * @return Kind of response applied
+     * @throws std::runtime_error if malformed, or if a delta's base is not the
+     *         frame held (call reset() and request a keyframe)
+     */
+    SnapshotKind apply(const char* data, size_t size);
+
+    /**
+     * @brief Forget the held frame (next request gets a keyframe)
+     */
+    void reset();
+
+    const SnapshotFrame& frame() const { return frame_; }   ///< Current reconstructed frame
+    uint64_t epoch() const { return epoch_; }                ///< Epoch to send in the next request
+    uint64_t lastSequence() const { return frame_.sequence; } ///< Sequence to send (0 = none)
+
+private:
+    SnapshotFrame frame_;
+    uint64_t epoch_ = 0;
+};
+
+}  // namespace WinHKMon
@@ -61,7 +61,7 @@ public:
      * - Read/write rates (bytes per second)
      * - Disk busy percentage (0-100)
      * - Total disk size
-     * - Cumulative byte counters
+     * - Cumulative bytes read and written since boot (raw PDH counts)
      * 
      * @return Vector of DiskStats for all physical disks
      * @throws std::runtime_error if PDH query fails
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "TimerQueue.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/**
+ * @file EventLoop.h
+ * @brief Single-threaded reactor for sampling timers, sockets and sink writes
+ *
+ * One thread waits in WSAPoll on every registered socket with the timeout
+ * set to the next timer deadline, so an idle agent wakes exactly once per
+ * tick no matter how many listeners and sinks are open. WSAPoll rather
+ * than IOCP because the sockets here are few, readiness-driven and already
+ * non-blocking, and rather than WaitForMultipleObjects because the
+ * aggregator watches far more than 64 connections.
+ */
+
+namespace WinHKMon {
+
+/**
+ * @brief One socket a PollSource wants watched, and what happened to it
+ */
+struct PollEntry {
+    uintptr_t socket = 0;     ///< SOCKET value
+    bool wantRead = true;     ///< Watch for incoming data or connections
+    bool wantWrite = false;   ///< Watch for send space (pending output)
+    bool readable = false;    ///< Set by the loop; also set on hangup and error so recv() reports them
+    bool writable = false;    ///< Set by the loop
+};
+
+/**
+ * @brief Something that owns sockets serviced by the event loop
+ */
+class PollSource {
+public:
+    virtual ~PollSource() = default;
+
+    /**
+     * @brief Append the sockets to watch in the next wait
+     */
+    virtual void pollEntries(std::vector<PollEntry>& entries) = 0;
+
+    /**
+     * @brief Handle readiness for the entries appended by the last pollEntries()
+     *
+     * Called only when at least one of them is ready.
+     */
+    virtual void dispatch(PollEntry* entries, size_t count) = 0;
+};
+
+/**
+ * @brief Timers, socket readiness and cross-thread tasks on one thread
+ *
+ * Collectors run on the loop thread from timer callbacks (a collection pass
+ * takes well under a millisecond). Work done on other threads hands its
+ * result back with post().
+ *
+ * @note Only post() and stop() may be called from other threads.
+ */
+class EventLoop {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Start Winsock and create the wake-up socket pair
+     *
+     * @throws std::runtime_error if the sockets cannot be created
+     */
+    EventLoop();
+
+    /**
+     * @brief Close the wake-up sockets
+     */
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    /**
+     * @brief Run a callback on the loop thread at a monotonic deadline
+     *
+     * @return Timer ID for cancelTimer()
+     */
+    uint64_t addTimer(TimerQueue::Clock::time_point due, TimerQueue::Callback callback);
+
+    /**
+     * @brief Cancel a pending timer
+     *
+     * @return false if it already ran or was cancelled
+     */
+    bool cancelTimer(uint64_t id);
+
+    /**
+     * @brief Watch a source's sockets until removeSource() (source must outlive it)
+     */
+    void addSource(PollSource& source);
+
+    /**
+     * @brief Stop watching a source (not from within its own dispatch())
+     */
+    void removeSource(PollSource& source);
+
+    /**
+     * @brief Queue a task for the loop thread and wake it (thread-safe)
+     */
+    void post(Task task);
+
+    /**
+     * @brief Dispatch events until stop() is called
+     */
+    void run();
+
+    /**
+     * @brief Make run() return after the current iteration (thread-safe)
+     *
+     * Safe to call from a console control or SIGINT handler.
+     */
+    void stop();
+
+    /**
+     * @brief Returns from the wait so far (one per poll, timer or task wake-up)
+     */
+    uint64_t wakeups() const { return wakeups_; }
+
+private:
+    void runOnce();
+    void wake();
+
+    TimerQueue timers_;
+    std::vector<PollSource*> sources_;
+    std::vector<PollEntry> entries_;      ///< Reused between iterations
+    uintptr_t wakeReceiver_;
+    uintptr_t wakeSender_;
+    std::mutex tasksMutex_;
+    std::vector<Task> tasks_;
+    std::atomic<bool> stopping_;
+    uint64_t wakeups_;
+};
+
+}  // namespace WinHKMon
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Types.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file FieldProjection.h
+ * @brief Field registry and --fields projections
+ *
+ * Every scalar a formatter can print has a path:
+ *
+ *   cpu.total  cpu.mhz
+ *   core.<id>.usage  core.<id>.mhz
+ *   ram.total  ram.available  ram.used  ram.percent
+ *   ram.pagefile_total  ram.pagefile_used  ram.pagefile_percent
+ *   hugepages.<size>.total  hugepages.<size>.free  hugepages.<size>.reserved
+ *   hugepages.<size>.surplus                       (pages; size e.g. 2048kB)
+ *   thp.anon  thp.faults  thp.fallbacks  thp.compact_stalls           (Linux)
+ *   numa.<node>.total  numa.<node>.free  numa.<node>.file  numa.<node>.anon
+ *   numa.<node>.hit  numa.<node>.miss  numa.<node>.foreign            (per second)
+ *   disk.<name>.read  disk.<name>.write  disk.<name>.busy          (IO)
+ *   disk.<name>.total  disk.<name>.used  disk.<name>.free          (DISK)
+ *   net.<name>.in  net.<name>.out  net.<name>.in_total  net.<name>.out_total
+ *   net.<name>.link_speed
+ *   cgroup.<path>.cpu  cgroup.<path>.throttled  cgroup.<path>.memory
+ *   cgroup.<path>.oom_kill  cgroup.<path>.read  cgroup.<path>.write
+ *   cgroup.<path>.psi_cpu  cgroup.<path>.psi_memory  cgroup.<path>.psi_io
+ *   power.watts  rapl.<zone>.watts  rapl.<zone>.energy
+ *   kres.files  kres.files_max  kres.files_percent  kres.sockets       (Linux)
+ *   sock.<protocol>.inuse  sock.<protocol>.memory  sock.<protocol>.memory_percent
+ *   system.handles  system.threads  system.processes                  (Windows)
+ *   module.<module>.<counter>                    (declared by each --module)
+ *
+ * A pattern may use * for the instance or the field (net.*.in, disk.C:.*,
+ * module.gpu.*), and a bare group selects all of it (ram). Instance names may
+ * contain dots: cgroup.system.slice selects every field of that cgroup, and
+ * only a last segment that names a field (cgroup.system.slice.cpu) is taken
+ * as one. Patterns are compiled once into
+ * FieldSelectors; formatters then visit only the selected values and the
+ * collectors of unselected groups are not run at all.
+ */
+
+namespace WinHKMon {
+
+/**
+ * @brief Compile a comma-separated --fields list
+ *
+ * @param list Patterns such as "cpu.total,net.*.in,disk.C:.busy"
+ * @return One selector per registry field each pattern matches
+ * @throws std::invalid_argument on an unknown group or field
+ */
+std::vector<FieldSelector> compileFields(const std::string& list);
+
+/**
+ * @brief Turn on exactly the collectors the selected fields need
+ *
+ * Sets the show flags of every collector (showCpu, showMemory, ...) from
+ * options.fields; metrics named on the command line but not selected are
+ * turned off, and --module names are dropped unless a module field is
+ * selected. Does nothing without --fields.
+ */
+void selectCollectors(CliOptions& options);
+
+/**
+ * @brief One selected value
+ */
+struct FieldValue {
+    std::string path;   ///< Concrete path (instance filled in), e.g. "net.Ethernet.in"
+    double value;       ///< Value in the field's unit (bytes, bytes/s, percent, MHz)
+};
+
+/**
+ * @brief Selected values present in a sample, in selector order
+ *
+ * Instances are listed in the order the collector reported them.
+ */
+std::vector<FieldValue> projectFields(const SystemMetrics& metrics, const std::vector<FieldSelector>& fields);
+
+}  // namespace WinHKMon
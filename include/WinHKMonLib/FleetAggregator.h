@@ -0,0 +1,111 @@
+#pragma once
+
+#include "PushProtocol.h"
+#include "Types.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file FleetAggregator.h
+ * @brief Time-bucketed cluster statistics over samples pushed by many agents
+ */
+
+namespace WinHKMon {
+
+/**
+ * @brief Aligns agent samples to common time buckets and summarizes them
+ *
+ * Each sample lands in the bucket containing its timestamp (buckets start
+ * at multiples of the bucket width, so all agents agree on boundaries).
+ * Within a bucket the latest sample per host wins, so an agent pushing
+ * faster than the bucket width is counted once. A bucket is closed once
+ * the clock passes its end plus a grace period that absorbs network delay
+ * and clock skew; samples for closed buckets are counted as late and
+ * dropped. Samples stamped more than one bucket width ahead of the
+ * aggregator's clock are counted as future and dropped, so an agent with a
+ * skewed (or hostile) clock cannot open buckets without bound. NaN and
+ * infinite slot values are cleared from the sample and counted as invalid.
+ *
+ * Per-metric sums are exact; percentiles come from QuantileSketch.
+ * Not thread-safe: feed it from the thread that reads the sockets.
+ */
+class FleetAggregator {
+public:
+    /**
+     * @brief Construct aggregator
+     *
+     * @param bucketMs Bucket width in milliseconds (> 0)
+     * @param graceMs Time after a bucket ends before it is closed
+     * @param sketchAccuracy Relative accuracy of percentile estimates
+     * @throws std::invalid_argument if bucketMs is 0
+     */
+    FleetAggregator(uint64_t bucketMs, uint64_t graceMs, double sketchAccuracy = 0.01);
+
+    /**
+     * @brief Add one agent sample
+     *
+     * @param nowMs Current Unix epoch milliseconds; samples stamped after
+     *        nowMs plus one bucket width are dropped
+     */
+    void ingest(const PushSample& sample, uint64_t nowMs);
+
+    /**
+     * @brief Close every bucket that ended at least graceMs before nowMs
+     *
+     * @param nowMs Current Unix epoch milliseconds
+     * @return Statistics of closed, non-empty buckets, oldest first
+     */
+    std::vector<ClusterStats> closeBuckets(uint64_t nowMs);
+
+    /**
+     * @brief Samples dropped because their bucket had already closed
+     */
+    uint64_t lateSamples() const { return lateSamples_; }
+
+    /**
+     * @brief Samples dropped because they were stamped too far in the future
+     */
+    uint64_t futureSamples() const { return futureSamples_; }
+
+    /**
+     * @brief Slot values dropped because they were NaN or infinite
+     */
+    uint64_t invalidValues() const { return invalidValues_; }
+
+    /**
+     * @brief Buckets currently accepting samples
+     */
+    size_t openBuckets() const { return buckets_.size(); }
+
+    /**
+     * @brief Present cluster statistics as SystemMetrics for the output formatters
+     *
+     * CPU and busy percentages are host means; bytes and rates are cluster
+     * sums, with disk under "_Total" and network under one "cluster"
+     * interface. The full statistics are attached as SystemMetrics::cluster.
+     */
+    static SystemMetrics toSystemMetrics(const ClusterStats& stats);
+
+private:
+    struct HostSample {
+        uint64_t validMask;
+        std::array<double, MAX_FRAME_SLOTS> values;
+    };
+    using Bucket = std::unordered_map<std::string, HostSample>;
+
+    ClusterStats summarize(uint64_t bucketStartMs, const Bucket& bucket) const;
+
+    uint64_t bucketMs_;
+    uint64_t graceMs_;
+    double sketchAccuracy_;
+    std::map<uint64_t, Bucket> buckets_;   ///< Bucket start -> latest sample per host
+    uint64_t closedThroughMs_;             ///< Buckets starting before this are closed
+    uint64_t lateSamples_;
+    uint64_t futureSamples_;
+    uint64_t invalidValues_;
+};
+
+}  // namespace WinHKMon
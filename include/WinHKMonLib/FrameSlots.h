@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Types.h"
+#include "WinHKMonC.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file FrameSlots.h
+ * @brief Flat scalar slot view of SystemMetrics
+ *
+ * One mapping from SystemMetrics to the numbered scalar slots (whk_slot),
+ * shared by the C API frame, the push protocol and the pull ring so all
+ * of them agree on slot numbers and meaning. Collector module counters
+ * take the slots after the built-in ones, assigned when the modules load.
+ */
+
+namespace WinHKMon {
+
+constexpr uint32_t SLOT_COUNT = WHK_SLOT_COUNT;  ///< Built-in scalar slots known to this build
+
+/**
+ * @brief Frame slots of the loaded collector modules
+ *
+ * Each module gets a contiguous run of slots after the built-in ones, in
+ * load order, and each counter is exported as "<module>_<counter>". The
+ * layout only changes at load time; frames keep the schema list they were
+ * sampled with, so adding a module never disturbs frames already taken.
+ */
+class SlotLayout {
+public:
+    SlotLayout();
+
+    /**
+     * @brief Assign slots to a module's counters
+     *
+     * @param schema Module schema (firstSlot is ignored)
+     * @return First slot of the module (counter i is at first + i)
+     * @throws std::runtime_error if an export name is already a built-in
+     *         slot or a counter of an earlier module, or the frame has no
+     *         room left for the counters (nothing is registered then)
+     */
+    uint32_t addModule(const ModuleSchema& schema);
+
+    /**
+     * @brief Registered modules with their firstSlot set (never null)
+     */
+    const std::shared_ptr<const std::vector<ModuleSchema>>& modules() const { return modules_; }
+
+    /**
+     * @brief Built-in plus module slots
+     */
+    uint32_t slotCount() const;
+
+    /**
+     * @brief Export name of a slot (built-in name, "<module>_<counter>" or "unknown")
+     */
+    std::string name(uint32_t slot) const;
+
+private:
+    std::shared_ptr<const std::vector<ModuleSchema>> modules_;
+    std::vector<std::string> moduleSlotNames_;   ///< Export names of slots SLOT_COUNT and up
+};
+
+/**
+ * @brief Flatten metrics into scalar slots
+ *
+ * - CPU: total percent, average frequency
+ * - Memory: physical and page file bytes and percentages
+ * - Disk: _Total read/write rates and busy percent
+ * - Network: receive/send rates summed over interfaces
+ * - Modules: each counter in the slot its module was given at load time
+ *
+ * @param metrics Collected metrics (absent fields leave their slots untouched)
+ * @param values Output array of MAX_FRAME_SLOTS doubles
+ * @return Bit mask of slots written (bit N = slot N)
+ */
+uint64_t flattenSlots(const SystemMetrics& metrics, double* values);
+
+/**
+ * @brief Slots a frame of these metrics spans (SLOT_COUNT plus module counters)
+ */
+uint32_t frameSlotCount(const SystemMetrics& metrics);
+
+/**
+ * @brief Stable snake_case name of a built-in slot (e.g., "cpu_percent")
+ *
+ * @return Name, or "unknown" for slots past the built-in ones
+ */
+const char* slotName(uint32_t slot);
+
+}  // namespace WinHKMon
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file Gzip.h
+ * @brief Dependency-free gzip (RFC 1952) encoder for export request bodies
+ *
+ * One deflate block with the fixed Huffman code and greedy LZ77 matching
+ * over a 32 KB window. Metric payloads repeat the same names, keys and
+ * attribute sets on every data point, which LZ77 alone removes, so this
+ * gets most of zlib's ratio on them without linking zlib.
+ */
+
+namespace WinHKMon {
+
+/**
+ * @brief CRC-32 (IEEE 802.3, as used by gzip and zip)
+ *
+ * @param crc Running value (0 to start)
+ */
+uint32_t crc32(const void* data, size_t size, uint32_t crc = 0);
+
+/**
+ * @brief Compress to a complete gzip member
+ */
+std::string gzipCompress(const std::string& data);
+
+}  // namespace WinHKMon
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "QuantileSketch.h"
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @file HighRateTimer.h
+ * @brief Absolute-deadline timing for sub-100 ms intervals (--high-rate)
+ *
+ * The event loop's poll timeout has millisecond granularity and the system
+ * timer tick is ~15.6 ms on Windows by default, so neither can hold a 1 ms
+ * period. High-rate mode instead sleeps on a high-resolution waitable timer
+ * (Windows 10 1803+, else a regular one with a 1 ms timer period) or on
+ * clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME), and measures how late
+ * each wake-up was against its deadline.
+ */
+
+namespace WinHKMon {
+
+/**
+ * @brief Sleeps until absolute monotonic deadlines
+ */
+class DeadlineTimer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Create the timer
+     *
+     * @throws std::runtime_error if no timer can be created
+     */
+    DeadlineTimer();
+    ~DeadlineTimer();
+
+    DeadlineTimer(const DeadlineTimer&) = delete;
+    DeadlineTimer& operator=(const DeadlineTimer&) = delete;
+
+    /**
+     * @brief Sleep until the deadline (returns at once if it has passed)
+     *
+     * @return Clock reading on wake-up
+     */
+    Clock::time_point sleepUntil(Clock::time_point deadline);
+
+    /**
+     * @brief True when the timer wakes with sub-millisecond precision by itself
+     *
+     * false on Windows before 1803, where the process raised the system
+     * timer resolution to 1 ms instead.
+     */
+    bool highResolution() const { return highResolution_; }
+
+private:
+    void* timer_;              ///< Waitable timer HANDLE (Windows)
+    bool highResolution_;
+    bool timerPeriodRaised_;   ///< timeBeginPeriod(1) to undo (Windows)
+};
+
+/**
+ * @brief Achieved timing of a high-rate run
+ */
+struct JitterStats {
+    uint64_t ticks = 0;        ///< Deadlines met (samples taken)
+    uint64_t missed = 0;       ///< Deadlines skipped because a tick overran them
+    double meanUs = 0.0;       ///< Mean wake-up lateness (microseconds)
+    double p50Us = 0.0;        ///< Median lateness
+    double p99Us = 0.0;        ///< 99th percentile lateness
+    double maxUs = 0.0;        ///< Worst lateness
+};
+
+/**
+ * @brief Fixed-period deadlines on a grid, with lateness statistics
+ *
+ * Deadline k is start + k * period, so the period never accumulates tick
+ * run time or wake-up lateness. A tick that overruns one or more deadlines
+ * skips them (counted as missed) instead of firing a burst to catch up.
+ *
+ * Clock readings are passed in, so the pacing is testable and clock-agnostic.
+ *
+ * @note Not thread-safe; owned by the sampling loop
+ */
+class TickPacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @param period Tick spacing
+     * @param start First deadline is start + period
+     * @throws std::invalid_argument if the period is not positive
+     */
+    TickPacer(Clock::duration period, Clock::time_point start);
+
+    /**
+     * @brief Deadline of the next tick
+     */
+    Clock::time_point deadline() const { return deadline_; }
+
+    /**
+     * @brief Record a tick and advance to the next deadline after it
+     *
+     * @param woke When the sleep for deadline() returned
+     * @param done When the tick's work finished
+     * @return Deadlines skipped because done was already past them
+     */
+    uint64_t complete(Clock::time_point woke, Clock::time_point done);
+
+    /**
+     * @brief Lateness and missed deadlines so far
+     */
+    JitterStats stats() const;
+
+private:
+    Clock::duration period_;
+    Clock::time_point deadline_;
+    QuantileSketch latenessUs_;
+    uint64_t missed_;
+};
+
+}  // namespace WinHKMon
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CachedFile.h"
+#include "Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @file KernelResourceMonitor.h
+ * @brief System-wide kernel resource usage and headroom (KRES metric)
+ *
+ * Windows: handle, thread and process counts from one GetPerformanceInfo
+ * call. Linux (under a /proc root): allocated versus maximum file handles
+ * from sys/fs/file-nr, and socket counts and buffer memory per protocol
+ * from net/sockstat and net/sockstat6, with TCP and UDP memory measured
+ * against the tcp_mem/udp_mem limits read at start.
+ *
+ * Each tick costs one call (Windows) or one read per file (Linux).
+ */
+
+namespace WinHKMon {
+
+/**
+ * @brief Kernel resource monitor
+ */
+class KernelResourceMonitor {
+public:
+    /**
+     * @param procRoot procfs mount point (Linux sources only)
+     * @param pageBytes Unit of the sockstat mem counters (0 = this host's page size)
+     */
+    explicit KernelResourceMonitor(std::string procRoot = PROC_ROOT, size_t pageBytes = 0);
+    ~KernelResourceMonitor();
+
+    KernelResourceMonitor(const KernelResourceMonitor&) = delete;
+    KernelResourceMonitor& operator=(const KernelResourceMonitor&) = delete;
+
+    /**
+     * @brief Open the sources this host has and read the socket memory limits
+     *
+     * @throws std::runtime_error if no source is available
+     */
+    void initialize();
+
+    /**
+     * @brief Current usage; fields of sources this host lacks are left empty
+     */
+    KernelResourceStats getCurrentStats();
+
+private:
+    std::string procRoot_;
+    size_t pageBytes_;
+    bool performanceInfo_;         ///< GetPerformanceInfo is the source (Windows)
+    std::unique_ptr<CachedFile> fileNr_;
+    std::unique_ptr<CachedFile> sockstat_;
+    std::unique_ptr<CachedFile> sockstat6_;
+    uint64_t tcpMemoryMaxPages_;   ///< Third tcp_mem value (0 = unknown)
+    uint64_t udpMemoryMaxPages_;   ///< Third udp_mem value (0 = unknown)
+    std::string buffer_;
+};
+
+}  // namespace WinHKMon
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file LowImpact.h
+ * @brief Low-interference execution mode (--low-impact)
+ *
+ * Keeps WinHKMon out of the way of latency-sensitive workloads on the same
+ * host: idle CPU priority, pinning to housekeeping CPUs, background I/O
+ * priority for output writes, and a locked working set so the sampling loop
+ * does not take page faults.
+ */
+
+namespace WinHKMon {
+
+/**
+ * @brief Which low-impact settings took effect
+ *
+ * Each setting is best-effort: a failure is reported as a warning and the
+ * monitor keeps running with the remaining settings.
+ */
+struct LowImpactStatus {
+    bool idlePriority = false;       ///< Process runs in IDLE_PRIORITY_CLASS
+    bool affinityPinned = false;     ///< Process affinity restricted to housekeeping CPUs
+    bool backgroundIo = false;       ///< Calling thread in background mode (very low I/O priority)
+    bool workingSetLocked = false;   ///< Hard minimum working set covers the hot path
+    std::vector<std::string> warnings;  ///< Human-readable reasons for settings that failed
+};
+
+/**
+ * @brief Convert a CPU list to a processor-group affinity mask
+ *
+ * @param cpus Logical CPU numbers (0 - 63)
+ * @return Bit mask with one bit per CPU
+ * @throws std::invalid_argument if a CPU number does not fit in the mask
+ */
+uint64_t cpuListToAffinityMask(const std::vector<unsigned>& cpus);
+
+/**
+ * @brief Apply the scheduling side of low-impact mode to the current process
+ *
+ * - Priority class: IDLE_PRIORITY_CLASS (runs only when CPUs are otherwise idle)
+ * - Affinity: process-wide, so PDH and IP Helper worker threads are pinned too;
+ *   CPUs not present on this system are ignored
+ * - I/O: THREAD_MODE_BACKGROUND_BEGIN on the calling thread, which performs
+ *   state-file writes (sink writer threads call enterBackgroundIo())
+ *
+ * @param housekeepingCpus CPUs to pin to (empty = leave affinity unchanged)
+ * @return Settings that took effect and warnings for those that did not
+ * @note Call from the thread that writes output
+ */
+LowImpactStatus enterLowImpactMode(const std::vector<unsigned>& housekeepingCpus);
+
+/**
+ * @brief Put the calling thread in background I/O mode (very low I/O priority)
+ *
+ * @return true on success
+ */
+bool enterBackgroundIo();
+
+/**
+ * @brief Fault in and lock the current working set
+ *
+ * Touches a stack reserve, then raises the hard minimum working set to the
+ * current size plus headroom, so pages used by the sampling loop stay resident.
+ * Call after the first sample, when monitors and output buffers are allocated.
+ *
+ * @param headroomBytes Extra bytes above the current working set
+ * @param status Updated with the result (workingSetLocked or a warning)
+ * @return true if the working set was locked
+ */
+bool lockWorkingSet(size_t headroomBytes, LowImpactStatus& status);
+
+}  // namespace WinHKMon
@@ -1,17 +1,26 @@
 #pragma once
 
+#include "CachedFile.h"
 #include "Types.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
 
 /**
  * @file MemoryMonitor.h
  * @brief Memory (RAM and page file) monitoring component
  * 
  * Provides real-time memory usage statistics using Windows GlobalMemoryStatusEx API.
- * This is the simplest monitor component with a single API call.
+ * Where procfs is present, one pass over meminfo and vmstat per sample adds
+ * huge page pools, THP usage and THP fault, fallback and compaction-stall rates
+ * (and supplies RAM and swap on hosts without GlobalMemoryStatusEx).
  */
 
 namespace WinHKMon {
 
+constexpr const char* HUGEPAGE_ROOT = "/sys/kernel/mm/hugepages";
+
 /**
  * @brief Monitors physical and virtual memory (RAM and page file) usage
  * 
@@ -19,15 +28,29 @@ namespace WinHKMon {
  * - Physical RAM (total, available, used)
  * - Page file (total, available, used)
  * - Usage percentages
+ * - Huge pages and transparent huge pages (Linux)
  * 
  * Implementation uses GlobalMemoryStatusEx() which provides all needed data
  * in a single API call.
  * 
- * @note This class is stateless and thread-safe.
- * @note No initialization or cleanup required.
+ * meminfo only describes the default huge page size. Pools of every other
+ * size are read from their sysfs directories as well. An empty pool costs
+ * one read per sample and is listed once pages are allocated to it.
+ * 
+ * @note Not thread-safe: THP rates are kept between calls.
  */
 class MemoryMonitor {
 public:
+    /**
+     * @param procRoot procfs mount point (meminfo, vmstat)
+     * @param hugePageRoot Directory of the per-size hugepages-<N>kB pools
+     */
+    explicit MemoryMonitor(std::string procRoot = PROC_ROOT, std::string hugePageRoot = HUGEPAGE_ROOT);
+    ~MemoryMonitor();
+
+    MemoryMonitor(const MemoryMonitor&) = delete;
+    MemoryMonitor& operator=(const MemoryMonitor&) = delete;
+
     /**
      * @brief Collect current memory usage statistics
      * 
@@ -38,7 +61,6 @@ public:
      * @throws std::runtime_error if GlobalMemoryStatusEx fails
      * 
      * @note Execution time: < 1ms (single API call)
-     * @note Thread-safe: Can be called from multiple threads
      * 
      * @par Example:
      * @code
@@ -48,7 +70,35 @@ public:
      * @endcode
      */
     MemoryStats getCurrentStats();
+
+    /**
+     * @brief Same, with the sample time supplied (THP rates use it)
+     */
+    MemoryStats getCurrentStats(std::chrono::steady_clock::time_point now);
+
+private:
+    /// A non-default huge page size, read from sysfs
+    struct HugePagePool {
+        uint64_t pageBytes;
+        std::unique_ptr<CachedFile> total;
+        std::unique_ptr<CachedFile> free;
+        std::unique_ptr<CachedFile> reserved;
+        std::unique_ptr<CachedFile> surplus;
+    };
+
+    bool readProcMemory(MemoryStats& stats, std::chrono::steady_clock::time_point now);
+    void openHugePagePools(const std::string& hugePageRoot);
+
+    std::unique_ptr<CachedFile> meminfo_;   ///< Null without procfs
+    std::unique_ptr<CachedFile> vmstat_;
+    std::vector<HugePagePool> pools_;       ///< Other page sizes, smallest first
+    std::string buffer_;
+
+    bool primed_;                           ///< Previous vmstat counters are set
+    std::chrono::steady_clock::time_point previousTime_;
+    uint64_t thpFaults_;
+    uint64_t thpFallbacks_;
+    uint64_t compactStalls_;
 };
 
 }  // namespace WinHKMon
-
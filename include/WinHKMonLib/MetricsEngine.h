@@ -0,0 +1,194 @@
+#pragma once
+
+#include "Types.h"
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file MetricsEngine.h
+ * @brief In-process subscription API for embedding WinHKMonLib
+ *
+ * Lets a host process receive metrics on a schedule without running the CLI
+ * loop: subscribers name the fields they need and an interval, and the engine
+ * collects on its own thread and calls back with shared, immutable frames.
+ */
+
+namespace WinHKMon {
+
+/**
+ * @brief Metric fields a subscriber can request (bit mask)
+ */
+enum MetricField : uint32_t {
+    FIELD_CPU = 1u << 0,       ///< CpuStats (PDH usage + frequency)
+    FIELD_MEMORY = 1u << 1,    ///< MemoryStats
+    FIELD_DISK = 1u << 2,      ///< DiskStats (space and I/O rates)
+    FIELD_NETWORK = 1u << 3,   ///< InterfaceStats with rates
+    FIELD_MODULES = 1u << 4,   ///< Counters of modules loaded with loadModule()
+    FIELD_ALL = FIELD_CPU | FIELD_MEMORY | FIELD_DISK | FIELD_NETWORK | FIELD_MODULES
+};
+
+/**
+ * @brief One collection pass, shared by every subscriber it is delivered to
+ *
+ * Only the fields collected in that pass are set; failedFields names the
+ * requested ones whose collector failed. Frames are never modified
+ * after delivery, so callbacks may keep the pointer as long as they like.
+ */
+using MetricsFrame = std::shared_ptr<const SystemMetrics>;
+
+/**
+ * @brief Subscriber callback (runs on the engine thread)
+ */
+using FrameCallback = std::function<void(const MetricsFrame& frame)>;
+
+/**
+ * @brief Collects the requested fields into a new SystemMetrics
+ *
+ * Replaceable so hosts and tests can drive the scheduler without the
+ * Windows monitors.
+ */
+using FieldCollector = std::function<SystemMetrics(uint32_t fieldMask)>;
+
+/**
+ * @brief Subscription scheduler that owns the monitors and one worker thread
+ *
+ * Each wake-up collects the union of the fields of every subscriber that is
+ * due (within a small coalescing window), once, and hands the same frame to
+ * all of them. Due times lie on a grid of interval multiples counted from
+ * engine construction, not from each subscribe() call, so subscribers at
+ * 1 s and 5 s share every fifth pass, and two 1 s subscribers share every
+ * pass however far apart they subscribed. Monitors are created on first use
+ * of their field.
+ *
+ * Rates: CPU and disk rates come from PDH and cover the time since the
+ * previous pass that included the field; network rates are computed against
+ * the previous pass that included FIELD_NETWORK.
+ *
+ * @note Callbacks run on the engine thread and should return quickly; a
+ *       slow callback delays later passes. Exceptions thrown by callbacks
+ *       are caught and ignored. A collector that fails leaves its field
+ *       unset and sets its bit in SystemMetrics::failedFields, so callbacks
+ *       can tell a failed field from one that was not requested.
+ * @note subscribe(), unsubscribe() and sample() are thread-safe.
+ */
+class MetricsEngine {
+public:
+    using SubscriptionId = uint64_t;
+
+    static constexpr std::chrono::milliseconds COALESCE_WINDOW{5};  ///< Due-time slack for sharing a pass
+
+    /**
+     * @brief Construct engine using the built-in Windows monitors
+     */
+    MetricsEngine();
+
+    /**
+     * @brief Construct engine with a custom field collector
+     *
+     * @param collector Called once per pass with the union of due fields
+     */
+    explicit MetricsEngine(FieldCollector collector);
+
+    /**
+     * @brief Stop the worker thread and release monitors
+     */
+    ~MetricsEngine();
+
+    MetricsEngine(const MetricsEngine&) = delete;
+    MetricsEngine& operator=(const MetricsEngine&) = delete;
+
+    /**
+     * @brief Register a periodic subscriber
+     *
+     * The first delivery happens at the next multiple of the interval
+     * since the engine was constructed (at most one interval away). Monitors
+     * for newly requested fields are started here, so that delivery already
+     * has a rate baseline. Starts the worker thread on the first subscription.
+     *
+     * @param fieldMask MetricField bits to collect
+     * @param intervalSeconds Delivery period (> 0)
+     * @param callback Receives each frame
+     * @return Handle for unsubscribe()
+     * @throws std::invalid_argument if the mask is empty, the interval is not
+     *         positive or the callback is empty
+     */
+    SubscriptionId subscribe(uint32_t fieldMask, double intervalSeconds, FrameCallback callback);
+
+    /**
+     * @brief Remove a subscriber
+     *
+     * No callback for this subscriber starts after return. When called from
+     * outside the engine thread it also waits for a running delivery to end.
+     *
+     * @param id Handle returned by subscribe()
+     * @return true if the subscription existed
+     */
+    bool unsubscribe(SubscriptionId id);
+
+    /**
+     * @brief Collect a frame immediately on the calling thread
+     *
+     * @param fieldMask MetricField bits to collect
+     * @return New frame (not delivered to subscribers)
+     * @note Rates are zero the first time a field is collected (no baseline yet)
+     */
+    MetricsFrame sample(uint32_t fieldMask);
+
+    /**
+     * @brief Load a collector module; its counters are collected with FIELD_MODULES
+     *
+     * @param path Shared library implementing WinHKMonModule.h
+     * @return Frame slot of the module's first counter (counter i is at first + i)
+     * @throws std::runtime_error if the engine uses a custom collector, the
+     *         module fails to load or one of its export names is taken
+     */
+    uint32_t loadModule(const std::string& path);
+
+    /**
+     * @brief Number of collection passes performed so far (including sample())
+     */
+    uint64_t passCount() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Subscription {
+        SubscriptionId id;
+        uint32_t fieldMask;
+        Clock::duration interval;
+        Clock::time_point nextDue;
+        FrameCallback callback;
+        std::atomic<bool> active{true};       ///< Cleared by unsubscribe()
+    };
+
+    class MonitorSet;
+
+    void run();
+    MetricsFrame collect(uint32_t fieldMask);
+    Clock::time_point nextGridPoint(Clock::duration interval, Clock::time_point after) const;  ///< First grid time > after
+
+    FieldCollector collector_;
+    std::unique_ptr<MonitorSet> monitors_;    ///< Built-in collectors (null with custom collector)
+
+    mutable std::mutex mutex_;                ///< Guards subscriptions, ids, stop flag, counters
+    std::condition_variable wake_;
+    std::vector<std::shared_ptr<Subscription>> subscriptions_;
+    Clock::time_point epoch_;                 ///< Origin of every subscriber's due-time grid
+    SubscriptionId nextId_;
+    uint64_t passCount_;
+    bool stopping_;
+    std::thread worker_;
+
+    std::mutex collectMutex_;                 ///< Serializes passes (monitors are single-threaded)
+    std::mutex deliveryMutex_;                ///< Held while callbacks run (unsubscribe waits on it)
+};
+
+}  // namespace WinHKMon
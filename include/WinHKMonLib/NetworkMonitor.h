@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Types.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -9,7 +10,8 @@
  * @brief Network interface statistics monitoring
  * 
  * Provides network interface enumeration and statistics collection using
- * Windows IP Helper API (GetIfTable2, MIB_IF_ROW2).
+ * Windows IP Helper API (GetIfTable2, MIB_IF_ROW2). Monitors restricted to
+ * selected interfaces read just those rows (GetIfEntry2).
  */
 
 namespace WinHKMon {
@@ -21,7 +23,7 @@ namespace WinHKMon {
  * connection status, and link speeds. Uses GetIfTable2() for modern
  * Windows versions (Vista+).
  * 
- * @note Loopback interfaces are automatically filtered out
+ * @note Loopback interfaces are filtered out unless explicitly requested
  * @note Rate calculations require DeltaCalculator and previous state
  */
 class NetworkMonitor {
@@ -58,12 +60,33 @@ public:
      * @return Vector of InterfaceStats for all non-loopback interfaces
      * @throws std::runtime_error if GetIfTable2() fails
      * 
-     * @note Loopback interfaces are filtered out automatically
+     * @note Loopback interfaces are filtered out unless setIncludeLoopback(true)
      * @note Rate calculations (inBytesPerSec, outBytesPerSec) are set to 0;
      *       caller must use DeltaCalculator to compute rates from cumulative counters
      */
     std::vector<InterfaceStats> getCurrentStats();
     
+    /**
+     * @brief Restrict getCurrentStats() to some interfaces (high-rate mode)
+     * 
+     * Resolves the names once, with one GetIfTable2() call; afterwards each
+     * sample reads only these rows with GetIfEntry2() instead of the whole
+     * table. An interface that disappears later is left out of samples.
+     * 
+     * @param names Interface aliases, loopback included (empty = every
+     *        non-loopback interface present now)
+     * @throws std::runtime_error if GetIfTable2() fails or a name matches no interface
+     */
+    void selectInterfaces(const std::vector<std::string>& names);
+    
+    /**
+     * @brief Keep loopback interfaces in getCurrentStats()
+     * 
+     * For a caller that filters by an explicitly named interface (--interface),
+     * so loopback traffic can be measured when asked for by name.
+     */
+    void setIncludeLoopback(bool include) { includeLoopback_ = include; }
+    
     /**
      * @brief Select primary network interface for monitoring
      * 
@@ -94,6 +117,19 @@ private:
      * @return UTF-8 encoded string
      */
     std::string wideToUtf8(const wchar_t* wstr) const;
+    
+    /**
+     * @brief Interface chosen by selectInterfaces()
+     */
+    struct SelectedInterface {
+        uint64_t luid;               ///< NET_LUID value
+        std::string name;
+        std::string description;
+    };
+    
+    bool selected_ = false;          ///< getCurrentStats() reads selectedInterfaces_ only
+    bool includeLoopback_ = false;   ///< getCurrentStats() keeps loopback rows
+    std::vector<SelectedInterface> selectedInterfaces_;
 };
 
 }  // namespace WinHKMon
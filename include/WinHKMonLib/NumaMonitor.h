@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CachedFile.h"
+#include "Types.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file NumaMonitor.h
+ * @brief Per-NUMA-node memory statistics (NUMA metric)
+ *
+ * Reads node<N>/meminfo (MemTotal, MemFree, FilePages, AnonPages) and
+ * node<N>/numastat (numa_hit, numa_miss, numa_foreign) under a root,
+ * normally /sys/devices/system/node. A node short of memory while others
+ * have plenty shows up as rising numa_miss/numa_foreign rates.
+ *
+ * On hosts without that sysfs tree (including Windows) initialize() fails
+ * and the metric is reported as unavailable.
+ */
+
+namespace WinHKMon {
+
+constexpr const char* NUMA_NODE_ROOT = "/sys/devices/system/node";
+
+/**
+ * @brief NUMA node monitor with persistent meminfo/numastat handles
+ *
+ * Nodes are found once by initialize(); each sample is then one seek and
+ * one read per file.
+ */
+class NumaMonitor {
+public:
+    /**
+     * @param root Directory holding the node<N> directories
+     */
+    explicit NumaMonitor(std::string root = NUMA_NODE_ROOT);
+    ~NumaMonitor();
+
+    NumaMonitor(const NumaMonitor&) = delete;
+    NumaMonitor& operator=(const NumaMonitor&) = delete;
+
+    /**
+     * @brief Find the nodes and take the baseline sample
+     *
+     * @throws std::runtime_error if there are no readable nodes
+     */
+    void initialize();
+
+    /**
+     * @brief Every node, in node order; rates cover the time since the previous call
+     */
+    std::vector<NumaNodeStats> getCurrentStats();
+
+    /**
+     * @brief As getCurrentStats(), sampled as of now (tests control elapsed time)
+     */
+    std::vector<NumaNodeStats> getCurrentStats(std::chrono::steady_clock::time_point now);
+
+private:
+    struct Node {
+        int id;
+        std::unique_ptr<CachedFile> meminfo;
+        std::unique_ptr<CachedFile> numastat;
+        bool primed = false;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t foreign = 0;
+        std::chrono::steady_clock::time_point previousTime;
+    };
+
+    std::string root_;
+    std::vector<Node> nodes_;
+    std::string buffer_;
+};
+
+}  // namespace WinHKMon
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "MetricsEngine.h"
+#include "Types.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file OtlpExporter.h
+ * @brief OpenTelemetry metrics export over OTLP/HTTP with JSON bodies (--otlp)
+ *
+ * Samples map onto the OTel host-metrics semantic conventions
+ * (system.cpu.utilization, system.memory.usage, system.disk.io,
+ * system.network.io, ...). The sampling loop only queues a frame; a
+ * background thread batches queued samples into one request, gzips it and
+ * retries retryable failures with backoff. The queue is bounded and drops
+ * its oldest sample when full, so an unreachable collector never slows
+ * sampling and never grows memory.
+ */
+
+namespace WinHKMon {
+
+constexpr uint16_t OTLP_DEFAULT_PORT = 4318;           ///< OTLP/HTTP port
+constexpr const char* OTLP_METRICS_PATH = "/v1/metrics";
+
+/**
+ * @brief Collector address from an --otlp URL
+ */
+struct OtlpEndpoint {
+    std::string host;
+    uint16_t port = OTLP_DEFAULT_PORT;
+    std::string path = OTLP_METRICS_PATH;
+};
+
+/**
+ * @brief Parse http://host[:port][/path]
+ *
+ * The path defaults to /v1/metrics and the port to 4318.
+ * Example: "http://otel-collector:4318/v1/metrics"
+ *
+ * @throws std::invalid_argument if malformed or not http
+ */
+OtlpEndpoint parseOtlpUrl(const std::string& url);
+
+/**
+ * @brief Exporter settings
+ */
+struct OtlpConfig {
+    OtlpEndpoint endpoint;
+    size_t batchSamples = 10;                  ///< Samples per request
+    size_t maxQueuedSamples = 1000;            ///< Samples held while the collector is behind
+    std::chrono::milliseconds maxBatchDelay{10000};  ///< Send a partial batch after this long
+    bool gzip = true;                          ///< Content-Encoding: gzip
+    int timeoutMs = 5000;                      ///< Connect, send and response timeout
+    int maxAttempts = 4;                       ///< Tries per batch before it is dropped
+    std::chrono::milliseconds retryDelay{500}; ///< First backoff; doubles per attempt
+};
+
+/**
+ * @brief One queued sample with its wall-clock time
+ */
+struct OtlpSample {
+    MetricsFrame metrics;
+    uint64_t timeUnixNano = 0;
+};
+
+/**
+ * @brief Start times of the cumulative series, one per metric and attribute set
+ *
+ * The exported counters are the OS's own (PDH raw disk counts, interface
+ * octets and errors), so a series starts at the counters' origin, the
+ * boot time. A value below the previous one means the counter restarted
+ * (interface reset, driver reload), and the series then starts again at
+ * the time of its previous point.
+ */
+class CumulativeStarts {
+public:
+    /**
+     * @param originUnixNano Start of every series until it is reset
+     */
+    explicit CumulativeStarts(uint64_t originUnixNano);
+
+    uint64_t origin() const { return origin_; }
+
+    /**
+     * @brief Start time for a point of a series; records the point
+     */
+    uint64_t startFor(const std::string& series, uint64_t timeUnixNano, uint64_t value);
+
+private:
+    struct Series {
+        uint64_t startUnixNano;
+        uint64_t lastUnixNano;
+        uint64_t lastValue;
+    };
+
+    uint64_t origin_;
+    std::map<std::string, Series> series_;
+};
+
+/**
+ * @brief ExportMetricsServiceRequest JSON for a batch of samples
+ *
+ * One data point per sample per series. Rates and percentages become
+ * gauges; cumulative byte counters become monotonic cumulative sums whose
+ * start times come from starts. Metrics without an OTel convention
+ * (temperature, cgroups, power, ...) are not exported.
+ *
+ * @param hostName Resource attribute host.name
+ * @param starts Series start times (updated with the batch's points)
+ */
+std::string encodeOtlpJson(const std::vector<OtlpSample>& samples, const std::string& hostName,
+                           CumulativeStarts& starts);
+
+/**
+ * @brief POST a body to the collector
+ *
+ * @return HTTP status code, or 0 if the collector could not be reached
+ *         or did not answer within the timeout
+ */
+int postOtlpRequest(const OtlpEndpoint& endpoint, const std::string& body, bool gzip, int timeoutMs);
+
+/**
+ * @brief Batching, retrying exporter with its own thread
+ */
+class OtlpExporter {
+public:
+    /**
+     * @brief Sends a request body; returns an HTTP status (0 = unreachable)
+     */
+    using Transport = std::function<int(const std::string& body, bool gzip)>;
+
+    /**
+     * @brief Start the export thread
+     *
+     * @param config Endpoint, batching and retry settings
+     * @param hostName Resource attribute host.name
+     * @param transport Replaces the HTTP POST (tests)
+     * @throws std::invalid_argument if a batch or queue size is zero
+     */
+    OtlpExporter(const OtlpConfig& config, const std::string& hostName, Transport transport = nullptr);
+
+    /**
+     * @brief Stop the export thread (see stop())
+     */
+    ~OtlpExporter();
+
+    OtlpExporter(const OtlpExporter&) = delete;
+    OtlpExporter& operator=(const OtlpExporter&) = delete;
+
+    /**
+     * @brief Queue a sample; never blocks (the oldest is dropped when full)
+     */
+    void submit(MetricsFrame frame, uint64_t timeUnixNano);
+
+    /**
+     * @brief Block until the queue is empty and no request is in flight
+     *
+     * Queued samples are sent now instead of waiting for a full batch.
+     */
+    void flush();
+
+    /**
+     * @brief Send what is queued without further retries, then stop the thread
+     *
+     * Pending backoffs end at once and, after the first failed request, the
+     * rest of the queue is dropped, so shutdown never waits out an
+     * unreachable collector. Counters stay readable afterwards.
+     */
+    void stop();
+
+    uint64_t exportedSamples() const;  ///< Samples the collector accepted
+    uint64_t droppedSamples() const;   ///< Samples lost to a full queue or failed batches
+    uint64_t failedExports() const;    ///< Batches given up on
+
+private:
+    void run();
+    bool send(const std::vector<OtlpSample>& batch);  ///< true once accepted
+
+    OtlpConfig config_;
+    std::string hostName_;
+    Transport transport_;
+    CumulativeStarts starts_;  ///< Export thread only
+
+    mutable std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<OtlpSample> queue_;
+    bool busy_;              ///< Export thread holds a batch taken off the queue
+    bool flushing_;          ///< flush() waiting: send partial batches now
+    bool stopping_;
+    uint64_t exported_;
+    uint64_t dropped_;
+    uint64_t failed_;
+    std::thread exporter_;
+};
+
+}  // namespace WinHKMon
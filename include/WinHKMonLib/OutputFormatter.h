@@ -6,6 +6,18 @@
 /**
  * @file OutputFormatter.h
  * @brief Output formatting functions for WinHKMon metrics
+ *
+ * With --fields (options.fields), every format writes only the selected
+ * values, flat and named by field path (see FieldProjection.h).
+ *
+ * Per-core CPU data follows options.coreView (--cores). JSON writes one
+ * object per core by default. The packed view writes a "coreUsage" array
+ * indexed by core ID, plus "coreFrequencyMhz" only when cores run at
+ * different frequencies. The histogram view writes "coreHistogram" with
+ * core counts per 10% bin. The top view writes "topCores", the busiest
+ * cores first. Both of those also write "coreSummary" (count, min, mean,
+ * max). Text shows the compact views after the CPU line; CSV has no
+ * per-core columns.
  */
 
 namespace WinHKMon {
@@ -29,6 +41,17 @@ std::string formatText(const SystemMetrics& metrics, bool singleLine, const CliO
  */
 std::string formatJson(const SystemMetrics& metrics, const CliOptions& options);
 
+/**
+ * @brief Format metrics as one compact JSON line (NDJSON)
+ * 
+ * Same fields as formatJson(), without line breaks or indentation.
+ * 
+ * @param metrics System metrics to format
+ * @param options CLI options to determine which metrics to display
+ * @return JSON object followed by a newline
+ */
+std::string formatNdjson(const SystemMetrics& metrics, const CliOptions& options);
+
 /**
  * @brief Format metrics as CSV
  * 
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CachedFile.h"
+#include "DeltaCalculator.h"
+#include "Types.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file PowerMonitor.h
+ * @brief Energy and power from RAPL counters (POWER metric)
+ *
+ * Reads the Linux powercap interface: every intel-rapl:<n>[:<m>] zone under
+ * the root (normally /sys/class/powercap) has a name (package-0, core,
+ * uncore, dram, psys), an energy_uj counter and the max_energy_range_uj at
+ * which that counter wraps. Watts are energy deltas over the sample
+ * interval.
+ *
+ * On hosts without RAPL zones (including Windows), or where energy_uj is
+ * readable only by root (Linux 5.10 and later), initialize() fails and the
+ * metric is reported as unavailable.
+ */
+
+namespace WinHKMon {
+
+constexpr const char* POWERCAP_ROOT = "/sys/class/powercap";
+
+/**
+ * @brief RAPL zone monitor with persistent energy_uj handles
+ *
+ * Zones are found once by initialize(); each sample is then one seek and
+ * one read per zone. Sample at least once per wrap period (minutes to
+ * hours, depending on the zone) so a wrap is never missed.
+ */
+class PowerMonitor {
+public:
+    /**
+     * @param root powercap class directory
+     */
+    explicit PowerMonitor(std::string root = POWERCAP_ROOT);
+    ~PowerMonitor();
+
+    PowerMonitor(const PowerMonitor&) = delete;
+    PowerMonitor& operator=(const PowerMonitor&) = delete;
+
+    /**
+     * @brief Find the zones and take the baseline sample
+     *
+     * @throws std::runtime_error if there are no readable RAPL zones
+     */
+    void initialize();
+
+    /**
+     * @brief Power of every zone since the previous call (0 W on the first)
+     *
+     * hostWatts is psys when the platform zone exists, otherwise the
+     * package zones plus the DRAM zones (package energy excludes DRAM).
+     * Zones that cannot be read this time are left out.
+     */
+    PowerStats getCurrentStats();
+
+    /**
+     * @brief As getCurrentStats(), sampled as of now (tests control elapsed time)
+     */
+    PowerStats getCurrentStats(std::chrono::steady_clock::time_point now);
+
+private:
+    struct Zone {
+        std::string name;            ///< "package-0", "package-0/dram"
+        bool counted;                ///< Part of hostWatts
+        uint64_t range;              ///< max_energy_range_uj (0 = unknown)
+        std::unique_ptr<CachedFile> energy;
+        bool primed = false;
+        uint64_t previous = 0;
+        std::chrono::steady_clock::time_point previousTime;
+    };
+
+    std::string root_;
+    std::vector<Zone> zones_;
+    DeltaCalculator deltaCalc_;
+    std::string buffer_;
+};
+
+}  // namespace WinHKMon
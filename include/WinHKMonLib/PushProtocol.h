@@ -0,0 +1,110 @@
+#pragma once
+
+#include "FrameSlots.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file PushProtocol.h
+ * @brief Compact binary protocol for agents pushing samples to an aggregator
+ *
+ * One message per sample, all integers little-endian:
+ *
+ *   u32 length        Bytes after this field
+ *   u32 magic         PUSH_MAGIC ("WHKA")
+ *   u16 version       PUSH_VERSION
+ *   u16 slotCount     Slots known to the sender
+ *   u64 timestampMs   Sender wall clock (Unix epoch milliseconds)
+ *   u64 validMask     Bit N set when slot N follows
+ *   u8  hostLen       Host ID length, followed by hostLen bytes
+ *   f64 values...     One IEEE double per set bit, lowest slot first
+ *
+ * A typical sample is under 150 bytes. Receivers keep every slot up to
+ * MAX_FRAME_SLOTS, so agents can be upgraded before the aggregator.
+ * Collector module counters travel in the slots after the built-in ones
+ * without their names, so agents feeding one aggregator should load the
+ * same modules in the same order.
+ */
+
+namespace WinHKMon {
+
+constexpr uint32_t PUSH_MAGIC = 0x414B4857;        ///< "WHKA" little-endian
+constexpr uint16_t PUSH_VERSION = 1;
+constexpr size_t MAX_PUSH_MESSAGE_BYTES = 4096;    ///< Larger length prefixes are rejected
+constexpr size_t MAX_HOST_ID_BYTES = 255;
+
+/**
+ * @brief One agent sample as carried by the push protocol
+ */
+struct PushSample {
+    std::string hostId;                          ///< Agent identifier (truncated to 255 bytes)
+    uint64_t timestampMs = 0;                    ///< Unix epoch milliseconds
+    uint64_t validMask = 0;                      ///< Bit N set when values[N] holds data
+    std::array<double, MAX_FRAME_SLOTS> values{};  ///< Scalar slots (see FrameSlots.h)
+};
+
+/**
+ * @brief Append one encoded message to a buffer
+ *
+ * @param sample Sample to encode
+ * @param out Buffer to append to (can be reused across calls)
+ */
+void encodePushSample(const PushSample& sample, std::string& out);
+
+/**
+ * @brief Incremental decoder for a stream of push messages
+ *
+ * Accepts bytes in whatever chunks the socket delivers and yields complete
+ * samples; a message split across reads is held until the rest arrives.
+ */
+class PushDecoder {
+public:
+    /**
+     * @brief Append received bytes
+     */
+    void feed(const char* data, size_t size);
+
+    /**
+     * @brief Extract the next complete sample
+     *
+     * @param sample Receives the sample
+     * @return true if a sample was extracted, false if more bytes are needed
+     * @throws std::runtime_error on a malformed stream (bad magic, version or length);
+     *         the connection should be dropped
+     */
+    bool next(PushSample& sample);
+
+    /**
+     * @brief Bytes received but not yet decoded
+     */
+    size_t buffered() const { return buffer_.size() - offset_; }
+
+private:
+    std::string buffer_;
+    size_t offset_ = 0;
+};
+
+/**
+ * @brief Listen or connect address
+ */
+struct Endpoint {
+    enum class Kind {
+        TCP,   ///< host:port
+        UNIX   ///< Filesystem path (AF_UNIX stream socket)
+    };
+    Kind kind = Kind::TCP;
+    std::string host;       ///< TCP host or IPv4 address
+    uint16_t port = 0;      ///< TCP port
+    std::string path;       ///< Socket path (UNIX)
+};
+
+/**
+ * @brief Parse "tcp:host:port" or "unix:path" ("host:port" implies tcp)
+ *
+ * @throws std::invalid_argument on malformed input
+ */
+Endpoint parseEndpoint(const std::string& text);
+
+}  // namespace WinHKMon
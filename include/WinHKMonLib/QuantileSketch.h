@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+
+/**
+ * @file QuantileSketch.h
+ * @brief Mergeable relative-error quantile sketch
+ *
+ * Log-bucketed sketch in the style of DDSketch: every quantile estimate is
+ * within a fixed relative error of a real value, and two sketches built
+ * with the same accuracy merge exactly by adding bucket counts. Used to
+ * compute cluster-wide percentiles without keeping every host's value.
+ */
+
+namespace WinHKMon {
+
+/**
+ * @brief Quantile sketch for non-negative values
+ *
+ * Value v > 0 falls in bucket ceil(log(v) / log(gamma)) with
+ * gamma = (1 + alpha) / (1 - alpha); zeros (and negatives, clamped to zero)
+ * are counted separately. Memory grows with the log of the value range,
+ * not with the number of values (~ 2,000 buckets cover 1 to 1e18 at 1%).
+ */
+class QuantileSketch {
+public:
+    /**
+     * @brief Construct empty sketch
+     *
+     * @param relativeAccuracy Maximum relative error alpha (0 < alpha < 1, default 1%)
+     * @throws std::invalid_argument if alpha is out of range
+     */
+    explicit QuantileSketch(double relativeAccuracy = 0.01);
+
+    /**
+     * @brief Add one value
+     *
+     * Negative values count as zero; NaN and infinities are ignored.
+     */
+    void add(double value);
+
+    /**
+     * @brief Add all values of another sketch
+     *
+     * @throws std::invalid_argument if the sketches use different accuracies
+     */
+    void merge(const QuantileSketch& other);
+
+    /**
+     * @brief Estimate the q-quantile
+     *
+     * @param q Quantile in [0, 1] (0.5 = median, 0.99 = p99)
+     * @return Estimate within relativeAccuracy of a real value; 0 if empty
+     */
+    double quantile(double q) const;
+
+    uint64_t count() const { return count_; }        ///< Values added
+    double sum() const { return sum_; }              ///< Exact sum of values
+    double min() const { return count_ ? min_ : 0.0; }  ///< Exact minimum
+    double max() const { return count_ ? max_ : 0.0; }  ///< Exact maximum
+    double relativeAccuracy() const { return alpha_; }
+
+private:
+    double alpha_;
+    double gamma_;
+    double logGamma_;
+    std::map<int32_t, uint64_t> buckets_;   ///< Bucket index -> count
+    uint64_t zeroCount_;
+    uint64_t count_;
+    double sum_;
+    double min_;
+    double max_;
+};
+
+}  // namespace WinHKMon
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "DeltaProtocol.h"
+#include "EventLoop.h"
+#include "PushProtocol.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @file RemoteTransport.h
+ * @brief Socket transport for the push and pull protocols
+ *
+ * TCP and AF_UNIX stream sockets via Winsock (AF_UNIX needs Windows 10
+ * 1803 or later). Servers and the push client are PollSources: every
+ * socket is non-blocking and serviced from the EventLoop thread, so 1,000
+ * agents pushing at 1 Hz cost one poll wakeup and a few small reads per sample.
+ */
+
+namespace WinHKMon {
+
+/**
+ * @brief Aggregator side: accepts agents and decodes their samples
+ */
+class AggregateServer : public PollSource {
+public:
+    using SampleHandler = std::function<void(const PushSample&)>;
+
+    /**
+     * @brief Bind and listen
+     *
+     * @param endpoint Listen address (an existing unix socket file is replaced)
+     * @param handler Called on the loop thread once per decoded sample
+     * @throws std::runtime_error if the socket cannot be bound
+     */
+    AggregateServer(const Endpoint& endpoint, SampleHandler handler);
+
+    /**
+     * @brief Close every connection and the listening socket
+     */
+    ~AggregateServer();
+
+    AggregateServer(const AggregateServer&) = delete;
+    AggregateServer& operator=(const AggregateServer&) = delete;
+
+    void pollEntries(std::vector<PollEntry>& entries) override;
+    void dispatch(PollEntry* entries, size_t count) override;
+
+    /**
+     * @brief Connected agents
+     */
+    size_t connectionCount() const { return connections_.size(); }
+
+    /**
+     * @brief Connections closed because they sent a malformed stream
+     */
+    uint64_t rejectedConnections() const { return rejected_; }
+
+private:
+    struct Connection {
+        uintptr_t socket;
+        PushDecoder decoder;
+    };
+
+    void acceptPending();
+    bool readConnection(Connection& connection);
+
+    Endpoint endpoint_;
+    SampleHandler handler_;
+    uintptr_t listenSocket_;
+    std::vector<Connection> connections_;
+    std::vector<char> readBuffer_;
+    uint64_t rejected_;
+};
+
+/**
+ * @brief Agent side: sends samples to an aggregator
+ *
+ * Connects on first use and reconnects after failures, at most once per
+ * retry interval, so an unreachable aggregator never stalls sampling.
+ * Output the socket could not take immediately is flushed by the event
+ * loop when the socket becomes writable.
+ */
+class PushClient : public PollSource {
+public:
+    /**
+     * @brief Construct client (does not connect yet)
+     *
+     * @param endpoint Aggregator address
+     */
+    explicit PushClient(const Endpoint& endpoint);
+
+    /**
+     * @brief Close the connection
+     */
+    ~PushClient();
+
+    PushClient(const PushClient&) = delete;
+    PushClient& operator=(const PushClient&) = delete;
+
+    /**
+     * @brief Send one sample
+     *
+     * @return true if the sample was handed to the socket, false if dropped
+     *         (not connected and the retry interval has not elapsed, or send failed)
+     */
+    bool send(const PushSample& sample);
+
+    /**
+     * @brief Whether a connection is currently open
+     */
+    bool isConnected() const { return socket_ != INVALID_HANDLE; }
+
+    void pollEntries(std::vector<PollEntry>& entries) override;
+    void dispatch(PollEntry* entries, size_t count) override;
+
+private:
+    static constexpr uintptr_t INVALID_HANDLE = ~static_cast<uintptr_t>(0);
+
+    bool connect();
+    void disconnect();
+    bool flush();
+
+    Endpoint endpoint_;
+    uintptr_t socket_;
+    std::string sendBuffer_;
+    std::chrono::steady_clock::time_point nextAttempt_;
+};
+
+/**
+ * @brief Agent side of the pull protocol: answers snapshot requests
+ *
+ * Serviced by the sampling thread's event loop between ticks, so requests
+ * are answered from the frames already collected and never trigger a
+ * collection.
+ */
+class PullServer : public PollSource {
+public:
+    /**
+     * @brief Bind and listen
+     *
+     * @param endpoint Listen address (an existing unix socket file is replaced)
+     * @param ring Frames to answer from (must outlive the server)
+     * @param epoch Agent run identifier
+     * @throws std::runtime_error if the socket cannot be bound
+     */
+    PullServer(const Endpoint& endpoint, const FrameRing& ring, uint64_t epoch);
+
+    /**
+     * @brief Close every connection and the listening socket
+     */
+    ~PullServer();
+
+    PullServer(const PullServer&) = delete;
+    PullServer& operator=(const PullServer&) = delete;
+
+    void pollEntries(std::vector<PollEntry>& entries) override;
+    void dispatch(PollEntry* entries, size_t count) override;
+
+    /**
+     * @brief Connected clients
+     */
+    size_t connectionCount() const { return connections_.size(); }
+
+    /**
+     * @brief Requests answered so far
+     */
+    uint64_t requestsAnswered() const { return answered_; }
+
+private:
+    struct Connection {
+        uintptr_t socket;
+        std::string inbox;    ///< Received request bytes not yet decoded
+        std::string outbox;   ///< Response bytes not yet sent
+    };
+
+    void acceptPending();
+    bool serviceConnection(Connection& connection, bool readable);
+
+    Endpoint endpoint_;
+    const FrameRing& ring_;
+    uint64_t epoch_;
+    uintptr_t listenSocket_;
+    std::vector<Connection> connections_;
+    std::vector<char> readBuffer_;
+    uint64_t answered_;
+};
+
+/**
+ * @brief Client side of the pull protocol
+ *
+ * Blocking socket with send/receive timeouts; connects on first use and
+ * after failures.
+ */
+class PullClient {
+public:
+    /**
+     * @brief Construct client (does not connect yet)
+     *
+     * @param endpoint Agent address
+     * @param timeoutMs Connect, send and receive timeout
+     */
+    explicit PullClient(const Endpoint& endpoint, int timeoutMs = 2000);
+
+    /**
+     * @brief Close the connection
+     */
+    ~PullClient();
+
+    PullClient(const PullClient&) = delete;
+    PullClient& operator=(const PullClient&) = delete;
+
+    /**
+     * @brief Request the latest snapshot and apply it to the decoder
+     *
+     * A delta that does not match the decoder's frame resets the decoder
+     * and is retried once as a keyframe request.
+     *
+     * @param decoder Client state (updated in place)
+     * @param responseBytes Receives the response size on the wire (optional)
+     * @return Kind of response applied
+     * @throws std::runtime_error if the agent is unreachable or the response is malformed
+     */
+    SnapshotKind pull(SnapshotDecoder& decoder, size_t* responseBytes = nullptr);
+
+private:
+    static constexpr uintptr_t INVALID_HANDLE = ~static_cast<uintptr_t>(0);
+
+    void connect();
+    void disconnect();
+    void exchange(const SnapshotDecoder& decoder, size_t* responseBytes);
+
+    Endpoint endpoint_;
+    int timeoutMs_;
+    uintptr_t socket_;
+    std::string message_;
+};
+
+}  // namespace WinHKMon
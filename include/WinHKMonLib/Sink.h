@@ -0,0 +1,215 @@
+#pragma once
+
+#include "MetricsEngine.h"
+#include "SqliteStore.h"
+#include "Types.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file Sink.h
+ * @brief Output destinations fed from one shared frame per tick
+ *
+ * Each --sink owns a bounded queue; a small shared pool of writer threads
+ * formats and writes them, so a console view, an NDJSON log and a CSV file
+ * cost one collection pass and format in parallel instead of three runs.
+ *
+ * Output goes through stdio (FILE*), not iostreams, so the CLI carries no
+ * stream static initialization into every short single-shot process.
+ */
+
+namespace WinHKMon {
+
+constexpr size_t SINK_QUEUE_FRAMES = 64;   ///< Frames a sink can fall behind by
+constexpr size_t SINK_WRITER_THREADS = 2;  ///< Writer threads shared by all sinks
+
+class Sink;
+
+/**
+ * @brief Parse a sink option value: format[+policy]:target
+ *
+ * Formats: text, json, ndjson, csv, sqlite. Policies: block (default) or drop.
+ * Targets: stdout, stderr or a file path (appended to); sqlite takes a
+ * database file only.
+ * Example: "ndjson+drop:C:\logs\whk.ndjson"
+ *
+ * @throws std::invalid_argument if malformed
+ */
+SinkSpec parseSinkSpec(const std::string& value);
+
+/**
+ * @brief Sinks in effect: the --sink list, or --format on stdout without one
+ */
+std::vector<SinkSpec> effectiveSinks(const CliOptions& options);
+
+/**
+ * @brief Human-readable form of a spec ("csv:C:\x.csv") for messages
+ */
+std::string describeSink(const SinkSpec& spec);
+
+/**
+ * @brief Format and write one sample on the calling thread
+ *
+ * For single-shot runs: no queue and no writer thread, one fwrite per
+ * target. CSV files get a header unless they already have content.
+ *
+ * @return false if the target cannot be opened or the write failed
+ */
+bool writeSample(const SinkSpec& spec, const CliOptions& options, const SystemMetrics& metrics);
+
+/**
+ * @brief Bounded set of writer threads shared by the sinks of a run
+ *
+ * A sink with queued frames (or a due SQLite commit) is handed to one idle
+ * thread at a time, so its frames stay in order while different sinks
+ * format in parallel. Threads start as sinks attach, up to the limit.
+ * Destroy every sink before its pool.
+ */
+class SinkWriterPool {
+public:
+    /**
+     * @param threads Most writer threads to run (at least one)
+     * @param onWriterStart Called on each writer thread before its first write
+     *                      (low-impact mode lowers its I/O priority there)
+     */
+    explicit SinkWriterPool(size_t threads = SINK_WRITER_THREADS,
+                            std::function<void()> onWriterStart = nullptr);
+
+    /**
+     * @brief Stop and join the writer threads
+     */
+    ~SinkWriterPool();
+
+    SinkWriterPool(const SinkWriterPool&) = delete;
+    SinkWriterPool& operator=(const SinkWriterPool&) = delete;
+
+    size_t threadCount() const;   ///< Writer threads started so far
+
+private:
+    friend class Sink;
+    using Clock = std::chrono::steady_clock;
+
+    void attach(Sink* sink);
+    void detach(Sink* sink);      ///< Waits until no thread is writing for the sink
+    void schedule(Sink* sink);    ///< The sink has work now
+    void run(size_t index);
+
+    size_t maxThreads_;
+    std::function<void()> onWriterStart_;
+    mutable std::mutex mutex_;
+    std::condition_variable changed_;
+    std::vector<Sink*> sinks_;
+    size_t cursor_;               ///< Round-robin start, so no sink starves the others
+    bool stopping_;
+    std::vector<std::thread> threads_;
+};
+
+/**
+ * @brief One output destination with its own queue, written by a pool thread
+ *
+ * Frames are shared and immutable, so every sink formats the same sample
+ * without copying it. When the queue is full, a DROP_OLDEST sink discards
+ * its oldest queued frame and counts it; a BLOCK sink makes submit() wait
+ * (the sampling loop slows down to the sink's pace). The event loop must
+ * not wait, so it checks mustWait() and defers its next frame instead.
+ */
+class Sink {
+public:
+    /**
+     * @brief Open the target and attach to the writer pool
+     *
+     * CSV sinks write a header with their first frame unless they append to
+     * a non-empty file (or forceHeader is set, e.g. after the columns changed).
+     *
+     * @param spec Format, target and policy
+     * @param options Sections, units and line mode used by the formatters
+     * @param writers Pool whose threads write this sink (outlives the sink)
+     * @param forceHeader Write a CSV header even when appending
+     * @throws std::runtime_error if a file target or database cannot be opened
+     */
+    Sink(const SinkSpec& spec, const CliOptions& options, SinkWriterPool& writers,
+         bool forceHeader = false);
+
+    /**
+     * @brief Write the frames still queued, then detach from the pool
+     */
+    ~Sink();
+
+    Sink(const Sink&) = delete;
+    Sink& operator=(const Sink&) = delete;
+
+    /**
+     * @brief Queue a frame for formatting and writing
+     *
+     * @param canWait false on the event loop thread: a full BLOCK queue then
+     *                drops its oldest frame instead of stalling every timer
+     *                (callers check mustWait() first, so this is a last resort)
+     */
+    void submit(MetricsFrame frame, bool canWait = true);
+
+    /**
+     * @brief Whether submit() would have to wait: a BLOCK sink with a full queue
+     *
+     * Only writer threads take frames off the queue, so once this is false
+     * the submitting thread can queue one frame without waiting or dropping.
+     */
+    bool mustWait() const;
+
+    /**
+     * @brief Block until every queued frame has been written
+     */
+    void flush();
+
+    const SinkSpec& spec() const { return spec_; }
+
+    uint64_t droppedFrames() const;   ///< Frames discarded because the queue was full
+    bool writeFailed() const;         ///< A write to the target has failed
+
+private:
+    friend class SinkWriterPool;
+
+    /**
+     * @brief Write queued frames and commit a due transaction (pool thread)
+     *
+     * Writes at most SINK_QUEUE_FRAMES frames so other sinks get a turn.
+     *
+     * @return When to run again: now if frames remain, the commit time of
+     *         pending rows, or time_point::max() when idle
+     */
+    SinkWriterPool::Clock::time_point service();
+    bool write(const SystemMetrics& metrics);   ///< false if the write failed
+
+    SinkWriterPool& writers_;
+
+    SinkSpec spec_;
+    CliOptions options_;
+    std::FILE* out_;
+    std::unique_ptr<SqliteStore> store_;   ///< Database of a sqlite sink (out_ unused)
+    bool ownsFile_;          ///< out_ is a file target, closed with the sink
+    bool headerPending_;
+    uint64_t written_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<MetricsFrame> queue_;
+    bool busy_;              ///< Writer is formatting a frame taken off the queue
+    bool stopping_;
+    uint64_t dropped_;
+    bool failed_;
+
+    // Guarded by the pool's mutex
+    SinkWriterPool::Clock::time_point due_;   ///< When a pool thread should run service()
+    bool running_;                            ///< A pool thread is in service()
+};
+
+}  // namespace WinHKMon
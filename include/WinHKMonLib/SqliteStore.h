@@ -0,0 +1,125 @@
+#pragma once
+
+#include "Types.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @file SqliteStore.h
+ * @brief SQLite database target for --sink sqlite:<path>
+ *
+ * Samples go into normalized tables so history can be queried with SQL:
+ *
+ *   samples    (id, time_ms, interval_s)
+ *   devices    (id, kind, name)              -- 'disk' / 'interface' dimension
+ *   cpu        (sample_id, usage_percent, avg_freq_mhz, user_percent, system_percent)
+ *   cpu_core   (sample_id, core_id, usage_percent, freq_mhz)
+ *   memory     (sample_id, total_bytes, available_bytes, usage_percent,
+ *               page_file_used_bytes, page_file_percent)
+ *   disk       (sample_id, device_id, total_bytes, used_bytes, free_bytes,
+ *               read_bytes_per_sec, write_bytes_per_sec, busy_percent)
+ *   interface  (sample_id, device_id, in_bytes_per_sec, out_bytes_per_sec,
+ *               total_in_octets, total_out_octets)
+ *
+ * The database runs in WAL mode. Statements are prepared once and reused
+ * for every sample, per-core rows go in multi-row INSERTs, and samples are
+ * grouped into one transaction until a batch size or age is reached, so a
+ * sample costs a few statement steps instead of a commit (an fsync) each.
+ *
+ * Requires a build with SQLite (find_package(SQLite3)); otherwise opening
+ * a store throws.
+ */
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace WinHKMon {
+
+constexpr size_t SQLITE_CORE_ROWS_PER_INSERT = 64;   ///< Rows per multi-row cpu_core INSERT
+
+/**
+ * @brief True when the build includes SQLite
+ */
+bool sqliteAvailable();
+
+/**
+ * @brief One database file and its prepared statements
+ *
+ * @note Not thread-safe; used by one sink writer thread at a time
+ */
+class SqliteStore {
+public:
+    /**
+     * @brief Open or create the database and its tables
+     *
+     * @param path Database file
+     * @param batchSamples Samples per transaction
+     * @param commitSeconds Commit an open transaction once it is this old
+     * @throws std::runtime_error if the database cannot be opened or set up,
+     *         or the build has no SQLite
+     */
+    SqliteStore(const std::string& path, size_t batchSamples, double commitSeconds);
+
+    /**
+     * @brief Commit pending samples and close the database
+     */
+    ~SqliteStore();
+
+    SqliteStore(const SqliteStore&) = delete;
+    SqliteStore& operator=(const SqliteStore&) = delete;
+
+    /**
+     * @brief Insert one sample, committing when the batch is full or old enough
+     *
+     * @param timeMs Sample wall-clock time (Unix epoch milliseconds)
+     * @return false if a statement failed (the sample may be partially written)
+     */
+    bool append(const SystemMetrics& metrics, uint64_t timeMs);
+
+    /**
+     * @brief Commit the open transaction, if any
+     *
+     * @return false if the commit failed
+     */
+    bool commit();
+
+    size_t pendingSamples() const { return pending_; }   ///< Samples not yet committed
+
+    /**
+     * @brief When the open transaction reaches its commit age
+     */
+    std::chrono::steady_clock::time_point commitDue() const { return transactionStart_ + commitAge_; }
+
+private:
+    enum Statement {
+        BEGIN,
+        COMMIT,
+        INSERT_SAMPLE,
+        INSERT_CPU,
+        INSERT_CORE,          ///< One row
+        INSERT_CORES,         ///< SQLITE_CORE_ROWS_PER_INSERT rows
+        INSERT_MEMORY,
+        INSERT_DISK,
+        INSERT_INTERFACE,
+        INSERT_DEVICE,
+        SELECT_DEVICE,
+        STATEMENT_COUNT
+    };
+
+    bool run(sqlite3_stmt* statement);             ///< Step to completion and reset
+    int64_t deviceId(const char* kind, const std::string& name);   ///< -1 on failure
+    bool insertCores(int64_t sampleId, const CpuStats& cpu);
+
+    sqlite3* db_;
+    sqlite3_stmt* statements_[STATEMENT_COUNT];
+    size_t batchSamples_;
+    std::chrono::steady_clock::duration commitAge_;
+    std::chrono::steady_clock::time_point transactionStart_;
+    size_t pending_;                               ///< Samples in the open transaction
+    std::unordered_map<std::string, int64_t> devices_;   ///< "kind/name" -> devices.id
+};
+
+}  // namespace WinHKMon
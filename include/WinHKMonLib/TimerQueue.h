@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <utility>
+
+/**
+ * @file TimerQueue.h
+ * @brief One-shot timers ordered by monotonic deadline (event loop core)
+ */
+
+namespace WinHKMon {
+
+/**
+ * @brief Deadline-ordered one-shot timers
+ *
+ * The owner sleeps until nextDue() and then calls runDue(). Periodic work
+ * re-arms itself from its callback with an absolute deadline, so periods
+ * do not accumulate callback run time.
+ *
+ * @note Not thread-safe; owned by the event loop thread
+ */
+class TimerQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+    /**
+     * @brief Add a timer
+     *
+     * @param due Deadline on the monotonic clock
+     * @param callback Called once from runDue() at or after the deadline
+     * @return Timer ID (never 0)
+     */
+    uint64_t add(Clock::time_point due, Callback callback);
+
+    /**
+     * @brief Cancel a pending timer
+     *
+     * @return false if the timer already ran or was cancelled
+     */
+    bool cancel(uint64_t id);
+
+    /**
+     * @brief Earliest pending deadline, or nullopt if no timer is pending
+     */
+    std::optional<Clock::time_point> nextDue() const;
+
+    /**
+     * @brief Run every timer due at now, earliest first
+     *
+     * Callbacks may add or cancel timers. Timers added by a callback run in
+     * a later call even if already due, so a timer re-arming itself for
+     * "now" cannot starve the caller.
+     *
+     * @param now Current monotonic time
+     * @return Callbacks run
+     */
+    size_t runDue(Clock::time_point now);
+
+    size_t size() const { return timers_.size(); }   ///< Pending timers
+
+private:
+    using Key = std::pair<Clock::time_point, uint64_t>;   ///< Deadline, then ID (FIFO for equal deadlines)
+
+    std::map<Key, Callback> timers_;
+    std::map<uint64_t, Clock::time_point> deadlines_;     ///< ID -> deadline, for cancel()
+    uint64_t nextId_ = 1;
+};
+
+}  // namespace WinHKMon
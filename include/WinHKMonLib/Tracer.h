@@ -0,0 +1,188 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @file Tracer.h
+ * @brief Self-instrumentation spans exported as a Chrome trace
+ *
+ * Records timed spans (collector calls, PDH waits, formatting, output writes)
+ * into per-thread buffers and writes them in the Chrome trace-event JSON
+ * format, which chrome://tracing and Perfetto (ui.perfetto.dev) can open.
+ */
+
+namespace WinHKMon {
+
+/**
+ * @brief One completed span
+ *
+ * @note name and category must point to string literals (not copied)
+ */
+struct TraceEvent {
+    const char* name;      ///< Span name (e.g., "cpu")
+    const char* category;  ///< Span category (e.g., "collect")
+    uint64_t startNs;      ///< Start time relative to tracer start (nanoseconds)
+    uint64_t durationNs;   ///< Span duration (nanoseconds)
+};
+
+/**
+ * @brief Process-wide span recorder
+ *
+ * Each thread appends to its own fixed-capacity buffer, so recording a span
+ * takes no lock: one relaxed load to check enabled state, two clock reads
+ * and a store. Buffers are registered once per thread under a mutex.
+ * Spans beyond the buffer capacity are dropped and counted. A thread's
+ * span storage is only allocated when it records its first span, so
+ * threads that run while tracing is off never pay for it.
+ *
+ * @note When disabled, WINHKMON_TRACE_SPAN costs a single relaxed load.
+ *       Defining WINHKMON_DISABLE_TRACING compiles spans out entirely.
+ */
+class Tracer {
+public:
+    static constexpr size_t EVENTS_PER_THREAD = 32768;  ///< Buffer capacity per thread (1 MB)
+
+    /**
+     * @brief Access the process-wide tracer
+     */
+    static Tracer& instance();
+
+    /**
+     * @brief Start recording spans (resets the time origin)
+     */
+    void start();
+
+    /**
+     * @brief Stop recording spans (recorded spans are kept)
+     */
+    void stop();
+
+    /**
+     * @brief Check whether spans are being recorded
+     */
+    bool isEnabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Name the calling thread in the exported trace
+     *
+     * @param name Thread name shown in the timeline (e.g., "main", "writer")
+     */
+    void setThreadName(const std::string& name);
+
+    /**
+     * @brief Append a completed span to the calling thread's buffer
+     *
+     * @param name Span name (string literal)
+     * @param category Span category (string literal)
+     * @param startNs Start time from now()
+     * @param endNs End time from now()
+     */
+    void record(const char* name, const char* category, uint64_t startNs, uint64_t endNs);
+
+    /**
+     * @brief Current time in nanoseconds relative to start()
+     */
+    uint64_t now() const noexcept;
+
+    /**
+     * @brief Render all recorded spans as Chrome trace-event JSON
+     *
+     * @return JSON document with a "traceEvents" array
+     */
+    std::string toChromeTraceJson() const;
+
+    /**
+     * @brief Write Chrome trace-event JSON to a file
+     *
+     * @param path Output file path
+     * @return true if written successfully, false on error
+     */
+    bool writeChromeTrace(const std::string& path) const;
+
+    /**
+     * @brief Number of spans dropped because a thread buffer was full
+     */
+    uint64_t droppedCount() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Discard recorded spans and thread names
+     *
+     * @note Only safe while no other thread is recording
+     */
+    void clear();
+
+private:
+    Tracer();
+
+    /**
+     * @brief Per-thread span storage (single writer, read at export)
+     */
+    struct ThreadBuffer {
+        uint32_t threadId;                        ///< Sequential thread ID in the trace
+        std::string name;                         ///< Thread name (empty = unnamed)
+        std::unique_ptr<TraceEvent[]> events;     ///< Span storage (allocated by the first record())
+        std::atomic<size_t> count{0};             ///< Published span count
+    };
+
+    /**
+     * @brief Get (registering on first use) the calling thread's buffer
+     */
+    ThreadBuffer& localBuffer();
+
+    std::atomic<bool> enabled_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<int64_t> originNs_;                     ///< steady_clock origin
+    mutable std::mutex registryMutex_;                  ///< Guards buffers_ membership
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    std::atomic<uint64_t> generation_;                  ///< Bumped by clear() to invalidate cached buffers
+};
+
+/**
+ * @brief RAII span: records from construction to destruction when tracing is on
+ */
+class TraceSpan {
+public:
+    TraceSpan(const char* name, const char* category) noexcept
+        : name_(name), category_(category), startNs_(0)
+        , active_(Tracer::instance().isEnabled()) {
+        if (active_) {
+            startNs_ = Tracer::instance().now();
+        }
+    }
+
+    ~TraceSpan() {
+        if (active_) {
+            Tracer& tracer = Tracer::instance();
+            tracer.record(name_, category_, startNs_, tracer.now());
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name_;
+    const char* category_;
+    uint64_t startNs_;
+    bool active_;
+};
+
+}  // namespace WinHKMon
+
+#define WINHKMON_TRACE_CONCAT_INNER(a, b) a##b
+#define WINHKMON_TRACE_CONCAT(a, b) WINHKMON_TRACE_CONCAT_INNER(a, b)
+
+#ifdef WINHKMON_DISABLE_TRACING
+#define WINHKMON_TRACE_SPAN(category, name) ((void)0)
+#else
+/**
+ * @brief Record a span covering the rest of the enclosing scope
+ */
+#define WINHKMON_TRACE_SPAN(category, name) \
+    ::WinHKMon::TraceSpan WINHKMON_TRACE_CONCAT(traceSpan_, __LINE__)(name, category)
+#endif
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -39,6 +42,28 @@ struct CpuStats {
     std::optional<double> idlePercent;       ///< Idle time percentage
 };
 
+/**
+ * @brief Huge page pool of one page size (hugetlbfs)
+ */
+struct HugePagePoolStats {
+    uint64_t pageBytes;                      ///< Page size (e.g., 2 MB, 1 GB)
+    uint64_t totalPages;                     ///< Pages in the pool
+    uint64_t freePages;                      ///< Pages not yet faulted in
+    uint64_t reservedPages;                  ///< Free pages promised to mappings
+    uint64_t surplusPages;                   ///< Pages above the pool size (overcommit)
+};
+
+/**
+ * @brief Huge page and transparent huge page usage (Linux)
+ */
+struct HugePageStats {
+    std::vector<HugePagePoolStats> pools;    ///< Default page size first
+    uint64_t anonHugeBytes;                  ///< Anonymous memory backed by THP
+    uint64_t thpFaultsPerSec;                ///< Faults served with a huge page
+    uint64_t thpFallbacksPerSec;             ///< Faults that fell back to small pages
+    uint64_t compactStallsPerSec;            ///< Allocations stalled in direct compaction
+};
+
 /**
  * @brief Physical and virtual memory statistics
  */
@@ -56,6 +81,8 @@ struct MemoryStats {
     // Optional: cached memory breakdown
     std::optional<uint64_t> cachedBytes;     ///< File cache size
     std::optional<uint64_t> committedBytes;  ///< Committed memory
+    
+    std::optional<HugePageStats> hugePages;  ///< Huge pages and THP (Linux /proc only)
 };
 
 /**
@@ -74,7 +101,7 @@ struct DiskStats {
     uint64_t bytesWrittenPerSec;             ///< Current write rate
     double percentBusy;                      ///< Disk active time percentage (0.0 - 100.0)
     
-    // Cumulative counters (since boot or monitor start)
+    // Cumulative counters (since boot, from the raw PDH byte counts)
     uint64_t totalBytesRead;                 ///< Cumulative reads
     uint64_t totalBytesWritten;              ///< Cumulative writes
     
@@ -131,6 +158,169 @@ struct TempStats {
     std::optional<int> avgCpuTempCelsius;    ///< Average CPU temperature
 };
 
+/**
+ * @brief Pressure stall information for one resource (cgroup v2 *.pressure)
+ */
+struct PressureStats {
+    double someAvg10;                        ///< % of time some tasks stalled (10 s average)
+    double fullAvg10;                        ///< % of time all tasks stalled (10 s average)
+    uint64_t someTotalUsec;                  ///< Cumulative "some" stall time
+};
+
+/**
+ * @brief I/O of one cgroup on one block device (cgroup v2 io.stat)
+ */
+struct CgroupIoStats {
+    std::string device;                      ///< Device number ("8:0")
+    uint64_t readBytesPerSec;                ///< rbytes rate
+    uint64_t writeBytesPerSec;               ///< wbytes rate
+    uint64_t readsPerSec;                    ///< rios rate
+    uint64_t writesPerSec;                   ///< wios rate
+};
+
+/**
+ * @brief Resource usage of one cgroup v2 group (Linux containers and services)
+ *
+ * Rates cover the time since the previous sample and are 0 on the first.
+ */
+struct CgroupStats {
+    std::string path;                        ///< Path under the cgroup root ("system.slice/nginx.service")
+    
+    // cpu.stat
+    double cpuPercent;                       ///< usage_usec rate (100 = one CPU busy)
+    double throttledPercent;                 ///< throttled_usec rate (100 = throttled all interval)
+    uint64_t throttledPeriodsPerSec;         ///< nr_throttled rate
+    uint64_t totalThrottledPeriods;          ///< Cumulative nr_throttled
+    
+    // memory.current / memory.events (cumulative counts)
+    uint64_t memoryCurrentBytes;             ///< Memory charged to the group
+    uint64_t memoryHighEvents;               ///< Times over memory.high
+    uint64_t memoryMaxEvents;                ///< Times at memory.max
+    uint64_t oomEvents;                      ///< OOM conditions
+    uint64_t oomKillEvents;                  ///< Processes OOM-killed
+    
+    std::vector<CgroupIoStats> io;           ///< io.stat per device
+    
+    // PSI (absent when the kernel has no PSI support)
+    std::optional<PressureStats> cpuPressure;
+    std::optional<PressureStats> memoryPressure;
+    std::optional<PressureStats> ioPressure;
+};
+
+/**
+ * @brief Power of one RAPL zone (package, core, uncore, dram, psys)
+ */
+struct PowerZoneStats {
+    std::string name;                        ///< Zone name, subzones under their package ("package-0/dram")
+    double watts;                            ///< Average power since the previous sample
+    uint64_t energyMicrojoules;              ///< Raw energy counter (wraps at the zone's range)
+};
+
+/**
+ * @brief Host and per-zone power (POWER metric)
+ */
+struct PowerStats {
+    double hostWatts;                        ///< psys if present, else packages plus DRAM
+    std::vector<PowerZoneStats> zones;       ///< Every readable zone
+};
+
+/**
+ * @brief Memory of one NUMA node (NUMA metric)
+ */
+struct NumaNodeStats {
+    int nodeId;                              ///< Node number
+    uint64_t totalBytes;                     ///< MemTotal
+    uint64_t freeBytes;                      ///< MemFree
+    uint64_t fileBytes;                      ///< FilePages (page cache)
+    uint64_t anonBytes;                      ///< AnonPages
+    uint64_t hitsPerSec;                     ///< numa_hit rate: allocations satisfied here as intended
+    uint64_t missesPerSec;                   ///< numa_miss rate: allocations placed here meant for another node
+    uint64_t foreignPerSec;                  ///< numa_foreign rate: allocations meant for here placed elsewhere
+};
+
+/**
+ * @brief Sockets of one protocol (Linux sockstat/sockstat6)
+ */
+struct SocketProtocolStats {
+    std::string protocol;                    ///< "TCP", "UDP", "TCP6", "RAW", ...
+    uint64_t inUse;                          ///< Sockets in use
+    std::optional<uint64_t> memoryBytes;     ///< Buffer memory (protocols that report it)
+    std::optional<double> memoryPercent;     ///< Of the tcp_mem/udp_mem hard limit
+};
+
+/**
+ * @brief System-wide kernel resources (KRES metric)
+ *
+ * Which fields are set depends on the host: handle/thread/process counts
+ * on Windows, file handles and sockets on Linux.
+ */
+struct KernelResourceStats {
+    std::optional<uint64_t> handleCount;     ///< Open handles, all processes (Windows)
+    std::optional<uint64_t> threadCount;     ///< Threads (Windows)
+    std::optional<uint64_t> processCount;    ///< Processes (Windows)
+
+    std::optional<uint64_t> fileHandlesAllocated;  ///< file-nr allocated (Linux)
+    std::optional<uint64_t> fileHandlesMax;        ///< file-nr maximum (fs.file-max)
+    std::optional<double> fileHandlePercent;       ///< allocated / maximum
+    std::optional<uint64_t> socketsUsed;           ///< sockstat "sockets: used"
+    std::vector<SocketProtocolStats> protocols;    ///< Per protocol, sockstat then sockstat6
+};
+
+/**
+ * @brief Scalar slots one frame can carry: the built-in slots, then module counters
+ *
+ * Bounded by the 64-bit valid masks of the frame, push and pull formats.
+ */
+constexpr uint32_t MAX_FRAME_SLOTS = 64;
+
+/**
+ * @brief Counters a collector module declared when it was loaded
+ */
+struct ModuleSchema {
+    std::string name;                        ///< Module name (e.g., "gpu")
+    std::string description;                 ///< One line from the module
+    std::vector<std::string> counters;       ///< Counter names, in declaration order
+    std::vector<std::string> units;          ///< Unit per counter ("" if none)
+    uint32_t firstSlot = 0;                  ///< Frame slot of counters[0] (set when registered)
+};
+
+/**
+ * @brief Collector module counters of one tick, stored by frame slot
+ *
+ * The slots are assigned once, when the modules load (see SlotLayout), so
+ * a tick only fills values and validMask and allocates nothing.
+ */
+struct ModuleFrame {
+    std::shared_ptr<const std::vector<ModuleSchema>> schemas;  ///< Loaded modules, in slot order
+    std::array<double, MAX_FRAME_SLOTS> values{};  ///< Indexed by frame slot (module slots only)
+    uint64_t validMask = 0;                  ///< Bit N set when values[N] holds data
+};
+
+/**
+ * @brief Cluster-wide statistics for one metric in one aggregation bucket
+ */
+struct ClusterMetricStats {
+    std::string name;                        ///< Slot name (e.g., "cpu_percent")
+    uint32_t hosts;                          ///< Hosts that reported this metric
+    double sum;                              ///< Sum over hosts
+    double min;                              ///< Smallest host value
+    double max;                              ///< Largest host value
+    double mean;                             ///< Average over hosts
+    double p50;                              ///< Median host value (sketch estimate)
+    double p90;                              ///< 90th percentile (sketch estimate)
+    double p99;                              ///< 99th percentile (sketch estimate)
+};
+
+/**
+ * @brief Aggregated view of many agents for one time bucket (aggregate mode)
+ */
+struct ClusterStats {
+    uint64_t bucketStartMs;                  ///< Bucket start (Unix epoch milliseconds)
+    double bucketSeconds;                    ///< Bucket width
+    uint32_t hostCount;                      ///< Hosts with a sample in this bucket
+    std::vector<ClusterMetricStats> metrics; ///< Per-metric statistics (reported metrics only)
+};
+
 /**
  * @brief Central container for all collected metrics at a specific point in time
  */
@@ -140,8 +330,18 @@ struct SystemMetrics {
     std::optional<std::vector<DiskStats>> disks;          ///< Disk I/O metrics (optional)
     std::optional<std::vector<InterfaceStats>> network;   ///< Network metrics (optional)
     std::optional<TempStats> temperature;                 ///< Temperature metrics (optional)
+    std::optional<std::vector<CgroupStats>> cgroups;      ///< cgroup v2 groups (optional)
+    std::optional<PowerStats> power;                      ///< RAPL energy (optional)
+    std::optional<std::vector<NumaNodeStats>> numa;       ///< Per-NUMA-node memory (optional)
+    std::optional<KernelResourceStats> kernelResources;   ///< Handles, files, sockets (optional)
+    std::optional<ModuleFrame> modules;                   ///< Collector module counters (optional)
+    std::optional<ClusterStats> cluster;                  ///< Fleet statistics (aggregate mode only)
     
     uint64_t timestamp;  ///< Monotonic timestamp (QueryPerformanceCounter)
+    std::optional<double> intervalSeconds;  ///< Actual time covered since previous sample (continuous mode)
+    std::optional<uint64_t> nominalTimeMs;  ///< Wall-clock tick the sample belongs to (--align, Unix epoch ms)
+    std::optional<uint64_t> captureTimeMs;  ///< Wall clock when collection started (--align, Unix epoch ms)
+    uint32_t failedFields = 0;  ///< MetricField bits whose collector failed this pass (MetricsEngine)
 };
 
 /**
@@ -164,7 +364,31 @@ struct MonitorState {
 enum class OutputFormat {
     TEXT,  ///< Human-readable multi-line text
     JSON,  ///< Structured JSON
-    CSV    ///< Comma-separated values
+    CSV,   ///< Comma-separated values
+    NDJSON, ///< One compact JSON object per line
+    SQLITE ///< Rows in a SQLite database (sinks only)
+};
+
+/**
+ * @brief What a sink does when its queue is full
+ */
+enum class SinkPolicy {
+    BLOCK,        ///< Wait for the writer (never loses a frame)
+    DROP_OLDEST   ///< Discard the oldest queued frame (never slows sampling)
+};
+
+/**
+ * @brief One output destination (--sink format[+policy]:target)
+ */
+struct SinkSpec {
+    OutputFormat format = OutputFormat::TEXT;  ///< Formatter used
+    std::string target = "stdout";             ///< stdout, stderr or file path (database for SQLITE)
+    SinkPolicy policy = SinkPolicy::BLOCK;     ///< Backpressure policy
+    
+    bool operator==(const SinkSpec& other) const {
+        return format == other.format && target == other.target && policy == other.policy;
+    }
+    bool operator!=(const SinkSpec& other) const { return !(*this == other); }
 };
 
 /**
@@ -175,6 +399,33 @@ enum class NetworkUnit {
     BYTES   ///< Display in bytes/sec (MB/s, GB/s)
 };
 
+/**
+ * @brief Per-core CPU representation in JSON and text output (--cores)
+ *
+ * The compact views are sized for hosts with hundreds of logical
+ * processors, where one JSON object per core dominates every sample.
+ */
+enum class CoreView {
+    FULL,       ///< JSON: one object per core (default); text: no per-core lines
+    PACKED,     ///< Usage (and differing frequencies) as arrays indexed by core ID
+    HISTOGRAM,  ///< Core counts per 10% usage bin, plus min/mean/max
+    TOP,        ///< The busiest cores (CliOptions::topCores), plus min/mean/max
+    NONE        ///< No per-core data
+};
+
+/**
+ * @brief One compiled --fields entry (see FieldProjection.h)
+ */
+struct FieldSelector {
+    uint16_t field = 0;        ///< Index into the field registry
+    std::string instance;      ///< Instance name or "*" (empty for cpu and ram)
+    
+    bool operator==(const FieldSelector& other) const {
+        return field == other.field && instance == other.instance;
+    }
+    bool operator!=(const FieldSelector& other) const { return !(*this == other); }
+};
+
 /**
  * @brief Parsed command-line options
  */
@@ -186,20 +437,68 @@ struct CliOptions {
     bool showDiskIO = false;                 ///< Monitor disk I/O (read/write rates)
     bool showNetwork = false;                ///< Monitor network
     bool showTemp = false;                   ///< Monitor temperature
+    bool showCgroup = false;                 ///< Monitor cgroup v2 groups
+    bool showPower = false;                  ///< Monitor RAPL power
+    bool showNuma = false;                   ///< Monitor per-NUMA-node memory
+    bool showKernelResources = false;        ///< Monitor kernel resources (KRES)
+    std::vector<std::string> modules;        ///< Collector modules to load (--module names or paths)
+    std::string moduleDir;                   ///< Where bare module names are looked up (empty = <exe dir>/modules)
     
     std::string networkInterface;            ///< Specific interface (empty = auto-select)
+    std::string cgroupFilter = "*";          ///< Glob over cgroup paths (--cgroup)
+    std::string cgroupRoot = "/sys/fs/cgroup"; ///< cgroup v2 mount point (--cgroup-root)
     
     // Output options
     OutputFormat format = OutputFormat::TEXT; ///< Output format
+    std::vector<SinkSpec> sinks;             ///< --sink outputs (empty = format on stdout)
+    size_t sqliteBatchSamples = 100;         ///< Samples per SQLite transaction (1 - 100000)
+    double sqliteCommitSeconds = 1.0;        ///< Commit older SQLite transactions (0.1 - 3600)
+    std::vector<FieldSelector> fields;       ///< --fields projection (empty = every field)
+    CoreView coreView = CoreView::FULL;      ///< Per-core representation (--cores)
+    size_t topCores = 8;                     ///< Cores listed by CoreView::TOP (1 - 4096)
     bool singleLine = false;                 ///< Single-line compact output
     
     // Monitoring mode
     bool continuous = false;                 ///< Continuous monitoring mode
-    double intervalSeconds = 1.0;            ///< Update interval (0.1 - 3600)
+    double intervalSeconds = 1.0;            ///< Update interval (0.1 - 3600; from 0.001 with highRate)
+    bool highRate = false;                   ///< Deadline-timer loop for sub-100 ms intervals (--high-rate)
+    bool align = false;                      ///< Tick on wall-clock multiples of the interval
+    
+    // Adaptive sampling (continuous mode only)
+    bool adaptive = false;                   ///< Adjust interval to metric activity
+    double minIntervalSeconds = 0.25;        ///< Adaptive lower bound (0.1 - 3600)
+    double maxIntervalSeconds = 10.0;        ///< Adaptive upper bound (0.1 - 3600)
+    double adaptiveSensitivity = 0.2;        ///< Relative change that counts as activity
     
     // Units
     NetworkUnit networkUnit = NetworkUnit::BITS; ///< Network speed unit
     
+    // Low-impact mode
+    bool lowImpact = false;                  ///< Idle priority, locked working set, background I/O
+    std::vector<unsigned> housekeepingCpus;  ///< CPUs to pin to in low-impact mode (empty = no pinning)
+    
+    // Fleet aggregation
+    bool aggregate = false;                  ///< Run as aggregator ("WinHKMon aggregate")
+    std::string listenEndpoint = "tcp:0.0.0.0:9410"; ///< Aggregator listen address
+    double bucketSeconds = 1.0;              ///< Aggregation bucket width (0.1 - 3600)
+    std::string pushEndpoint;                ///< Push samples to an aggregator (empty = off)
+    std::string hostId;                      ///< Host ID sent with pushed and OTLP samples (empty = computer name)
+    
+    // Remote pull
+    std::string serveEndpoint;               ///< Answer delta snapshot pulls here (empty = off)
+    size_t ringFrames = 600;                 ///< Recent frames kept for deltas (2 - 100000)
+    
+    // OpenTelemetry export
+    std::string otlpUrl;                     ///< OTLP/HTTP collector URL (empty = off)
+    size_t otlpBatchSamples = 10;            ///< Samples per export request (1 - 1000)
+    
+    // Config file
+    std::string configPath;                  ///< Config file in use (empty = none); watched in continuous mode
+    std::string profile;                     ///< Profile applied from it (empty = shared keys only)
+    
+    // Diagnostics
+    std::string traceFile;                   ///< Chrome trace output path (empty = tracing off)
+    
     // Help/version
     bool showHelp = false;                   ///< Display help
     bool showVersion = false;                ///< Display version
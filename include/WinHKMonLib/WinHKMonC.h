@@ -0,0 +1,189 @@
+#pragma once
+
+/**
+ * @file WinHKMonC.h
+ * @brief Stable C ABI over the WinHKMonLib collection engine
+ *
+ * For agents written in other languages (Go, Rust, ...) that want the
+ * collectors without parsing CLI output. Samples are written into a flat,
+ * versioned frame in caller-provided memory: fixed scalar slots followed by
+ * per-core usage, all doubles, so callers can read fields directly from the
+ * struct (or through whk_frame_get_double) without per-field marshalling.
+ *
+ * Compatibility rules:
+ * - Slots are only ever appended; existing slot numbers never change
+ * - Collector module counters follow the built-in slots, at the slot
+ *   whk_engine_load_module() returns for each module
+ * - Readers check magic/version and use header_bytes and slot_count to find
+ *   per-core data, so older readers keep working with newer frames
+ * - The library writes as many slots as the caller's buffer holds, so a
+ *   caller built against an older header (smaller whk_frame) keeps working
+ *   with a newer library; slot_count and core_count report what was written
+ * - No C++ exception crosses this boundary; every call returns a status
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WHK_ABI_VERSION 1u            /**< Bumped on incompatible API changes */
+#define WHK_FRAME_MAGIC 0x464B4857u   /**< "WHKF" little-endian */
+#define WHK_FRAME_VERSION 1u          /**< Bumped when slots are appended */
+
+/* Field selection bits (same values as WinHKMon::MetricField) */
+#define WHK_FIELD_CPU 0x1u
+#define WHK_FIELD_MEMORY 0x2u
+#define WHK_FIELD_DISK 0x4u
+#define WHK_FIELD_NETWORK 0x8u
+#define WHK_FIELD_MODULES 0x10u
+#define WHK_FIELD_ALL 0x1Fu
+
+/**
+ * @brief Scalar slots in whk_frame.values (append-only)
+ */
+typedef enum whk_slot {
+    WHK_SLOT_CPU_TOTAL_PERCENT = 0,       /**< CPU usage, 0-100 */
+    WHK_SLOT_CPU_AVG_FREQ_MHZ = 1,        /**< Average core frequency */
+    WHK_SLOT_MEM_TOTAL_BYTES = 2,         /**< Physical RAM installed */
+    WHK_SLOT_MEM_AVAILABLE_BYTES = 3,     /**< Physical RAM available */
+    WHK_SLOT_MEM_USED_BYTES = 4,          /**< Physical RAM in use */
+    WHK_SLOT_MEM_USAGE_PERCENT = 5,       /**< RAM usage, 0-100 */
+    WHK_SLOT_PAGEFILE_TOTAL_BYTES = 6,    /**< Page file size */
+    WHK_SLOT_PAGEFILE_USED_BYTES = 7,     /**< Page file in use */
+    WHK_SLOT_PAGEFILE_PERCENT = 8,        /**< Page file usage, 0-100 */
+    WHK_SLOT_DISK_READ_BYTES_PER_SEC = 9,   /**< _Total disk read rate */
+    WHK_SLOT_DISK_WRITE_BYTES_PER_SEC = 10, /**< _Total disk write rate */
+    WHK_SLOT_DISK_BUSY_PERCENT = 11,        /**< _Total disk busy, 0-100 */
+    WHK_SLOT_NET_IN_BYTES_PER_SEC = 12,     /**< Receive rate, all interfaces */
+    WHK_SLOT_NET_OUT_BYTES_PER_SEC = 13,    /**< Send rate, all interfaces */
+    WHK_SLOT_COUNT = 14
+} whk_slot;
+
+/**
+ * @brief Call status (0 = success, negative = error)
+ */
+typedef enum whk_status {
+    WHK_OK = 0,
+    WHK_ERR_INVALID_ARGUMENT = -1,  /**< Null pointer or empty field mask */
+    WHK_ERR_BUFFER_TOO_SMALL = -2,  /**< Frame buffer smaller than WHK_FRAME_MIN_BYTES */
+    WHK_ERR_NO_DATA = -3,           /**< No sample taken yet */
+    WHK_ERR_INTERNAL = -4,          /**< Unexpected failure inside the library */
+    WHK_ERR_MODULE = -5             /**< Module failed to load or exports a name already taken */
+} whk_status;
+
+/**
+ * @brief Flat sample frame (version 1 layout, 8-byte aligned)
+ *
+ * Followed in memory by core_count doubles of per-core usage percent,
+ * starting at (const double*)((const char*)frame + header_bytes) + slot_count.
+ */
+typedef struct whk_frame {
+    uint32_t magic;          /**< WHK_FRAME_MAGIC */
+    uint16_t version;        /**< WHK_FRAME_VERSION of the writer */
+    uint16_t header_bytes;   /**< Offset of values[] from the frame start */
+    uint32_t slot_count;     /**< Entries in values[] */
+    uint32_t core_count;     /**< Per-core entries written after values[] */
+    uint32_t core_total;     /**< Logical CPUs reported (> core_count if buffer was short) */
+    uint32_t field_mask;     /**< WHK_FIELD_* bits collected */
+    uint64_t valid_mask;     /**< Bit N set when values[N] holds data */
+    uint64_t sequence;       /**< Sample number on this engine (starts at 1) */
+    uint64_t timestamp_ns;   /**< Monotonic collection time (QueryPerformanceCounter) */
+    double values[WHK_SLOT_COUNT];  /**< Scalar slots (NaN when not valid) */
+} whk_frame;
+
+/** Bytes needed for a frame with room for n per-core values */
+#define WHK_FRAME_BYTES(n) (sizeof(whk_frame) + (size_t)(n) * sizeof(double))
+
+/** Smallest accepted buffer: the fixed header, without any slots */
+#define WHK_FRAME_MIN_BYTES offsetof(whk_frame, values)
+
+/** Opaque engine handle */
+typedef struct whk_engine whk_engine;
+
+/**
+ * @brief ABI version of the loaded library (compare with WHK_ABI_VERSION)
+ */
+uint32_t whk_abi_version(void);
+
+/**
+ * @brief Human-readable status name (static string)
+ */
+const char* whk_status_string(whk_status status);
+
+/**
+ * @brief Create a collection engine
+ *
+ * @param out Receives the handle (set to NULL on failure)
+ */
+whk_status whk_engine_create(whk_engine** out);
+
+/**
+ * @brief Destroy an engine (NULL is ignored)
+ */
+void whk_engine_destroy(whk_engine* engine);
+
+/**
+ * @brief Load a collector module (WinHKMonModule.h) into an engine
+ *
+ * Its counters are collected with WHK_FIELD_MODULES, in the slots after
+ * the built-in ones: counter i of the module is slot *first_slot + i.
+ * Size frames for the extra slots: WHK_FRAME_BYTES(module counters + cores).
+ *
+ * @param engine Engine handle
+ * @param path Shared library path
+ * @param first_slot Receives the slot of the module's first counter (may be NULL)
+ * @return WHK_ERR_MODULE if the module cannot be loaded, or one of its
+ *         "<module>_<counter>" names is a built-in slot or belongs to a
+ *         module loaded before
+ */
+whk_status whk_engine_load_module(whk_engine* engine, const char* path, uint32_t* first_slot);
+
+/**
+ * @brief Collect the requested fields into a caller-provided frame
+ *
+ * The buffer can be reused for every call; nothing is allocated per call
+ * beyond the collection itself. Slots are written up to the buffer size
+ * (slot_count tells how many), then per-core values; those that do not fit
+ * are dropped (core_count < core_total).
+ *
+ * @param engine Engine handle
+ * @param field_mask WHK_FIELD_* bits
+ * @param frame Frame buffer (8-byte aligned)
+ * @param frame_bytes Buffer size, at least WHK_FRAME_MIN_BYTES; normally
+ *        WHK_FRAME_BYTES(n) from the header the caller was built with
+ * @note Rates are zero the first time a field is collected (no baseline yet)
+ */
+whk_status whk_engine_sample(whk_engine* engine, uint32_t field_mask,
+                             whk_frame* frame, size_t frame_bytes);
+
+/**
+ * @brief Write the most recent sample again, without collecting
+ *
+ * Lets several readers share one sample. Same buffer rules as
+ * whk_engine_sample().
+ */
+whk_status whk_engine_last_frame(whk_engine* engine, whk_frame* frame, size_t frame_bytes);
+
+/**
+ * @brief Read a scalar slot
+ *
+ * @return Slot value, or NaN if the slot is unknown to this frame or not valid
+ */
+double whk_frame_get_double(const whk_frame* frame, uint32_t slot);
+
+/**
+ * @brief Check whether a slot holds data (1) or not (0)
+ */
+int whk_frame_has(const whk_frame* frame, uint32_t slot);
+
+/**
+ * @brief Per-core usage values (core_count entries)
+ */
+const double* whk_frame_cores(const whk_frame* frame);
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
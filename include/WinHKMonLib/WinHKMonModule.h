@@ -0,0 +1,87 @@
+#pragma once
+
+/**
+ * @file WinHKMonModule.h
+ * @brief Stable C ABI for collector modules loaded at run time
+ *
+ * A collector module is a shared library (whk_<name>.dll / whk_<name>.so)
+ * that WinHKMon loads with LoadLibrary/dlopen only when its metric is
+ * requested (--module <name>), so a run pays for a module's dependencies
+ * only if it asks for that metric, and site-specific collectors ship
+ * without rebuilding WinHKMon.
+ *
+ * The module exports one function, WHK_MODULE_ENTRY, returning a static
+ * descriptor. The descriptor declares the module's counters; WinHKMon
+ * registers them as --fields paths (module.<name>.<counter>) and output
+ * columns, and on every tick passes an array with one double per counter
+ * that sample() fills in place.
+ *
+ * Compatibility rules:
+ * - abi_version is checked on load; a module built for another version is rejected
+ * - Counters are declared once; their number and order are fixed per load
+ * - No C++ exception may leave a module function; errors are status codes
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WHK_MODULE_ABI_VERSION 1u                  /**< Bumped on incompatible changes */
+#define WHK_MODULE_ENTRY "whk_module_entry"        /**< Exported entry point name */
+
+#ifdef _WIN32
+#define WHK_MODULE_EXPORT __declspec(dllexport)
+#else
+#define WHK_MODULE_EXPORT __attribute__((visibility("default")))
+#endif
+
+/**
+ * @brief One counter a module reports
+ */
+typedef struct whk_module_counter {
+    const char* name;    /**< Field name, [a-z0-9_] (e.g., "queue_depth") */
+    const char* unit;    /**< Display unit (e.g., "bytes", "percent", "/s"); may be "" */
+} whk_module_counter;
+
+/**
+ * @brief Module descriptor (static storage in the module)
+ */
+typedef struct whk_module {
+    uint32_t abi_version;                  /**< WHK_MODULE_ABI_VERSION of the module */
+    const char* name;                      /**< Metric and field group name, [a-z0-9_] */
+    const char* description;               /**< One line for messages */
+    uint32_t counter_count;                /**< Entries in counters[] (1-50; loaded modules share 50 slots) */
+    const whk_module_counter* counters;    /**< Declared counters */
+
+    /**
+     * @brief Start collecting
+     * @param state Receives the module's per-load state (may stay NULL)
+     * @return 0 on success; anything else makes the metric unavailable
+     */
+    int (*open)(void** state);
+
+    /**
+     * @brief Take one sample
+     * @param state Value set by open()
+     * @param values counter_count doubles to fill, in declaration order
+     * @param valid_mask Bit N set when values[N] holds data (preset to 0)
+     * @return 0 on success
+     */
+    int (*sample)(void* state, double* values, uint64_t* valid_mask);
+
+    /**
+     * @brief Stop collecting and free the state
+     */
+    void (*close)(void* state);
+} whk_module;
+
+/**
+ * @brief Signature of the exported WHK_MODULE_ENTRY function
+ */
+typedef const whk_module* (*whk_module_entry_fn)(void);
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
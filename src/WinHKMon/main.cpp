@@ -1,31 +1,201 @@
 #include "WinHKMonLib/CliParser.h"
-#include "WinHKMonLib/OutputFormatter.h"
 #include "WinHKMonLib/StateManager.h"
 #include "WinHKMonLib/MemoryMonitor.h"
 #include "WinHKMonLib/CpuMonitor.h"
 #include "WinHKMonLib/NetworkMonitor.h"
 #include "WinHKMonLib/DiskMonitor.h"
+#include "WinHKMonLib/CgroupMonitor.h"
+#include "WinHKMonLib/PowerMonitor.h"
+#include "WinHKMonLib/KernelResourceMonitor.h"
+#include "WinHKMonLib/NumaMonitor.h"
+#include "WinHKMonLib/CollectorModule.h"
 #include "WinHKMonLib/DeltaCalculator.h"
-#include <iostream>
+#include "WinHKMonLib/AdaptiveSampler.h"
+#include "WinHKMonLib/Tracer.h"
+#include "WinHKMonLib/LowImpact.h"
+#include "WinHKMonLib/RemoteTransport.h"
+#include "WinHKMonLib/FleetAggregator.h"
+#include "WinHKMonLib/FrameSlots.h"
+#include "WinHKMonLib/DeltaProtocol.h"
+#include "WinHKMonLib/AlignedSchedule.h"
+#include "WinHKMonLib/EventLoop.h"
+#include "WinHKMonLib/ConfigProfile.h"
+#include "WinHKMonLib/ConfigWatcher.h"
+#include "WinHKMonLib/Sink.h"
+#include "WinHKMonLib/HighRateTimer.h"
+#include "WinHKMonLib/OtlpExporter.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
 #include <windows.h>
 #include <thread>
 #include <chrono>
 #include <csignal>
+#include <optional>
+#include <utility>
 
 using namespace WinHKMon;
 
 // Global flag for Ctrl+C handling
 volatile bool g_continueMonitoring = true;
 
+// Event loop to stop on Ctrl+C (continuous and aggregate modes)
+std::atomic<EventLoop*> g_eventLoop{nullptr};
+
+// Working set headroom locked above the post-first-sample size (--low-impact)
+constexpr size_t LOW_IMPACT_HEADROOM_BYTES = 2 * 1024 * 1024;
+
+// How soon the event loop looks again when a full BLOCK sink defers a frame
+constexpr auto SINK_RETRY_DELAY = std::chrono::milliseconds(10);
+
+/**
+ * @brief Write one line to stderr
+ * 
+ * Output uses stdio throughout: without <iostream> the binary has no stream
+ * static initialization, which short single-shot runs would pay every time.
+ */
+void printError(const std::string& line) {
+    std::fputs(line.c_str(), stderr);
+    std::fputc('\n', stderr);
+}
+
+/**
+ * @brief Print warnings for low-impact settings that did not take effect
+ */
+void reportLowImpactWarnings(const LowImpactStatus& status) {
+    for (const std::string& warning : status.warnings) {
+        printError("[WARNING] --low-impact: " + warning);
+    }
+}
+
+/**
+ * @brief Current wall clock in Unix epoch milliseconds (push protocol timestamps)
+ */
+uint64_t unixTimeMs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Current monotonic clock in milliseconds (aligned tick deadlines)
+ */
+int64_t steadyNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Host ID for pushed and OTLP-exported samples (--host-id, else the computer name)
+ */
+std::string resolveHostId(const CliOptions& options) {
+    if (!options.hostId.empty()) {
+        return options.hostId;
+    }
+    char name[MAX_COMPUTERNAME_LENGTH + 1] = {};
+    DWORD size = sizeof(name);
+    if (GetComputerNameA(name, &size)) {
+        return std::string(name, size);
+    }
+    return "unknown";
+}
+
 /**
  * @brief Signal handler for Ctrl+C (SIGINT)
  * 
- * Sets global flag to stop continuous monitoring loop.
+ * Sets global flag and stops the event loop of continuous/aggregate mode.
  */
 void signalHandler(int signal) {
     if (signal == SIGINT) {
         g_continueMonitoring = false;
-        std::cerr << "\nStopping... ";
+        if (EventLoop* loop = g_eventLoop.load()) {
+            loop->stop();
+        }
+        std::fputs("\nStopping... ", stderr);
+    }
+}
+
+/**
+ * @brief Hook run on each sink writer thread before its first write
+ */
+std::function<void()> sinkWriterStart(const CliOptions& options) {
+    // Writes leave the sampling thread, so background I/O must follow them
+    if (options.lowImpact) {
+        return [] { enterBackgroundIo(); };
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Open the sinks of the options (--sink, or --format on stdout)
+ * 
+ * @param options CLI options
+ * @param writers Shared writer threads (destroyed after the sinks)
+ * @param forceHeader Start CSV files with a header even when appending
+ * @return Open sinks, in command-line order
+ * @throws std::runtime_error if a file target cannot be opened
+ */
+std::vector<std::unique_ptr<Sink>> openSinks(const CliOptions& options, SinkWriterPool& writers,
+                                             bool forceHeader = false) {
+    std::vector<std::unique_ptr<Sink>> sinks;
+    for (const SinkSpec& spec : effectiveSinks(options)) {
+        sinks.push_back(std::make_unique<Sink>(spec, options, writers, forceHeader));
+    }
+    return sinks;
+}
+
+/**
+ * @brief Hand one frame to every sink
+ * 
+ * @param canWait false on the event loop: full BLOCK sinks drop instead of stalling it
+ *        (loop callers defer while sinksMustWait() instead of reaching that)
+ * @return The shared frame, for other consumers of the same sample
+ */
+MetricsFrame submitToSinks(const std::vector<std::unique_ptr<Sink>>& sinks, const SystemMetrics& metrics,
+                           bool canWait = true) {
+    MetricsFrame frame = std::make_shared<const SystemMetrics>(metrics);
+    for (const auto& sink : sinks) {
+        sink->submit(frame, canWait);
+    }
+    return frame;
+}
+
+/**
+ * @brief Whether a BLOCK sink is full, so the event loop must defer its next frame
+ */
+bool sinksMustWait(const std::vector<std::unique_ptr<Sink>>& sinks) {
+    return std::any_of(sinks.begin(), sinks.end(), [](const std::unique_ptr<Sink>& sink) {
+        return sink->mustWait();
+    });
+}
+
+/**
+ * @brief Warn about sinks that dropped frames or failed to write
+ */
+void reportSinkProblems(const std::vector<std::unique_ptr<Sink>>& sinks) {
+    for (const auto& sink : sinks) {
+        sink->flush();
+        if (sink->droppedFrames() > 0) {
+            printError("[WARNING] Sink " + describeSink(sink->spec()) + " dropped " +
+                       std::to_string(sink->droppedFrames()) + " frames (queue full).");
+        }
+        if (sink->writeFailed()) {
+            printError("[WARNING] Writing to sink " + describeSink(sink->spec()) + " failed.");
+        }
+    }
+}
+
+/**
+ * @brief Stop the OTLP exporter and warn about samples that never reached the collector
+ */
+void stopOtlpExporter(OtlpExporter& exporter, const std::string& url) {
+    exporter.stop();
+    if (exporter.droppedSamples() > 0) {
+        printError("[WARNING] OTLP export to " + url + " dropped " + std::to_string(exporter.droppedSamples()) +
+                   " samples (" + std::to_string(exporter.failedExports()) + " failed requests).");
     }
 }
 
@@ -34,9 +204,14 @@ void signalHandler(int signal) {
  * 
  * @param options Parsed CLI options
  * @param cpuMonitor CPU monitor instance (if initialized)
- * @param memoryMonitor Memory monitor instance
+ * @param memoryMonitor Memory monitor instance (if initialized)
  * @param networkMonitor Network monitor instance (if initialized)
  * @param diskMonitor Disk monitor instance (if initialized)
+ * @param cgroupMonitor cgroup monitor instance (if initialized)
+ * @param powerMonitor RAPL power monitor instance (if initialized)
+ * @param numaMonitor NUMA node monitor instance (if initialized)
+ * @param kernelResourceMonitor Kernel resource monitor instance (if initialized)
+ * @param modules Loaded collector modules (--module)
  * @param deltaCalc Delta calculator for timestamps and rates
  * @param previousMetrics Previous sample metrics for delta calculations
  * @param previousTimestamp Previous sample timestamp
@@ -44,12 +219,18 @@ void signalHandler(int signal) {
  */
 SystemMetrics collectMetrics(const CliOptions& options, 
                              CpuMonitor* cpuMonitor, 
-                             MemoryMonitor& memoryMonitor,
+                             MemoryMonitor* memoryMonitor,
                              NetworkMonitor* networkMonitor,
                              DiskMonitor* diskMonitor,
+                             CgroupMonitor* cgroupMonitor,
+                             PowerMonitor* powerMonitor,
+                             NumaMonitor* numaMonitor,
+                             KernelResourceMonitor* kernelResourceMonitor,
+                             ModuleSet& modules,
                              DeltaCalculator& deltaCalc,
                              const SystemMetrics& previousMetrics,
                              uint64_t previousTimestamp) {
+    WINHKMON_TRACE_SPAN("collect", "collectMetrics");
     SystemMetrics metrics;
     
     // Get timestamp
@@ -62,50 +243,35 @@ SystemMetrics collectMetrics(const CliOptions& options,
     
     // Collect CPU stats
     if (options.showCpu && cpuMonitor != nullptr) {
+        WINHKMON_TRACE_SPAN("collect", "cpu");
         try {
             metrics.cpu = cpuMonitor->getCurrentStats();
         } catch (const std::exception& e) {
-            std::cerr << "[WARNING] CPU monitoring failed: " << e.what() << std::endl;
+            printError(std::string("[WARNING] CPU monitoring failed: ") + e.what());
         }
     }
     
     // Collect memory stats
-    if (options.showMemory) {
+    if (options.showMemory && memoryMonitor != nullptr) {
+        WINHKMON_TRACE_SPAN("collect", "memory");
         try {
-            metrics.memory = memoryMonitor.getCurrentStats();
+            metrics.memory = memoryMonitor->getCurrentStats();
         } catch (const std::exception& e) {
-            std::cerr << "[WARNING] Memory monitoring failed: " << e.what() << std::endl;
+            printError(std::string("[WARNING] Memory monitoring failed: ") + e.what());
         }
     }
     
     // Collect network stats with rate calculations
     if (options.showNetwork && networkMonitor != nullptr) {
+        WINHKMON_TRACE_SPAN("collect", "network");
         try {
+            // Loopback is left out unless --interface names it
+            networkMonitor->setIncludeLoopback(!options.networkInterface.empty());
             std::vector<InterfaceStats> interfaces = networkMonitor->getCurrentStats();
             
             // Calculate rates for each interface
-            if (elapsedSeconds > 0 && previousMetrics.network.has_value()) {
-                for (auto& iface : interfaces) {
-                    // Find previous data for this interface
-                    auto prevIt = std::find_if(
-                        previousMetrics.network->begin(),
-                        previousMetrics.network->end(),
-                        [&iface](const InterfaceStats& prev) {
-                            return prev.name == iface.name;
-                        });
-                    
-                    if (prevIt != previousMetrics.network->end()) {
-                        // Calculate rates using DeltaCalculator
-                        iface.inBytesPerSec = static_cast<uint64_t>(
-                            deltaCalc.calculateRate(iface.totalInOctets, 
-                                                   prevIt->totalInOctets, 
-                                                   elapsedSeconds));
-                        iface.outBytesPerSec = static_cast<uint64_t>(
-                            deltaCalc.calculateRate(iface.totalOutOctets, 
-                                                    prevIt->totalOutOctets, 
-                                                    elapsedSeconds));
-                    }
-                }
+            if (previousMetrics.network.has_value()) {
+                deltaCalc.applyInterfaceRates(interfaces, *previousMetrics.network, elapsedSeconds);
             }
             
             // Filter to specific interface if requested
@@ -117,59 +283,164 @@ SystemMetrics collectMetrics(const CliOptions& options,
                 if (it != interfaces.end()) {
                     metrics.network = std::vector<InterfaceStats>{*it};
                 } else {
-                    std::cerr << "[WARNING] Network interface '" << options.networkInterface 
-                             << "' not found." << std::endl;
+                    printError("[WARNING] Network interface '" + options.networkInterface +
+                               "' not found.");
                 }
             } else {
                 // Auto-select primary interface or include all
                 metrics.network = interfaces;
             }
         } catch (const std::exception& e) {
-            std::cerr << "[WARNING] Network monitoring failed: " << e.what() << std::endl;
+            printError(std::string("[WARNING] Network monitoring failed: ") + e.what());
         }
     }
     
     // Collect disk stats (if either DISK or IO is requested)
-    // NOTE: Disk I/O rates come directly from PDH counters (already calculated)
-    // Unlike network (which provides cumulative counters), PDH provides instantaneous rates
+    // PDH provides the rates and the raw byte counts behind them (totals since boot)
     if ((options.showDiskSpace || options.showDiskIO) && diskMonitor != nullptr) {
+        WINHKMON_TRACE_SPAN("collect", "disk");
         try {
-            std::vector<DiskStats> disks = diskMonitor->getCurrentStats();
-            
-            // PDH already provides bytesReadPerSec and bytesWrittenPerSec
-            // We only need to accumulate totalBytesRead/totalBytesWritten for historical tracking
-            if (elapsedSeconds > 0 && previousMetrics.disks.has_value()) {
-                for (auto& disk : disks) {
-                    // Find previous data for this disk
-                    auto prevIt = std::find_if(
-                        previousMetrics.disks->begin(),
-                        previousMetrics.disks->end(),
-                        [&disk](const DiskStats& prev) {
-                            return prev.deviceName == disk.deviceName;
-                        });
-                    
-                    if (prevIt != previousMetrics.disks->end()) {
-                        // Accumulate cumulative totals (integrate rates over time)
-                        disk.totalBytesRead = prevIt->totalBytesRead + 
-                            static_cast<uint64_t>(disk.bytesReadPerSec * elapsedSeconds);
-                        disk.totalBytesWritten = prevIt->totalBytesWritten + 
-                            static_cast<uint64_t>(disk.bytesWrittenPerSec * elapsedSeconds);
-                    }
-                    // NOTE: bytesReadPerSec and bytesWrittenPerSec are already set by DiskMonitor from PDH
-                }
-            }
-            
-            metrics.disks = disks;
+            metrics.disks = diskMonitor->getCurrentStats();
+        } catch (const std::exception& e) {
+            printError(std::string("[WARNING] Disk monitoring failed: ") + e.what());
+        }
+    }
+    
+    // Collect cgroup stats (the monitor keeps its own counters for rates)
+    if (options.showCgroup && cgroupMonitor != nullptr) {
+        WINHKMON_TRACE_SPAN("collect", "cgroup");
+        try {
+            metrics.cgroups = cgroupMonitor->getCurrentStats();
+        } catch (const std::exception& e) {
+            printError(std::string("[WARNING] cgroup monitoring failed: ") + e.what());
+        }
+    }
+    
+    // Collect power (wrapping energy counters, rates kept by the monitor)
+    if (options.showPower && powerMonitor != nullptr) {
+        WINHKMON_TRACE_SPAN("collect", "power");
+        try {
+            metrics.power = powerMonitor->getCurrentStats();
         } catch (const std::exception& e) {
-            std::cerr << "[WARNING] Disk monitoring failed: " << e.what() << std::endl;
+            printError(std::string("[WARNING] Power monitoring failed: ") + e.what());
         }
     }
     
+    // Collect NUMA node memory (numastat rates kept by the monitor)
+    if (options.showNuma && numaMonitor != nullptr) {
+        WINHKMON_TRACE_SPAN("collect", "numa");
+        try {
+            metrics.numa = numaMonitor->getCurrentStats();
+        } catch (const std::exception& e) {
+            printError(std::string("[WARNING] NUMA monitoring failed: ") + e.what());
+        }
+    }
+    
+    // Collect kernel resource usage (handles, file handles, socket memory)
+    if (options.showKernelResources && kernelResourceMonitor != nullptr) {
+        WINHKMON_TRACE_SPAN("collect", "kres");
+        try {
+            metrics.kernelResources = kernelResourceMonitor->getCurrentStats();
+        } catch (const std::exception& e) {
+            printError(std::string("[WARNING] Kernel resource monitoring failed: ") + e.what());
+        }
+    }
+    
+    // Sample collector modules (each writes straight into its frame slots)
+    if (!modules.empty()) {
+        modules.sample(metrics.modules.emplace(), [](const std::exception& e) {
+            printError(std::string("[WARNING] ") + e.what());
+        });
+    }
+    
     // TODO: Collect temperature stats (T017 - TempMonitor)
     
     return metrics;
 }
 
+/**
+ * @brief Start a monitor of a Linux kernel interface, or warn and return nullptr
+ * 
+ * A host without the interface (any Windows host, unless a root option
+ * points at a mounted copy) still reports every other metric.
+ * 
+ * @param metric Metric name for the warning
+ * @param args Monitor constructor arguments
+ */
+template <typename Monitor, typename... Args>
+Monitor* startOptionalMonitor(const char* metric, Args&&... args) {
+    auto* monitor = new Monitor(std::forward<Args>(args)...);
+    try {
+        monitor->initialize();
+    } catch (const std::exception& e) {
+        printError(std::string("[WARNING] ") + metric + " monitoring unavailable: " + e.what());
+        delete monitor;
+        return nullptr;
+    }
+    return monitor;
+}
+
+/**
+ * @brief Replace a running monitor with a newly started one, or stop it when no longer wanted
+ * 
+ * @param current Running monitor (nullptr if none)
+ * @param started Newly started monitor (empty if none was started)
+ * @param wanted Whether the current monitor should keep running without a replacement
+ */
+template <typename Monitor>
+void adoptMonitor(Monitor*& current, std::unique_ptr<Monitor>& started, bool wanted) {
+    if (started || !wanted) {
+        delete current;
+        current = started.release();
+    }
+}
+
+/**
+ * @brief Start the cgroup monitor; warn if the open-file limit leaves groups untracked
+ */
+CgroupMonitor* startCgroupMonitor(const CliOptions& options) {
+    auto* monitor = startOptionalMonitor<CgroupMonitor>("cgroup", options.cgroupRoot, options.cgroupFilter);
+    if (monitor != nullptr && monitor->untrackedGroups() > 0) {
+        printError("[WARNING] Tracking " + std::to_string(monitor->groupLimit()) + " cgroups; " +
+                   std::to_string(monitor->untrackedGroups()) + " more match --cgroup. Raise the "
+                   "open-file limit (ulimit -n) or narrow --cgroup to see them.");
+    }
+    return monitor;
+}
+
+/**
+ * @brief Directory bare --module names are looked up in: "modules" next to the executable
+ */
+std::string defaultModuleDir() {
+    char path[MAX_PATH];
+    DWORD length = GetModuleFileNameA(nullptr, path, MAX_PATH);
+    std::string exePath(path, length < MAX_PATH ? length : 0);
+    size_t slash = exePath.find_last_of("\\/");
+    return (slash == std::string::npos ? std::string(".") : exePath.substr(0, slash)) + "\\modules";
+}
+
+/**
+ * @brief Load the requested collector modules; ones that fail are skipped with a warning
+ * 
+ * A module exporting a name a built-in slot or an earlier module already
+ * has counts as failed.
+ */
+ModuleSet loadModules(const CliOptions& options) {
+    ModuleSet modules;
+    if (options.modules.empty()) {
+        return modules;
+    }
+    std::string moduleDir = options.moduleDir.empty() ? defaultModuleDir() : options.moduleDir;
+    for (const std::string& name : options.modules) {
+        try {
+            modules.load(resolveModulePath(name, moduleDir));
+        } catch (const std::exception& e) {
+            printError("[WARNING] Module '" + name + "' monitoring unavailable: " + e.what());
+        }
+    }
+    return modules;
+}
+
 /**
  * @brief Single-shot monitoring mode
  * 
@@ -180,13 +451,20 @@ SystemMetrics collectMetrics(const CliOptions& options,
  */
 int singleShotMode(const CliOptions& options) {
     try {
-        // Initialize monitors
-        MemoryMonitor memoryMonitor;
+        // Construct only the monitors of requested metrics
+        MemoryMonitor* memoryMonitor = nullptr;
         CpuMonitor* cpuMonitor = nullptr;
         NetworkMonitor* networkMonitor = nullptr;
         DiskMonitor* diskMonitor = nullptr;
+        CgroupMonitor* cgroupMonitor = nullptr;
+        PowerMonitor* powerMonitor = nullptr;
+        NumaMonitor* numaMonitor = nullptr;
+        KernelResourceMonitor* kernelResourceMonitor = nullptr;
         DeltaCalculator deltaCalc;
-        StateManager stateManager("WinHKMon");
+        
+        if (options.showMemory) {
+            memoryMonitor = new MemoryMonitor();
+        }
         
         if (options.showCpu) {
             cpuMonitor = new CpuMonitor();
@@ -209,39 +487,62 @@ int singleShotMode(const CliOptions& options) {
             std::this_thread::sleep_for(std::chrono::milliseconds(1100));
         }
         
-        // Load previous state for delta calculations
+        if (options.showCgroup) {
+            cgroupMonitor = startCgroupMonitor(options);
+        }
+        
+        if (options.showPower) {
+            powerMonitor = startOptionalMonitor<PowerMonitor>("Power");
+        }
+        
+        if (options.showNuma) {
+            numaMonitor = startOptionalMonitor<NumaMonitor>("NUMA");
+        }
+        
+        if (options.showKernelResources) {
+            kernelResourceMonitor = startOptionalMonitor<KernelResourceMonitor>("Kernel resource");
+        }
+        
+        ModuleSet modules = loadModules(options);
+        
+        // Wait for second sample (cpu.stat, io.stat, energy_uj and numastat are counters)
+        if (cgroupMonitor != nullptr || powerMonitor != nullptr || numaMonitor != nullptr) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        
+        // Load previous state for delta calculations (only network and disk
+        // I/O rates span runs; other runs leave the state file alone)
+        bool usesState = options.showNetwork || options.showDiskIO;
+        StateManager stateManager("WinHKMon");
         SystemMetrics previousMetrics;
         uint64_t previousTimestamp = 0;
-        if (!stateManager.load(previousMetrics, previousTimestamp)) {
+        if (!usesState || !stateManager.load(previousMetrics, previousTimestamp)) {
             // First run or corrupted state - use current timestamp as baseline
             previousTimestamp = deltaCalc.getCurrentTimestamp();
         }
         
         // Collect metrics
         SystemMetrics metrics = collectMetrics(options, cpuMonitor, memoryMonitor, 
-                                               networkMonitor, diskMonitor, deltaCalc,
-                                               previousMetrics, previousTimestamp);
+                                               networkMonitor, diskMonitor, cgroupMonitor,
+                                               powerMonitor, numaMonitor, kernelResourceMonitor,
+                                               modules, deltaCalc, previousMetrics, previousTimestamp);
         
         // Save current state for next run
-        stateManager.save(metrics);
-        
-        // Format output
-        std::string output;
-        if (options.format == OutputFormat::JSON) {
-            output = formatJson(metrics, options);
-        } else if (options.format == OutputFormat::CSV) {
-            output = formatCsv(metrics, true, options);  // Include header
-        } else {
-            output = formatText(metrics, options.singleLine, options);
+        if (usesState) {
+            stateManager.save(metrics);
         }
         
-        // Output to stdout
-        std::cout << output;
-        if (options.format == OutputFormat::TEXT && !options.singleLine) {
-            std::cout << std::endl;
+        // Write to every sink on this thread (one sample needs no writer threads)
+        for (const SinkSpec& spec : effectiveSinks(options)) {
+            if (!writeSample(spec, options, metrics)) {
+                printError("[WARNING] Writing to sink " + describeSink(spec) + " failed.");
+            }
         }
         
         // Cleanup
+        if (memoryMonitor != nullptr) {
+            delete memoryMonitor;
+        }
         if (cpuMonitor != nullptr) {
             cpuMonitor->cleanup();
             delete cpuMonitor;
@@ -253,11 +554,23 @@ int singleShotMode(const CliOptions& options) {
             diskMonitor->cleanup();
             delete diskMonitor;
         }
+        if (cgroupMonitor != nullptr) {
+            delete cgroupMonitor;
+        }
+        if (powerMonitor != nullptr) {
+            delete powerMonitor;
+        }
+        if (numaMonitor != nullptr) {
+            delete numaMonitor;
+        }
+        if (kernelResourceMonitor != nullptr) {
+            delete kernelResourceMonitor;
+        }
         
         return 0;
         
     } catch (const std::exception& e) {
-        std::cerr << "[ERROR] " << e.what() << std::endl;
+        printError(std::string("[ERROR] ") + e.what());
         return 2;
     }
 }
@@ -265,50 +578,128 @@ int singleShotMode(const CliOptions& options) {
 /**
  * @brief Continuous monitoring mode
  * 
- * Collects metrics repeatedly at specified interval until Ctrl+C.
+ * Collects metrics repeatedly at specified interval until Ctrl+C. With a
+ * config file (--config/--profile), changes to it are applied live.
  * 
- * @param options CLI options
+ * @param initialOptions CLI options at start
+ * @param argc Argument count (re-parsed on config reload)
+ * @param argv Argument values
  * @return Exit code (0 = success, 2 = error)
  */
-int continuousMode(const CliOptions& options) {
+int continuousMode(const CliOptions& initialOptions, int argc, char* argv[]) {
     try {
         // Set up signal handler for Ctrl+C
         signal(SIGINT, signalHandler);
         
+        // Current options (replaced as a whole by config reloads)
+        CliOptions options = initialOptions;
+        
         // Initialize monitors
-        MemoryMonitor memoryMonitor;
+        MemoryMonitor* memoryMonitor = nullptr;
         CpuMonitor* cpuMonitor = nullptr;
         NetworkMonitor* networkMonitor = nullptr;
         DiskMonitor* diskMonitor = nullptr;
+        CgroupMonitor* cgroupMonitor = nullptr;
+        PowerMonitor* powerMonitor = nullptr;
+        NumaMonitor* numaMonitor = nullptr;
+        KernelResourceMonitor* kernelResourceMonitor = nullptr;
         DeltaCalculator deltaCalc;
         StateManager stateManager("WinHKMon");
         
-        if (options.showCpu) {
-            cpuMonitor = new CpuMonitor();
-            cpuMonitor->initialize();
-            
-            // Wait for first sample
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
+        // Monitors a reload starts; adopted only once the whole reload has succeeded
+        struct StartedMonitors {
+            std::unique_ptr<MemoryMonitor> memory;
+            std::unique_ptr<CpuMonitor> cpu;
+            std::unique_ptr<NetworkMonitor> network;
+            std::unique_ptr<DiskMonitor> disk;
+            std::unique_ptr<CgroupMonitor> cgroup;
+            std::unique_ptr<PowerMonitor> power;
+            std::unique_ptr<NumaMonitor> numa;
+            std::unique_ptr<KernelResourceMonitor> kernelResources;
+        };
         
-        if (options.showNetwork) {
-            networkMonitor = new NetworkMonitor();
-            networkMonitor->initialize();
-        }
+        // Start the monitors wanted and not running; running monitors keep
+        // their PDH queries and baselines. Throws if a required monitor cannot
+        // start, in which case the started ones are destroyed and nothing
+        // running has been touched. Without warmUp (config reloads on the
+        // event loop) nothing sleeps: a new monitor's initialize() takes its
+        // baseline and its first rates come from the next tick, so timers and
+        // pulls are never stalled.
+        auto startMonitors = [&](const CliOptions& wanted, bool warmUp) {
+            StartedMonitors started;
+            if (wanted.showMemory && memoryMonitor == nullptr) {
+                started.memory = std::make_unique<MemoryMonitor>();
+            }
+            
+            if (wanted.showCpu && cpuMonitor == nullptr) {
+                started.cpu = std::make_unique<CpuMonitor>();
+                started.cpu->initialize();
+                
+                // Wait for first sample
+                if (warmUp) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                }
+            }
+            
+            if (wanted.showNetwork && networkMonitor == nullptr) {
+                started.network = std::make_unique<NetworkMonitor>();
+                started.network->initialize();
+            }
+            
+            if ((wanted.showDiskSpace || wanted.showDiskIO) && diskMonitor == nullptr) {
+                started.disk = std::make_unique<DiskMonitor>();
+                started.disk->initialize();
+                
+                // Wait for first sample (PDH requires two samples for I/O rates)
+                if (warmUp) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+                }
+            }
+            
+            // A new root or filter starts over with a fresh discovery
+            bool cgroupChanged = wanted.cgroupRoot != options.cgroupRoot ||
+                                 wanted.cgroupFilter != options.cgroupFilter;
+            if (wanted.showCgroup && (cgroupMonitor == nullptr || cgroupChanged)) {
+                started.cgroup.reset(startCgroupMonitor(wanted));
+            }
+            
+            if (wanted.showPower && powerMonitor == nullptr) {
+                started.power.reset(startOptionalMonitor<PowerMonitor>("Power"));
+            }
+            if (wanted.showNuma && numaMonitor == nullptr) {
+                started.numa.reset(startOptionalMonitor<NumaMonitor>("NUMA"));
+            }
+            if (wanted.showKernelResources && kernelResourceMonitor == nullptr) {
+                started.kernelResources.reset(startOptionalMonitor<KernelResourceMonitor>("Kernel resource"));
+            }
+            return started;
+        };
         
-        if (options.showDiskSpace || options.showDiskIO) {
-            diskMonitor = new DiskMonitor();
-            diskMonitor->initialize();
+        // Adopt the started monitors and stop the ones no longer wanted (never throws)
+        auto adoptMonitors = [&](const CliOptions& wanted, StartedMonitors& started) {
+            adoptMonitor(memoryMonitor, started.memory, wanted.showMemory);
+            adoptMonitor(cpuMonitor, started.cpu, wanted.showCpu);
+            adoptMonitor(networkMonitor, started.network, wanted.showNetwork);
+            adoptMonitor(diskMonitor, started.disk, wanted.showDiskSpace || wanted.showDiskIO);
             
-            // Wait for first sample (PDH requires two samples for I/O rates)
-            std::this_thread::sleep_for(std::chrono::milliseconds(1100));
-        }
+            // A changed root or filter replaces the old monitor even when the new one failed to start
+            bool cgroupChanged = wanted.cgroupRoot != options.cgroupRoot ||
+                                 wanted.cgroupFilter != options.cgroupFilter;
+            adoptMonitor(cgroupMonitor, started.cgroup, wanted.showCgroup && !cgroupChanged);
+            
+            adoptMonitor(powerMonitor, started.power, wanted.showPower);
+            adoptMonitor(numaMonitor, started.numa, wanted.showNuma);
+            adoptMonitor(kernelResourceMonitor, started.kernelResources, wanted.showKernelResources);
+        };
+        StartedMonitors initialMonitors = startMonitors(options, true);
+        adoptMonitors(options, initialMonitors);
         
-        // For CSV, output header once
-        if (options.format == OutputFormat::CSV) {
-            SystemMetrics dummyMetrics;
-            std::cout << formatCsv(dummyMetrics, true, options);
-        }
+        // Modules stay loaded for the whole run (a --module change needs a restart)
+        ModuleSet modules = loadModules(options);
+        
+        // Every sink formats the same frame on the shared writer threads
+        SinkWriterPool sinkWriters(SINK_WRITER_THREADS, sinkWriterStart(options));
+        std::vector<std::unique_ptr<Sink>> sinks = openSinks(options, sinkWriters);
         
         // Load previous state for delta calculations
         SystemMetrics previousMetrics;
@@ -318,36 +709,89 @@ int continuousMode(const CliOptions& options) {
             previousTimestamp = deltaCalc.getCurrentTimestamp();
         }
         
-        // Monitoring loop
+        // Adaptive interval controller (fixed interval when not requested)
+        std::optional<AdaptiveSampler> sampler;
+        if (options.adaptive) {
+            sampler.emplace(options.minIntervalSeconds, options.maxIntervalSeconds,
+                            options.adaptiveSensitivity, options.intervalSeconds);
+        }
+        uint64_t frequency = deltaCalc.getPerformanceFrequency();
+        
+        // Timers, pull requests and push writes share one thread
+        EventLoop loop;
+        
+        // Push to an aggregator (--push); samples are dropped while it is unreachable
+        std::unique_ptr<PushClient> pushClient;
+        PushSample pushSample;
+        if (!options.pushEndpoint.empty()) {
+            pushClient = std::make_unique<PushClient>(parseEndpoint(options.pushEndpoint));
+            pushSample.hostId = resolveHostId(options);
+            loop.addSource(*pushClient);
+        }
+        
+        // Answer remote pulls (--serve); the epoch tells clients this run apart from a restart
+        std::unique_ptr<PullServer> pullServer;
+        FrameRing frameRing(options.ringFrames);
+        if (!options.serveEndpoint.empty()) {
+            pullServer = std::make_unique<PullServer>(parseEndpoint(options.serveEndpoint), frameRing, unixTimeMs());
+            loop.addSource(*pullServer);
+        }
+        
+        // Export to an OpenTelemetry collector (--otlp); batches leave on the exporter's thread
+        std::unique_ptr<OtlpExporter> otlpExporter;
+        if (!options.otlpUrl.empty()) {
+            OtlpConfig otlpConfig;
+            otlpConfig.endpoint = parseOtlpUrl(options.otlpUrl);
+            otlpConfig.batchSamples = options.otlpBatchSamples;
+            otlpExporter = std::make_unique<OtlpExporter>(otlpConfig, resolveHostId(options));
+        }
+        
+        // Wall-clock-aligned ticks (--align)
+        std::optional<AlignedSchedule> schedule;
+        if (options.align) {
+            schedule.emplace(options.intervalSeconds);
+        }
+        
+        // One sample: collect, write, push and keep for pulls
         int sampleCount = 0;
-        while (g_continueMonitoring) {
+        auto takeSample = [&](std::optional<uint64_t> nominalTimeMs) {
+            uint64_t captureTimeMs = unixTimeMs();
+            
             // Collect metrics with delta calculations
             SystemMetrics metrics = collectMetrics(options, cpuMonitor, memoryMonitor, 
-                                                   networkMonitor, diskMonitor, deltaCalc,
-                                                   previousMetrics, previousTimestamp);
+                                                   networkMonitor, diskMonitor, cgroupMonitor,
+                                                   powerMonitor, numaMonitor, kernelResourceMonitor,
+                                                   modules, deltaCalc, previousMetrics, previousTimestamp);
             
-            // Format output
-            std::string output;
-            if (options.format == OutputFormat::JSON) {
-                output = formatJson(metrics, options);
-            } else if (options.format == OutputFormat::CSV) {
-                output = formatCsv(metrics, false, options);  // No header
-            } else {
-                // For text mode in continuous, optionally clear screen
-                if (sampleCount > 0 && !options.singleLine) {
-                    // Move cursor to top of screen for in-place update
-                    // (simple version - could use Windows console API for better control)
-                    std::cout << "\n";
-                }
-                output = formatText(metrics, options.singleLine, options);
+            // Record the interval the rates actually cover
+            metrics.intervalSeconds = deltaCalc.calculateElapsedSeconds(
+                metrics.timestamp, previousTimestamp, frequency);
+            if (nominalTimeMs) {
+                metrics.nominalTimeMs = nominalTimeMs;
+                metrics.captureTimeMs = captureTimeMs;
+            }
+            
+            // Format and write on the writer threads; the loop never waits for a sink
+            MetricsFrame sharedFrame = submitToSinks(sinks, metrics, false);
+            
+            if (otlpExporter) {
+                uint64_t timeMs = metrics.nominalTimeMs.value_or(captureTimeMs);
+                otlpExporter->submit(sharedFrame, timeMs * 1000000);
+            }
+            
+            if (pushClient) {
+                WINHKMON_TRACE_SPAN("output", "push");
+                pushSample.timestampMs = metrics.nominalTimeMs.value_or(captureTimeMs);
+                pushSample.validMask = flattenSlots(metrics, pushSample.values.data());
+                pushClient->send(pushSample);
             }
             
-            // Output to stdout
-            std::cout << output;
-            if (options.format == OutputFormat::TEXT) {
-                std::cout << std::endl;
+            if (pullServer) {
+                SnapshotFrame frame;
+                frame.timestampMs = metrics.nominalTimeMs.value_or(captureTimeMs);
+                frame.validMask = flattenSlots(metrics, frame.values.data());
+                frameRing.push(frame);
             }
-            std::cout.flush();
             
             // Update previous metrics for next iteration
             previousMetrics = metrics;
@@ -355,13 +799,159 @@ int continuousMode(const CliOptions& options) {
             
             sampleCount++;
             
-            // Wait for interval
-            if (g_continueMonitoring) {
-                auto sleepMs = static_cast<int>(options.intervalSeconds * 1000);
-                std::this_thread::sleep_for(std::chrono::milliseconds(sleepMs));
+            // Low-impact: lock the working set once the hot path has run
+            if (options.lowImpact && sampleCount == 1) {
+                LowImpactStatus lockStatus;
+                lockWorkingSet(LOW_IMPACT_HEADROOM_BYTES, lockStatus);
+                reportLowImpactWarnings(lockStatus);
+            }
+            return metrics;
+        };
+        
+        // Next tick: the next wall-clock boundary (--align), else one interval
+        // after the last sample (adaptive mode picks it from recent activity).
+        // A full BLOCK sink slows sampling to its pace: an aligned tick is
+        // skipped, any other tick is retried shortly, and the loop keeps
+        // serving pulls and reloads meanwhile.
+        uint64_t tickTimer = 0;
+        double nextIntervalSeconds = 0.0;  // First sample right away
+        std::function<void()> scheduleTick;
+        scheduleTick = [&]() {
+            if (schedule) {
+                AlignedTick tick = schedule->next(steadyNowMs(), unixTimeMs());
+                auto deadline = std::chrono::steady_clock::time_point(std::chrono::milliseconds(tick.steadyDeadlineMs));
+                tickTimer = loop.addTimer(deadline, [&, tick]() {
+                    // A wall-clock step during the wait would mislabel the sample: plan again
+                    if (!schedule->clockStepped(steadyNowMs(), unixTimeMs()) && !sinksMustWait(sinks)) {
+                        takeSample(tick.nominalMs);
+                    }
+                    scheduleTick();
+                });
+            } else {
+                auto sleepMs = static_cast<int>(nextIntervalSeconds * 1000);
+                tickTimer = loop.addTimer(std::chrono::steady_clock::now() + std::chrono::milliseconds(sleepMs), [&]() {
+                    if (sinksMustWait(sinks)) {
+                        nextIntervalSeconds = std::chrono::duration<double>(SINK_RETRY_DELAY).count();
+                        scheduleTick();
+                        return;
+                    }
+                    SystemMetrics metrics = takeSample(std::nullopt);
+                    nextIntervalSeconds = sampler ? sampler->update(metrics) : options.intervalSeconds;
+                    scheduleTick();
+                });
+            }
+        };
+        
+        // Config reload: runs on the loop between ticks, so a sample never
+        // sees half of the old and half of the new options
+        auto reloadConfig = [&]() {
+            CliOptions next;
+            try {
+                next = parseArguments(argc, argv);
+            } catch (const std::exception& e) {
+                printError(std::string("[WARNING] Config reload failed, keeping current options: ") +
+                           e.what());
+                return;
+            }
+            std::string restartOnly = restartOnlyChanges(options, next);
+            if (!restartOnly.empty()) {
+                printError("[WARNING] Config reload ignored; restart to change: " + restartOnly);
+                return;
+            }
+            
+            bool samplerChanged = next.adaptive != options.adaptive ||
+                                  next.intervalSeconds != options.intervalSeconds ||
+                                  next.minIntervalSeconds != options.minIntervalSeconds ||
+                                  next.maxIntervalSeconds != options.maxIntervalSeconds ||
+                                  next.adaptiveSensitivity != options.adaptiveSensitivity;
+            bool scheduleChanged = samplerChanged || next.align != options.align;
+            bool columnsChanged = next.align != options.align || next.adaptive != options.adaptive ||
+                                  next.fields != options.fields ||
+                                  next.showCpu != options.showCpu || next.showMemory != options.showMemory ||
+                                  next.showDiskSpace != options.showDiskSpace ||
+                                  next.showDiskIO != options.showDiskIO ||
+                                  next.showNetwork != options.showNetwork ||
+                                  next.showTemp != options.showTemp ||
+                                  next.showCgroup != options.showCgroup ||
+                                  next.showPower != options.showPower ||
+                                  next.showNuma != options.showNuma ||
+                                  next.showKernelResources != options.showKernelResources;
+            
+            // New sinks when targets, formats or what they print changed
+            bool sinksChanged = effectiveSinks(next) != effectiveSinks(options) || columnsChanged ||
+                                next.singleLine != options.singleLine ||
+                                next.networkUnit != options.networkUnit ||
+                                next.coreView != options.coreView || next.topCores != options.topCores ||
+                                next.sqliteBatchSamples != options.sqliteBatchSamples ||
+                                next.sqliteCommitSeconds != options.sqliteCommitSeconds;
+            
+            // Start new monitors and open new sinks before touching the running
+            // pipeline, so a reload that fails halfway leaves it as it was
+            StartedMonitors started;
+            std::vector<std::unique_ptr<Sink>> nextSinks;
+            try {
+                started = startMonitors(next, false);
+                if (sinksChanged) {
+                    nextSinks = openSinks(next, sinkWriters, columnsChanged);
+                }
+            } catch (const std::exception& e) {
+                printError(std::string("[WARNING] Config reload failed, keeping current options: ") +
+                           e.what());
+                return;
+            }
+            
+            adoptMonitors(next, started);
+            if (sinksChanged) {
+                reportSinkProblems(sinks);
+                sinks = std::move(nextSinks);
+            }
+            options = next;
+            
+            if (samplerChanged) {
+                sampler.reset();
+                if (options.adaptive) {
+                    sampler.emplace(options.minIntervalSeconds, options.maxIntervalSeconds,
+                                    options.adaptiveSensitivity, options.intervalSeconds);
+                }
+            }
+            if (scheduleChanged) {
+                schedule.reset();
+                if (options.align) {
+                    schedule.emplace(options.intervalSeconds);
+                }
+                loop.cancelTimer(tickTimer);
+                nextIntervalSeconds = options.intervalSeconds;
+                scheduleTick();
+            }
+            printError("Config reloaded from " + options.configPath);
+        };
+        
+        // Watch the config file; the watcher thread hands changes to the loop
+        std::unique_ptr<ConfigWatcher> configWatcher;
+        if (!options.configPath.empty()) {
+            try {
+                configWatcher = std::make_unique<ConfigWatcher>(
+                    options.configPath, [&loop, &reloadConfig]() { loop.post(reloadConfig); });
+            } catch (const std::exception& e) {
+                printError(std::string("[WARNING] Config changes will not be applied live: ") + e.what());
             }
         }
         
+        // Monitoring loop (until Ctrl+C)
+        scheduleTick();
+        g_eventLoop = &loop;
+        if (g_continueMonitoring) {
+            loop.run();
+        }
+        g_eventLoop = nullptr;
+        
+        // Write what the sinks still hold
+        reportSinkProblems(sinks);
+        sinks.clear();
+        if (otlpExporter) {
+            stopOtlpExporter(*otlpExporter, options.otlpUrl);
+        }
+        
         // Save final state
         stateManager.save(previousMetrics);
         
@@ -377,13 +967,217 @@ int continuousMode(const CliOptions& options) {
             diskMonitor->cleanup();
             delete diskMonitor;
         }
+        if (cgroupMonitor != nullptr) {
+            delete cgroupMonitor;
+        }
+        if (powerMonitor != nullptr) {
+            delete powerMonitor;
+        }
+        if (numaMonitor != nullptr) {
+            delete numaMonitor;
+        }
+        if (kernelResourceMonitor != nullptr) {
+            delete kernelResourceMonitor;
+        }
+        if (memoryMonitor != nullptr) {
+            delete memoryMonitor;
+        }
+        
+        printError("state saved.");
+        
+        return 0;
+        
+    } catch (const std::exception& e) {
+        printError(std::string("[ERROR] ") + e.what());
+        return 2;
+    }
+}
+
+/**
+ * @brief High-rate mode (--high-rate)
+ * 
+ * Samples CPU and/or network on absolute deadlines from a high-resolution
+ * timer instead of the event loop, for intervals down to 1 ms. Each tick
+ * collects, hands the frame to the NDJSON sinks' writer threads and sleeps
+ * until the next deadline on the grid; overrun deadlines are skipped. The
+ * achieved wake-up lateness is reported on exit. No state file and no
+ * config reloads: per-tick work stays a counter read and a queue push.
+ * CPU usage comes from raw processor times (no PDH wait) and network
+ * counters from the rows of the interfaces chosen at start.
+ * 
+ * @param options CLI options
+ * @return Exit code (0 = success, 2 = error)
+ */
+int highRateMode(const CliOptions& options) {
+    try {
+        signal(SIGINT, signalHandler);
+        
+        std::unique_ptr<CpuMonitor> cpuMonitor;
+        std::unique_ptr<NetworkMonitor> networkMonitor;
+        if (options.showCpu) {
+            cpuMonitor = std::make_unique<CpuMonitor>(CpuSampling::RAW_TIMES);
+            cpuMonitor->initialize();
+        }
+        if (options.showNetwork) {
+            networkMonitor = std::make_unique<NetworkMonitor>();
+            networkMonitor->initialize();
+            networkMonitor->selectInterfaces(options.networkInterface.empty()
+                                                 ? std::vector<std::string>()
+                                                 : std::vector<std::string>{options.networkInterface});
+        }
+        ModuleSet noModules;
+        DeltaCalculator deltaCalc;
+        uint64_t frequency = deltaCalc.getPerformanceFrequency();
+        
+        DeadlineTimer timer;
+        if (!timer.highResolution()) {
+            printError("[WARNING] High-resolution timers need Windows 10 1803 or later; "
+                       "using a 1 ms system timer period instead.");
+        }
+        
+        SinkWriterPool sinkWriters(SINK_WRITER_THREADS, sinkWriterStart(options));
+        std::vector<std::unique_ptr<Sink>> sinks = openSinks(options, sinkWriters);
+        
+        // The first tick's rates cover the time since start
+        SystemMetrics previousMetrics;
+        uint64_t previousTimestamp = deltaCalc.getCurrentTimestamp();
+        auto period = std::chrono::duration_cast<TickPacer::Clock::duration>(
+            std::chrono::duration<double>(options.intervalSeconds));
+        TickPacer pacer(period, TickPacer::Clock::now());
+        
+        while (g_continueMonitoring) {
+            TickPacer::Clock::time_point woke = timer.sleepUntil(pacer.deadline());
+            if (!g_continueMonitoring) {
+                break;
+            }
+            
+            SystemMetrics metrics = collectMetrics(options, cpuMonitor.get(), nullptr,
+                                                   networkMonitor.get(), nullptr, nullptr,
+                                                   nullptr, nullptr, nullptr,
+                                                   noModules, deltaCalc, previousMetrics, previousTimestamp);
+            metrics.intervalSeconds = deltaCalc.calculateElapsedSeconds(
+                metrics.timestamp, previousTimestamp, frequency);
+            submitToSinks(sinks, metrics);
+            
+            previousTimestamp = metrics.timestamp;
+            previousMetrics = std::move(metrics);
+            pacer.complete(woke, TickPacer::Clock::now());
+        }
         
-        std::cerr << "state saved." << std::endl;
+        reportSinkProblems(sinks);
+        sinks.clear();
         
+        JitterStats jitter = pacer.stats();
+        char summary[256];
+        std::snprintf(summary, sizeof(summary),
+                      "%llu ticks at %.3f ms, %llu deadlines missed; lateness mean %.1f us, "
+                      "p50 %.1f us, p99 %.1f us, max %.1f us",
+                      static_cast<unsigned long long>(jitter.ticks), options.intervalSeconds * 1000.0,
+                      static_cast<unsigned long long>(jitter.missed), jitter.meanUs, jitter.p50Us,
+                      jitter.p99Us, jitter.maxUs);
+        printError(summary);
+        
+        if (cpuMonitor) {
+            cpuMonitor->cleanup();
+        }
         return 0;
         
     } catch (const std::exception& e) {
-        std::cerr << "[ERROR] " << e.what() << std::endl;
+        printError(std::string("[ERROR] ") + e.what());
+        return 2;
+    }
+}
+
+/**
+ * @brief Aggregate mode ("WinHKMon aggregate")
+ * 
+ * Receives samples pushed by agents and prints one cluster-wide sample per
+ * closed time bucket until Ctrl+C. Buckets close one bucket width after
+ * they end, which absorbs network delay and modest clock skew.
+ * 
+ * @param options CLI options
+ * @return Exit code (0 = success, 2 = error)
+ */
+int aggregateMode(const CliOptions& options) {
+    try {
+        signal(SIGINT, signalHandler);
+        
+        // Buckets close on wall-clock boundaries: one wakeup per bucket when idle
+        AlignedSchedule closeSchedule(options.bucketSeconds);
+        FleetAggregator aggregator(closeSchedule.intervalMs(), closeSchedule.intervalMs());
+        EventLoop loop;
+        AggregateServer server(parseEndpoint(options.listenEndpoint),
+                               [&aggregator](const PushSample& sample) { aggregator.ingest(sample, unixTimeMs()); });
+        loop.addSource(server);
+        std::fprintf(stderr, "Aggregating on %s (%g s buckets)\n", options.listenEndpoint.c_str(),
+                     options.bucketSeconds);
+        
+        // Formatters show sections by option; the cluster view has all of them
+        CliOptions outputOptions = options;
+        outputOptions.showCpu = true;
+        outputOptions.showMemory = true;
+        outputOptions.showDiskIO = true;
+        outputOptions.showNetwork = true;
+        
+        // CSV headers come from the first bucket, which has the agents' columns
+        SinkWriterPool sinkWriters(SINK_WRITER_THREADS, sinkWriterStart(outputOptions));
+        std::vector<std::unique_ptr<Sink>> sinks = openSinks(outputOptions, sinkWriters);
+        
+        // Closed buckets wait here while a BLOCK sink is full
+        std::deque<SystemMetrics> pendingBuckets;
+        bool retryArmed = false;
+        std::function<void()> submitPending;
+        submitPending = [&]() {
+            while (!pendingBuckets.empty() && !sinksMustWait(sinks)) {
+                submitToSinks(sinks, pendingBuckets.front(), false);
+                pendingBuckets.pop_front();
+            }
+            if (!pendingBuckets.empty() && !retryArmed) {
+                retryArmed = true;
+                loop.addTimer(std::chrono::steady_clock::now() + SINK_RETRY_DELAY, [&]() {
+                    retryArmed = false;
+                    submitPending();
+                });
+            }
+        };
+        auto printClosedBuckets = [&](uint64_t nowMs) {
+            for (const ClusterStats& stats : aggregator.closeBuckets(nowMs)) {
+                pendingBuckets.push_back(FleetAggregator::toSystemMetrics(stats));
+            }
+            submitPending();
+        };
+        
+        std::function<void()> scheduleClose;
+        scheduleClose = [&]() {
+            AlignedTick tick = closeSchedule.next(steadyNowMs(), unixTimeMs());
+            loop.addTimer(std::chrono::steady_clock::time_point(std::chrono::milliseconds(tick.steadyDeadlineMs)),
+                          [&, tick]() {
+                              // Close on the boundary itself, even if woken a little early
+                              printClosedBuckets(std::max(tick.nominalMs, unixTimeMs()));
+                              scheduleClose();
+                          });
+        };
+        scheduleClose();
+        
+        g_eventLoop = &loop;
+        if (g_continueMonitoring) {
+            loop.run();
+        }
+        g_eventLoop = nullptr;
+        for (const SystemMetrics& metrics : pendingBuckets) {
+            submitToSinks(sinks, metrics);
+        }
+        reportSinkProblems(sinks);
+        
+        printError("stopped (" + std::to_string(server.connectionCount()) + " agents connected, " +
+                   std::to_string(aggregator.lateSamples()) + " late samples, " +
+                   std::to_string(aggregator.futureSamples()) + " future samples, " +
+                   std::to_string(aggregator.invalidValues()) + " invalid values, " +
+                   std::to_string(server.rejectedConnections()) + " rejected connections).");
+        return 0;
+        
+    } catch (const std::exception& e) {
+        printError(std::string("[ERROR] ") + e.what());
         return 2;
     }
 }
@@ -398,38 +1192,67 @@ int main(int argc, char* argv[]) {
         
         // Handle help
         if (options.showHelp) {
-            std::cout << generateHelpMessage() << std::endl;
+            std::puts(generateHelpMessage().c_str());
             return 0;
         }
         
         // Handle version
         if (options.showVersion) {
-            std::cout << generateVersionString() << std::endl;
+            std::puts(generateVersionString().c_str());
             return 0;
         }
         
-        // Check that at least one metric is requested
-        if (!options.showCpu && !options.showMemory && !options.showDiskSpace && !options.showDiskIO &&
-            !options.showNetwork && !options.showTemp) {
-            std::cerr << "[ERROR] No metrics specified. Use --help for usage information." << std::endl;
+        // Check that at least one metric is requested (the aggregator takes none)
+        if (!options.aggregate && !options.showCpu && !options.showMemory && !options.showDiskSpace && !options.showDiskIO &&
+            !options.showNetwork && !options.showTemp && !options.showCgroup &&
+            !options.showPower && !options.showNuma && !options.showKernelResources &&
+            options.modules.empty()) {
+            printError("[ERROR] No metrics specified. Use --help for usage information.");
             return 1;
         }
         
         // Warn about unimplemented features
         if (options.showTemp) {
-            std::cerr << "[WARNING] Temperature monitoring not yet implemented (T017 pending)." << std::endl;
+            printError("[WARNING] Temperature monitoring not yet implemented (T017 pending).");
+        }
+        
+        if (options.adaptive && !options.continuous) {
+            printError("[WARNING] --adaptive only applies to continuous mode (-c).");
+        }
+        
+        // Low-impact scheduling applies before monitors start their helper threads
+        if (options.lowImpact) {
+            reportLowImpactWarnings(enterLowImpactMode(options.housekeepingCpus));
+        }
+        
+        // Self-instrumentation trace (spans are only recorded when enabled)
+        Tracer& tracer = Tracer::instance();
+        if (!options.traceFile.empty()) {
+            tracer.start();
+            tracer.setThreadName("main");
         }
         
         // Run in appropriate mode
-        if (options.continuous) {
-            return continuousMode(options);
-        } else {
-            return singleShotMode(options);
+        int exitCode = options.aggregate ? aggregateMode(options)
+                     : options.highRate ? highRateMode(options)
+                     : options.continuous ? continuousMode(options, argc, argv)
+                     : singleShotMode(options);
+        
+        if (tracer.isEnabled()) {
+            tracer.stop();
+            if (!tracer.writeChromeTrace(options.traceFile)) {
+                printError("[WARNING] Failed to write trace file '" + options.traceFile + "'.");
+            } else if (tracer.droppedCount() > 0) {
+                printError("[WARNING] Trace buffer full; " + std::to_string(tracer.droppedCount()) +
+                           " spans dropped.");
+            }
         }
         
+        return exitCode;
+        
     } catch (const std::exception& e) {
-        std::cerr << "[ERROR] " << e.what() << std::endl;
-        std::cerr << "Use --help for usage information." << std::endl;
+        printError(std::string("[ERROR] ") + e.what());
+        printError("Use --help for usage information.");
         return 1;
     }
 }
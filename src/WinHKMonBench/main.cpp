@@ -0,0 +1,993 @@
+/**
+ * @file main.cpp
+ * @brief WinHKMonBench - end-to-end overhead and footprint benchmark harness
+ *
+ * Launches WinHKMon.exe in representative configurations and measures the
+ * child process from the outside (so the measurement does not perturb it):
+ * - CPU usage (percent of one core and of the whole system)
+ * - Peak and steady-state working set (RSS)
+ * - Context switches and page faults per tick
+ * - I/O operations per tick (closest Windows proxy for syscalls per tick)
+ * - Bytes written besides stdout (state file)
+ * - Single-shot wall time (after a warm-up run) and its margin over a --version start
+ * - Wake-up jitter of a co-located latency probe, with and without --low-impact
+ * - Bytes and consumer CPU of delta pulls (--serve) versus the full JSON stream
+ * - Achieved sample rate of --high-rate at 1 kHz, and whether one core keeps up
+ *
+ * Results are written as a JSON report with pass/fail against NFR-1.
+ */
+
+#include "WinHKMonLib/DeltaProtocol.h"
+#include "WinHKMonLib/RemoteTransport.h"
+#include <windows.h>
+#include <psapi.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// NFR-1 targets (spec.md)
+constexpr double NFR_CPU_PERCENT = 1.0;                      ///< NFR-1.1 (system-wide)
+constexpr uint64_t NFR_RSS_BYTES = 10ULL * 1024 * 1024;      ///< NFR-1.2
+constexpr double NFR_DISK_BYTES_PER_SEC = 1024.0;            ///< NFR-1.3
+constexpr double NFR_STARTUP_MS = 200.0;                     ///< NFR-1.4
+constexpr double HIGH_RATE_MIN_FRACTION = 0.95;              ///< --high-rate ticks / nominal rate
+
+// Minimal NtQuerySystemInformation(SystemProcessInformation) layout for
+// per-thread context switch counts (not exposed by documented Win32 APIs)
+struct BenchUnicodeString {
+    USHORT Length;
+    USHORT MaximumLength;
+    PWSTR Buffer;
+};
+
+struct BenchThreadInformation {
+    LARGE_INTEGER KernelTime;
+    LARGE_INTEGER UserTime;
+    LARGE_INTEGER CreateTime;
+    ULONG WaitTime;
+    PVOID StartAddress;
+    HANDLE UniqueProcess;
+    HANDLE UniqueThread;
+    LONG Priority;
+    LONG BasePriority;
+    ULONG ContextSwitches;
+    ULONG ThreadState;
+    ULONG WaitReason;
+};
+
+struct BenchProcessInformation {
+    ULONG NextEntryOffset;
+    ULONG NumberOfThreads;
+    LARGE_INTEGER WorkingSetPrivateSize;
+    ULONG HardFaultCount;
+    ULONG NumberOfThreadsHighWatermark;
+    ULONGLONG CycleTime;
+    LARGE_INTEGER CreateTime;
+    LARGE_INTEGER UserTime;
+    LARGE_INTEGER KernelTime;
+    BenchUnicodeString ImageName;
+    LONG BasePriority;
+    HANDLE UniqueProcessId;
+    HANDLE InheritedFromUniqueProcessId;
+    ULONG HandleCount;
+    ULONG SessionId;
+    ULONG_PTR UniqueProcessKey;
+    SIZE_T PeakVirtualSize;
+    SIZE_T VirtualSize;
+    ULONG PageFaultCount;
+    SIZE_T PeakWorkingSetSize;
+    SIZE_T WorkingSetSize;
+    SIZE_T QuotaPeakPagedPoolUsage;
+    SIZE_T QuotaPagedPoolUsage;
+    SIZE_T QuotaPeakNonPagedPoolUsage;
+    SIZE_T QuotaNonPagedPoolUsage;
+    SIZE_T PagefileUsage;
+    SIZE_T PeakPagefileUsage;
+    SIZE_T PrivatePageCount;
+    LARGE_INTEGER ReadOperationCount;
+    LARGE_INTEGER WriteOperationCount;
+    LARGE_INTEGER OtherOperationCount;
+    LARGE_INTEGER ReadTransferCount;
+    LARGE_INTEGER WriteTransferCount;
+    LARGE_INTEGER OtherTransferCount;
+    BenchThreadInformation Threads[1];
+};
+
+typedef LONG(WINAPI* NtQuerySystemInformationFn)(ULONG, PVOID, ULONG, PULONG);
+constexpr ULONG SYSTEM_PROCESS_INFORMATION_CLASS = 5;
+// Latency probe: 1 ms periodic wake-ups on the last logical CPU
+constexpr LONGLONG PROBE_PERIOD_100NS = 10000;
+
+// Pull scenario: client period, loopback port range and decode replay rounds
+constexpr double PULL_PERIOD_SECONDS = 0.1;
+constexpr unsigned PULL_PORT_BASE = 40000;
+constexpr int PULL_REPLAY_ROUNDS = 50;
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+constexpr LONG STATUS_INFO_LENGTH_MISMATCH_CODE = static_cast<LONG>(0xC0000004L);
+
+/**
+ * @brief How a scenario exercises WinHKMon
+ */
+enum class BenchKind {
+    CONTINUOUS,   ///< Long-running child measured from outside
+    SINGLE_SHOT,  ///< Repeated short runs
+    JITTER,       ///< Latency probe in this process while the child runs (no args = baseline)
+    PULL          ///< Delta pulls from the child compared with its JSON output
+};
+
+/**
+ * @brief One benchmark scenario
+ */
+struct BenchConfig {
+    std::string name;                 ///< Scenario identifier used in the report
+    std::vector<std::string> args;    ///< WinHKMon arguments
+    BenchKind kind;                   ///< Measurement mode
+    double intervalSeconds;           ///< Sampling interval for continuous/jitter runs
+};
+
+/**
+ * @brief Measurements for one scenario
+ */
+struct BenchResult {
+    BenchConfig config;
+    bool ok = false;                   ///< Child ran and produced output
+    std::string error;                 ///< Failure reason if !ok
+
+    // Continuous runs
+    double wallSeconds = 0.0;          ///< Measured window (after warm-up)
+    uint64_t ticks = 0;                ///< Samples produced in the measured window
+    double achievedHz = 0.0;           ///< ticks / wallSeconds
+    double cpuPercentOneCore = 0.0;    ///< CPU time / wall time
+    double cpuPercentSystem = 0.0;     ///< CPU time / (wall time * logical CPUs)
+    uint64_t peakRssBytes = 0;         ///< PeakWorkingSetSize
+    uint64_t steadyRssBytes = 0;       ///< Median working set after warm-up
+    double contextSwitchesPerTick = 0.0;
+    double pageFaultsPerTick = 0.0;
+    double ioOperationsPerTick = 0.0;  ///< Read+write+other I/O operations per tick
+    double stateBytesPerSec = 0.0;     ///< Bytes written besides stdout
+
+    // Single-shot loops
+    std::vector<double> wallMs;        ///< Per-run wall time
+    double overBaselineMs = 0.0;       ///< Median above the --version baseline
+
+    // Jitter probe
+    uint64_t probeWakeups = 0;         ///< Probe wake-ups measured
+    double jitterP50Us = 0.0;          ///< Median wake-up lateness
+    double jitterP99Us = 0.0;          ///< 99th percentile wake-up lateness
+    double jitterMaxUs = 0.0;          ///< Worst wake-up lateness
+    double addedP99Us = 0.0;           ///< p99 above the no-WinHKMon baseline
+
+    // Delta pulls versus JSON
+    uint64_t pulls = 0;                ///< Pull requests answered
+    uint64_t keyframes = 0;            ///< Pulls answered with a full keyframe
+    double pullBytesPerSec = 0.0;      ///< Pull responses on the wire
+    double jsonBytesPerSec = 0.0;      ///< JSON written to stdout in the same window
+    double bytesSavedPercent = 0.0;    ///< 100 * (1 - pull / JSON bytes)
+    double decodeNsPerPull = 0.0;      ///< SnapshotDecoder::apply per response
+    double jsonParseNsPerSample = 0.0; ///< Extracting every number from one JSON sample
+    double cpuSavedPercent = 0.0;      ///< 100 * (1 - decode / JSON parse time)
+
+    bool pass = true;                  ///< All applicable NFR-1 checks passed
+};
+
+std::wstring toWide(const std::string& str) {
+    if (str.empty()) {
+        return L"";
+    }
+    int size = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, nullptr, 0);
+    std::wstring wide(size - 1, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, &wide[0], size);
+    return wide;
+}
+
+uint64_t fileTimeTo100ns(const FILETIME& ft) {
+    return (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+}
+
+double nowSeconds() {
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return static_cast<double>(counter.QuadPart) / static_cast<double>(frequency.QuadPart);
+}
+
+double median(std::vector<double> values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+// Percentile of an already sorted vector (fraction in [0, 1])
+double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1));
+    return sorted[index];
+}
+
+std::wstring buildCommandLine(const std::wstring& exePath, const std::vector<std::string>& args) {
+    std::wstring cmd = L"\"" + exePath + L"\"";
+    for (const auto& arg : args) {
+        cmd += L" " + toWide(arg);
+    }
+    return cmd;
+}
+
+/**
+ * @brief Sum context switches over all threads of a process
+ *
+ * @return Context switch count, or 0 if unavailable
+ */
+uint64_t queryContextSwitches(DWORD processId) {
+    static NtQuerySystemInformationFn query = reinterpret_cast<NtQuerySystemInformationFn>(
+        GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtQuerySystemInformation"));
+    if (query == nullptr) {
+        return 0;
+    }
+
+    std::vector<BYTE> buffer(1024 * 1024);
+    ULONG needed = 0;
+    LONG status;
+    while ((status = query(SYSTEM_PROCESS_INFORMATION_CLASS, buffer.data(),
+                           static_cast<ULONG>(buffer.size()), &needed)) ==
+           STATUS_INFO_LENGTH_MISMATCH_CODE) {
+        buffer.resize(std::max<size_t>(needed, buffer.size() * 2));
+    }
+    if (status < 0) {
+        return 0;
+    }
+
+    const BYTE* entry = buffer.data();
+    while (true) {
+        const auto* process = reinterpret_cast<const BenchProcessInformation*>(entry);
+        if (reinterpret_cast<ULONG_PTR>(process->UniqueProcessId) == processId) {
+            uint64_t switches = 0;
+            for (ULONG i = 0; i < process->NumberOfThreads; i++) {
+                switches += process->Threads[i].ContextSwitches;
+            }
+            return switches;
+        }
+        if (process->NextEntryOffset == 0) {
+            break;
+        }
+        entry += process->NextEntryOffset;
+    }
+    return 0;
+}
+
+/**
+ * @brief Point-in-time counters for the child process
+ */
+struct ProcessSnapshot {
+    double time = 0.0;
+    uint64_t cpu100ns = 0;
+    uint64_t workingSet = 0;
+    uint64_t peakWorkingSet = 0;
+    uint64_t pageFaults = 0;
+    uint64_t contextSwitches = 0;
+    uint64_t ioOperations = 0;
+    uint64_t bytesWritten = 0;
+};
+
+ProcessSnapshot takeSnapshot(HANDLE process, DWORD processId) {
+    ProcessSnapshot snap;
+    snap.time = nowSeconds();
+
+    FILETIME creation, exitTime, kernel, user;
+    if (GetProcessTimes(process, &creation, &exitTime, &kernel, &user)) {
+        snap.cpu100ns = fileTimeTo100ns(kernel) + fileTimeTo100ns(user);
+    }
+
+    PROCESS_MEMORY_COUNTERS pmc{};
+    if (GetProcessMemoryInfo(process, &pmc, sizeof(pmc))) {
+        snap.workingSet = pmc.WorkingSetSize;
+        snap.peakWorkingSet = pmc.PeakWorkingSetSize;
+        snap.pageFaults = pmc.PageFaultCount;
+    }
+
+    IO_COUNTERS io{};
+    if (GetProcessIoCounters(process, &io)) {
+        snap.ioOperations = io.ReadOperationCount + io.WriteOperationCount + io.OtherOperationCount;
+        snap.bytesWritten = io.WriteTransferCount;
+    }
+
+    snap.contextSwitches = queryContextSwitches(processId);
+    return snap;
+}
+
+/**
+ * @brief Launch WinHKMon with stdout redirected to a file
+ */
+PROCESS_INFORMATION launch(const std::wstring& exePath, const std::vector<std::string>& args,
+                           const std::wstring& outputPath) {
+    SECURITY_ATTRIBUTES sa{sizeof(sa), nullptr, TRUE};
+    HANDLE out = CreateFileW(outputPath.c_str(), GENERIC_WRITE, FILE_SHARE_READ, &sa,
+                             CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY, nullptr);
+    if (out == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot create output capture file");
+    }
+    HANDLE nul = CreateFileW(L"NUL", GENERIC_WRITE, FILE_SHARE_WRITE, &sa, OPEN_EXISTING, 0, nullptr);
+
+    STARTUPINFOW si{};
+    si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+    si.hStdOutput = out;
+    si.hStdError = nul;
+
+    std::wstring cmd = buildCommandLine(exePath, args);
+    PROCESS_INFORMATION pi{};
+    BOOL created = CreateProcessW(exePath.c_str(), &cmd[0], nullptr, nullptr, TRUE,
+                                  CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi);
+    CloseHandle(out);
+    if (nul != INVALID_HANDLE_VALUE) {
+        CloseHandle(nul);
+    }
+    if (!created) {
+        throw std::runtime_error("CreateProcess failed: " + std::to_string(GetLastError()));
+    }
+    return pi;
+}
+
+uint64_t countLines(const std::wstring& path, uint64_t& sizeBytes) {
+    std::ifstream file(path, std::ios::binary);
+    uint64_t lines = 0;
+    sizeBytes = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        lines++;
+        sizeBytes += line.size() + 1;
+    }
+    return lines;
+}
+
+BenchResult runContinuous(const BenchConfig& config, const std::wstring& exePath,
+                          double durationSeconds, unsigned logicalCpus) {
+    BenchResult result;
+    result.config = config;
+
+    wchar_t tempDir[MAX_PATH];
+    GetTempPathW(MAX_PATH, tempDir);
+    std::wstring outputPath = std::wstring(tempDir) + L"WinHKMonBench_" + toWide(config.name) + L".csv";
+
+    // Longer intervals need a longer window to produce enough ticks
+    double window = std::max(durationSeconds, config.intervalSeconds * 6.0);
+    double warmup = std::max(2.0, config.intervalSeconds * 2.0);
+
+    PROCESS_INFORMATION pi = launch(exePath, config.args, outputPath);
+
+    // Warm-up: initialization (PDH baseline sleeps) is excluded per NFR-1.1
+    Sleep(static_cast<DWORD>(warmup * 1000));
+    uint64_t outputBytesAtStart = 0;
+    uint64_t linesAtStart = countLines(outputPath, outputBytesAtStart);
+    ProcessSnapshot start = takeSnapshot(pi.hProcess, pi.dwProcessId);
+
+    std::vector<double> workingSets;
+    ProcessSnapshot end = start;
+    while (nowSeconds() - start.time < window) {
+        if (WaitForSingleObject(pi.hProcess, 250) == WAIT_OBJECT_0) {
+            break;  // Child exited early
+        }
+        end = takeSnapshot(pi.hProcess, pi.dwProcessId);
+        workingSets.push_back(static_cast<double>(end.workingSet));
+    }
+
+    DWORD exitCode = STILL_ACTIVE;
+    GetExitCodeProcess(pi.hProcess, &exitCode);
+    TerminateProcess(pi.hProcess, 0);
+    WaitForSingleObject(pi.hProcess, 5000);
+    CloseHandle(pi.hThread);
+    CloseHandle(pi.hProcess);
+
+    uint64_t outputBytes = 0;
+    uint64_t linesAtEnd = countLines(outputPath, outputBytes);
+    DeleteFileW(outputPath.c_str());
+
+    if (exitCode != STILL_ACTIVE) {
+        result.error = "WinHKMon exited early with code " + std::to_string(exitCode);
+        result.pass = false;
+        return result;
+    }
+
+    result.wallSeconds = end.time - start.time;
+    result.ticks = linesAtEnd > linesAtStart ? linesAtEnd - linesAtStart : 0;
+    if (result.wallSeconds <= 0.0 || result.ticks == 0) {
+        result.error = "No samples produced in the measurement window";
+        result.pass = false;
+        return result;
+    }
+
+    double cpuSeconds = static_cast<double>(end.cpu100ns - start.cpu100ns) / 1.0e7;
+    double ticks = static_cast<double>(result.ticks);
+    result.cpuPercentOneCore = cpuSeconds / result.wallSeconds * 100.0;
+    result.cpuPercentSystem = result.cpuPercentOneCore / std::max(1u, logicalCpus);
+    result.peakRssBytes = end.peakWorkingSet;
+    result.steadyRssBytes = static_cast<uint64_t>(median(workingSets));
+    result.contextSwitchesPerTick = static_cast<double>(end.contextSwitches - start.contextSwitches) / ticks;
+    result.pageFaultsPerTick = static_cast<double>(end.pageFaults - start.pageFaults) / ticks;
+    result.ioOperationsPerTick = static_cast<double>(end.ioOperations - start.ioOperations) / ticks;
+
+    // Stdout is captured to a file, so subtract it to isolate state-file writes
+    double outputBytesInWindow = static_cast<double>(outputBytes - outputBytesAtStart);
+    double writtenBytes = static_cast<double>(end.bytesWritten - start.bytesWritten);
+    result.stateBytesPerSec = std::max(0.0, writtenBytes - outputBytesInWindow) / result.wallSeconds;
+
+    result.achievedHz = ticks / result.wallSeconds;
+
+    result.ok = true;
+    if (config.intervalSeconds < 0.1) {
+        // High-rate runs trade CPU for resolution: hold the rate on one core
+        result.pass = result.achievedHz >= HIGH_RATE_MIN_FRACTION / config.intervalSeconds &&
+                      result.cpuPercentOneCore < 100.0 &&
+                      result.steadyRssBytes < NFR_RSS_BYTES;
+        return result;
+    }
+    result.pass = result.cpuPercentSystem < NFR_CPU_PERCENT &&
+                  result.steadyRssBytes < NFR_RSS_BYTES &&
+                  result.stateBytesPerSec < NFR_DISK_BYTES_PER_SEC;
+    return result;
+}
+
+BenchResult runSingleShotLoop(const BenchConfig& config, const std::wstring& exePath, int runs) {
+    BenchResult result;
+    result.config = config;
+
+    wchar_t tempDir[MAX_PATH];
+    GetTempPathW(MAX_PATH, tempDir);
+    std::wstring outputPath = std::wstring(tempDir) + L"WinHKMonBench_" + toWide(config.name) + L".txt";
+
+    // Run 0 only warms the file cache (image, DLLs) and is not counted
+    for (int i = 0; i <= runs; i++) {
+        double begin = nowSeconds();
+        PROCESS_INFORMATION pi = launch(exePath, config.args, outputPath);
+        WaitForSingleObject(pi.hProcess, INFINITE);
+        double elapsedMs = (nowSeconds() - begin) * 1000.0;
+
+        PROCESS_MEMORY_COUNTERS pmc{};
+        if (GetProcessMemoryInfo(pi.hProcess, &pmc, sizeof(pmc))) {
+            result.peakRssBytes = std::max<uint64_t>(result.peakRssBytes, pmc.PeakWorkingSetSize);
+        }
+        DWORD exitCode = 0;
+        GetExitCodeProcess(pi.hProcess, &exitCode);
+        CloseHandle(pi.hThread);
+        CloseHandle(pi.hProcess);
+
+        if (exitCode != 0) {
+            result.error = "WinHKMon exited with code " + std::to_string(exitCode);
+            result.pass = false;
+            DeleteFileW(outputPath.c_str());
+            return result;
+        }
+        if (i > 0) {
+            result.wallMs.push_back(elapsedMs);
+        }
+    }
+    DeleteFileW(outputPath.c_str());
+
+    result.ok = true;
+    result.pass = median(result.wallMs) < NFR_STARTUP_MS && result.peakRssBytes < NFR_RSS_BYTES;
+    return result;
+}
+
+/**
+ * @brief Measure wake-up lateness of a 1 ms periodic timer
+ *
+ * Runs on the calling thread, pinned to probeCpu at highest priority, the way
+ * a latency-sensitive service thread would. Lateness is the time past the
+ * requested 1 ms that each wait took to return.
+ *
+ * @return Lateness per wake-up in microseconds
+ */
+std::vector<double> runLatencyProbe(double durationSeconds, unsigned probeCpu) {
+    HANDLE timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                          TIMER_ALL_ACCESS);
+    if (timer == nullptr) {
+        // High-resolution timers need Windows 10 1803+
+        timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+    }
+    if (timer == nullptr) {
+        throw std::runtime_error("CreateWaitableTimer failed: " + std::to_string(GetLastError()));
+    }
+
+    HANDLE thread = GetCurrentThread();
+    DWORD_PTR previousAffinity = SetThreadAffinityMask(thread, static_cast<DWORD_PTR>(1) << probeCpu);
+    int previousPriority = GetThreadPriority(thread);
+    SetThreadPriority(thread, THREAD_PRIORITY_HIGHEST);
+
+    std::vector<double> latenessUs;
+    latenessUs.reserve(static_cast<size_t>(durationSeconds * 1000.0));
+    double periodUs = static_cast<double>(PROBE_PERIOD_100NS) / 10.0;
+    double end = nowSeconds() + durationSeconds;
+    while (nowSeconds() < end) {
+        LARGE_INTEGER due;
+        due.QuadPart = -PROBE_PERIOD_100NS;  // Relative
+        double begin = nowSeconds();
+        SetWaitableTimer(timer, &due, 0, nullptr, nullptr, FALSE);
+        WaitForSingleObject(timer, INFINITE);
+        double elapsedUs = (nowSeconds() - begin) * 1.0e6;
+        latenessUs.push_back(std::max(0.0, elapsedUs - periodUs));
+    }
+
+    SetThreadPriority(thread, previousPriority);
+    if (previousAffinity != 0) {
+        SetThreadAffinityMask(thread, previousAffinity);
+    }
+    CloseHandle(timer);
+    return latenessUs;
+}
+
+BenchResult runJitter(const BenchConfig& config, const std::wstring& exePath,
+                      double durationSeconds, unsigned logicalCpus) {
+    BenchResult result;
+    result.config = config;
+
+    wchar_t tempDir[MAX_PATH];
+    GetTempPathW(MAX_PATH, tempDir);
+    std::wstring outputPath = std::wstring(tempDir) + L"WinHKMonBench_" + toWide(config.name) + L".csv";
+
+    // Probe on the last CPU; low-impact scenarios pin WinHKMon to CPU 0
+    unsigned probeCpu = std::min(logicalCpus, 64u) - 1;
+
+    PROCESS_INFORMATION pi{};
+    bool launched = !config.args.empty();
+    if (launched) {
+        pi = launch(exePath, config.args, outputPath);
+        Sleep(static_cast<DWORD>(std::max(2.0, config.intervalSeconds * 2.0) * 1000));
+    }
+
+    std::vector<double> latenessUs = runLatencyProbe(durationSeconds, probeCpu);
+
+    if (launched) {
+        DWORD exitCode = STILL_ACTIVE;
+        GetExitCodeProcess(pi.hProcess, &exitCode);
+        TerminateProcess(pi.hProcess, 0);
+        WaitForSingleObject(pi.hProcess, 5000);
+        CloseHandle(pi.hThread);
+        CloseHandle(pi.hProcess);
+        DeleteFileW(outputPath.c_str());
+        if (exitCode != STILL_ACTIVE) {
+            result.error = "WinHKMon exited early with code " + std::to_string(exitCode);
+            result.pass = false;
+            return result;
+        }
+    }
+
+    std::sort(latenessUs.begin(), latenessUs.end());
+    result.probeWakeups = latenessUs.size();
+    result.jitterP50Us = percentile(latenessUs, 0.5);
+    result.jitterP99Us = percentile(latenessUs, 0.99);
+    result.jitterMaxUs = latenessUs.empty() ? 0.0 : latenessUs.back();
+    result.ok = !latenessUs.empty();
+    if (!result.ok) {
+        result.error = "Latency probe recorded no wake-ups";
+        result.pass = false;
+    }
+    return result;
+}
+
+std::string readFile(const std::wstring& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+// JSON samples in captured output (each starts with "schemaVersion")
+size_t countJsonSamples(const std::string& output) {
+    const std::string marker = "\"schemaVersion\"";
+    size_t count = 0;
+    for (size_t pos = output.find(marker); pos != std::string::npos; pos = output.find(marker, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+// What a JSON consumer minimally does per sample: convert every value
+double parseJsonNumbers(const std::string& json) {
+    double sum = 0.0;
+    for (size_t pos = json.find(": "); pos != std::string::npos; pos = json.find(": ", pos + 2)) {
+        sum += std::strtod(json.c_str() + pos + 2, nullptr);
+    }
+    return sum;
+}
+
+/**
+ * @brief Compare delta pulls with consuming the full JSON stream
+ *
+ * The child samples at the scenario interval with JSON on stdout and
+ * --serve on loopback; this process pulls every 100 ms. Bytes are measured
+ * on the wire and in the captured output. Consumer CPU is timed afterwards
+ * by replaying the pulled frames through SnapshotDecoder and by converting
+ * every number in the captured JSON samples.
+ */
+BenchResult runPull(const BenchConfig& config, const std::wstring& exePath, double durationSeconds) {
+    BenchResult result;
+    result.config = config;
+
+    wchar_t tempDir[MAX_PATH];
+    GetTempPathW(MAX_PATH, tempDir);
+    std::wstring outputPath = std::wstring(tempDir) + L"WinHKMonBench_" + toWide(config.name) + L".json";
+    std::string endpoint = "tcp:127.0.0.1:" + std::to_string(PULL_PORT_BASE + GetCurrentProcessId() % 20000);
+    result.config.args.push_back("--serve");
+    result.config.args.push_back(endpoint);
+
+    PROCESS_INFORMATION pi = launch(exePath, result.config.args, outputPath);
+    Sleep(static_cast<DWORD>(std::max(2.0, config.intervalSeconds * 2.0) * 1000));
+    size_t jsonAtStart = readFile(outputPath).size();
+
+    std::vector<WinHKMon::SnapshotFrame> frames;
+    uint64_t pullBytes = 0;
+    double start = nowSeconds();
+    try {
+        WinHKMon::PullClient client(WinHKMon::parseEndpoint(endpoint));
+        WinHKMon::SnapshotDecoder decoder;
+        double next = start;
+        while (nowSeconds() - start < durationSeconds &&
+               WaitForSingleObject(pi.hProcess, 0) == WAIT_TIMEOUT) {
+            size_t bytes = 0;
+            WinHKMon::SnapshotKind kind = client.pull(decoder, &bytes);
+            result.pulls++;
+            pullBytes += bytes;
+            if (kind == WinHKMon::SnapshotKind::KEYFRAME) {
+                result.keyframes++;
+            }
+            if (kind != WinHKMon::SnapshotKind::NONE &&
+                (frames.empty() || frames.back().sequence != decoder.frame().sequence)) {
+                frames.push_back(decoder.frame());
+            }
+            next += PULL_PERIOD_SECONDS;
+            double wait = next - nowSeconds();
+            if (wait > 0.0) {
+                Sleep(static_cast<DWORD>(wait * 1000));
+            }
+        }
+    } catch (const std::runtime_error& e) {
+        result.error = std::string("Pull failed: ") + e.what();
+    }
+    double wallSeconds = nowSeconds() - start;
+
+    DWORD exitCode = STILL_ACTIVE;
+    GetExitCodeProcess(pi.hProcess, &exitCode);
+    TerminateProcess(pi.hProcess, 0);
+    WaitForSingleObject(pi.hProcess, 5000);
+    CloseHandle(pi.hThread);
+    CloseHandle(pi.hProcess);
+    std::string output = readFile(outputPath);
+    DeleteFileW(outputPath.c_str());
+
+    if (exitCode != STILL_ACTIVE) {
+        result.error = "WinHKMon exited early with code " + std::to_string(exitCode);
+    }
+    std::string window = output.size() > jsonAtStart ? output.substr(jsonAtStart) : std::string();
+    size_t samples = countJsonSamples(window);
+    if (result.error.empty() && (frames.size() < 2 || samples == 0)) {
+        result.error = "No samples produced in the measurement window";
+    }
+    if (!result.error.empty()) {
+        result.pass = false;
+        return result;
+    }
+
+    result.pullBytesPerSec = static_cast<double>(pullBytes) / wallSeconds;
+    result.jsonBytesPerSec = static_cast<double>(window.size()) / wallSeconds;
+    result.bytesSavedPercent = 100.0 * (1.0 - result.pullBytesPerSec / result.jsonBytesPerSec);
+
+    // Re-encode the pulled frames as the agent would have sent them
+    std::vector<std::string> messages;
+    {
+        WinHKMon::FrameRing ring(2);
+        WinHKMon::SnapshotDecoder shadow;
+        for (const WinHKMon::SnapshotFrame& frame : frames) {
+            ring.push(frame);
+            std::string message;
+            WinHKMon::encodeSnapshotResponse(ring, 1, shadow.epoch(), shadow.lastSequence(), message);
+            message.erase(0, 4);  // Length prefix is consumed by the transport
+            shadow.apply(message.data(), message.size());
+            messages.push_back(message);
+        }
+    }
+    double checksum = 0.0;
+    double decodeStart = nowSeconds();
+    for (int round = 0; round < PULL_REPLAY_ROUNDS; round++) {
+        WinHKMon::SnapshotDecoder decoder;
+        for (const std::string& message : messages) {
+            decoder.apply(message.data(), message.size());
+        }
+        checksum += decoder.frame().values[0];
+    }
+    result.decodeNsPerPull = (nowSeconds() - decodeStart) * 1.0e9 /
+                             static_cast<double>(PULL_REPLAY_ROUNDS * messages.size());
+
+    double parseStart = nowSeconds();
+    for (int round = 0; round < PULL_REPLAY_ROUNDS; round++) {
+        checksum += parseJsonNumbers(window);
+    }
+    result.jsonParseNsPerSample = (nowSeconds() - parseStart) * 1.0e9 /
+                                  static_cast<double>(PULL_REPLAY_ROUNDS * samples);
+    result.cpuSavedPercent = 100.0 * (1.0 - result.decodeNsPerPull / result.jsonParseNsPerSample);
+
+    volatile double sink = checksum;  // Keep the timed loops from being optimized away
+    (void)sink;
+    result.ok = true;
+    return result;
+}
+
+std::vector<BenchConfig> buildConfigs() {
+    std::vector<BenchConfig> configs;
+
+    // Each metric alone at the default interval
+    for (const char* metric : {"CPU", "RAM", "DISK", "IO", "NET"}) {
+        configs.push_back({std::string(metric) + "_i1",
+                           {metric, "-c", "-i", "1", "-f", "csv"}, BenchKind::CONTINUOUS, 1.0});
+    }
+
+    // All metrics at fast, default and slow intervals
+    for (const char* interval : {"0.1", "1", "5"}) {
+        configs.push_back({std::string("ALL_i") + interval,
+                           {"CPU", "RAM", "DISK", "IO", "NET", "-c", "-i", interval, "-f", "csv"},
+                           BenchKind::CONTINUOUS, std::stod(interval)});
+    }
+
+    // High-rate mode at 1 kHz (profiling short benchmarks)
+    configs.push_back({"highrate_CPU_NET_i0.001",
+                       {"CPU", "NET", "-c", "-i", "0.001", "--high-rate", "-f", "ndjson"},
+                       BenchKind::CONTINUOUS, 0.001});
+
+    // Single-shot loops (status-bar usage); --version is the process start baseline
+    configs.push_back({"single_version", {"--version"}, BenchKind::SINGLE_SHOT, 0.0});
+    configs.push_back({"single_CPU_RAM_LINE", {"CPU", "RAM", "LINE"}, BenchKind::SINGLE_SHOT, 0.0});
+    configs.push_back({"single_RAM_LINE", {"RAM", "LINE"}, BenchKind::SINGLE_SHOT, 0.0});
+
+    // Co-located latency probe: baseline, default mode, --low-impact
+    configs.push_back({"jitter_baseline", {}, BenchKind::JITTER, 0.0});
+    configs.push_back({"jitter_ALL_i0.1",
+                       {"CPU", "RAM", "DISK", "IO", "NET", "-c", "-i", "0.1", "-f", "csv"},
+                       BenchKind::JITTER, 0.1});
+    configs.push_back({"jitter_ALL_i0.1_low_impact",
+                       {"CPU", "RAM", "DISK", "IO", "NET", "-c", "-i", "0.1", "-f", "csv",
+                        "--low-impact", "--cpu-set", "0"},
+                       BenchKind::JITTER, 0.1});
+
+    // Remote consumer at 10 Hz: delta pulls versus the JSON stream
+    configs.push_back({"pull_ALL_i0.1",
+                       {"CPU", "RAM", "DISK", "IO", "NET", "-c", "-i", "0.1", "-f", "json"},
+                       BenchKind::PULL, 0.1});
+
+    return configs;
+}
+
+std::string toJson(const std::vector<BenchResult>& results, unsigned logicalCpus, bool allPass) {
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+    json << "{\n";
+    json << "  \"schemaVersion\": \"1.0\",\n";
+    json << "  \"logicalCpus\": " << logicalCpus << ",\n";
+    json << "  \"targets\": {\"cpuPercentSystem\": " << NFR_CPU_PERCENT
+         << ", \"steadyRssBytes\": " << NFR_RSS_BYTES
+         << ", \"stateBytesPerSec\": " << NFR_DISK_BYTES_PER_SEC
+         << ", \"singleShotMedianMs\": " << NFR_STARTUP_MS << "},\n";
+    json << "  \"pass\": " << (allPass ? "true" : "false") << ",\n";
+    json << "  \"results\": [\n";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        json << "    {\n";
+        json << "      \"name\": \"" << r.config.name << "\",\n";
+        json << "      \"args\": \"";
+        for (size_t a = 0; a < r.config.args.size(); a++) {
+            json << (a > 0 ? " " : "") << r.config.args[a];
+        }
+        json << "\",\n";
+        const char* mode = r.config.kind == BenchKind::CONTINUOUS ? "continuous"
+                         : r.config.kind == BenchKind::SINGLE_SHOT ? "single-shot"
+                         : r.config.kind == BenchKind::PULL ? "pull" : "jitter";
+        json << "      \"mode\": \"" << mode << "\",\n";
+        if (!r.ok) {
+            json << "      \"error\": \"" << r.error << "\",\n";
+        } else if (r.config.kind == BenchKind::JITTER) {
+            json << "      \"probeWakeups\": " << r.probeWakeups << ",\n";
+            json << "      \"jitterP50Us\": " << r.jitterP50Us << ",\n";
+            json << "      \"jitterP99Us\": " << r.jitterP99Us << ",\n";
+            json << "      \"jitterMaxUs\": " << r.jitterMaxUs << ",\n";
+            json << "      \"addedP99Us\": " << r.addedP99Us << ",\n";
+        } else if (r.config.kind == BenchKind::PULL) {
+            json << "      \"pulls\": " << r.pulls << ",\n";
+            json << "      \"keyframes\": " << r.keyframes << ",\n";
+            json << "      \"pullBytesPerSec\": " << r.pullBytesPerSec << ",\n";
+            json << "      \"jsonBytesPerSec\": " << r.jsonBytesPerSec << ",\n";
+            json << "      \"bytesSavedPercent\": " << r.bytesSavedPercent << ",\n";
+            json << "      \"decodeNsPerPull\": " << r.decodeNsPerPull << ",\n";
+            json << "      \"jsonParseNsPerSample\": " << r.jsonParseNsPerSample << ",\n";
+            json << "      \"cpuSavedPercent\": " << r.cpuSavedPercent << ",\n";
+        } else if (r.config.kind == BenchKind::CONTINUOUS) {
+            json << "      \"wallSeconds\": " << r.wallSeconds << ",\n";
+            json << "      \"ticks\": " << r.ticks << ",\n";
+            json << "      \"achievedHz\": " << r.achievedHz << ",\n";
+            json << "      \"cpuPercentOneCore\": " << r.cpuPercentOneCore << ",\n";
+            json << "      \"cpuPercentSystem\": " << r.cpuPercentSystem << ",\n";
+            json << "      \"peakRssBytes\": " << r.peakRssBytes << ",\n";
+            json << "      \"steadyRssBytes\": " << r.steadyRssBytes << ",\n";
+            json << "      \"contextSwitchesPerTick\": " << r.contextSwitchesPerTick << ",\n";
+            json << "      \"pageFaultsPerTick\": " << r.pageFaultsPerTick << ",\n";
+            json << "      \"ioOperationsPerTick\": " << r.ioOperationsPerTick << ",\n";
+            json << "      \"stateBytesPerSec\": " << r.stateBytesPerSec << ",\n";
+        } else {
+            std::vector<double> sorted = r.wallMs;
+            std::sort(sorted.begin(), sorted.end());
+            json << "      \"runs\": " << sorted.size() << ",\n";
+            json << "      \"wallMsMin\": " << sorted.front() << ",\n";
+            json << "      \"wallMsMedian\": " << median(sorted) << ",\n";
+            json << "      \"wallMsMax\": " << sorted.back() << ",\n";
+            json << "      \"overBaselineMs\": " << r.overBaselineMs << ",\n";
+            json << "      \"peakRssBytes\": " << r.peakRssBytes << ",\n";
+        }
+        json << "      \"pass\": " << (r.pass ? "true" : "false") << "\n";
+        json << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+
+    json << "  ]\n";
+    json << "}\n";
+    return json.str();
+}
+
+std::wstring defaultExePath() {
+    wchar_t path[MAX_PATH];
+    GetModuleFileNameW(nullptr, path, MAX_PATH);
+    std::wstring dir(path);
+    size_t slash = dir.find_last_of(L"\\/");
+    dir = (slash == std::wstring::npos) ? L"" : dir.substr(0, slash + 1);
+    return dir + L"WinHKMon.exe";
+}
+
+std::string helpMessage() {
+    return R"(WinHKMonBench - WinHKMon overhead and footprint benchmark
+
+USAGE:
+  WinHKMonBench [OPTIONS...]
+
+OPTIONS:
+  --exe <path>        WinHKMon executable (default: next to WinHKMonBench.exe)
+  --duration <sec>    Measurement window per continuous/jitter scenario (default: 30)
+  --runs <n>          Runs per single-shot scenario (default: 20)
+  --only <name>       Run only scenarios whose name contains <name>
+  --output <file>     Write JSON report to file (default: stdout)
+  --help, -h          Show this help
+
+JITTER SCENARIOS:
+  A 1 ms periodic timer thread (highest priority, pinned to the last CPU)
+  measures wake-up lateness alone, next to WinHKMon, and next to WinHKMon
+  with --low-impact --cpu-set 0. addedP99Us is relative to the probe alone.
+  Jitter is informational and does not affect the exit code.
+
+PULL SCENARIOS:
+  WinHKMon samples at 10 Hz with JSON output and --serve on loopback while
+  the harness pulls delta snapshots every 100 ms. bytesSavedPercent compares
+  pull responses with the JSON written in the same window; cpuSavedPercent
+  compares decoding a pull with converting the numbers of one JSON sample.
+  Pull results are informational and do not affect the exit code.
+
+EXIT CODES:
+  0  All scenarios meet NFR-1 targets
+  1  At least one scenario failed a target
+  2  Harness error
+)";
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        std::wstring exePath = defaultExePath();
+        double durationSeconds = 30.0;
+        int runs = 20;
+        std::string only;
+        std::string outputPath;
+
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h") {
+                std::cout << helpMessage();
+                return 0;
+            } else if (arg == "--exe" && i + 1 < argc) {
+                exePath = toWide(argv[++i]);
+            } else if (arg == "--duration" && i + 1 < argc) {
+                durationSeconds = std::stod(argv[++i]);
+            } else if (arg == "--runs" && i + 1 < argc) {
+                runs = std::stoi(argv[++i]);
+            } else if (arg == "--only" && i + 1 < argc) {
+                only = argv[++i];
+            } else if (arg == "--output" && i + 1 < argc) {
+                outputPath = argv[++i];
+            } else {
+                throw std::invalid_argument("Invalid argument '" + arg + "'. Use --help for usage.");
+            }
+        }
+
+        if (GetFileAttributesW(exePath.c_str()) == INVALID_FILE_ATTRIBUTES) {
+            throw std::runtime_error("WinHKMon executable not found (use --exe)");
+        }
+
+        SYSTEM_INFO sysInfo;
+        GetSystemInfo(&sysInfo);
+        unsigned logicalCpus = sysInfo.dwNumberOfProcessors;
+
+        std::vector<BenchResult> results;
+        bool allPass = true;
+        for (const BenchConfig& config : buildConfigs()) {
+            if (!only.empty() && config.name.find(only) == std::string::npos) {
+                continue;
+            }
+            std::cerr << "[bench] " << config.name << "..." << std::endl;
+            BenchResult result;
+            if (config.kind == BenchKind::CONTINUOUS) {
+                result = runContinuous(config, exePath, durationSeconds, logicalCpus);
+            } else if (config.kind == BenchKind::SINGLE_SHOT) {
+                result = runSingleShotLoop(config, exePath, runs);
+            } else if (config.kind == BenchKind::PULL) {
+                result = runPull(config, exePath, durationSeconds);
+            } else {
+                result = runJitter(config, exePath, durationSeconds, logicalCpus);
+            }
+            allPass = allPass && result.pass;
+            results.push_back(result);
+        }
+
+        // Jitter is reported relative to the probe running alone
+        auto baseline = std::find_if(results.begin(), results.end(), [](const BenchResult& r) {
+            return r.config.kind == BenchKind::JITTER && r.config.args.empty() && r.ok;
+        });
+        if (baseline != results.end()) {
+            for (BenchResult& r : results) {
+                if (r.config.kind == BenchKind::JITTER && r.ok) {
+                    r.addedP99Us = r.jitterP99Us - baseline->jitterP99Us;
+                }
+            }
+        }
+
+        // Startup cost is reported above a run that only starts and exits
+        auto startBaseline = std::find_if(results.begin(), results.end(), [](const BenchResult& r) {
+            return r.config.name == "single_version" && r.ok;
+        });
+        if (startBaseline != results.end()) {
+            for (BenchResult& r : results) {
+                if (r.config.kind == BenchKind::SINGLE_SHOT && r.ok) {
+                    r.overBaselineMs = median(r.wallMs) - median(startBaseline->wallMs);
+                }
+            }
+        }
+
+        std::string report = toJson(results, logicalCpus, allPass);
+        if (outputPath.empty()) {
+            std::cout << report;
+        } else {
+            std::ofstream file(outputPath, std::ios::trunc);
+            file << report;
+            if (!file.good()) {
+                throw std::runtime_error("Failed to write report to " + outputPath);
+            }
+        }
+
+        return allPass ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+        return 2;
+    }
+}
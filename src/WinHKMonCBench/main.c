@@ -0,0 +1,100 @@
+/**
+ * @file main.c
+ * @brief WinHKMonCBench - per-call overhead of the C API
+ *
+ * Measures, from a plain C caller:
+ * - whk_engine_sample() for memory only (collection + C API)
+ * - whk_engine_last_frame() (C API + frame encoding, no collection), which is
+ *   the overhead the C ABI adds on top of collecting
+ *
+ * Exit code 0 if the per-call overhead is below 1 microsecond, 1 otherwise,
+ * 2 on setup failure.
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L  /* clock_gettime */
+#endif
+
+#include "WinHKMonLib/WinHKMonC.h"
+#include <stdio.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define SAMPLE_ITERATIONS 2000
+#define FRAME_ITERATIONS 1000000
+#define OVERHEAD_TARGET_NS 1000.0
+
+typedef union FrameBuffer {
+    whk_frame frame;
+    unsigned char bytes[WHK_FRAME_BYTES(256)];
+} FrameBuffer;
+
+static double nowNs(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1.0e9 / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1.0e9 + (double)now.tv_nsec;
+#endif
+}
+
+int main(void) {
+    whk_engine* engine = NULL;
+    FrameBuffer buffer;
+    whk_status status;
+    double begin;
+    double sampleNs;
+    double frameNs;
+    double checksum = 0.0;
+    int i;
+
+    status = whk_engine_create(&engine);
+    if (status != WHK_OK) {
+        printf("whk_engine_create failed: %s\n", whk_status_string(status));
+        return 2;
+    }
+
+    /* Warm-up: start monitors and fault in code paths */
+    whk_engine_sample(engine, WHK_FIELD_CPU | WHK_FIELD_MEMORY, &buffer.frame, sizeof(buffer));
+
+    begin = nowNs();
+    for (i = 0; i < SAMPLE_ITERATIONS; i++) {
+        whk_engine_sample(engine, WHK_FIELD_MEMORY, &buffer.frame, sizeof(buffer));
+        checksum += buffer.frame.values[WHK_SLOT_MEM_USAGE_PERCENT];
+    }
+    sampleNs = (nowNs() - begin) / SAMPLE_ITERATIONS;
+
+    /* Re-encode a frame carrying CPU per-core data (worst case for encoding) */
+    whk_engine_sample(engine, WHK_FIELD_CPU | WHK_FIELD_MEMORY, &buffer.frame, sizeof(buffer));
+    begin = nowNs();
+    for (i = 0; i < FRAME_ITERATIONS; i++) {
+        whk_engine_last_frame(engine, &buffer.frame, sizeof(buffer));
+        checksum += whk_frame_get_double(&buffer.frame, WHK_SLOT_CPU_TOTAL_PERCENT);
+    }
+    frameNs = (nowNs() - begin) / FRAME_ITERATIONS;
+
+    whk_engine_destroy(engine);
+
+    printf("{\n");
+    printf("  \"abiVersion\": %u,\n", whk_abi_version());
+    printf("  \"frameBytes\": %u,\n", (unsigned)sizeof(buffer));
+    printf("  \"cores\": %u,\n", buffer.frame.core_count);
+    printf("  \"sampleMemoryNsPerCall\": %.1f,\n", sampleNs);
+    printf("  \"apiOverheadNsPerCall\": %.1f,\n", frameNs);
+    printf("  \"apiOverheadTargetNs\": %.1f,\n", OVERHEAD_TARGET_NS);
+    printf("  \"pass\": %s,\n", frameNs < OVERHEAD_TARGET_NS ? "true" : "false");
+    printf("  \"checksum\": %.1f\n", checksum);
+    printf("}\n");
+
+    return frameNs < OVERHEAD_TARGET_NS ? 0 : 1;
+}
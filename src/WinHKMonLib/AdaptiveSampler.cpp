@@ -0,0 +1,85 @@
+#include "WinHKMonLib/AdaptiveSampler.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace WinHKMon {
+
+AdaptiveSampler::AdaptiveSampler(double minIntervalSeconds, double maxIntervalSeconds,
+                                 double sensitivity, double initialIntervalSeconds)
+    : minInterval_(minIntervalSeconds)
+    , maxInterval_(maxIntervalSeconds)
+    , sensitivity_(sensitivity)
+    , interval_(0.0)
+    , lastScore_(0.0) {
+    if (minIntervalSeconds <= 0.0 || maxIntervalSeconds < minIntervalSeconds) {
+        throw std::invalid_argument("Adaptive interval bounds must satisfy 0 < min <= max");
+    }
+    if (sensitivity <= 0.0) {
+        throw std::invalid_argument("Adaptive sensitivity must be greater than 0");
+    }
+    interval_ = std::clamp(initialIntervalSeconds, minInterval_, maxInterval_);
+}
+
+double AdaptiveSampler::scoreSignal(const std::string& key, double value, double floor) {
+    auto it = ewma_.find(key);
+    if (it == ewma_.end()) {
+        // New signal (first sample or new interface/disk) - seed only
+        ewma_[key] = value;
+        return 0.0;
+    }
+
+    double score = std::fabs(value - it->second) / std::max(it->second, floor);
+    it->second = EWMA_ALPHA * value + (1.0 - EWMA_ALPHA) * it->second;
+    return score;
+}
+
+double AdaptiveSampler::update(const SystemMetrics& metrics) {
+    bool firstSample = ewma_.empty();
+    double score = 0.0;
+
+    if (metrics.cpu) {
+        score = std::max(score, scoreSignal("cpu", metrics.cpu->totalUsagePercent,
+                                            CPU_FLOOR_PERCENT));
+    }
+
+    if (metrics.network) {
+        for (const auto& iface : *metrics.network) {
+            score = std::max(score, scoreSignal("net:" + iface.name + ":in",
+                                                static_cast<double>(iface.inBytesPerSec),
+                                                RATE_FLOOR_BYTES));
+            score = std::max(score, scoreSignal("net:" + iface.name + ":out",
+                                                static_cast<double>(iface.outBytesPerSec),
+                                                RATE_FLOOR_BYTES));
+        }
+    }
+
+    if (metrics.disks) {
+        for (const auto& disk : *metrics.disks) {
+            score = std::max(score, scoreSignal("disk:" + disk.deviceName + ":read",
+                                                static_cast<double>(disk.bytesReadPerSec),
+                                                RATE_FLOOR_BYTES));
+            score = std::max(score, scoreSignal("disk:" + disk.deviceName + ":write",
+                                                static_cast<double>(disk.bytesWrittenPerSec),
+                                                RATE_FLOOR_BYTES));
+        }
+    }
+
+    lastScore_ = score;
+
+    // Nothing to compare against yet - keep the starting interval
+    if (firstSample) {
+        return interval_;
+    }
+
+    if (score > sensitivity_) {
+        interval_ *= SHRINK_FACTOR;
+    } else {
+        interval_ *= GROW_FACTOR;
+    }
+    interval_ = std::clamp(interval_, minInterval_, maxInterval_);
+
+    return interval_;
+}
+
+}  // namespace WinHKMon
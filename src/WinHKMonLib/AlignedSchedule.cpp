@@ -0,0 +1,48 @@
+#include "WinHKMonLib/AlignedSchedule.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace WinHKMon {
+
+AlignedSchedule::AlignedSchedule(double intervalSeconds)
+    : intervalMs_(0)
+    , stepThresholdMs_(MIN_STEP_THRESHOLD_MS)
+    , anchored_(false)
+    , wallMinusSteady_(0)
+    , lastNominal_(0)
+    , clockSteps_(0) {
+    double intervalMs = std::round(intervalSeconds * 1000.0);
+    if (!(intervalMs >= 1.0)) {
+        throw std::invalid_argument("Aligned interval must be at least 1 ms");
+    }
+    intervalMs_ = static_cast<uint64_t>(intervalMs);
+    stepThresholdMs_ = std::max(MIN_STEP_THRESHOLD_MS, static_cast<int64_t>(intervalMs_ / 1000));
+}
+
+AlignedTick AlignedSchedule::next(int64_t steadyNowMs, uint64_t wallNowMs) {
+    bool stepped = clockStepped(steadyNowMs, wallNowMs);
+    if (stepped) {
+        clockSteps_++;
+    }
+    wallMinusSteady_ = static_cast<int64_t>(wallNowMs) - steadyNowMs;
+
+    uint64_t nominal = (wallNowMs / intervalMs_ + 1) * intervalMs_;
+    if (anchored_ && !stepped && nominal <= lastNominal_) {
+        nominal = lastNominal_ + intervalMs_;  // Woke a little early; do not repeat the tick
+    }
+    anchored_ = true;
+    lastNominal_ = nominal;
+    return AlignedTick{nominal, static_cast<int64_t>(nominal) - wallMinusSteady_};
+}
+
+bool AlignedSchedule::clockStepped(int64_t steadyNowMs, uint64_t wallNowMs) const {
+    if (!anchored_) {
+        return false;
+    }
+    int64_t difference = static_cast<int64_t>(wallNowMs) - steadyNowMs;
+    return std::llabs(difference - wallMinusSteady_) > stepThresholdMs_;
+}
+
+}  // namespace WinHKMon
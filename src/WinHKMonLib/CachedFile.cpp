@@ -0,0 +1,64 @@
+#include "WinHKMonLib/CachedFile.h"
+#include <utility>
+
+namespace WinHKMon {
+
+namespace {
+
+constexpr size_t READ_CHUNK_BYTES = 4096;
+
+}  // anonymous namespace
+
+CachedFile::CachedFile(std::string path)
+    : path_(std::move(path))
+    , file_(nullptr) {
+}
+
+CachedFile::~CachedFile() {
+    close();
+}
+
+void CachedFile::close() {
+    if (file_ != nullptr) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+bool CachedFile::read(std::string& contents) {
+    if (file_ == nullptr) {
+#ifdef _WIN32
+        if (fopen_s(&file_, path_.c_str(), "rb") != 0) {
+            file_ = nullptr;
+        }
+#else
+        file_ = std::fopen(path_.c_str(), "rb");
+#endif
+        if (file_ == nullptr) {
+            return false;
+        }
+        // Unbuffered: each read goes to the kernel, so nothing stale is served
+        std::setvbuf(file_, nullptr, _IONBF, 0);
+    } else if (std::fseek(file_, 0, SEEK_SET) != 0) {
+        close();
+        return false;
+    }
+
+    contents.clear();
+    char chunk[READ_CHUNK_BYTES];
+    for (;;) {
+        size_t got = std::fread(chunk, 1, sizeof(chunk), file_);
+        contents.append(chunk, got);
+        if (got < sizeof(chunk)) {
+            break;
+        }
+    }
+    if (std::ferror(file_)) {
+        close();
+        return false;
+    }
+    std::clearerr(file_);  // Clear EOF for the next read
+    return true;
+}
+
+}  // namespace WinHKMon
@@ -0,0 +1,444 @@
+#include "WinHKMonLib/CgroupMonitor.h"
+#include "WinHKMonLib/CachedFile.h"
+#include "WinHKMonLib/Tracer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace WinHKMon {
+
+namespace {
+
+constexpr size_t FILES_PER_GROUP = 7;
+constexpr size_t RESERVED_DESCRIPTORS = 256;   ///< Left for sinks, sockets and other collectors
+
+// Value of "key <number>" lines (cpu.stat, memory.events); 0 if absent
+uint64_t keyedValue(const std::string& text, const char* key) {
+    size_t keyLength = std::strlen(key);
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        if (text.compare(pos, keyLength, key) == 0 && pos + keyLength < end &&
+            text[pos + keyLength] == ' ') {
+            return std::strtoull(text.c_str() + pos + keyLength + 1, nullptr, 10);
+        }
+        pos = end + 1;
+    }
+    return 0;
+}
+
+// Value of "name=<number>" within one line
+const char* fieldValue(const std::string& line, const char* name) {
+    std::string needle = std::string(name) + "=";
+    size_t pos = line.find(needle);
+    return pos == std::string::npos ? nullptr : line.c_str() + pos + needle.size();
+}
+
+// "some avg10=1.50 avg60=... total=N" / "full avg10=..."
+PressureStats parsePressure(const std::string& text) {
+    PressureStats pressure{0.0, 0.0, 0};
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string line = text.substr(pos, end - pos);
+        const char* avg10 = fieldValue(line, "avg10");
+        if (line.compare(0, 5, "some ") == 0) {
+            pressure.someAvg10 = avg10 ? std::strtod(avg10, nullptr) : 0.0;
+            const char* total = fieldValue(line, "total");
+            pressure.someTotalUsec = total ? std::strtoull(total, nullptr, 10) : 0;
+        } else if (line.compare(0, 5, "full ") == 0) {
+            pressure.fullAvg10 = avg10 ? std::strtod(avg10, nullptr) : 0.0;
+        }
+        pos = end + 1;
+    }
+    return pressure;
+}
+
+struct IoCounters {
+    uint64_t readBytes = 0;
+    uint64_t writeBytes = 0;
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+};
+
+// "8:0 rbytes=1 wbytes=2 rios=3 wios=4 dbytes=0 dios=0" per device
+std::map<std::string, IoCounters> parseIoStat(const std::string& text) {
+    std::map<std::string, IoCounters> devices;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string line = text.substr(pos, end - pos);
+        size_t space = line.find(' ');
+        if (space != std::string::npos && space > 0) {
+            IoCounters& counters = devices[line.substr(0, space)];
+            const char* value = nullptr;
+            if ((value = fieldValue(line, "rbytes")) != nullptr) {
+                counters.readBytes = std::strtoull(value, nullptr, 10);
+            }
+            if ((value = fieldValue(line, "wbytes")) != nullptr) {
+                counters.writeBytes = std::strtoull(value, nullptr, 10);
+            }
+            if ((value = fieldValue(line, "rios")) != nullptr) {
+                counters.reads = std::strtoull(value, nullptr, 10);
+            }
+            if ((value = fieldValue(line, "wios")) != nullptr) {
+                counters.writes = std::strtoull(value, nullptr, 10);
+            }
+        }
+        pos = end + 1;
+    }
+    return devices;
+}
+
+// Per-second rate of a counter; a counter that went backwards (group recreated) gives 0
+uint64_t rate(uint64_t current, uint64_t previous, double elapsedSeconds) {
+    if (elapsedSeconds <= 0.0 || current < previous) {
+        return 0;
+    }
+    return static_cast<uint64_t>(static_cast<double>(current - previous) / elapsedSeconds);
+}
+
+double percentOfTime(uint64_t currentUsec, uint64_t previousUsec, double elapsedSeconds) {
+    if (elapsedSeconds <= 0.0 || currentUsec < previousUsec) {
+        return 0.0;
+    }
+    return static_cast<double>(currentUsec - previousUsec) / (elapsedSeconds * 1e6) * 100.0;
+}
+
+// Groups whose files fit under the open-file soft limit, next to the rest of the process
+size_t descriptorGroupLimit() {
+#ifdef __linux__
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+        rlim_t spare = limit.rlim_cur > RESERVED_DESCRIPTORS ? limit.rlim_cur - RESERVED_DESCRIPTORS : 0;
+        return std::min(CGROUP_MAX_GROUPS, static_cast<size_t>(spare / FILES_PER_GROUP));
+    }
+#endif
+    return CGROUP_MAX_GROUPS;
+}
+
+}  // anonymous namespace
+
+bool matchCgroupGlob(const std::string& pattern, const std::string& path) {
+    // Iterative wildcard match with backtracking to the last '*'
+    size_t p = 0;
+    size_t s = 0;
+    size_t starP = std::string::npos;
+    size_t starS = 0;
+    while (s < path.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == path[s])) {
+            p++;
+            s++;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            starP = p++;
+            starS = s;
+        } else if (starP != std::string::npos) {
+            p = starP + 1;
+            s = ++starS;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        p++;
+    }
+    return p == pattern.size();
+}
+
+/**
+ * @brief One tracked group: its open files and the previous counters
+ */
+struct CgroupMonitor::Group {
+    explicit Group(const std::string& rootPath, const std::string& relative)
+        : path(relative) {
+        // Only controllers enabled for this group have files; probe once
+        auto open = [&rootPath, &relative](const char* name) -> std::unique_ptr<CachedFile> {
+            std::string file = rootPath + "/" + relative + "/" + name;
+            std::error_code error;
+            if (!fs::exists(file, error)) {
+                return nullptr;
+            }
+            return std::make_unique<CachedFile>(file);
+        };
+        cpuStat = open("cpu.stat");
+        memoryCurrent = open("memory.current");
+        memoryEvents = open("memory.events");
+        ioStat = open("io.stat");
+        cpuPressure = open("cpu.pressure");
+        memoryPressure = open("memory.pressure");
+        ioPressure = open("io.pressure");
+    }
+
+    /**
+     * @brief Read every file of the group into stats
+     *
+     * @return REMOVED if the group is gone, UNREADABLE if its cpu.stat exists
+     *         but cannot be opened (out of descriptors)
+     */
+    ReadResult sample(std::chrono::steady_clock::time_point now, CgroupStats& stats) {
+        stats = CgroupStats{};
+        stats.path = path;
+        double elapsedSeconds = primed ? std::chrono::duration<double>(now - lastSample).count() : 0.0;
+
+        // cpu.stat exists in every cgroup v2 group; reads of a removed group fail with ENODEV
+        if (!cpuStat->read(buffer)) {
+            std::error_code error;
+            return fs::exists(cpuStat->path(), error) ? ReadResult::UNREADABLE : ReadResult::REMOVED;
+        }
+        uint64_t usageUsec = keyedValue(buffer, "usage_usec");
+        uint64_t nrThrottled = keyedValue(buffer, "nr_throttled");
+        uint64_t throttledUsec = keyedValue(buffer, "throttled_usec");
+        stats.cpuPercent = percentOfTime(usageUsec, previousUsageUsec, elapsedSeconds);
+        stats.throttledPercent = percentOfTime(throttledUsec, previousThrottledUsec, elapsedSeconds);
+        stats.throttledPeriodsPerSec = rate(nrThrottled, previousNrThrottled, elapsedSeconds);
+        stats.totalThrottledPeriods = nrThrottled;
+
+        if (memoryCurrent && memoryCurrent->read(buffer)) {
+            stats.memoryCurrentBytes = std::strtoull(buffer.c_str(), nullptr, 10);
+        }
+        if (memoryEvents && memoryEvents->read(buffer)) {
+            stats.memoryHighEvents = keyedValue(buffer, "high");
+            stats.memoryMaxEvents = keyedValue(buffer, "max");
+            stats.oomEvents = keyedValue(buffer, "oom");
+            stats.oomKillEvents = keyedValue(buffer, "oom_kill");
+        }
+
+        std::map<std::string, IoCounters> devices;
+        if (ioStat && ioStat->read(buffer)) {
+            devices = parseIoStat(buffer);
+        }
+        for (const auto& [device, counters] : devices) {
+            auto previous = previousIo.find(device);
+            IoCounters before = previous != previousIo.end() ? previous->second : counters;
+            CgroupIoStats io;
+            io.device = device;
+            io.readBytesPerSec = rate(counters.readBytes, before.readBytes, elapsedSeconds);
+            io.writeBytesPerSec = rate(counters.writeBytes, before.writeBytes, elapsedSeconds);
+            io.readsPerSec = rate(counters.reads, before.reads, elapsedSeconds);
+            io.writesPerSec = rate(counters.writes, before.writes, elapsedSeconds);
+            stats.io.push_back(io);
+        }
+
+        if (cpuPressure && cpuPressure->read(buffer)) {
+            stats.cpuPressure = parsePressure(buffer);
+        }
+        if (memoryPressure && memoryPressure->read(buffer)) {
+            stats.memoryPressure = parsePressure(buffer);
+        }
+        if (ioPressure && ioPressure->read(buffer)) {
+            stats.ioPressure = parsePressure(buffer);
+        }
+
+        previousUsageUsec = usageUsec;
+        previousNrThrottled = nrThrottled;
+        previousThrottledUsec = throttledUsec;
+        previousIo = std::move(devices);
+        lastSample = now;
+        primed = true;
+        return ReadResult::OK;
+    }
+
+    std::string path;
+    std::unique_ptr<CachedFile> cpuStat;
+    std::unique_ptr<CachedFile> memoryCurrent;
+    std::unique_ptr<CachedFile> memoryEvents;
+    std::unique_ptr<CachedFile> ioStat;
+    std::unique_ptr<CachedFile> cpuPressure;
+    std::unique_ptr<CachedFile> memoryPressure;
+    std::unique_ptr<CachedFile> ioPressure;
+    std::string buffer;   ///< Read buffer reused across files and samples
+
+    bool primed = false;
+    std::chrono::steady_clock::time_point lastSample;
+    uint64_t previousUsageUsec = 0;
+    uint64_t previousNrThrottled = 0;
+    uint64_t previousThrottledUsec = 0;
+    std::map<std::string, IoCounters> previousIo;
+    bool seen = false;    ///< Found by the current discovery walk
+};
+
+CgroupMonitor::CgroupMonitor(std::string root, std::string filter, std::chrono::milliseconds rescanInterval,
+                             size_t maxGroups)
+    : root_(std::move(root))
+    , filter_(std::move(filter))
+    , rescanInterval_(rescanInterval)
+    , rescanDue_(true)
+    , maxGroups_(maxGroups > 0 ? maxGroups : descriptorGroupLimit())
+    , untracked_(0)
+    , workers_(1)
+    , tickNumber_(0)
+    , readersBusy_(0)
+    , readersStopping_(false) {
+    while (root_.size() > 1 && (root_.back() == '/' || root_.back() == '\\')) {
+        root_.pop_back();
+    }
+}
+
+CgroupMonitor::~CgroupMonitor() {
+    {
+        std::lock_guard<std::mutex> lock(readersMutex_);
+        readersStopping_ = true;
+    }
+    readersChanged_.notify_all();
+    for (std::thread& reader : readers_) {
+        reader.join();
+    }
+}
+
+void CgroupMonitor::initialize() {
+    std::error_code error;
+    if (!fs::exists(root_ + "/cgroup.controllers", error)) {
+        throw std::runtime_error("'" + root_ + "' is not a cgroup v2 hierarchy (no cgroup.controllers)");
+    }
+    getCurrentStats();
+}
+
+void CgroupMonitor::discover(std::chrono::steady_clock::time_point now) {
+    WINHKMON_TRACE_SPAN("collect", "cgroup-discover");
+    for (auto& entry : groups_) {
+        entry.second->seen = false;
+    }
+
+    untracked_ = 0;
+    std::error_code error;
+    fs::recursive_directory_iterator it(root_, fs::directory_options::skip_permission_denied, error);
+    for (; !error && it != fs::recursive_directory_iterator(); it.increment(error)) {
+        if (!it->is_directory(error)) {
+            continue;
+        }
+        std::string relative = it->path().lexically_relative(root_).generic_string();
+        if (!matchCgroupGlob(filter_, relative)) {
+            continue;
+        }
+        auto known = groups_.find(relative);
+        if (known == groups_.end()) {
+            if (groups_.size() >= maxGroups_) {
+                untracked_++;   // Known groups keep their place; counted, not opened
+                continue;
+            }
+            auto group = std::make_unique<Group>(root_, relative);
+            if (!group->cpuStat) {
+                continue;   // Not a cgroup directory
+            }
+            known = groups_.emplace(relative, std::move(group)).first;
+        }
+        known->second->seen = true;
+    }
+
+    for (auto entry = groups_.begin(); entry != groups_.end();) {
+        entry = entry->second->seen ? std::next(entry) : groups_.erase(entry);
+    }
+    lastScan_ = now;
+    rescanDue_ = false;
+}
+
+std::vector<CgroupStats> CgroupMonitor::getCurrentStats() {
+    return getCurrentStats(std::chrono::steady_clock::now());
+}
+
+std::vector<CgroupStats> CgroupMonitor::getCurrentStats(std::chrono::steady_clock::time_point now) {
+    if (rescanDue_ || now - lastScan_ >= rescanInterval_) {
+        discover(now);
+    }
+
+    tickGroups_.clear();
+    for (auto& entry : groups_) {
+        tickGroups_.push_back(entry.second.get());
+    }
+    tickStats_.resize(tickGroups_.size());
+    tickResults_.assign(tickGroups_.size(), ReadResult::REMOVED);
+    tickNow_ = now;
+
+    // Readers start once there are enough groups and then stay for later ticks
+    if (readers_.empty() && tickGroups_.size() >= CGROUP_PARALLEL_MIN_GROUPS) {
+        workers_ = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, CGROUP_MAX_WORKERS);
+        for (size_t index = 1; index < workers_; index++) {
+            readers_.emplace_back(&CgroupMonitor::runReader, this, index);
+        }
+    }
+    {
+        WINHKMON_TRACE_SPAN("collect", "cgroup-read");
+        if (!readers_.empty()) {
+            {
+                std::lock_guard<std::mutex> lock(readersMutex_);
+                tickNumber_++;
+                readersBusy_ = readers_.size();
+            }
+            readersChanged_.notify_all();
+        }
+        readShare(0);
+        if (!readers_.empty()) {
+            std::unique_lock<std::mutex> lock(readersMutex_);
+            readersChanged_.wait(lock, [this] { return readersBusy_ == 0; });
+        }
+    }
+
+    // Removed groups drop out now and the tree is walked again next time;
+    // groups that could not be opened stay tracked and are tried again
+    std::vector<CgroupStats> stats;
+    stats.reserve(tickGroups_.size());
+    for (size_t i = 0; i < tickGroups_.size(); i++) {
+        switch (tickResults_[i]) {
+            case ReadResult::OK:
+                stats.push_back(std::move(tickStats_[i]));
+                break;
+            case ReadResult::REMOVED:
+                groups_.erase(tickGroups_[i]->path);
+                rescanDue_ = true;
+                break;
+            case ReadResult::UNREADABLE:
+                break;
+        }
+    }
+    return stats;
+}
+
+void CgroupMonitor::readShare(size_t first) {
+    // Groups share nothing, so each share is every workers_-th one
+    for (size_t i = first; i < tickGroups_.size(); i += workers_) {
+        tickResults_[i] = tickGroups_[i]->sample(tickNow_, tickStats_[i]);
+    }
+}
+
+void CgroupMonitor::runReader(size_t index) {
+    if (Tracer::instance().isEnabled()) {
+        Tracer::instance().setThreadName("cgroup-reader " + std::to_string(index));
+    }
+    uint64_t done = 0;
+    std::unique_lock<std::mutex> lock(readersMutex_);
+    for (;;) {
+        readersChanged_.wait(lock, [this, done] { return readersStopping_ || tickNumber_ != done; });
+        if (readersStopping_) {
+            return;
+        }
+        done = tickNumber_;
+        lock.unlock();
+        readShare(index);
+        lock.lock();
+        if (--readersBusy_ == 0) {
+            readersChanged_.notify_all();
+        }
+    }
+}
+
+}  // namespace WinHKMon
@@ -1,4 +1,9 @@
 #include "WinHKMonLib/CliParser.h"
+#include "WinHKMonLib/ConfigProfile.h"
+#include "WinHKMonLib/FieldProjection.h"
+#include "WinHKMonLib/OtlpExporter.h"
+#include "WinHKMonLib/PushProtocol.h"
+#include "WinHKMonLib/Sink.h"
 #include <algorithm>
 #include <cctype>
 #include <stdexcept>
@@ -8,6 +13,9 @@ namespace WinHKMon {
 
 namespace {
 
+// CPU pinning uses a single processor group affinity mask
+constexpr unsigned MAX_HOUSEKEEPING_CPUS = 64;
+
 // Convert string to uppercase for case-insensitive comparison
 std::string toUpper(const std::string& str) {
     std::string result = str;
@@ -21,6 +29,115 @@ bool isFlag(const std::string& arg) {
     return !arg.empty() && arg[0] == '-';
 }
 
+// Parse an interval-style value in seconds and validate its range
+double parseSeconds(const std::string& flag, const char* value) {
+    double seconds = 0.0;
+    try {
+        seconds = std::stod(value);
+    } catch (const std::exception&) {
+        throw std::invalid_argument("Invalid " + flag + " value: " + std::string(value));
+    }
+    if (seconds < 0.1 || seconds > 3600.0) {
+        throw std::invalid_argument(
+            flag + " must be between 0.1 and 3600 seconds. Got: " + std::string(value));
+    }
+    return seconds;
+}
+
+// Parse a whole-number count and validate its range
+size_t parseCount(const std::string& flag, const char* value, size_t minimum, size_t maximum) {
+    size_t count = 0;
+    try {
+        size_t used = 0;
+        count = static_cast<size_t>(std::stoul(value, &used));
+        if (used != std::string(value).size()) {
+            throw std::invalid_argument(value);
+        }
+    } catch (const std::exception&) {
+        throw std::invalid_argument("Invalid " + flag + " value: " + std::string(value));
+    }
+    if (count < minimum || count > maximum) {
+        throw std::invalid_argument(flag + " must be between " + std::to_string(minimum) + " and " +
+                                    std::to_string(maximum) + ". Got: " + std::string(value));
+    }
+    return count;
+}
+
+// Parse a CPU list such as "0", "0,2" or "0-3,6" (ascending, no duplicates)
+std::vector<unsigned> parseCpuList(const char* value) {
+    std::vector<unsigned> cpus;
+    std::stringstream list(value);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        size_t dash = item.find('-');
+        unsigned first = 0;
+        unsigned last = 0;
+        try {
+            size_t used = 0;
+            first = static_cast<unsigned>(std::stoul(item.substr(0, dash), &used));
+            if (used != (dash == std::string::npos ? item.size() : dash)) {
+                throw std::invalid_argument(item);
+            }
+            last = first;
+            if (dash != std::string::npos) {
+                std::string upper = item.substr(dash + 1);
+                last = static_cast<unsigned>(std::stoul(upper, &used));
+                if (used != upper.size()) {
+                    throw std::invalid_argument(item);
+                }
+            }
+        } catch (const std::exception&) {
+            throw std::invalid_argument("Invalid --cpu-set value: " + std::string(value));
+        }
+        if (first > last || last >= MAX_HOUSEKEEPING_CPUS) {
+            throw std::invalid_argument(
+                "--cpu-set CPUs must be ascending and below " +
+                std::to_string(MAX_HOUSEKEEPING_CPUS) + ". Got: " + std::string(value));
+        }
+        for (unsigned cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+    if (cpus.empty()) {
+        throw std::invalid_argument("--cpu-set requires at least one CPU");
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+// Insert the arguments of --profile/--config ahead of the command line's own
+std::vector<std::string> expandProfile(int argc, char* argv[]) {
+    std::vector<std::string> args(argv, argv + argc);
+    std::string configPath;
+    std::string profile;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h" || arg == "--version" || arg == "-v") {
+            return args;  // Help and version never need the file
+        }
+        if (arg == "--config" || arg == "--profile") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(arg == "--config" ? "--config requires a file path"
+                                                              : "--profile requires a profile name");
+            }
+            (arg == "--config" ? configPath : profile) = argv[++i];
+        }
+    }
+    if (configPath.empty() && profile.empty()) {
+        return args;
+    }
+    if (configPath.empty()) {
+        configPath = DEFAULT_CONFIG_FILE;
+    }
+
+    // After the aggregate subcommand, which must stay the first argument
+    std::vector<std::string> profileArgs = loadProfileArguments(configPath, profile);
+    auto insertAt = args.begin() + (argc > 1 && toUpper(args[1]) == "AGGREGATE" ? 2 : 1);
+    args.insert(insertAt, profileArgs.begin(), profileArgs.end());
+    return args;
+}
+
 }  // anonymous namespace
 
 std::string generateHelpMessage() {
@@ -28,31 +145,99 @@ std::string generateHelpMessage() {
 
 USAGE:
   WinHKMon [METRICS...] [OPTIONS...] [INTERFACE]
+  WinHKMon aggregate [--listen <endpoint>] [--bucket <sec>] [OPTIONS...]
 
 METRICS:
   CPU           Monitor CPU usage and frequency
-  RAM           Monitor memory (RAM and page file)
+  RAM           Monitor memory (RAM and page file; huge pages and THP on Linux)
   DISK          Monitor disk space (capacity, used, free)
   IO            Monitor disk I/O (read/write rates, busy %)
   NET           Monitor network traffic
   TEMP          Monitor temperature (requires admin)
+  CGROUP        Monitor Linux cgroup v2 groups (CPU, throttling, memory, I/O, PSI)
+  POWER         Monitor power per RAPL zone and host (Linux powercap, root)
+  NUMA          Monitor memory and NUMA hit/miss rates per node (Linux sysfs)
+  KRES          Monitor kernel resources: handles and threads (Windows), file
+                handles and sockets with headroom (Linux)
 
 OPTIONS:
-  --format, -f <fmt>     Output format: text, json, csv (default: text)
+  --format, -f <fmt>     Output format: text, json, ndjson, csv (default: text)
+  --sink <fmt:target>    Write to a target instead of stdout; repeatable, e.g.
+                         --sink text:stdout --sink csv:C:\logs\whk.csv
+                         (targets: stdout, stderr, file; append +drop to the
+                         format to drop frames rather than wait on a slow target;
+                         sqlite:<db> writes normalized tables to a database)
+  --sqlite-batch <n>     Samples per SQLite transaction (default: 100, range: 1-100000)
+  --sqlite-commit <sec>  Commit a SQLite transaction once it is this old
+                         (default: 1, range: 0.1-3600)
+  --fields <list>        Print only these fields and run only their collectors,
+                         e.g. cpu.total,net.*.in,disk.C:.busy (groups: cpu,
+                         core, ram, hugepages, thp, numa, disk, net, cgroup,
+                         power, rapl, kres, sock, system, module; * matches
+                         any instance or field)
+  --cores <view>         Per-core CPU output: full (JSON object per core, the
+                         default), packed (usage array), histogram (cores per
+                         10% bin), top[:N] (busiest N cores, default 8) or none.
+                         packed, histogram and top also show in text output
   --line, -l, LINE       Single-line compact output
   --continuous, -c       Continuous monitoring (until Ctrl+C)
   --interval, -i <sec>   Update interval (default: 1, range: 0.1-3600)
+  --high-rate            Intervals down to 0.001 s on absolute-deadline timers,
+                         with lateness reported on exit (continuous mode; CPU
+                         and NET only; NDJSON output)
+  --align                Tick on wall-clock multiples of the interval (continuous mode)
+  --adaptive             Adapt interval to activity (continuous mode)
+  --min-interval <sec>   Adaptive lower bound (default: 0.25)
+  --max-interval <sec>   Adaptive upper bound (default: 10)
+  --sensitivity <frac>   Adaptive change threshold (default: 0.2 = 20%)
   --net-units <unit>     Network units: bits or bytes (default: bits)
-  --interface <name>     Specific network interface
+  --interface <name>     Specific network interface (loopback included by name)
+  --cgroup <glob>        cgroups to report, e.g. system.slice/* (default: all)
+  --cgroup-root <path>   cgroup v2 mount point (default: /sys/fs/cgroup)
+  --module <name|path>   Load a collector module (whk_<name>.dll/.so); repeatable.
+                         Its counters appear as module.<name>.<counter>
+  --module-dir <dir>     Where --module names are found (default: modules
+                         directory next to WinHKMon.exe)
+  --low-impact           Idle CPU priority, background I/O, locked working set
+  --cpu-set <list>       Pin to housekeeping CPUs in low-impact mode (e.g., 0-1)
+  --push <endpoint>      Push samples to an aggregator (continuous mode)
+  --host-id <name>       Host ID for pushed and OTLP samples (default: computer name)
+  --serve <endpoint>     Answer delta snapshot pulls (continuous mode)
+  --ring <n>             Frames kept for pull deltas (default: 600, range: 2-100000)
+  --otlp <url>           Export to an OpenTelemetry collector over OTLP/HTTP,
+                         e.g. http://collector:4318 (continuous mode; batched,
+                         gzipped, retried in the background)
+  --otlp-batch <n>       Samples per OTLP request (default: 10, range: 1-1000)
+  --trace-file <path>    Write internal timing spans as Chrome trace JSON
+  --profile <name>       Apply a named profile from the config file first
+  --config <path>        Config file (default: WinHKMon.ini; reloaded live
+                         in continuous mode when it changes)
   --help, -h             Show this help
   --version, -v          Show version
 
+AGGREGATE OPTIONS:
+  --listen <endpoint>    tcp:host:port or unix:path (default: tcp:0.0.0.0:9410)
+  --bucket <sec>         Aggregation bucket width (default: 1, range: 0.1-3600)
+
 EXAMPLES:
   WinHKMon CPU RAM                  # Single sample of CPU and memory
   WinHKMon NET "Ethernet"           # Network stats for specific interface
   WinHKMon CPU RAM -c -i 5          # Continuous monitoring, 5 sec intervals
+  WinHKMon CPU NET -c --adaptive    # Faster when busy, slower when idle
+  WinHKMon CPU RAM -c -i 5 --align  # Samples at :00, :05, :10, ... on every host
+  WinHKMon CPU -c --low-impact --cpu-set 0   # Stay off latency-sensitive CPUs
   WinHKMon CPU TEMP --format json   # JSON output
   WinHKMon CPU RAM LINE             # Single-line output for status bars
+  WinHKMon CPU RAM -c --sink text:stdout --sink ndjson:whk.ndjson   # Console and log
+  WinHKMon CPU DISK NET -c --sink sqlite:C:\WinHKMon\history.db     # Queryable history
+  WinHKMon --fields cpu.total,ram.percent LINE   # Two numbers, two collectors
+  WinHKMon CPU -c -f ndjson --cores top:16   # 16 busiest cores of a large host
+  WinHKMon CPU --module gpu -c      # CPU plus counters from modules\whk_gpu.dll
+  WinHKMon aggregate -f json        # Cluster view of agents pushing to port 9410
+  WinHKMon CPU RAM NET -c --push tcp:monitor01:9410   # Agent feeding an aggregator
+  WinHKMon CPU RAM NET -c --serve tcp:0.0.0.0:9411    # Agent answering remote pulls
+  WinHKMon CPU RAM DISK NET -c --otlp http://otel:4318  # Feed an OpenTelemetry collector
+  WinHKMon --profile server --config C:\WinHKMon\agents.ini   # Options from [server]
 
 For more information: https://github.com/yourorg/WinHKMon
 )";
@@ -73,6 +258,15 @@ CliOptions parseArguments(int argc, char* argv[]) {
         throw std::invalid_argument("No arguments provided. Use --help for usage information.");
     }
     
+    // Profile options come first so the command line can override them
+    std::vector<std::string> expanded = expandProfile(argc, argv);
+    std::vector<char*> expandedArgv;
+    for (std::string& arg : expanded) {
+        expandedArgv.push_back(&arg[0]);
+    }
+    argc = static_cast<int>(expandedArgv.size());
+    argv = expandedArgv.data();
+    
     // Parse arguments
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
@@ -90,8 +284,13 @@ CliOptions parseArguments(int argc, char* argv[]) {
             return opts;  // Return immediately, ignore other args
         }
         
+        // Aggregate subcommand (first argument only)
+        if (i == 1 && argUpper == "AGGREGATE") {
+            opts.aggregate = true;
+        }
+        
         // Metrics (case-insensitive)
-        if (argUpper == "CPU") {
+        else if (argUpper == "CPU") {
             opts.showCpu = true;
         }
         else if (argUpper == "RAM") {
@@ -109,6 +308,18 @@ CliOptions parseArguments(int argc, char* argv[]) {
         else if (argUpper == "TEMP") {
             opts.showTemp = true;
         }
+        else if (argUpper == "CGROUP") {
+            opts.showCgroup = true;
+        }
+        else if (argUpper == "POWER") {
+            opts.showPower = true;
+        }
+        else if (argUpper == "NUMA") {
+            opts.showNuma = true;
+        }
+        else if (argUpper == "KRES") {
+            opts.showKernelResources = true;
+        }
         else if (argUpper == "LINE") {
             opts.singleLine = true;
         }
@@ -116,7 +327,7 @@ CliOptions parseArguments(int argc, char* argv[]) {
         // Format flags
         else if (arg == "--format" || arg == "-f") {
             if (i + 1 >= argc) {
-                throw std::invalid_argument("--format requires an argument (text, json, csv)");
+                throw std::invalid_argument("--format requires an argument (text, json, ndjson, csv)");
             }
             std::string format = toUpper(argv[++i]);
             if (format == "TEXT") {
@@ -125,12 +336,48 @@ CliOptions parseArguments(int argc, char* argv[]) {
                 opts.format = OutputFormat::JSON;
             } else if (format == "CSV") {
                 opts.format = OutputFormat::CSV;
+            } else if (format == "NDJSON") {
+                opts.format = OutputFormat::NDJSON;
             } else {
                 throw std::invalid_argument("Invalid format '" + std::string(argv[i]) + 
-                                          "'. Valid formats: text, json, csv");
+                                          "'. Valid formats: text, json, ndjson, csv");
             }
         }
         
+        // Field projection
+        else if (arg == "--fields") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--fields requires a field list (e.g., cpu.total,net.*.in)");
+            }
+            opts.fields = compileFields(argv[++i]);
+        }
+        
+        // Output sinks (repeatable)
+        else if (arg == "--sink") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--sink requires format:target (e.g., csv:C:\\logs\\whk.csv)");
+            }
+            SinkSpec spec = parseSinkSpec(argv[++i]);
+            for (const SinkSpec& existing : opts.sinks) {
+                if (existing.target == spec.target) {
+                    throw std::invalid_argument("--sink target '" + spec.target + "' is used twice");
+                }
+            }
+            opts.sinks.push_back(spec);
+        }
+        else if (arg == "--sqlite-batch") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--sqlite-batch requires a sample count");
+            }
+            opts.sqliteBatchSamples = parseCount("--sqlite-batch", argv[++i], 1, 100000);
+        }
+        else if (arg == "--sqlite-commit") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--sqlite-commit requires a numeric argument");
+            }
+            opts.sqliteCommitSeconds = parseSeconds("--sqlite-commit", argv[++i]);
+        }
+        
         // Single-line mode
         else if (arg == "--line" || arg == "-l") {
             opts.singleLine = true;
@@ -148,9 +395,9 @@ CliOptions parseArguments(int argc, char* argv[]) {
             }
             try {
                 double interval = std::stod(argv[++i]);
-                if (interval < 0.1 || interval > 3600.0) {
+                if (interval < 0.001 || interval > 3600.0) {
                     throw std::invalid_argument(
-                        "Interval must be between 0.1 and 3600 seconds. Got: " + 
+                        "Interval must be between 0.001 and 3600 seconds. Got: " + 
                         std::to_string(interval));
                 }
                 opts.intervalSeconds = interval;
@@ -159,6 +406,46 @@ CliOptions parseArguments(int argc, char* argv[]) {
             }
         }
         
+        // Deadline-timer loop (sub-100 ms intervals)
+        else if (arg == "--high-rate") {
+            opts.highRate = true;
+        }
+        
+        // Wall-clock-aligned ticks
+        else if (arg == "--align") {
+            opts.align = true;
+        }
+        
+        // Adaptive sampling
+        else if (arg == "--adaptive") {
+            opts.adaptive = true;
+        }
+        else if (arg == "--min-interval") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--min-interval requires a numeric argument");
+            }
+            opts.minIntervalSeconds = parseSeconds("--min-interval", argv[++i]);
+        }
+        else if (arg == "--max-interval") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--max-interval requires a numeric argument");
+            }
+            opts.maxIntervalSeconds = parseSeconds("--max-interval", argv[++i]);
+        }
+        else if (arg == "--sensitivity") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--sensitivity requires a numeric argument");
+            }
+            try {
+                opts.adaptiveSensitivity = std::stod(argv[++i]);
+            } catch (const std::exception&) {
+                throw std::invalid_argument("Invalid sensitivity value: " + std::string(argv[i]));
+            }
+            if (opts.adaptiveSensitivity <= 0.0) {
+                throw std::invalid_argument("Sensitivity must be greater than 0");
+            }
+        }
+        
         // Network interface
         else if (arg == "--interface") {
             if (i + 1 >= argc) {
@@ -167,6 +454,41 @@ CliOptions parseArguments(int argc, char* argv[]) {
             opts.networkInterface = argv[++i];
         }
         
+        // cgroup selection
+        else if (arg == "--cgroup") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--cgroup requires a path glob (e.g., system.slice/*)");
+            }
+            opts.cgroupFilter = argv[++i];
+            if (opts.cgroupFilter.empty()) {
+                throw std::invalid_argument("--cgroup requires a path glob (e.g., system.slice/*)");
+            }
+        }
+        else if (arg == "--cgroup-root") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--cgroup-root requires a directory path");
+            }
+            opts.cgroupRoot = argv[++i];
+        }
+        
+        // Collector modules (repeatable)
+        else if (arg == "--module") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--module requires a module name or path (e.g., gpu)");
+            }
+            std::string module = argv[++i];
+            if (std::find(opts.modules.begin(), opts.modules.end(), module) != opts.modules.end()) {
+                throw std::invalid_argument("--module '" + module + "' is given twice");
+            }
+            opts.modules.push_back(module);
+        }
+        else if (arg == "--module-dir") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--module-dir requires a directory path");
+            }
+            opts.moduleDir = argv[++i];
+        }
+        
         // Network units
         else if (arg == "--net-units") {
             if (i + 1 >= argc) {
@@ -183,6 +505,122 @@ CliOptions parseArguments(int argc, char* argv[]) {
             }
         }
         
+        // Per-core representation
+        else if (arg == "--cores") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--cores requires a view (full, packed, histogram, top[:N], none)");
+            }
+            std::string view = toUpper(argv[++i]);
+            if (view == "FULL") {
+                opts.coreView = CoreView::FULL;
+            } else if (view == "PACKED") {
+                opts.coreView = CoreView::PACKED;
+            } else if (view == "HISTOGRAM") {
+                opts.coreView = CoreView::HISTOGRAM;
+            } else if (view == "TOP") {
+                opts.coreView = CoreView::TOP;
+            } else if (view.rfind("TOP:", 0) == 0) {
+                opts.coreView = CoreView::TOP;
+                opts.topCores = parseCount("--cores top", view.c_str() + 4, 1, 4096);
+            } else if (view == "NONE") {
+                opts.coreView = CoreView::NONE;
+            } else {
+                throw std::invalid_argument("Invalid core view '" + std::string(argv[i]) +
+                                            "'. Valid views: full, packed, histogram, top[:N], none");
+            }
+        }
+        
+        // Low-impact execution
+        else if (arg == "--low-impact") {
+            opts.lowImpact = true;
+        }
+        else if (arg == "--cpu-set") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--cpu-set requires a CPU list (e.g., 0-1,4)");
+            }
+            opts.housekeepingCpus = parseCpuList(argv[++i]);
+        }
+        
+        // Fleet aggregation
+        else if (arg == "--listen") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--listen requires an endpoint (tcp:host:port or unix:path)");
+            }
+            opts.listenEndpoint = argv[++i];
+            parseEndpoint(opts.listenEndpoint);  // Validate now, not at bind time
+        }
+        else if (arg == "--bucket") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--bucket requires a numeric argument");
+            }
+            opts.bucketSeconds = parseSeconds("--bucket", argv[++i]);
+        }
+        else if (arg == "--push") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--push requires an endpoint (tcp:host:port or unix:path)");
+            }
+            opts.pushEndpoint = argv[++i];
+            parseEndpoint(opts.pushEndpoint);
+        }
+        else if (arg == "--host-id") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--host-id requires a name");
+            }
+            opts.hostId = argv[++i];
+            if (opts.hostId.empty() || opts.hostId.size() > MAX_HOST_ID_BYTES) {
+                throw std::invalid_argument("--host-id must be 1 to 255 characters");
+            }
+        }
+        
+        // Remote pull
+        else if (arg == "--serve") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--serve requires an endpoint (tcp:host:port or unix:path)");
+            }
+            opts.serveEndpoint = argv[++i];
+            parseEndpoint(opts.serveEndpoint);
+        }
+        else if (arg == "--ring") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--ring requires a frame count");
+            }
+            opts.ringFrames = parseCount("--ring", argv[++i], 2, 100000);
+        }
+        
+        // OpenTelemetry export
+        else if (arg == "--otlp") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--otlp requires a collector URL (http://host[:port][/path])");
+            }
+            opts.otlpUrl = argv[++i];
+            parseOtlpUrl(opts.otlpUrl);
+        }
+        else if (arg == "--otlp-batch") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--otlp-batch requires a sample count");
+            }
+            opts.otlpBatchSamples = parseCount("--otlp-batch", argv[++i], 1, 1000);
+        }
+        
+        // Config file profiles (arguments already inserted by expandProfile)
+        else if (arg == "--config") {
+            opts.configPath = argv[++i];
+        }
+        else if (arg == "--profile") {
+            opts.profile = argv[++i];
+            if (opts.configPath.empty()) {
+                opts.configPath = DEFAULT_CONFIG_FILE;
+            }
+        }
+        
+        // Self-instrumentation trace output
+        else if (arg == "--trace-file") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--trace-file requires a file path");
+            }
+            opts.traceFile = argv[++i];
+        }
+        
         // Interface name without flag (only if NET already specified or looks like interface)
         else if (!isFlag(arg) && opts.showNetwork) {
             // Interface name for already-enabled network monitoring
@@ -196,16 +634,93 @@ CliOptions parseArguments(int argc, char* argv[]) {
         }
     }
     
-    // Validation: At least one metric must be selected (unless help/version)
-    if (!opts.showHelp && !opts.showVersion) {
+    // Validation: Aggregator only listens; agents choose what to collect
+    if (opts.aggregate) {
+        if (opts.showCpu || opts.showMemory || opts.showDiskSpace || opts.showDiskIO ||
+            opts.showNetwork || opts.showTemp || opts.showCgroup || opts.showPower ||
+            opts.showNuma || opts.showKernelResources || !opts.modules.empty()) {
+            throw std::invalid_argument("aggregate does not take metrics; agents choose what to push");
+        }
+        if (!opts.pushEndpoint.empty() || !opts.serveEndpoint.empty() || !opts.otlpUrl.empty()) {
+            throw std::invalid_argument("--push, --serve and --otlp cannot be used with aggregate");
+        }
+        if (!opts.fields.empty()) {
+            throw std::invalid_argument("--fields cannot be used with aggregate");
+        }
+        opts.continuous = true;
+    }
+    
+    // Field projection decides which collectors run
+    selectCollectors(opts);
+    
+    // Validation: At least one metric must be selected (unless help/version/aggregate)
+    if (!opts.showHelp && !opts.showVersion && !opts.aggregate) {
         if (!opts.showCpu && !opts.showMemory && !opts.showDiskSpace && !opts.showDiskIO &&
-            !opts.showNetwork && !opts.showTemp) {
+            !opts.showNetwork && !opts.showTemp && !opts.showCgroup && !opts.showPower &&
+            !opts.showNuma && !opts.showKernelResources && opts.modules.empty()) {
             throw std::invalid_argument(
-                "At least one metric must be specified (CPU, RAM, DISK, IO, NET, TEMP). "
+                "At least one metric must be specified (CPU, RAM, DISK, IO, NET, TEMP, CGROUP, "
+                "POWER, NUMA, KRES, or --module). "
                 "Use --help for usage information.");
         }
     }
     
+    // Validation: Sub-100 ms intervals only run on the high-rate loop
+    if (opts.intervalSeconds < 0.1 && !opts.highRate) {
+        throw std::invalid_argument("Interval must be between 0.1 and 3600 seconds "
+                                    "(down to 0.001 with --high-rate)");
+    }
+    
+    // Validation: High-rate mode samples only raw counters and writes one line per tick
+    if (opts.highRate) {
+        if (!opts.continuous) {
+            throw std::invalid_argument("--high-rate requires --continuous");
+        }
+        if (opts.showMemory || opts.showDiskSpace || opts.showDiskIO || opts.showTemp ||
+            opts.showCgroup || opts.showPower || opts.showNuma || opts.showKernelResources ||
+            !opts.modules.empty()) {
+            throw std::invalid_argument("--high-rate supports the CPU and NET metrics only");
+        }
+        if (opts.adaptive || opts.align || !opts.pushEndpoint.empty() || !opts.serveEndpoint.empty() ||
+            !opts.otlpUrl.empty()) {
+            throw std::invalid_argument("--high-rate cannot be used with --adaptive, --align, --push, --serve or --otlp");
+        }
+        for (const SinkSpec& spec : effectiveSinks(opts)) {
+            if (spec.format != OutputFormat::NDJSON) {
+                throw std::invalid_argument("--high-rate writes NDJSON only (use -f ndjson or --sink ndjson:<target>)");
+            }
+        }
+    }
+    
+    // Validation: Adaptive bounds must form a valid range
+    if (opts.adaptive && opts.minIntervalSeconds > opts.maxIntervalSeconds) {
+        throw std::invalid_argument("--min-interval must not exceed --max-interval");
+    }
+    
+    // Validation: Aligned ticks need a fixed interval in continuous mode
+    if (opts.align && !opts.continuous) {
+        throw std::invalid_argument("--align requires --continuous");
+    }
+    if (opts.align && opts.adaptive) {
+        throw std::invalid_argument("--align cannot be used with --adaptive");
+    }
+    
+    // Validation: CPU pinning is part of low-impact mode
+    if (!opts.housekeepingCpus.empty() && !opts.lowImpact) {
+        throw std::invalid_argument("--cpu-set requires --low-impact");
+    }
+    
+    // Validation: Pushing is a continuous-mode feature
+    if (!opts.pushEndpoint.empty() && !opts.continuous) {
+        throw std::invalid_argument("--push requires --continuous");
+    }
+    if (!opts.serveEndpoint.empty() && !opts.continuous) {
+        throw std::invalid_argument("--serve requires --continuous");
+    }
+    if (!opts.otlpUrl.empty() && !opts.continuous) {
+        throw std::invalid_argument("--otlp requires --continuous");
+    }
+    
     return opts;
 }
 
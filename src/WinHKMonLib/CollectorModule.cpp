@@ -0,0 +1,206 @@
+#include "WinHKMonLib/CollectorModule.h"
+#include "WinHKMonLib/Tracer.h"
+#include "WinHKMonLib/WinHKMonModule.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace WinHKMon {
+
+namespace {
+
+#ifdef _WIN32
+constexpr const char* MODULE_SUFFIX = ".dll";
+#else
+constexpr const char* MODULE_SUFFIX = ".so";
+#endif
+
+constexpr uint32_t MAX_COUNTERS = MAX_FRAME_SLOTS - SLOT_COUNT;  // Every module slot of a frame
+
+// Module and counter names become field paths and column names: [a-z0-9_]+
+bool isValidName(const char* name) {
+    if (name == nullptr || *name == '\0') {
+        return false;
+    }
+    for (const char* c = name; *c != '\0'; c++) {
+        if (!((*c >= 'a' && *c <= 'z') || (*c >= '0' && *c <= '9') || *c == '_')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string lastLoadError() {
+#ifdef _WIN32
+    return "error " + std::to_string(GetLastError());
+#else
+    const char* error = dlerror();
+    return error != nullptr ? error : "unknown error";
+#endif
+}
+
+}  // anonymous namespace
+
+std::string resolveModulePath(const std::string& module, const std::string& moduleDir) {
+    if (module.find_first_of("/\\.") != std::string::npos) {
+        return module;
+    }
+    std::string name = module;
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return (fs::path(moduleDir) / ("whk_" + name + MODULE_SUFFIX)).string();
+}
+
+CollectorModule::CollectorModule(std::string path)
+    : path_(std::move(path))
+    , library_(nullptr)
+    , descriptor_(nullptr)
+    , state_(nullptr)
+    , opened_(false)
+    , firstSlot_(SLOT_COUNT) {
+}
+
+CollectorModule::~CollectorModule() {
+    unload();
+}
+
+void CollectorModule::unload() {
+    if (opened_ && descriptor_->close != nullptr) {
+        descriptor_->close(state_);
+    }
+    opened_ = false;
+    state_ = nullptr;
+    descriptor_ = nullptr;
+    if (library_ != nullptr) {
+#ifdef _WIN32
+        FreeLibrary(static_cast<HMODULE>(library_));
+#else
+        dlclose(library_);
+#endif
+        library_ = nullptr;
+    }
+}
+
+void CollectorModule::initialize() {
+    unload();
+
+    whk_module_entry_fn entry = nullptr;
+#ifdef _WIN32
+    HMODULE library = LoadLibraryA(path_.c_str());
+    if (library == nullptr) {
+        throw std::runtime_error("Cannot load module '" + path_ + "': " + lastLoadError());
+    }
+    library_ = library;
+    entry = reinterpret_cast<whk_module_entry_fn>(GetProcAddress(library, WHK_MODULE_ENTRY));
+#else
+    library_ = dlopen(path_.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (library_ == nullptr) {
+        throw std::runtime_error("Cannot load module '" + path_ + "': " + lastLoadError());
+    }
+    entry = reinterpret_cast<whk_module_entry_fn>(dlsym(library_, WHK_MODULE_ENTRY));
+#endif
+
+    try {
+        if (entry == nullptr) {
+            throw std::runtime_error("Module '" + path_ + "' does not export " WHK_MODULE_ENTRY);
+        }
+        const whk_module* descriptor = entry();
+        if (descriptor == nullptr) {
+            throw std::runtime_error("Module '" + path_ + "' returned no descriptor");
+        }
+        if (descriptor->abi_version != WHK_MODULE_ABI_VERSION) {
+            throw std::runtime_error("Module '" + path_ + "' uses module ABI " +
+                                     std::to_string(descriptor->abi_version) + "; this build expects " +
+                                     std::to_string(WHK_MODULE_ABI_VERSION));
+        }
+        if (!isValidName(descriptor->name)) {
+            throw std::runtime_error("Module '" + path_ + "' has an invalid name (use a-z, 0-9, _)");
+        }
+        if (descriptor->counter_count == 0 || descriptor->counter_count > MAX_COUNTERS ||
+            descriptor->counters == nullptr) {
+            throw std::runtime_error("Module '" + std::string(descriptor->name) + "' must declare 1-" +
+                                     std::to_string(MAX_COUNTERS) + " counters");
+        }
+        if (descriptor->open == nullptr || descriptor->sample == nullptr) {
+            throw std::runtime_error("Module '" + std::string(descriptor->name) + "' has no open or sample function");
+        }
+
+        auto schema = std::make_shared<ModuleSchema>();
+        schema->name = descriptor->name;
+        schema->description = descriptor->description != nullptr ? descriptor->description : "";
+        for (uint32_t i = 0; i < descriptor->counter_count; i++) {
+            const whk_module_counter& counter = descriptor->counters[i];
+            if (!isValidName(counter.name) ||
+                std::find(schema->counters.begin(), schema->counters.end(), counter.name) != schema->counters.end()) {
+                throw std::runtime_error("Module '" + schema->name + "' counter " + std::to_string(i) +
+                                         " has an invalid or duplicate name");
+            }
+            schema->counters.push_back(counter.name);
+            schema->units.push_back(counter.unit != nullptr ? counter.unit : "");
+        }
+
+        if (descriptor->open(&state_) != 0) {
+            throw std::runtime_error("Module '" + schema->name + "' failed to open");
+        }
+        descriptor_ = descriptor;
+        opened_ = true;
+        schema_ = std::move(schema);
+    } catch (...) {
+        unload();
+        throw;
+    }
+}
+
+void CollectorModule::sample(ModuleFrame& frame) {
+    if (!opened_) {
+        throw std::runtime_error("Module '" + path_ + "' is not initialized");
+    }
+    WINHKMON_TRACE_SPAN("collect", "module");
+
+    size_t counters = schema_->counters.size();
+    uint64_t counterBits = (uint64_t{1} << counters) - 1;
+    frame.validMask &= ~(counterBits << firstSlot_);
+
+    double* values = frame.values.data() + firstSlot_;
+    std::fill(values, values + counters, 0.0);
+    uint64_t validMask = 0;
+    if (descriptor_->sample(state_, values, &validMask) != 0) {
+        throw std::runtime_error("Module '" + schema_->name + "' failed to sample");
+    }
+    // Bits past the declared counters mean nothing
+    frame.validMask |= (validMask & counterBits) << firstSlot_;
+}
+
+uint32_t ModuleSet::load(const std::string& path) {
+    auto module = std::make_unique<CollectorModule>(path);
+    module->initialize();
+    uint32_t first = layout_.addModule(*module->schema());
+    module->bindSlots(first);
+    modules_.push_back(std::move(module));
+    return first;
+}
+
+void ModuleSet::sample(ModuleFrame& frame, const std::function<void(const std::exception&)>& onError) {
+    frame.schemas = layout_.modules();
+    for (const auto& module : modules_) {
+        try {
+            module->sample(frame);
+        } catch (const std::exception& e) {
+            if (onError) {
+                onError(e);
+            }
+        }
+    }
+}
+
+}  // namespace WinHKMon
@@ -0,0 +1,177 @@
+#include "WinHKMonLib/ConfigProfile.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace WinHKMon {
+
+namespace {
+
+// Options that take a value ("key = value" becomes "--key value")
+const char* const VALUE_KEYS[] = {
+    "format", "interval", "min-interval", "max-interval", "sensitivity", "net-units",
+    "interface", "cpu-set", "listen", "bucket", "push", "host-id", "serve", "ring", "trace-file",
+    "sink", "fields", "cgroup", "cgroup-root", "module", "module-dir", "otlp", "otlp-batch",
+    "sqlite-batch", "sqlite-commit", "cores"
+};
+
+// Switches ("key = true" becomes "--key", "key = false" leaves it out)
+const char* const SWITCH_KEYS[] = {
+    "continuous", "line", "align", "adaptive", "low-impact", "high-rate"
+};
+
+std::string trim(const std::string& str) {
+    size_t first = str.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return "";
+    }
+    size_t last = str.find_last_not_of(" \t\r");
+    return str.substr(first, last - first + 1);
+}
+
+std::string toLower(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return str;
+}
+
+template <size_t N>
+bool contains(const char* const (&keys)[N], const std::string& key) {
+    return std::find(std::begin(keys), std::end(keys), key) != std::end(keys);
+}
+
+std::invalid_argument lineError(int lineNumber, const std::string& message) {
+    return std::invalid_argument("Config line " + std::to_string(lineNumber) + ": " + message);
+}
+
+// Append the arguments for one "key = value" line
+void appendKey(std::vector<std::string>& args, const std::string& key, const std::string& value,
+               int lineNumber) {
+    if (key == "metrics") {
+        std::string list = value;
+        std::replace(list.begin(), list.end(), ',', ' ');
+        std::istringstream metrics(list);
+        std::string metric;
+        while (metrics >> metric) {
+            args.push_back(metric);
+        }
+    } else if (contains(VALUE_KEYS, key)) {
+        if (value.empty()) {
+            throw lineError(lineNumber, "'" + key + "' requires a value");
+        }
+        args.push_back("--" + key);
+        args.push_back(value);
+    } else if (contains(SWITCH_KEYS, key)) {
+        std::string flag = toLower(value);
+        if (flag == "true" || flag == "yes" || flag == "on" || flag == "1") {
+            args.push_back("--" + key);
+        } else if (flag != "false" && flag != "no" && flag != "off" && flag != "0") {
+            throw lineError(lineNumber, "'" + key + "' must be true or false. Got: " + value);
+        }
+    } else {
+        throw lineError(lineNumber, "unknown key '" + key + "'");
+    }
+}
+
+}  // anonymous namespace
+
+std::vector<std::string> profileArguments(const std::string& text, const std::string& profile) {
+    std::vector<std::string> shared;
+    std::vector<std::string> selected;
+    std::vector<std::string>* target = &shared;   // nullptr inside other profiles' sections
+    bool found = profile.empty();
+
+    std::istringstream lines(text);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        lineNumber++;
+        line = trim(line);
+        if (line.empty() || line[0] == '#' || line[0] == ';') {
+            continue;
+        }
+
+        if (line[0] == '[') {
+            if (line.back() != ']') {
+                throw lineError(lineNumber, "unterminated section header");
+            }
+            std::string name = trim(line.substr(1, line.size() - 2));
+            if (name.empty()) {
+                throw lineError(lineNumber, "empty section name");
+            }
+            bool match = name == profile;
+            found = found || match;
+            target = match ? &selected : nullptr;
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            throw lineError(lineNumber, "expected 'key = value'");
+        }
+        std::string key = toLower(trim(line.substr(0, equals)));
+        std::string value = trim(line.substr(equals + 1));
+        // Trailing comments need whitespace before them (interface names may contain '#')
+        for (const char* marker : {" #", " ;", "\t#", "\t;"}) {
+            size_t comment = value.find(marker);
+            if (comment != std::string::npos) {
+                value = trim(value.substr(0, comment));
+            }
+        }
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+            value = value.substr(1, value.size() - 2);
+        }
+
+        // Keys of other profiles are still checked so mistakes show up early
+        std::vector<std::string> ignored;
+        appendKey(target != nullptr ? *target : ignored, key, value, lineNumber);
+    }
+
+    if (!found) {
+        throw std::invalid_argument("Profile '" + profile + "' not found");
+    }
+    shared.insert(shared.end(), selected.begin(), selected.end());
+    return shared;
+}
+
+std::vector<std::string> loadProfileArguments(const std::string& path, const std::string& profile) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::invalid_argument("Cannot read config file '" + path + "'");
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    try {
+        return profileArguments(text.str(), profile);
+    } catch (const std::invalid_argument& e) {
+        throw std::invalid_argument(path + ": " + e.what());
+    }
+}
+
+std::string restartOnlyChanges(const CliOptions& current, const CliOptions& next) {
+    std::string list;
+    auto check = [&list](bool differs, const char* name) {
+        if (differs) {
+            list += (list.empty() ? "" : ", ") + std::string(name);
+        }
+    };
+    check(current.continuous != next.continuous, "continuous");
+    check(current.aggregate != next.aggregate, "aggregate");
+    check(current.highRate != next.highRate, "high-rate");
+    check(current.listenEndpoint != next.listenEndpoint, "listen");
+    check(current.bucketSeconds != next.bucketSeconds, "bucket");
+    check(current.pushEndpoint != next.pushEndpoint, "push");
+    check(current.hostId != next.hostId, "host-id");
+    check(current.serveEndpoint != next.serveEndpoint, "serve");
+    check(current.ringFrames != next.ringFrames, "ring");
+    check(current.otlpUrl != next.otlpUrl || current.otlpBatchSamples != next.otlpBatchSamples, "otlp");
+    check(current.lowImpact != next.lowImpact, "low-impact");
+    check(current.housekeepingCpus != next.housekeepingCpus, "cpu-set");
+    check(current.traceFile != next.traceFile, "trace-file");
+    check(current.modules != next.modules || current.moduleDir != next.moduleDir, "module");
+    return list;
+}
+
+}  // namespace WinHKMon
@@ -0,0 +1,110 @@
+#include "WinHKMonLib/ConfigWatcher.h"
+#include "WinHKMonLib/Tracer.h"
+#include <stdexcept>
+#include <utility>
+#include <windows.h>
+
+namespace WinHKMon {
+
+namespace {
+
+// Quiet time before a change counts as settled
+constexpr DWORD SETTLE_MS = 200;
+
+struct FileStamp {
+    bool exists = false;
+    FILETIME lastWrite{};
+    uint64_t size = 0;
+
+    bool operator!=(const FileStamp& other) const {
+        return exists != other.exists || CompareFileTime(&lastWrite, &other.lastWrite) != 0 ||
+               size != other.size;
+    }
+};
+
+FileStamp stampOf(const std::string& path) {
+    FileStamp stamp;
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data)) {
+        stamp.exists = true;
+        stamp.lastWrite = data.ftLastWriteTime;
+        stamp.size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+    }
+    return stamp;
+}
+
+std::string directoryOf(const std::string& path) {
+    size_t slash = path.find_last_of("\\/");
+    if (slash == std::string::npos) {
+        return ".";
+    }
+    return slash == 0 ? path.substr(0, 1) : path.substr(0, slash);
+}
+
+}  // anonymous namespace
+
+ConfigWatcher::ConfigWatcher(const std::string& path, Callback onChange)
+    : path_(path)
+    , onChange_(std::move(onChange))
+    , changeHandle_(INVALID_HANDLE_VALUE)
+    , stopEvent_(nullptr) {
+    // Renames cover editors that save to a temporary file and replace the original
+    changeHandle_ = FindFirstChangeNotificationA(
+        directoryOf(path_).c_str(), FALSE,
+        FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE);
+    if (changeHandle_ == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot watch config file directory (error " +
+                                 std::to_string(GetLastError()) + ")");
+    }
+    stopEvent_ = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (stopEvent_ == nullptr) {
+        FindCloseChangeNotification(changeHandle_);
+        throw std::runtime_error("CreateEvent failed");
+    }
+    thread_ = std::thread(&ConfigWatcher::run, this);
+}
+
+ConfigWatcher::~ConfigWatcher() {
+    SetEvent(stopEvent_);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    FindCloseChangeNotification(changeHandle_);
+    CloseHandle(stopEvent_);
+}
+
+void ConfigWatcher::run() {
+    if (Tracer::instance().isEnabled()) {
+        Tracer::instance().setThreadName("config-watcher");
+    }
+    HANDLE handles[2] = {stopEvent_, changeHandle_};
+    FileStamp last = stampOf(path_);
+    for (;;) {
+        DWORD result = WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+        if (result != WAIT_OBJECT_0 + 1) {
+            return;  // Stop requested, or the notification failed
+        }
+        FindNextChangeNotification(changeHandle_);
+
+        // Let the save finish; every further notification restarts the wait
+        for (;;) {
+            result = WaitForMultipleObjects(2, handles, FALSE, SETTLE_MS);
+            if (result == WAIT_OBJECT_0 + 1) {
+                FindNextChangeNotification(changeHandle_);
+            } else if (result == WAIT_TIMEOUT) {
+                break;
+            } else {
+                return;
+            }
+        }
+
+        // A deleted file is not a change; its replacement will be
+        FileStamp current = stampOf(path_);
+        if (current.exists && current != last) {
+            last = current;
+            onChange_();
+        }
+    }
+}
+
+}  // namespace WinHKMon
@@ -1,4 +1,5 @@
 #include "WinHKMonLib/CpuMonitor.h"
+#include "WinHKMonLib/Tracer.h"
 #include <stdexcept>
 #include <algorithm>
 #include <numeric>
@@ -50,11 +51,42 @@ extern "C" {
 
 namespace WinHKMon {
 
-CpuMonitor::CpuMonitor() 
-    : hQuery_(nullptr)
+namespace {
+
+// NtQuerySystemInformation(SystemProcessorPerformanceInformation): one record per processor
+constexpr ULONG SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION_CLASS = 8;
+
+struct ProcessorPerformanceRecord {
+    LARGE_INTEGER idleTime;
+    LARGE_INTEGER kernelTime;    // Includes idle time
+    LARGE_INTEGER userTime;
+    LARGE_INTEGER reserved1[2];
+    ULONG reserved2;
+};
+
+using NtQuerySystemInformationFn = LONG(WINAPI*)(ULONG, PVOID, ULONG, PULONG);
+
+uint64_t fileTimeValue(const FILETIME& time) {
+    return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+}
+
+// Share of total in percent, clamped to 0-100
+double percentOf(uint64_t part, uint64_t total) {
+    double percent = total > 0 ? static_cast<double>(part) / static_cast<double>(total) * 100.0 : 0.0;
+    return percent < 0.0 ? 0.0 : (percent > 100.0 ? 100.0 : percent);
+}
+
+}  // anonymous namespace
+
+CpuMonitor::CpuMonitor(CpuSampling sampling) 
+    : sampling_(sampling)
+    , hQuery_(nullptr)
     , hCpuTotal_(nullptr)
     , initialized_(false)
-    , coreCount_(0) {
+    , coreCount_(0)
+    , queryProcessorTimes_(nullptr)
+    , previousTotal_{}
+    , lastRawStats_{} {
 }
 
 CpuMonitor::~CpuMonitor() {
@@ -71,6 +103,11 @@ void CpuMonitor::initialize() {
     GetSystemInfo(&sysInfo);
     coreCount_ = static_cast<int>(sysInfo.dwNumberOfProcessors);
 
+    if (sampling_ == CpuSampling::RAW_TIMES) {
+        initializeRawTimes();
+        return;
+    }
+
     // Open PDH query
     PDH_STATUS status = PdhOpenQueryW(nullptr, 0, &hQuery_);
     if (status != ERROR_SUCCESS) {
@@ -125,6 +162,10 @@ CpuStats CpuMonitor::getCurrentStats() {
         throw std::runtime_error("CpuMonitor not initialized. Call initialize() first.");
     }
 
+    if (sampling_ == CpuSampling::RAW_TIMES) {
+        return getRawTimesStats();
+    }
+
     CpuStats stats;
 
     // Collect current sample
@@ -135,7 +176,10 @@ CpuStats CpuMonitor::getCurrentStats() {
 
     // PDH requires a small delay between samples to calculate percentages
     // Wait at least 100ms for accurate CPU percentage calculation
-    Sleep(100);
+    {
+        WINHKMON_TRACE_SPAN("pdh", "cpu.pdh-wait");
+        Sleep(100);
+    }
 
     // Collect second sample for percentage calculation
     status = PdhCollectQueryData(hQuery_);
@@ -190,6 +234,7 @@ CpuStats CpuMonitor::getCurrentStats() {
 
     // Get CPU frequencies
     try {
+        WINHKMON_TRACE_SPAN("collect", "cpu.frequency");
         std::vector<uint64_t> frequencies = getFrequencies();
         
         // Assign frequencies to cores
@@ -221,10 +266,97 @@ void CpuMonitor::cleanup() {
     
     hCpuTotal_ = nullptr;
     hCpuCores_.clear();
+    queryProcessorTimes_ = nullptr;
+    queryBuffer_.clear();
+    previousCores_.clear();
+    currentCores_.clear();
     initialized_ = false;
     coreCount_ = 0;
 }
 
+void CpuMonitor::initializeRawTimes() {
+    HMODULE ntdll = GetModuleHandleW(L"ntdll.dll");
+    queryProcessorTimes_ = ntdll != nullptr ? GetProcAddress(ntdll, "NtQuerySystemInformation") : nullptr;
+    if (queryProcessorTimes_ == nullptr) {
+        throw std::runtime_error("NtQuerySystemInformation is not available");
+    }
+
+    // Everything a sample touches is sized here, so sampling allocates only the result
+    queryBuffer_.assign(static_cast<size_t>(coreCount_) * sizeof(ProcessorPerformanceRecord), 0);
+    previousCores_.assign(coreCount_, ProcessorTimes{});
+    currentCores_.assign(coreCount_, ProcessorTimes{});
+    readProcessorTimes(previousTotal_, previousCores_);
+
+    lastRawStats_ = CpuStats{};
+    lastRawStats_.cores.resize(coreCount_);
+    for (int i = 0; i < coreCount_; ++i) {
+        lastRawStats_.cores[i].coreId = i;
+    }
+    initialized_ = true;
+}
+
+void CpuMonitor::readProcessorTimes(ProcessorTimes& total, std::vector<ProcessorTimes>& cores) {
+    FILETIME idle;
+    FILETIME kernel;
+    FILETIME user;
+    if (!GetSystemTimes(&idle, &kernel, &user)) {
+        throw std::runtime_error("GetSystemTimes failed: " + std::to_string(GetLastError()));
+    }
+    total.idle = fileTimeValue(idle);
+    total.kernel = fileTimeValue(kernel);
+    total.user = fileTimeValue(user);
+
+    auto query = reinterpret_cast<NtQuerySystemInformationFn>(queryProcessorTimes_);
+    ULONG returned = 0;
+    LONG status = query(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION_CLASS, queryBuffer_.data(),
+                        static_cast<ULONG>(queryBuffer_.size()), &returned);
+    if (status != 0) {  // STATUS_SUCCESS = 0
+        throw std::runtime_error("NtQuerySystemInformation failed: " + std::to_string(status));
+    }
+    const auto* records = reinterpret_cast<const ProcessorPerformanceRecord*>(queryBuffer_.data());
+    size_t count = returned / sizeof(ProcessorPerformanceRecord);
+    for (size_t i = 0; i < cores.size(); ++i) {
+        if (i < count) {
+            cores[i].idle = static_cast<uint64_t>(records[i].idleTime.QuadPart);
+            cores[i].kernel = static_cast<uint64_t>(records[i].kernelTime.QuadPart);
+            cores[i].user = static_cast<uint64_t>(records[i].userTime.QuadPart);
+        }
+    }
+}
+
+CpuStats CpuMonitor::getRawTimesStats() {
+    WINHKMON_TRACE_SPAN("collect", "cpu.times");
+    ProcessorTimes total;
+    readProcessorTimes(total, currentCores_);
+
+    // Times only advance at the scheduler tick: keep the baseline until they do
+    uint64_t elapsed = (total.kernel + total.user) - (previousTotal_.kernel + previousTotal_.user);
+    if (elapsed == 0) {
+        return lastRawStats_;
+    }
+
+    uint64_t idle = total.idle - previousTotal_.idle;
+    uint64_t kernel = total.kernel - previousTotal_.kernel;
+    lastRawStats_.totalUsagePercent = percentOf(elapsed > idle ? elapsed - idle : 0, elapsed);
+    lastRawStats_.userPercent = percentOf(total.user - previousTotal_.user, elapsed);
+    lastRawStats_.systemPercent = percentOf(kernel > idle ? kernel - idle : 0, elapsed);
+    lastRawStats_.idlePercent = percentOf(idle, elapsed);
+    for (int i = 0; i < coreCount_; ++i) {
+        const ProcessorTimes& now = currentCores_[i];
+        const ProcessorTimes& before = previousCores_[i];
+        uint64_t coreElapsed = (now.kernel + now.user) - (before.kernel + before.user);
+        uint64_t coreIdle = now.idle - before.idle;
+        if (coreElapsed > 0) {
+            lastRawStats_.cores[i].usagePercent = percentOf(coreElapsed > coreIdle ? coreElapsed - coreIdle : 0,
+                                                            coreElapsed);
+        }
+    }
+
+    previousTotal_ = total;
+    previousCores_.swap(currentCores_);
+    return lastRawStats_;
+}
+
 std::vector<uint64_t> CpuMonitor::getFrequencies() {
     std::vector<uint64_t> frequencies;
 
@@ -1,5 +1,6 @@
 #include "WinHKMonLib/DeltaCalculator.h"
 #include <windows.h>
+#include <algorithm>
 #include <stdexcept>
 
 namespace WinHKMon {
@@ -24,6 +25,39 @@ double DeltaCalculator::calculateRate(uint64_t current, uint64_t previous, doubl
     return static_cast<double>(delta) / elapsedSeconds;
 }
 
+double DeltaCalculator::calculateWrappingRate(uint64_t current, uint64_t previous, uint64_t range,
+                                              double elapsedSeconds) {
+    if (current >= previous) {
+        return calculateRate(current, previous, elapsedSeconds);
+    }
+    if (elapsedSeconds <= 0.0 || range == 0 || current > range || previous > range) {
+        return 0.0;
+    }
+
+    // Wrapped once: up to the range, then from 0 to current
+    uint64_t delta = (range - previous) + current;
+    return static_cast<double>(delta) / elapsedSeconds;
+}
+
+void DeltaCalculator::applyInterfaceRates(std::vector<InterfaceStats>& interfaces,
+                                          const std::vector<InterfaceStats>& previous,
+                                          double elapsedSeconds) {
+    if (elapsedSeconds <= 0.0) {
+        return;
+    }
+
+    for (auto& iface : interfaces) {
+        auto prevIt = std::find_if(previous.begin(), previous.end(),
+            [&iface](const InterfaceStats& prev) { return prev.name == iface.name; });
+        if (prevIt != previous.end()) {
+            iface.inBytesPerSec = static_cast<uint64_t>(
+                calculateRate(iface.totalInOctets, prevIt->totalInOctets, elapsedSeconds));
+            iface.outBytesPerSec = static_cast<uint64_t>(
+                calculateRate(iface.totalOutOctets, prevIt->totalOutOctets, elapsedSeconds));
+        }
+    }
+}
+
 double DeltaCalculator::calculateElapsedSeconds(uint64_t currentTimestamp, 
                                                 uint64_t previousTimestamp, 
                                                 uint64_t frequency) {
@@ -0,0 +1,282 @@
+#include "WinHKMonLib/DeltaProtocol.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace WinHKMon {
+
+namespace {
+
+constexpr size_t MAX_VARINT_BYTES = 10;
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+/**
+ * @brief Sequential reader over one message
+ */
+class Reader {
+public:
+    Reader(const char* data, size_t size) : p_(data), end_(data + size) {}
+
+    // Returns false if the varint is incomplete (only used for requests)
+    bool tryVarint(uint64_t& value) {
+        value = 0;
+        for (size_t i = 0; i < MAX_VARINT_BYTES; i++) {
+            if (p_ == end_) {
+                return false;
+            }
+            auto byte = static_cast<unsigned char>(*p_++);
+            value |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        throw std::runtime_error("Varint too long");
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        if (!tryVarint(value)) {
+            throw std::runtime_error("Truncated snapshot message");
+        }
+        return value;
+    }
+
+    uint8_t byte() {
+        if (p_ == end_) {
+            throw std::runtime_error("Truncated snapshot message");
+        }
+        return static_cast<uint8_t>(*p_++);
+    }
+
+    size_t consumed(const char* start) const { return static_cast<size_t>(p_ - start); }
+    bool done() const { return p_ == end_; }
+
+private:
+    const char* p_;
+    const char* end_;
+};
+
+uint64_t doubleBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsDouble(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Slot value bits, or 0 when the slot is not valid (XOR base for new slots)
+uint64_t slotBits(const SnapshotFrame& frame, uint32_t slot) {
+    return (frame.validMask & (1ULL << slot)) ? doubleBits(frame.values[slot]) : 0;
+}
+
+// Write the changed slots of current relative to base (nullptr = keyframe)
+void putSlots(std::string& out, const SnapshotFrame* base, const SnapshotFrame& current) {
+    uint64_t xors[MAX_FRAME_SLOTS];
+    uint64_t changed = 0;
+    for (uint32_t slot = 0; slot < MAX_FRAME_SLOTS; slot++) {
+        // Slots that are no longer valid are dropped through validMask alone
+        uint64_t previous = base ? slotBits(*base, slot) : 0;
+        bool valid = (current.validMask & (1ULL << slot)) != 0;
+        xors[slot] = valid ? slotBits(current, slot) ^ previous : 0;
+        if (xors[slot] != 0) {
+            changed++;
+        }
+    }
+
+    putVarint(out, changed);
+    for (uint32_t slot = 0; slot < MAX_FRAME_SLOTS; slot++) {
+        uint64_t x = xors[slot];
+        if (x == 0) {
+            continue;
+        }
+        int lead = 0;
+        while (lead < 7 && ((x >> (56 - 8 * lead)) & 0xFF) == 0) {
+            lead++;
+        }
+        int trail = 0;
+        while (trail < 7 - lead && ((x >> (8 * trail)) & 0xFF) == 0) {
+            trail++;
+        }
+        putVarint(out, slot);
+        out.push_back(static_cast<char>((lead << 4) | trail));
+        for (int i = 7 - lead; i >= trail; i--) {
+            out.push_back(static_cast<char>((x >> (8 * i)) & 0xFF));
+        }
+    }
+}
+
+}  // anonymous namespace
+
+// ============================================================================
+// FrameRing
+// ============================================================================
+
+FrameRing::FrameRing(size_t capacity)
+    : lastSequence_(0) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Frame ring capacity must be greater than zero");
+    }
+    frames_.resize(capacity);
+}
+
+uint64_t FrameRing::push(SnapshotFrame frame) {
+    frame.sequence = ++lastSequence_;
+    frames_[frame.sequence % frames_.size()] = frame;
+    return frame.sequence;
+}
+
+const SnapshotFrame* FrameRing::find(uint64_t sequence) const {
+    if (sequence == 0 || sequence > lastSequence_) {
+        return nullptr;
+    }
+    const SnapshotFrame& frame = frames_[sequence % frames_.size()];
+    return frame.sequence == sequence ? &frame : nullptr;
+}
+
+const SnapshotFrame* FrameRing::latest() const {
+    return find(lastSequence_);
+}
+
+// ============================================================================
+// Requests and responses
+// ============================================================================
+
+void encodePullRequest(uint64_t epoch, uint64_t lastSequence, std::string& out) {
+    putVarint(out, epoch);
+    putVarint(out, lastSequence);
+}
+
+size_t decodePullRequest(const char* data, size_t size, uint64_t& epoch, uint64_t& lastSequence) {
+    Reader reader(data, size);
+    if (!reader.tryVarint(epoch) || !reader.tryVarint(lastSequence)) {
+        return 0;
+    }
+    return reader.consumed(data);
+}
+
+SnapshotKind encodeSnapshotResponse(const FrameRing& ring, uint64_t epoch, uint64_t clientEpoch,
+                                    uint64_t clientSequence, std::string& out) {
+    size_t lengthAt = out.size();
+    out.append(4, '\0');  // Length prefix, filled in below
+
+    const SnapshotFrame* current = ring.latest();
+    const SnapshotFrame* base = clientEpoch == epoch ? ring.find(clientSequence) : nullptr;
+    SnapshotKind kind = current == nullptr ? SnapshotKind::NONE
+                      : base == nullptr ? SnapshotKind::KEYFRAME
+                      : SnapshotKind::DELTA;
+
+    out.push_back(static_cast<char>((PULL_VERSION << 4) | static_cast<uint8_t>(kind)));
+    putVarint(out, epoch);
+    if (kind != SnapshotKind::NONE) {
+        putVarint(out, current->sequence);
+        if (kind == SnapshotKind::DELTA) {
+            putVarint(out, base->sequence);
+            putVarint(out, zigzag(static_cast<int64_t>(current->timestampMs - base->timestampMs)));
+        } else {
+            putVarint(out, current->timestampMs);
+        }
+        putVarint(out, current->validMask);
+        putSlots(out, base, *current);
+    }
+
+    auto length = static_cast<uint32_t>(out.size() - lengthAt - 4);
+    for (int i = 0; i < 4; i++) {
+        out[lengthAt + i] = static_cast<char>((length >> (8 * i)) & 0xFF);
+    }
+    return kind;
+}
+
+// ============================================================================
+// SnapshotDecoder
+// ============================================================================
+
+SnapshotKind SnapshotDecoder::apply(const char* data, size_t size) {
+    if (size > MAX_SNAPSHOT_MESSAGE_BYTES) {
+        throw std::runtime_error("Snapshot message too large");
+    }
+    Reader reader(data, size);
+    uint8_t header = reader.byte();
+    if ((header >> 4) != PULL_VERSION) {
+        throw std::runtime_error("Unsupported snapshot protocol version");
+    }
+    auto kind = static_cast<SnapshotKind>(header & 0x0F);
+    if (kind != SnapshotKind::NONE && kind != SnapshotKind::KEYFRAME && kind != SnapshotKind::DELTA) {
+        throw std::runtime_error("Unknown snapshot kind");
+    }
+    uint64_t epoch = reader.varint();
+    if (kind == SnapshotKind::NONE) {
+        return kind;
+    }
+
+    SnapshotFrame next;
+    next.sequence = reader.varint();
+    if (kind == SnapshotKind::DELTA) {
+        uint64_t base = reader.varint();
+        if (epoch != epoch_ || base == 0 || base != frame_.sequence) {
+            throw std::runtime_error("Snapshot delta does not match the frame held");
+        }
+        next.timestampMs = frame_.timestampMs + static_cast<uint64_t>(unzigzag(reader.varint()));
+    } else {
+        next.timestampMs = reader.varint();
+    }
+    next.validMask = reader.varint();
+
+    // Start from the base bits (0 for keyframes and newly valid slots)
+    uint64_t bits[MAX_FRAME_SLOTS];
+    for (uint32_t slot = 0; slot < MAX_FRAME_SLOTS; slot++) {
+        bits[slot] = kind == SnapshotKind::DELTA ? slotBits(frame_, slot) : 0;
+    }
+
+    uint64_t changed = reader.varint();
+    for (uint64_t i = 0; i < changed; i++) {
+        uint64_t slot = reader.varint();
+        uint8_t shape = reader.byte();
+        int lead = shape >> 4;
+        int trail = shape & 0x0F;
+        if (lead + trail > 7) {
+            throw std::runtime_error("Invalid slot encoding");
+        }
+        uint64_t x = 0;
+        for (int b = 7 - lead; b >= trail; b--) {
+            x |= static_cast<uint64_t>(reader.byte()) << (8 * b);
+        }
+        if (slot < MAX_FRAME_SLOTS) {
+            bits[slot] ^= x;
+        }
+    }
+    if (!reader.done()) {
+        throw std::runtime_error("Trailing bytes in snapshot message");
+    }
+
+    for (uint32_t slot = 0; slot < MAX_FRAME_SLOTS; slot++) {
+        next.values[slot] = (next.validMask & (1ULL << slot)) ? bitsDouble(bits[slot]) : 0.0;
+    }
+    frame_ = next;
+    epoch_ = epoch;
+    return kind;
+}
+
+void SnapshotDecoder::reset() {
+    frame_ = SnapshotFrame();
+    epoch_ = 0;
+}
+
+}  // namespace WinHKMon
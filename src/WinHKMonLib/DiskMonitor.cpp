@@ -7,6 +7,7 @@
  */
 
 #include "WinHKMonLib/DiskMonitor.h"
+#include "WinHKMonLib/Tracer.h"
 #include <windows.h>
 #include <pdh.h>
 #include <pdhmsg.h>
@@ -53,6 +54,20 @@ namespace {
         // If format is unexpected, return as-is
         return pdhDiskName;
     }
+    
+    /**
+     * Read the cumulative count behind a rate counter (0 if unavailable)
+     * Disk Read/Write Bytes/sec are PERF_COUNTER_BULK_COUNT counters whose
+     * raw FirstValue is the byte count since boot.
+     */
+    uint64_t rawCount(PDH_HCOUNTER counter) {
+        PDH_RAW_COUNTER raw;
+        if (PdhGetRawCounterValue(counter, nullptr, &raw) != ERROR_SUCCESS ||
+            raw.CStatus != PDH_CSTATUS_VALID_DATA || raw.FirstValue < 0) {
+            return 0;
+        }
+        return static_cast<uint64_t>(raw.FirstValue);
+    }
 }
 
 namespace WinHKMon {
@@ -170,7 +185,10 @@ std::vector<DiskStats> DiskMonitor::getCurrentStats() {
     
     // Wait a moment for PDH to process (important for first real sample)
     // PDH needs time between samples for rate calculations
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    {
+        WINHKMON_TRACE_SPAN("pdh", "disk.pdh-wait");
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
     
     // Retrieve formatted values for each disk
     for (const auto& [diskName, counters] : counters_) {
@@ -232,10 +250,10 @@ std::vector<DiskStats> DiskMonitor::getCurrentStats() {
             stats.usedBytes = 0;
         }
         
-        // Cumulative counters (these would be tracked by StateManager in real usage)
-        // For now, we set them to 0 as they require persistent state
-        stats.totalBytesRead = 0;
-        stats.totalBytesWritten = 0;
+        // Cumulative bytes since boot: the raw value behind each bytes/sec
+        // counter, so totals are exact rather than rates times elapsed time
+        stats.totalBytesRead = rawCount(counters.bytesRead);
+        stats.totalBytesWritten = rawCount(counters.bytesWritten);
         
         // Optional IOPS (not currently collected, but structure supports it)
         // Could be added via additional PDH counters:
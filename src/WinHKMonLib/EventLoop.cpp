@@ -0,0 +1,181 @@
+#define _WINSOCKAPI_
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+
+#include "WinHKMonLib/EventLoop.h"
+#include "WinHKMonLib/Tracer.h"
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+namespace WinHKMon {
+
+namespace {
+
+// Loopback UDP pair: stop() and post() send one byte to interrupt WSAPoll
+bool createWakePair(SOCKET& receiver, SOCKET& sender) {
+    receiver = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    sender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (receiver == INVALID_SOCKET || sender == INVALID_SOCKET) {
+        return false;
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    int addrLen = sizeof(addr);
+    u_long nonBlocking = 1;
+    return bind(receiver, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+           getsockname(receiver, reinterpret_cast<sockaddr*>(&addr), &addrLen) == 0 &&
+           connect(sender, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+           ioctlsocket(receiver, FIONBIO, &nonBlocking) == 0 &&
+           ioctlsocket(sender, FIONBIO, &nonBlocking) == 0;
+}
+
+}  // anonymous namespace
+
+EventLoop::EventLoop()
+    : wakeReceiver_(INVALID_SOCKET)
+    , wakeSender_(INVALID_SOCKET)
+    , stopping_(false)
+    , wakeups_(0) {
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        throw std::runtime_error("WSAStartup failed");
+    }
+
+    SOCKET receiver = INVALID_SOCKET;
+    SOCKET sender = INVALID_SOCKET;
+    if (!createWakePair(receiver, sender)) {
+        int error = WSAGetLastError();
+        closesocket(receiver);
+        closesocket(sender);
+        WSACleanup();
+        throw std::runtime_error("Cannot create event loop wake-up sockets (error " +
+                                 std::to_string(error) + ")");
+    }
+    wakeReceiver_ = static_cast<uintptr_t>(receiver);
+    wakeSender_ = static_cast<uintptr_t>(sender);
+}
+
+EventLoop::~EventLoop() {
+    closesocket(static_cast<SOCKET>(wakeReceiver_));
+    closesocket(static_cast<SOCKET>(wakeSender_));
+    WSACleanup();
+}
+
+uint64_t EventLoop::addTimer(TimerQueue::Clock::time_point due, TimerQueue::Callback callback) {
+    return timers_.add(due, std::move(callback));
+}
+
+bool EventLoop::cancelTimer(uint64_t id) {
+    return timers_.cancel(id);
+}
+
+void EventLoop::addSource(PollSource& source) {
+    if (std::find(sources_.begin(), sources_.end(), &source) == sources_.end()) {
+        sources_.push_back(&source);
+    }
+}
+
+void EventLoop::removeSource(PollSource& source) {
+    sources_.erase(std::remove(sources_.begin(), sources_.end(), &source), sources_.end());
+}
+
+void EventLoop::post(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex_);
+        tasks_.push_back(std::move(task));
+    }
+    wake();
+}
+
+void EventLoop::run() {
+    stopping_ = false;
+    while (!stopping_) {
+        runOnce();
+    }
+}
+
+void EventLoop::stop() {
+    stopping_ = true;
+    wake();
+}
+
+void EventLoop::wake() {
+    char byte = 0;
+    send(static_cast<SOCKET>(wakeSender_), &byte, 1, 0);  // A full buffer already means "wake"
+}
+
+void EventLoop::runOnce() {
+    // Entry 0 is the wake-up socket; each source owns a contiguous range after it
+    entries_.clear();
+    entries_.push_back(PollEntry{wakeReceiver_, true, false, false, false});
+    std::vector<std::pair<size_t, size_t>> ranges(sources_.size());
+    for (size_t i = 0; i < sources_.size(); i++) {
+        size_t first = entries_.size();
+        sources_[i]->pollEntries(entries_);
+        ranges[i] = {first, entries_.size() - first};
+    }
+
+    std::vector<WSAPOLLFD> fds(entries_.size());
+    for (size_t i = 0; i < entries_.size(); i++) {
+        fds[i].fd = static_cast<SOCKET>(entries_[i].socket);
+        fds[i].events = static_cast<SHORT>((entries_[i].wantRead ? POLLRDNORM : 0) |
+                                           (entries_[i].wantWrite ? POLLWRNORM : 0));
+    }
+
+    // Sleep until the next timer, rounded up so an early return does not spin
+    int timeoutMs = -1;
+    if (auto due = timers_.nextDue()) {
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(*due - TimerQueue::Clock::now());
+        timeoutMs = static_cast<int>(std::clamp<long long>(remaining.count(), 0, INT_MAX));
+    }
+
+    int ready = 0;
+    {
+        WINHKMON_TRACE_SPAN("idle", "event-wait");
+        ready = WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), timeoutMs);
+    }
+    wakeups_++;
+
+    if (ready > 0) {
+        for (size_t i = 0; i < entries_.size(); i++) {
+            entries_[i].readable = (fds[i].revents & (POLLRDNORM | POLLHUP | POLLERR)) != 0;
+            entries_[i].writable = (fds[i].revents & POLLWRNORM) != 0;
+        }
+        if (entries_[0].readable) {
+            char drain[64];
+            while (recv(static_cast<SOCKET>(wakeReceiver_), drain, sizeof(drain), 0) > 0) {
+            }
+        }
+
+        // Ranges refer to the sources polled above, even if dispatch adds one
+        std::vector<PollSource*> polled = sources_;
+        for (size_t i = 0; i < polled.size(); i++) {
+            auto [first, count] = ranges[i];
+            bool any = false;
+            for (size_t e = first; e < first + count; e++) {
+                any = any || entries_[e].readable || entries_[e].writable;
+            }
+            if (any) {
+                polled[i]->dispatch(&entries_[first], count);
+            }
+        }
+    }
+
+    std::vector<Task> tasks;
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex_);
+        tasks.swap(tasks_);
+    }
+    for (Task& task : tasks) {
+        task();
+    }
+
+    timers_.runDue(TimerQueue::Clock::now());
+}
+
+}  // namespace WinHKMon
@@ -0,0 +1,451 @@
+#include "WinHKMonLib/FieldProjection.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace WinHKMon {
+
+namespace {
+
+enum class Group { CPU, CORE, RAM, DISK, NET, CGROUP, POWER, RAPL, NUMA, KRES, SOCK, SYSTEM, HUGEPAGES, THP, MODULE };
+
+// Which collector (and DiskMonitor half) a field comes from
+enum class Source { CPU, MEMORY, DISK_IO, DISK_SPACE, NETWORK, CGROUP, POWER, NUMA, KRES, MODULE };
+
+/**
+ * @brief Registry entry: where a field lives and how to read it
+ */
+struct FieldInfo {
+    Group group;
+    const char* name;
+    Source source;
+    double (*read)(const SystemMetrics& metrics, size_t instance);
+};
+
+double bytes(uint64_t value) {
+    return static_cast<double>(value);
+}
+
+// A cgroup's I/O rate over all devices
+double cgroupIo(const CgroupStats& group, bool write) {
+    uint64_t total = 0;
+    for (const CgroupIoStats& io : group.io) {
+        total += write ? io.writeBytesPerSec : io.readBytesPerSec;
+    }
+    return bytes(total);
+}
+
+double someAvg10(const std::optional<PressureStats>& pressure) {
+    return pressure ? pressure->someAvg10 : 0.0;
+}
+
+/**
+ * @brief One counter of one module: module instances are the flattened (module, counter) pairs
+ */
+struct ModuleCounter {
+    const ModuleSchema* schema;
+    size_t counter;
+    size_t slot;          ///< Frame slot holding the counter
+};
+
+ModuleCounter moduleCounter(const SystemMetrics& metrics, size_t instance) {
+    for (const ModuleSchema& schema : *metrics.modules->schemas) {
+        if (instance < schema.counters.size()) {
+            return {&schema, instance, schema.firstSlot + instance};
+        }
+        instance -= schema.counters.size();
+    }
+    return {nullptr, 0, 0};
+}
+
+// Every field --fields can select (FieldSelector::field indexes this table)
+const FieldInfo FIELDS[] = {
+    {Group::CPU, "total", Source::CPU,
+     [](const SystemMetrics& m, size_t) { return m.cpu->totalUsagePercent; }},
+    {Group::CPU, "mhz", Source::CPU,
+     [](const SystemMetrics& m, size_t) { return bytes(m.cpu->averageFrequencyMhz); }},
+    {Group::CORE, "usage", Source::CPU,
+     [](const SystemMetrics& m, size_t i) { return m.cpu->cores[i].usagePercent; }},
+    {Group::CORE, "mhz", Source::CPU,
+     [](const SystemMetrics& m, size_t i) { return bytes(m.cpu->cores[i].frequencyMhz); }},
+    {Group::RAM, "total", Source::MEMORY,
+     [](const SystemMetrics& m, size_t) { return bytes(m.memory->totalPhysicalBytes); }},
+    {Group::RAM, "available", Source::MEMORY,
+     [](const SystemMetrics& m, size_t) { return bytes(m.memory->availablePhysicalBytes); }},
+    {Group::RAM, "used", Source::MEMORY,
+     [](const SystemMetrics& m, size_t) { return bytes(m.memory->usedPhysicalBytes); }},
+    {Group::RAM, "percent", Source::MEMORY,
+     [](const SystemMetrics& m, size_t) { return m.memory->usagePercent; }},
+    {Group::RAM, "pagefile_total", Source::MEMORY,
+     [](const SystemMetrics& m, size_t) { return bytes(m.memory->totalPageFileBytes); }},
+    {Group::RAM, "pagefile_used", Source::MEMORY,
+     [](const SystemMetrics& m, size_t) { return bytes(m.memory->usedPageFileBytes); }},
+    {Group::RAM, "pagefile_percent", Source::MEMORY,
+     [](const SystemMetrics& m, size_t) { return m.memory->pageFilePercent; }},
+    {Group::HUGEPAGES, "total", Source::MEMORY,
+     [](const SystemMetrics& m, size_t i) { return bytes(m.memory->hugePages->pools[i].totalPages); }},
+    {Group::HUGEPAGES, "free", Source::MEMORY,
+     [](const SystemMetrics& m, size_t i) { return bytes(m.memory->hugePages->pools[i].freePages); }},
+    {Group::HUGEPAGES, "reserved", Source::MEMORY,
+     [](const SystemMetrics& m, size_t i) { return bytes(m.memory->hugePages->pools[i].reservedPages); }},
+    {Group::HUGEPAGES, "surplus", Source::MEMORY,
+     [](const SystemMetrics& m, size_t i) { return bytes(m.memory->hugePages->pools[i].surplusPages); }},
+    {Group::THP, "anon", Source::MEMORY,
+     [](const SystemMetrics& m, size_t) { return bytes(m.memory->hugePages->anonHugeBytes); }},
+    {Group::THP, "faults", Source::MEMORY,
+     [](const SystemMetrics& m, size_t) { return bytes(m.memory->hugePages->thpFaultsPerSec); }},
+    {Group::THP, "fallbacks", Source::MEMORY,
+     [](const SystemMetrics& m, size_t) { return bytes(m.memory->hugePages->thpFallbacksPerSec); }},
+    {Group::THP, "compact_stalls", Source::MEMORY,
+     [](const SystemMetrics& m, size_t) { return bytes(m.memory->hugePages->compactStallsPerSec); }},
+    {Group::DISK, "read", Source::DISK_IO,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.disks)[i].bytesReadPerSec); }},
+    {Group::DISK, "write", Source::DISK_IO,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.disks)[i].bytesWrittenPerSec); }},
+    {Group::DISK, "busy", Source::DISK_IO,
+     [](const SystemMetrics& m, size_t i) { return (*m.disks)[i].percentBusy; }},
+    {Group::DISK, "total", Source::DISK_SPACE,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.disks)[i].totalSizeBytes); }},
+    {Group::DISK, "used", Source::DISK_SPACE,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.disks)[i].usedBytes); }},
+    {Group::DISK, "free", Source::DISK_SPACE,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.disks)[i].freeBytes); }},
+    {Group::NET, "in", Source::NETWORK,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.network)[i].inBytesPerSec); }},
+    {Group::NET, "out", Source::NETWORK,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.network)[i].outBytesPerSec); }},
+    {Group::NET, "in_total", Source::NETWORK,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.network)[i].totalInOctets); }},
+    {Group::NET, "out_total", Source::NETWORK,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.network)[i].totalOutOctets); }},
+    {Group::NET, "link_speed", Source::NETWORK,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.network)[i].linkSpeedBitsPerSec); }},
+    {Group::CGROUP, "cpu", Source::CGROUP,
+     [](const SystemMetrics& m, size_t i) { return (*m.cgroups)[i].cpuPercent; }},
+    {Group::CGROUP, "throttled", Source::CGROUP,
+     [](const SystemMetrics& m, size_t i) { return (*m.cgroups)[i].throttledPercent; }},
+    {Group::CGROUP, "memory", Source::CGROUP,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.cgroups)[i].memoryCurrentBytes); }},
+    {Group::CGROUP, "oom_kill", Source::CGROUP,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.cgroups)[i].oomKillEvents); }},
+    {Group::CGROUP, "read", Source::CGROUP,
+     [](const SystemMetrics& m, size_t i) { return cgroupIo((*m.cgroups)[i], false); }},
+    {Group::CGROUP, "write", Source::CGROUP,
+     [](const SystemMetrics& m, size_t i) { return cgroupIo((*m.cgroups)[i], true); }},
+    {Group::CGROUP, "psi_cpu", Source::CGROUP,
+     [](const SystemMetrics& m, size_t i) { return someAvg10((*m.cgroups)[i].cpuPressure); }},
+    {Group::CGROUP, "psi_memory", Source::CGROUP,
+     [](const SystemMetrics& m, size_t i) { return someAvg10((*m.cgroups)[i].memoryPressure); }},
+    {Group::CGROUP, "psi_io", Source::CGROUP,
+     [](const SystemMetrics& m, size_t i) { return someAvg10((*m.cgroups)[i].ioPressure); }},
+    {Group::POWER, "watts", Source::POWER,
+     [](const SystemMetrics& m, size_t) { return m.power->hostWatts; }},
+    {Group::RAPL, "watts", Source::POWER,
+     [](const SystemMetrics& m, size_t i) { return m.power->zones[i].watts; }},
+    {Group::RAPL, "energy", Source::POWER,
+     [](const SystemMetrics& m, size_t i) { return bytes(m.power->zones[i].energyMicrojoules); }},
+    {Group::NUMA, "total", Source::NUMA,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.numa)[i].totalBytes); }},
+    {Group::NUMA, "free", Source::NUMA,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.numa)[i].freeBytes); }},
+    {Group::NUMA, "file", Source::NUMA,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.numa)[i].fileBytes); }},
+    {Group::NUMA, "anon", Source::NUMA,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.numa)[i].anonBytes); }},
+    {Group::NUMA, "hit", Source::NUMA,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.numa)[i].hitsPerSec); }},
+    {Group::NUMA, "miss", Source::NUMA,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.numa)[i].missesPerSec); }},
+    {Group::NUMA, "foreign", Source::NUMA,
+     [](const SystemMetrics& m, size_t i) { return bytes((*m.numa)[i].foreignPerSec); }},
+    {Group::KRES, "files", Source::KRES,
+     [](const SystemMetrics& m, size_t) { return bytes(*m.kernelResources->fileHandlesAllocated); }},
+    {Group::KRES, "files_max", Source::KRES,
+     [](const SystemMetrics& m, size_t) { return bytes(*m.kernelResources->fileHandlesMax); }},
+    {Group::KRES, "files_percent", Source::KRES,
+     [](const SystemMetrics& m, size_t) { return *m.kernelResources->fileHandlePercent; }},
+    {Group::KRES, "sockets", Source::KRES,
+     [](const SystemMetrics& m, size_t) { return bytes(m.kernelResources->socketsUsed.value_or(0)); }},
+    {Group::SOCK, "inuse", Source::KRES,
+     [](const SystemMetrics& m, size_t i) { return bytes(m.kernelResources->protocols[i].inUse); }},
+    {Group::SOCK, "memory", Source::KRES,
+     [](const SystemMetrics& m, size_t i) { return bytes(m.kernelResources->protocols[i].memoryBytes.value_or(0)); }},
+    {Group::SOCK, "memory_percent", Source::KRES,
+     [](const SystemMetrics& m, size_t i) { return m.kernelResources->protocols[i].memoryPercent.value_or(0.0); }},
+    {Group::SYSTEM, "handles", Source::KRES,
+     [](const SystemMetrics& m, size_t) { return bytes(*m.kernelResources->handleCount); }},
+    {Group::SYSTEM, "threads", Source::KRES,
+     [](const SystemMetrics& m, size_t) { return bytes(m.kernelResources->threadCount.value_or(0)); }},
+    {Group::SYSTEM, "processes", Source::KRES,
+     [](const SystemMetrics& m, size_t) { return bytes(m.kernelResources->processCount.value_or(0)); }},
+    {Group::MODULE, "value", Source::MODULE,
+     [](const SystemMetrics& m, size_t i) {
+         return m.modules->values[moduleCounter(m, i).slot];
+     }},
+};
+
+constexpr size_t FIELD_COUNT = sizeof(FIELDS) / sizeof(FIELDS[0]);
+
+struct GroupInfo {
+    Group group;
+    const char* name;
+    bool hasInstances;
+};
+
+const GroupInfo GROUPS[] = {
+    {Group::CPU, "cpu", false},
+    {Group::CORE, "core", true},
+    {Group::RAM, "ram", false},
+    {Group::DISK, "disk", true},
+    {Group::NET, "net", true},
+    {Group::CGROUP, "cgroup", true},
+    {Group::POWER, "power", false},
+    {Group::RAPL, "rapl", true},
+    {Group::NUMA, "numa", true},
+    {Group::KRES, "kres", false},
+    {Group::SOCK, "sock", true},
+    {Group::SYSTEM, "system", false},
+    {Group::HUGEPAGES, "hugepages", true},
+    {Group::THP, "thp", false},
+    {Group::MODULE, "module", true},
+};
+
+const GroupInfo& groupInfo(Group group) {
+    return GROUPS[static_cast<size_t>(group)];
+}
+
+std::string trim(const std::string& str) {
+    size_t first = str.find_first_not_of(" \t");
+    if (first == std::string::npos) {
+        return "";
+    }
+    size_t last = str.find_last_not_of(" \t");
+    return str.substr(first, last - first + 1);
+}
+
+// Does a selector's instance ("*", "name", or "prefix.*") match an instance name?
+bool instanceMatches(const std::string& pattern, const std::string& name) {
+    if (pattern == "*" || pattern == name) {
+        return true;
+    }
+    size_t prefix = pattern.size() - 1;
+    return pattern.size() >= 2 && pattern.compare(prefix - 1, 2, ".*") == 0 &&
+           name.compare(0, prefix, pattern, 0, prefix) == 0;
+}
+
+// Instances of a group present in a sample
+size_t instanceCount(Group group, const SystemMetrics& metrics) {
+    switch (group) {
+        case Group::CPU: return metrics.cpu ? 1 : 0;
+        case Group::RAM: return metrics.memory ? 1 : 0;
+        case Group::CORE: return metrics.cpu ? metrics.cpu->cores.size() : 0;
+        case Group::DISK: return metrics.disks ? metrics.disks->size() : 0;
+        case Group::NET: return metrics.network ? metrics.network->size() : 0;
+        case Group::CGROUP: return metrics.cgroups ? metrics.cgroups->size() : 0;
+        case Group::POWER: return metrics.power ? 1 : 0;
+        case Group::RAPL: return metrics.power ? metrics.power->zones.size() : 0;
+        case Group::NUMA: return metrics.numa ? metrics.numa->size() : 0;
+        // Scalar groups of one platform are absent on the other
+        case Group::KRES:
+            return metrics.kernelResources && metrics.kernelResources->fileHandlesAllocated ? 1 : 0;
+        case Group::SOCK: return metrics.kernelResources ? metrics.kernelResources->protocols.size() : 0;
+        case Group::SYSTEM: return metrics.kernelResources && metrics.kernelResources->handleCount ? 1 : 0;
+        case Group::HUGEPAGES:
+            return metrics.memory && metrics.memory->hugePages ? metrics.memory->hugePages->pools.size() : 0;
+        case Group::THP: return metrics.memory && metrics.memory->hugePages ? 1 : 0;
+        case Group::MODULE: {
+            size_t count = 0;
+            if (metrics.modules) {
+                for (const ModuleSchema& schema : *metrics.modules->schemas) {
+                    count += schema.counters.size();
+                }
+            }
+            return count;
+        }
+    }
+    return 0;
+}
+
+std::string instanceName(Group group, const SystemMetrics& metrics, size_t instance) {
+    switch (group) {
+        case Group::CORE: return std::to_string(metrics.cpu->cores[instance].coreId);
+        case Group::DISK: return (*metrics.disks)[instance].deviceName;
+        case Group::NET: return (*metrics.network)[instance].name;
+        case Group::CGROUP: return (*metrics.cgroups)[instance].path;
+        case Group::RAPL: return metrics.power->zones[instance].name;
+        case Group::NUMA: return std::to_string((*metrics.numa)[instance].nodeId);
+        case Group::SOCK: return metrics.kernelResources->protocols[instance].protocol;
+        case Group::HUGEPAGES:
+            return std::to_string(metrics.memory->hugePages->pools[instance].pageBytes / 1024) + "kB";
+        case Group::MODULE: {
+            ModuleCounter counter = moduleCounter(metrics, instance);
+            return counter.schema->name + "." + counter.schema->counters[counter.counter];
+        }
+        case Group::CPU:
+        case Group::RAM:
+        case Group::POWER:
+        case Group::KRES:
+        case Group::SYSTEM:
+        case Group::THP: break;
+    }
+    return "";
+}
+
+std::string fieldNames(Group group) {
+    std::string names;
+    for (const FieldInfo& info : FIELDS) {
+        if (info.group == group) {
+            names += (names.empty() ? "" : ", ") + std::string(info.name);
+        }
+    }
+    return names;
+}
+
+bool isFieldName(Group group, const std::string& name) {
+    return std::any_of(std::begin(FIELDS), std::end(FIELDS),
+                       [group, &name](const FieldInfo& info) { return info.group == group && name == info.name; });
+}
+
+// Append the selectors for one pattern
+void compilePattern(const std::string& pattern, std::vector<FieldSelector>& selectors) {
+    size_t dot = pattern.find('.');
+    std::string groupName = pattern.substr(0, dot);
+    auto group = std::find_if(std::begin(GROUPS), std::end(GROUPS),
+                              [&groupName](const GroupInfo& info) { return groupName == info.name; });
+    if (group == std::end(GROUPS)) {
+        throw std::invalid_argument("Unknown field group '" + groupName + "' in --fields. "
+                                    "Valid groups: cpu, core, ram, hugepages, thp, numa, disk, net, "
+                                    "cgroup, power, rapl, kres, sock, system, module");
+    }
+
+    // Scalar groups: group[.field]; instance groups: group[.instance[.field]]
+    std::string rest = dot == std::string::npos ? "" : pattern.substr(dot + 1);
+    std::string instance;
+    std::string field = rest;
+    if (group->group == Group::MODULE) {
+        // module[.<module>[.<counter>]]: counters are only known once modules load
+        instance = rest.empty() ? "*" : rest;
+        field = "";
+    } else if (group->hasInstances) {
+        // Instance names may contain dots (cgroup.system.slice, net.eth0.100): the last
+        // segment is the field only if it names one (or is a wildcard after one)
+        size_t last = rest.rfind('.');
+        std::string tail = last == std::string::npos ? "" : rest.substr(last + 1);
+        if (last != std::string::npos &&
+            (tail == "*" || isFieldName(group->group, tail) || rest.find('*') < last)) {
+            instance = rest.substr(0, last);
+            field = tail;
+        } else {
+            instance = rest.empty() ? "*" : rest;
+            field = "";
+        }
+        if (instance.empty()) {
+            throw std::invalid_argument("Missing instance in --fields pattern '" + pattern + "'");
+        }
+    }
+
+    bool matched = false;
+    for (size_t index = 0; index < FIELD_COUNT; index++) {
+        const FieldInfo& info = FIELDS[index];
+        if (info.group != group->group || (!field.empty() && field != "*" && field != info.name)) {
+            continue;
+        }
+        matched = true;
+        FieldSelector selector;
+        selector.field = static_cast<uint16_t>(index);
+        selector.instance = instance;
+        if (std::find(selectors.begin(), selectors.end(), selector) == selectors.end()) {
+            selectors.push_back(selector);
+        }
+    }
+    if (!matched) {
+        throw std::invalid_argument("Unknown field '" + field + "' in --fields pattern '" + pattern +
+                                    "'. Valid " + groupName + " fields: " + fieldNames(group->group));
+    }
+}
+
+}  // anonymous namespace
+
+std::vector<FieldSelector> compileFields(const std::string& list) {
+    std::vector<FieldSelector> selectors;
+    std::stringstream patterns(list);
+    std::string pattern;
+    while (std::getline(patterns, pattern, ',')) {
+        pattern = trim(pattern);
+        if (!pattern.empty()) {
+            compilePattern(pattern, selectors);
+        }
+    }
+    if (selectors.empty()) {
+        throw std::invalid_argument("--fields requires at least one field (e.g., cpu.total,net.*.in)");
+    }
+    return selectors;
+}
+
+void selectCollectors(CliOptions& options) {
+    if (options.fields.empty()) {
+        return;
+    }
+    options.showCpu = false;
+    options.showMemory = false;
+    options.showDiskSpace = false;
+    options.showDiskIO = false;
+    options.showNetwork = false;
+    options.showTemp = false;
+    options.showCgroup = false;
+    options.showPower = false;
+    options.showNuma = false;
+    options.showKernelResources = false;
+    bool modules = false;
+    for (const FieldSelector& selector : options.fields) {
+        switch (FIELDS[selector.field].source) {
+            case Source::CPU: options.showCpu = true; break;
+            case Source::MEMORY: options.showMemory = true; break;
+            case Source::DISK_IO: options.showDiskIO = true; break;
+            case Source::DISK_SPACE: options.showDiskSpace = true; break;
+            case Source::NETWORK: options.showNetwork = true; break;
+            case Source::CGROUP: options.showCgroup = true; break;
+            case Source::POWER: options.showPower = true; break;
+            case Source::NUMA: options.showNuma = true; break;
+            case Source::KRES: options.showKernelResources = true; break;
+            case Source::MODULE: modules = true; break;
+        }
+    }
+    if (!modules) {
+        options.modules.clear();
+    }
+}
+
+std::vector<FieldValue> projectFields(const SystemMetrics& metrics, const std::vector<FieldSelector>& fields) {
+    std::vector<FieldValue> values;
+    values.reserve(fields.size());
+    for (const FieldSelector& selector : fields) {
+        if (selector.field >= FIELD_COUNT) {
+            continue;
+        }
+        const FieldInfo& info = FIELDS[selector.field];
+        const GroupInfo& group = groupInfo(info.group);
+        size_t count = instanceCount(info.group, metrics);
+        for (size_t i = 0; i < count; i++) {
+            if (!group.hasInstances) {
+                values.push_back({std::string(group.name) + "." + info.name, info.read(metrics, i)});
+                continue;
+            }
+            std::string name = instanceName(info.group, metrics, i);
+            if (!instanceMatches(selector.instance, name)) {
+                continue;
+            }
+            if (info.group == Group::MODULE) {
+                // Counters the module left unset are absent, like a missing instance
+                if (((metrics.modules->validMask >> moduleCounter(metrics, i).slot) & 1) != 0) {
+                    values.push_back({std::string(group.name) + "." + name, info.read(metrics, i)});
+                }
+                continue;
+            }
+            values.push_back({std::string(group.name) + "." + name + "." + info.name, info.read(metrics, i)});
+        }
+    }
+    return values;
+}
+
+}  // namespace WinHKMon
@@ -0,0 +1,180 @@
+#include "WinHKMonLib/FleetAggregator.h"
+#include "WinHKMonLib/QuantileSketch.h"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace WinHKMon {
+
+FleetAggregator::FleetAggregator(uint64_t bucketMs, uint64_t graceMs, double sketchAccuracy)
+    : bucketMs_(bucketMs)
+    , graceMs_(graceMs)
+    , sketchAccuracy_(sketchAccuracy)
+    , closedThroughMs_(0)
+    , lateSamples_(0)
+    , futureSamples_(0)
+    , invalidValues_(0) {
+    if (bucketMs == 0) {
+        throw std::invalid_argument("Bucket width must be greater than zero");
+    }
+    if (!(sketchAccuracy > 0.0 && sketchAccuracy < 1.0)) {
+        throw std::invalid_argument("Sketch relative accuracy must be between 0 and 1");
+    }
+}
+
+void FleetAggregator::ingest(const PushSample& sample, uint64_t nowMs) {
+    if (sample.timestampMs > nowMs + bucketMs_) {
+        futureSamples_++;
+        return;
+    }
+    uint64_t bucketStart = sample.timestampMs - sample.timestampMs % bucketMs_;
+    if (bucketStart < closedThroughMs_) {
+        lateSamples_++;
+        return;
+    }
+    HostSample& slot = buckets_[bucketStart][sample.hostId];
+    slot.validMask = sample.validMask;
+    slot.values = sample.values;
+
+    // Values come off the network; keep non-finite ones out of sums and sketches
+    for (uint32_t index = 0; index < MAX_FRAME_SLOTS; index++) {
+        uint64_t bit = 1ULL << index;
+        if ((slot.validMask & bit) && !std::isfinite(slot.values[index])) {
+            slot.validMask &= ~bit;
+            invalidValues_++;
+        }
+    }
+}
+
+std::vector<ClusterStats> FleetAggregator::closeBuckets(uint64_t nowMs) {
+    std::vector<ClusterStats> closed;
+    while (!buckets_.empty()) {
+        auto oldest = buckets_.begin();
+        uint64_t bucketEnd = oldest->first + bucketMs_;
+        if (bucketEnd + graceMs_ > nowMs) {
+            break;
+        }
+        if (!oldest->second.empty()) {
+            closed.push_back(summarize(oldest->first, oldest->second));
+        }
+        closedThroughMs_ = bucketEnd;
+        buckets_.erase(oldest);
+    }
+
+    // Buckets that ended with no samples are closed too (late samples for them are dropped)
+    if (nowMs > graceMs_) {
+        uint64_t boundary = nowMs - graceMs_;
+        boundary -= boundary % bucketMs_;
+        if (boundary > closedThroughMs_) {
+            closedThroughMs_ = boundary;
+        }
+    }
+    return closed;
+}
+
+ClusterStats FleetAggregator::summarize(uint64_t bucketStartMs, const Bucket& bucket) const {
+    ClusterStats stats{};
+    stats.bucketStartMs = bucketStartMs;
+    stats.bucketSeconds = static_cast<double>(bucketMs_) / 1000.0;
+    stats.hostCount = static_cast<uint32_t>(bucket.size());
+
+    std::vector<QuantileSketch> sketches(MAX_FRAME_SLOTS, QuantileSketch(sketchAccuracy_));
+    for (const auto& host : bucket) {
+        for (uint32_t slot = 0; slot < MAX_FRAME_SLOTS; slot++) {
+            if (host.second.validMask & (1ULL << slot)) {
+                sketches[slot].add(host.second.values[slot]);
+            }
+        }
+    }
+
+    for (uint32_t slot = 0; slot < MAX_FRAME_SLOTS; slot++) {
+        const QuantileSketch& sketch = sketches[slot];
+        if (sketch.count() == 0) {
+            continue;
+        }
+        ClusterMetricStats metric{};
+        // Module slots carry no names on the wire (see PushProtocol.h)
+        metric.name = slot < SLOT_COUNT ? slotName(slot) : "slot_" + std::to_string(slot);
+        metric.hosts = static_cast<uint32_t>(sketch.count());
+        metric.sum = sketch.sum();
+        metric.min = sketch.min();
+        metric.max = sketch.max();
+        metric.mean = sketch.sum() / static_cast<double>(sketch.count());
+        metric.p50 = sketch.quantile(0.50);
+        metric.p90 = sketch.quantile(0.90);
+        metric.p99 = sketch.quantile(0.99);
+        stats.metrics.push_back(metric);
+    }
+    return stats;
+}
+
+SystemMetrics FleetAggregator::toSystemMetrics(const ClusterStats& stats) {
+    SystemMetrics metrics{};
+    metrics.timestamp = stats.bucketStartMs;
+    metrics.intervalSeconds = stats.bucketSeconds;
+
+    // Look up a metric by slot name
+    auto find = [&stats](const char* name) -> const ClusterMetricStats* {
+        for (const auto& metric : stats.metrics) {
+            if (metric.name == name) {
+                return &metric;
+            }
+        }
+        return nullptr;
+    };
+    auto sumOf = [](const ClusterMetricStats* metric) {
+        return metric ? static_cast<uint64_t>(metric->sum) : 0ULL;
+    };
+
+    if (const ClusterMetricStats* cpu = find("cpu_percent")) {
+        CpuStats cpuStats{};
+        cpuStats.totalUsagePercent = cpu->mean;
+        const ClusterMetricStats* mhz = find("cpu_mhz");
+        cpuStats.averageFrequencyMhz = mhz ? static_cast<uint64_t>(mhz->mean) : 0;
+        metrics.cpu = cpuStats;
+    }
+
+    if (const ClusterMetricStats* total = find("ram_total_bytes")) {
+        MemoryStats mem{};
+        mem.totalPhysicalBytes = static_cast<uint64_t>(total->sum);
+        mem.availablePhysicalBytes = sumOf(find("ram_available_bytes"));
+        mem.usedPhysicalBytes = sumOf(find("ram_used_bytes"));
+        mem.usagePercent = mem.totalPhysicalBytes > 0
+            ? static_cast<double>(mem.usedPhysicalBytes) / static_cast<double>(mem.totalPhysicalBytes) * 100.0
+            : 0.0;
+        mem.totalPageFileBytes = sumOf(find("pagefile_total_bytes"));
+        mem.usedPageFileBytes = sumOf(find("pagefile_used_bytes"));
+        mem.availablePageFileBytes = mem.totalPageFileBytes > mem.usedPageFileBytes
+            ? mem.totalPageFileBytes - mem.usedPageFileBytes
+            : 0;
+        mem.pageFilePercent = mem.totalPageFileBytes > 0
+            ? static_cast<double>(mem.usedPageFileBytes) / static_cast<double>(mem.totalPageFileBytes) * 100.0
+            : 0.0;
+        metrics.memory = mem;
+    }
+
+    if (const ClusterMetricStats* read = find("disk_read_bytes_per_sec")) {
+        DiskStats disk{};
+        disk.deviceName = "_Total";
+        disk.bytesReadPerSec = static_cast<uint64_t>(read->sum);
+        disk.bytesWrittenPerSec = sumOf(find("disk_write_bytes_per_sec"));
+        const ClusterMetricStats* busy = find("disk_busy_percent");
+        disk.percentBusy = busy ? busy->mean : 0.0;
+        metrics.disks = std::vector<DiskStats>{disk};
+    }
+
+    if (const ClusterMetricStats* in = find("net_in_bytes_per_sec")) {
+        InterfaceStats iface{};
+        iface.name = "cluster";
+        iface.description = "Sum over all hosts";
+        iface.isConnected = true;
+        iface.inBytesPerSec = static_cast<uint64_t>(in->sum);
+        iface.outBytesPerSec = sumOf(find("net_out_bytes_per_sec"));
+        metrics.network = std::vector<InterfaceStats>{iface};
+    }
+
+    metrics.cluster = stats;
+    return metrics;
+}
+
+}  // namespace WinHKMon
@@ -0,0 +1,148 @@
+#include "WinHKMonLib/FrameSlots.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace WinHKMon {
+
+namespace {
+
+const char* const SLOT_NAMES[SLOT_COUNT] = {
+    "cpu_percent",
+    "cpu_mhz",
+    "ram_total_bytes",
+    "ram_available_bytes",
+    "ram_used_bytes",
+    "ram_percent",
+    "pagefile_total_bytes",
+    "pagefile_used_bytes",
+    "pagefile_percent",
+    "disk_read_bytes_per_sec",
+    "disk_write_bytes_per_sec",
+    "disk_busy_percent",
+    "net_in_bytes_per_sec",
+    "net_out_bytes_per_sec",
+};
+
+inline void setSlot(double* values, uint64_t& mask, whk_slot slot, double value) {
+    values[slot] = value;
+    mask |= 1ULL << slot;
+}
+
+}  // anonymous namespace
+
+SlotLayout::SlotLayout()
+    : modules_(std::make_shared<const std::vector<ModuleSchema>>()) {
+}
+
+uint32_t SlotLayout::addModule(const ModuleSchema& schema) {
+    uint32_t first = slotCount();
+    if (schema.counters.size() > MAX_FRAME_SLOTS - first) {
+        throw std::runtime_error("Module '" + schema.name + "' needs " + std::to_string(schema.counters.size()) +
+                                 " slots; only " + std::to_string(MAX_FRAME_SLOTS - first) + " are left");
+    }
+
+    std::vector<std::string> names;
+    names.reserve(schema.counters.size());
+    for (const std::string& counter : schema.counters) {
+        std::string name = schema.name + "_" + counter;
+        bool builtIn = false;
+        for (uint32_t slot = 0; slot < SLOT_COUNT; slot++) {
+            builtIn = builtIn || name == SLOT_NAMES[slot];
+        }
+        if (builtIn || std::find(moduleSlotNames_.begin(), moduleSlotNames_.end(), name) != moduleSlotNames_.end() ||
+            std::find(names.begin(), names.end(), name) != names.end()) {
+            throw std::runtime_error("Module '" + schema.name + "' exports '" + name +
+                                     "', which is already a slot name");
+        }
+        names.push_back(std::move(name));
+    }
+
+    // Copy on write: frames sampled before keep the list they were taken with
+    auto modules = std::make_shared<std::vector<ModuleSchema>>(*modules_);
+    modules->push_back(schema);
+    modules->back().firstSlot = first;
+    modules_ = std::move(modules);
+    moduleSlotNames_.insert(moduleSlotNames_.end(), names.begin(), names.end());
+    return first;
+}
+
+uint32_t SlotLayout::slotCount() const {
+    return SLOT_COUNT + static_cast<uint32_t>(moduleSlotNames_.size());
+}
+
+std::string SlotLayout::name(uint32_t slot) const {
+    if (slot >= SLOT_COUNT && slot - SLOT_COUNT < moduleSlotNames_.size()) {
+        return moduleSlotNames_[slot - SLOT_COUNT];
+    }
+    return slotName(slot);
+}
+
+uint64_t flattenSlots(const SystemMetrics& metrics, double* values) {
+    uint64_t mask = 0;
+
+    if (metrics.cpu) {
+        setSlot(values, mask, WHK_SLOT_CPU_TOTAL_PERCENT, metrics.cpu->totalUsagePercent);
+        setSlot(values, mask, WHK_SLOT_CPU_AVG_FREQ_MHZ, static_cast<double>(metrics.cpu->averageFrequencyMhz));
+    }
+
+    if (metrics.memory) {
+        const MemoryStats& mem = *metrics.memory;
+        setSlot(values, mask, WHK_SLOT_MEM_TOTAL_BYTES, static_cast<double>(mem.totalPhysicalBytes));
+        setSlot(values, mask, WHK_SLOT_MEM_AVAILABLE_BYTES, static_cast<double>(mem.availablePhysicalBytes));
+        setSlot(values, mask, WHK_SLOT_MEM_USED_BYTES, static_cast<double>(mem.usedPhysicalBytes));
+        setSlot(values, mask, WHK_SLOT_MEM_USAGE_PERCENT, mem.usagePercent);
+        setSlot(values, mask, WHK_SLOT_PAGEFILE_TOTAL_BYTES, static_cast<double>(mem.totalPageFileBytes));
+        setSlot(values, mask, WHK_SLOT_PAGEFILE_USED_BYTES, static_cast<double>(mem.usedPageFileBytes));
+        setSlot(values, mask, WHK_SLOT_PAGEFILE_PERCENT, mem.pageFilePercent);
+    }
+
+    if (metrics.disks) {
+        for (const auto& disk : *metrics.disks) {
+            if (disk.deviceName == "_Total") {
+                setSlot(values, mask, WHK_SLOT_DISK_READ_BYTES_PER_SEC, static_cast<double>(disk.bytesReadPerSec));
+                setSlot(values, mask, WHK_SLOT_DISK_WRITE_BYTES_PER_SEC, static_cast<double>(disk.bytesWrittenPerSec));
+                setSlot(values, mask, WHK_SLOT_DISK_BUSY_PERCENT, disk.percentBusy);
+                break;
+            }
+        }
+    }
+
+    if (metrics.network) {
+        double in = 0.0;
+        double out = 0.0;
+        for (const auto& iface : *metrics.network) {
+            in += static_cast<double>(iface.inBytesPerSec);
+            out += static_cast<double>(iface.outBytesPerSec);
+        }
+        setSlot(values, mask, WHK_SLOT_NET_IN_BYTES_PER_SEC, in);
+        setSlot(values, mask, WHK_SLOT_NET_OUT_BYTES_PER_SEC, out);
+    }
+
+    if (metrics.modules) {
+        uint32_t end = frameSlotCount(metrics);
+        for (uint32_t slot = SLOT_COUNT; slot < end; slot++) {
+            if (metrics.modules->validMask & (1ULL << slot)) {
+                values[slot] = metrics.modules->values[slot];
+                mask |= 1ULL << slot;
+            }
+        }
+    }
+
+    return mask;
+}
+
+uint32_t frameSlotCount(const SystemMetrics& metrics) {
+    uint32_t count = SLOT_COUNT;
+    if (metrics.modules && metrics.modules->schemas) {
+        for (const ModuleSchema& schema : *metrics.modules->schemas) {
+            count += static_cast<uint32_t>(schema.counters.size());
+        }
+    }
+    return count;
+}
+
+const char* slotName(uint32_t slot) {
+    return slot < SLOT_COUNT ? SLOT_NAMES[slot] : "unknown";
+}
+
+}  // namespace WinHKMon
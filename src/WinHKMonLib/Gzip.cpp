@@ -0,0 +1,211 @@
+#include "WinHKMonLib/Gzip.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace WinHKMon {
+
+namespace {
+
+constexpr size_t WINDOW_BYTES = 32768;
+constexpr size_t MIN_MATCH = 3;
+constexpr size_t MAX_MATCH = 258;
+constexpr size_t HASH_BITS = 15;
+constexpr size_t MAX_CHAIN = 32;          // Candidates tried per position
+constexpr uint32_t NO_POSITION = 0xFFFFFFFFu;
+
+const uint16_t LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27,
+                                  31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                  2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t DISTANCE_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129,
+                                    193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097,
+                                    6145, 8193, 12289, 16385, 24577};
+const uint8_t DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+                                    6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+const std::array<uint32_t, 256>& crcTable() {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> entries{};
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[n] = c;
+        }
+        return entries;
+    }();
+    return table;
+}
+
+/**
+ * @brief LSB-first bit writer (deflate bit order)
+ */
+class BitWriter {
+public:
+    explicit BitWriter(std::string& out) : out_(out), bits_(0), count_(0) {}
+
+    void write(uint32_t value, unsigned count) {
+        bits_ |= static_cast<uint64_t>(value) << count_;
+        count_ += count;
+        while (count_ >= 8) {
+            out_.push_back(static_cast<char>(bits_ & 0xFF));
+            bits_ >>= 8;
+            count_ -= 8;
+        }
+    }
+
+    // Huffman codes are defined MSB-first
+    void writeCode(uint32_t code, unsigned length) {
+        uint32_t reversed = 0;
+        for (unsigned i = 0; i < length; i++) {
+            reversed = (reversed << 1) | ((code >> i) & 1);
+        }
+        write(reversed, length);
+    }
+
+    void finish() {
+        if (count_ > 0) {
+            out_.push_back(static_cast<char>(bits_ & 0xFF));
+        }
+        bits_ = 0;
+        count_ = 0;
+    }
+
+private:
+    std::string& out_;
+    uint64_t bits_;
+    unsigned count_;
+};
+
+// Fixed Huffman code of a literal/length symbol (RFC 1951 3.2.6)
+void writeSymbol(BitWriter& bits, unsigned symbol) {
+    if (symbol < 144) {
+        bits.writeCode(0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        bits.writeCode(0x190 + (symbol - 144), 9);
+    } else if (symbol < 280) {
+        bits.writeCode(symbol - 256, 7);
+    } else {
+        bits.writeCode(0xC0 + (symbol - 280), 8);
+    }
+}
+
+void writeMatch(BitWriter& bits, size_t length, size_t distance) {
+    unsigned code = 28;
+    while (LENGTH_BASE[code] > length) {
+        code--;
+    }
+    writeSymbol(bits, 257 + code);
+    bits.write(static_cast<uint32_t>(length - LENGTH_BASE[code]), LENGTH_EXTRA[code]);
+
+    unsigned distanceCode = 29;
+    while (DISTANCE_BASE[distanceCode] > distance) {
+        distanceCode--;
+    }
+    bits.writeCode(distanceCode, 5);
+    bits.write(static_cast<uint32_t>(distance - DISTANCE_BASE[distanceCode]), DISTANCE_EXTRA[distanceCode]);
+}
+
+uint32_t hash3(const unsigned char* p) {
+    uint32_t value = (static_cast<uint32_t>(p[0]) << 16) | (static_cast<uint32_t>(p[1]) << 8) | p[2];
+    return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+void appendLittleEndian(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+}  // anonymous namespace
+
+uint32_t crc32(const void* data, size_t size, uint32_t crc) {
+    const auto& table = crcTable();
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+std::string gzipCompress(const std::string& data) {
+    std::string out;
+    out.reserve(data.size() / 4 + 64);
+
+    // Header: magic, deflate, no flags, no mtime, no extra flags, unknown OS
+    const unsigned char header[10] = {0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF};
+    out.append(reinterpret_cast<const char*>(header), sizeof(header));
+
+    BitWriter bits(out);
+    bits.write(1, 1);   // BFINAL
+    bits.write(1, 2);   // BTYPE = fixed Huffman
+
+    const auto* input = reinterpret_cast<const unsigned char*>(data.data());
+    size_t size = data.size();
+    std::vector<uint32_t> head(size_t{1} << HASH_BITS, NO_POSITION);
+    std::vector<uint32_t> previous(WINDOW_BYTES, NO_POSITION);
+
+    auto insert = [&](size_t position) {
+        uint32_t h = hash3(input + position);
+        previous[position % WINDOW_BYTES] = head[h];
+        head[h] = static_cast<uint32_t>(position);
+    };
+
+    size_t position = 0;
+    while (position < size) {
+        size_t bestLength = 0;
+        size_t bestDistance = 0;
+        if (position + MIN_MATCH <= size) {
+            size_t limit = std::min(MAX_MATCH, size - position);
+            uint32_t candidate = head[hash3(input + position)];
+            for (size_t chain = 0; chain < MAX_CHAIN && candidate != NO_POSITION; chain++) {
+                size_t distance = position - candidate;
+                if (distance == 0 || distance > WINDOW_BYTES - 1) {
+                    break;
+                }
+                size_t length = 0;
+                while (length < limit && input[candidate + length] == input[position + length]) {
+                    length++;
+                }
+                if (length > bestLength) {
+                    bestLength = length;
+                    bestDistance = distance;
+                    if (length == limit) {
+                        break;
+                    }
+                }
+                uint32_t next = previous[candidate % WINDOW_BYTES];
+                if (next == NO_POSITION || next >= candidate) {
+                    break;  // End of chain, or a slot reused by a newer position
+                }
+                candidate = next;
+            }
+        }
+
+        if (bestLength >= MIN_MATCH) {
+            writeMatch(bits, bestLength, bestDistance);
+            for (size_t i = 0; i < bestLength; i++, position++) {
+                if (position + MIN_MATCH <= size) {
+                    insert(position);
+                }
+            }
+        } else {
+            writeSymbol(bits, input[position]);
+            if (position + MIN_MATCH <= size) {
+                insert(position);
+            }
+            position++;
+        }
+    }
+    writeSymbol(bits, 256);  // End of block
+    bits.finish();
+
+    appendLittleEndian(out, crc32(data.data(), data.size()));
+    appendLittleEndian(out, static_cast<uint32_t>(data.size()));
+    return out;
+}
+
+}  // namespace WinHKMon
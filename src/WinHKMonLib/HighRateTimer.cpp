@@ -0,0 +1,121 @@
+#include "WinHKMonLib/HighRateTimer.h"
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <timeapi.h>
+#else
+#include <time.h>
+#endif
+
+#ifdef _WIN32
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
+namespace WinHKMon {
+
+DeadlineTimer::DeadlineTimer()
+    : timer_(nullptr)
+    , highResolution_(true)
+    , timerPeriodRaised_(false) {
+#ifdef _WIN32
+    HANDLE timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                          TIMER_ALL_ACCESS);
+    if (timer == nullptr) {
+        // Before Windows 10 1803: a regular timer wakes on the system tick,
+        // so shorten the tick to 1 ms for as long as the timer exists
+        highResolution_ = false;
+        timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+        if (timer == nullptr) {
+            throw std::runtime_error("CreateWaitableTimerEx failed: error " + std::to_string(GetLastError()));
+        }
+        timerPeriodRaised_ = timeBeginPeriod(1) == TIMERR_NOERROR;
+    }
+    timer_ = timer;
+#endif
+}
+
+DeadlineTimer::~DeadlineTimer() {
+#ifdef _WIN32
+    if (timerPeriodRaised_) {
+        timeEndPeriod(1);
+    }
+    if (timer_ != nullptr) {
+        CloseHandle(static_cast<HANDLE>(timer_));
+    }
+#endif
+}
+
+DeadlineTimer::Clock::time_point DeadlineTimer::sleepUntil(Clock::time_point deadline) {
+#ifdef _WIN32
+    // Waitable timers take absolute times on the adjustable system clock
+    // only, so the monotonic deadline becomes a relative one (100 ns units)
+    Clock::time_point now = Clock::now();
+    if (deadline > now) {
+        auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count();
+        LARGE_INTEGER due;
+        due.QuadPart = -((remaining + 99) / 100);
+        if (SetWaitableTimer(static_cast<HANDLE>(timer_), &due, 0, nullptr, nullptr, FALSE)) {
+            WaitForSingleObject(static_cast<HANDLE>(timer_), INFINITE);
+        }
+    }
+#else
+    // steady_clock is CLOCK_MONOTONIC, so the deadline is used as is
+    auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    if (sinceEpoch > 0) {
+        timespec due;
+        due.tv_sec = static_cast<time_t>(sinceEpoch / 1000000000);
+        due.tv_nsec = static_cast<long>(sinceEpoch % 1000000000);
+        // A signal (Ctrl+C) ends the sleep with EINTR; sleeping again to the same
+        // absolute deadline keeps the tick on time, and the caller sees its stop
+        // flag when the tick wakes (at most one period later)
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, nullptr) == EINTR) {
+        }
+    }
+#endif
+    return Clock::now();
+}
+
+TickPacer::TickPacer(Clock::duration period, Clock::time_point start)
+    : period_(period)
+    , deadline_(start + period)
+    , latenessUs_(0.01)
+    , missed_(0) {
+    if (period <= Clock::duration::zero()) {
+        throw std::invalid_argument("Tick period must be positive");
+    }
+}
+
+uint64_t TickPacer::complete(Clock::time_point woke, Clock::time_point done) {
+    double latenessUs = std::chrono::duration<double, std::micro>(woke - deadline_).count();
+    latenessUs_.add(latenessUs > 0.0 ? latenessUs : 0.0);
+
+    deadline_ += period_;
+    if (done < deadline_) {
+        return 0;
+    }
+    // Skip to the first deadline still ahead
+    uint64_t skipped = static_cast<uint64_t>((done - deadline_) / period_) + 1;
+    deadline_ += period_ * static_cast<Clock::rep>(skipped);
+    missed_ += skipped;
+    return skipped;
+}
+
+JitterStats TickPacer::stats() const {
+    JitterStats stats;
+    stats.ticks = latenessUs_.count();
+    stats.missed = missed_;
+    if (stats.ticks > 0) {
+        stats.meanUs = latenessUs_.sum() / static_cast<double>(stats.ticks);
+        stats.p50Us = latenessUs_.quantile(0.5);
+        stats.p99Us = latenessUs_.quantile(0.99);
+        stats.maxUs = latenessUs_.max();
+    }
+    return stats;
+}
+
+}  // namespace WinHKMon
@@ -0,0 +1,162 @@
+#include "WinHKMonLib/KernelResourceMonitor.h"
+#include "WinHKMonLib/Tracer.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace WinHKMon {
+
+namespace {
+
+size_t hostPageBytes() {
+#ifdef _WIN32
+    return 4096;
+#else
+    long pageBytes = sysconf(_SC_PAGESIZE);
+    return pageBytes > 0 ? static_cast<size_t>(pageBytes) : 4096;
+#endif
+}
+
+// Hard limit (third value) of a "min pressure max" sysctl such as tcp_mem; 0 if unreadable
+uint64_t memoryLimitPages(const fs::path& path) {
+    std::ifstream file(path);
+    uint64_t min = 0;
+    uint64_t pressure = 0;
+    uint64_t max = 0;
+    if (!(file >> min >> pressure >> max)) {
+        return 0;
+    }
+    return max;
+}
+
+std::unique_ptr<CachedFile> openIfPresent(const fs::path& path) {
+    std::error_code error;
+    if (!fs::exists(path, error)) {
+        return nullptr;
+    }
+    return std::make_unique<CachedFile>(path.string());
+}
+
+}  // anonymous namespace
+
+KernelResourceMonitor::KernelResourceMonitor(std::string procRoot, size_t pageBytes)
+    : procRoot_(std::move(procRoot))
+    , pageBytes_(pageBytes != 0 ? pageBytes : hostPageBytes())
+    , performanceInfo_(false)
+    , tcpMemoryMaxPages_(0)
+    , udpMemoryMaxPages_(0) {
+}
+
+KernelResourceMonitor::~KernelResourceMonitor() = default;
+
+void KernelResourceMonitor::initialize() {
+#ifdef _WIN32
+    PERFORMANCE_INFORMATION info = {};
+    performanceInfo_ = GetPerformanceInfo(&info, sizeof(info)) != FALSE;
+#endif
+
+    fs::path root(procRoot_);
+    fileNr_ = openIfPresent(root / "sys" / "fs" / "file-nr");
+    sockstat_ = openIfPresent(root / "net" / "sockstat");
+    sockstat6_ = openIfPresent(root / "net" / "sockstat6");
+    tcpMemoryMaxPages_ = memoryLimitPages(root / "sys" / "net" / "ipv4" / "tcp_mem");
+    udpMemoryMaxPages_ = memoryLimitPages(root / "sys" / "net" / "ipv4" / "udp_mem");
+
+    if (!performanceInfo_ && !fileNr_ && !sockstat_ && !sockstat6_) {
+        throw std::runtime_error("No kernel resource counters (GetPerformanceInfo or '" + procRoot_ +
+                                 "/sys/fs/file-nr', '" + procRoot_ + "/net/sockstat')");
+    }
+}
+
+KernelResourceStats KernelResourceMonitor::getCurrentStats() {
+    WINHKMON_TRACE_SPAN("collect", "kres-read");
+    KernelResourceStats stats;
+
+#ifdef _WIN32
+    if (performanceInfo_) {
+        PERFORMANCE_INFORMATION info = {};
+        if (GetPerformanceInfo(&info, sizeof(info))) {
+            stats.handleCount = info.HandleCount;
+            stats.threadCount = info.ThreadCount;
+            stats.processCount = info.ProcessCount;
+        }
+    }
+#endif
+
+    // "allocated  unused  max" (unused is always 0 on current kernels)
+    if (fileNr_ && fileNr_->read(buffer_)) {
+        std::istringstream fields(buffer_);
+        uint64_t allocated = 0;
+        uint64_t unused = 0;
+        uint64_t max = 0;
+        if (fields >> allocated >> unused >> max) {
+            stats.fileHandlesAllocated = allocated - std::min(unused, allocated);
+            stats.fileHandlesMax = max;
+            stats.fileHandlePercent = max > 0
+                ? static_cast<double>(*stats.fileHandlesAllocated) / static_cast<double>(max) * 100.0
+                : 0.0;
+        }
+    }
+
+    // "TCP: inuse 12 orphan 0 tw 3 alloc 15 mem 2" (mem in pages, FRAG memory in bytes)
+    auto parseSockstat = [this, &stats](const std::string& text) {
+        std::istringstream lines(text);
+        std::string line;
+        while (std::getline(lines, line)) {
+            std::istringstream words(line);
+            std::string label;
+            words >> label;
+            if (label.empty() || label.back() != ':') {
+                continue;
+            }
+            label.pop_back();
+
+            SocketProtocolStats protocol;
+            protocol.protocol = label;
+            protocol.inUse = 0;
+            std::string key;
+            uint64_t value = 0;
+            while (words >> key >> value) {
+                if (key == "used" || key == "inuse") {
+                    protocol.inUse = value;
+                } else if (key == "mem") {
+                    protocol.memoryBytes = value * pageBytes_;
+                    uint64_t limit = label == "TCP" ? tcpMemoryMaxPages_
+                                   : label == "UDP" ? udpMemoryMaxPages_ : 0;
+                    if (limit > 0) {
+                        protocol.memoryPercent = static_cast<double>(value) / static_cast<double>(limit) * 100.0;
+                    }
+                } else if (key == "memory") {
+                    protocol.memoryBytes = value;
+                }
+            }
+            if (label == "sockets") {
+                stats.socketsUsed = protocol.inUse;
+            } else {
+                stats.protocols.push_back(protocol);
+            }
+        }
+    };
+    if (sockstat_ && sockstat_->read(buffer_)) {
+        parseSockstat(buffer_);
+    }
+    if (sockstat6_ && sockstat6_->read(buffer_)) {
+        parseSockstat(buffer_);
+    }
+    return stats;
+}
+
+}  // namespace WinHKMon
@@ -0,0 +1,106 @@
+#include "WinHKMonLib/LowImpact.h"
+#include <windows.h>
+#include <psapi.h>
+#include <stdexcept>
+
+namespace WinHKMon {
+
+namespace {
+
+// Stack depth touched before locking (covers collect/format/write call chains)
+constexpr size_t PREFAULT_STACK_BYTES = 64 * 1024;
+
+constexpr size_t PAGE_BYTES = 4096;
+
+std::string lastErrorMessage(const std::string& what) {
+    return what + " failed (error " + std::to_string(GetLastError()) + ")";
+}
+
+// Commit and touch stack pages now so deep calls on the hot path do not fault
+void prefaultStack() {
+    volatile char reserve[PREFAULT_STACK_BYTES];
+    for (size_t offset = 0; offset < PREFAULT_STACK_BYTES; offset += PAGE_BYTES) {
+        reserve[offset] = 0;
+    }
+}
+
+}  // anonymous namespace
+
+uint64_t cpuListToAffinityMask(const std::vector<unsigned>& cpus) {
+    uint64_t mask = 0;
+    for (unsigned cpu : cpus) {
+        if (cpu >= 64) {
+            throw std::invalid_argument("CPU " + std::to_string(cpu) +
+                                        " is outside the affinity mask (0-63)");
+        }
+        mask |= 1ULL << cpu;
+    }
+    return mask;
+}
+
+LowImpactStatus enterLowImpactMode(const std::vector<unsigned>& housekeepingCpus) {
+    LowImpactStatus status;
+    HANDLE process = GetCurrentProcess();
+
+    if (SetPriorityClass(process, IDLE_PRIORITY_CLASS)) {
+        status.idlePriority = true;
+    } else {
+        status.warnings.push_back(lastErrorMessage("Setting idle priority class"));
+    }
+
+    if (!housekeepingCpus.empty()) {
+        DWORD_PTR processMask = 0;
+        DWORD_PTR systemMask = 0;
+        GetProcessAffinityMask(process, &processMask, &systemMask);
+        DWORD_PTR requested = static_cast<DWORD_PTR>(cpuListToAffinityMask(housekeepingCpus));
+        DWORD_PTR effective = requested & systemMask;
+
+        if (effective == 0) {
+            status.warnings.push_back("None of the --cpu-set CPUs exist on this system; not pinning");
+        } else if (SetProcessAffinityMask(process, effective)) {
+            status.affinityPinned = true;
+            if (effective != requested) {
+                status.warnings.push_back("Some --cpu-set CPUs do not exist on this system; ignored");
+            }
+        } else {
+            status.warnings.push_back(lastErrorMessage("Setting process affinity"));
+        }
+    }
+
+    if (enterBackgroundIo()) {
+        status.backgroundIo = true;
+    } else {
+        status.warnings.push_back(lastErrorMessage("Entering background I/O mode"));
+    }
+
+    return status;
+}
+
+bool enterBackgroundIo() {
+    return SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN) != 0;
+}
+
+bool lockWorkingSet(size_t headroomBytes, LowImpactStatus& status) {
+    prefaultStack();
+
+    PROCESS_MEMORY_COUNTERS pmc{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        status.warnings.push_back(lastErrorMessage("Querying working set"));
+        return false;
+    }
+
+    // Hard minimum keeps these pages resident; the maximum stays soft so
+    // unexpected growth is still possible (and trimmable) rather than fatal
+    SIZE_T minimum = pmc.WorkingSetSize + headroomBytes;
+    SIZE_T maximum = minimum + headroomBytes;
+    if (!SetProcessWorkingSetSizeEx(GetCurrentProcess(), minimum, maximum,
+                                    QUOTA_LIMITS_HARDWS_MIN_ENABLE | QUOTA_LIMITS_HARDWS_MAX_DISABLE)) {
+        status.warnings.push_back(lastErrorMessage("Locking working set"));
+        return false;
+    }
+
+    status.workingSetLocked = true;
+    return true;
+}
+
+}  // namespace WinHKMon
@@ -1,10 +1,122 @@
 #include "WinHKMonLib/MemoryMonitor.h"
-#include <windows.h>
+#include "WinHKMonLib/DeltaCalculator.h"
+#include "WinHKMonLib/Tracer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
 #include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace fs = std::filesystem;
 
 namespace WinHKMon {
 
+namespace {
+
+/**
+ * @brief Calls visit(key, value) for each "key<separator> value" line, in one pass
+ */
+template <typename Visitor>
+void forEachLine(const std::string& text, char separator, Visitor visit) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        size_t split = text.find(separator, pos);
+        if (split != std::string::npos && split < end) {
+            visit(std::string_view(text).substr(pos, split - pos), std::strtoull(text.c_str() + split + 1, nullptr, 10));
+        }
+        pos = end + 1;
+    }
+}
+
+// Single value of a sysfs attribute file; 0 if unreadable
+uint64_t readValue(CachedFile& file, std::string& buffer) {
+    return file.read(buffer) ? std::strtoull(buffer.c_str(), nullptr, 10) : 0;
+}
+
+double percentOf(uint64_t part, uint64_t total) {
+    return total > 0 ? static_cast<double>(part) / static_cast<double>(total) * 100.0 : 0.0;
+}
+
+}  // anonymous namespace
+
+MemoryMonitor::MemoryMonitor(std::string procRoot, std::string hugePageRoot)
+    : primed_(false)
+    , thpFaults_(0)
+    , thpFallbacks_(0)
+    , compactStalls_(0) {
+    std::error_code error;
+    fs::path root(procRoot);
+    if (fs::exists(root / "meminfo", error)) {
+        meminfo_ = std::make_unique<CachedFile>((root / "meminfo").string());
+        vmstat_ = std::make_unique<CachedFile>((root / "vmstat").string());
+        openHugePagePools(hugePageRoot);
+    }
+}
+
+MemoryMonitor::~MemoryMonitor() = default;
+
+void MemoryMonitor::openHugePagePools(const std::string& hugePageRoot) {
+    // The default size is already in meminfo
+    uint64_t defaultPageBytes = 0;
+    if (meminfo_->read(buffer_)) {
+        forEachLine(buffer_, ':', [&](std::string_view key, uint64_t value) {
+            if (key == "Hugepagesize") {
+                defaultPageBytes = value * 1024;
+            }
+        });
+    }
+
+    std::error_code error;
+    fs::directory_iterator it(hugePageRoot, error);
+    if (error) {
+        return;
+    }
+    for (; it != fs::directory_iterator(); it.increment(error)) {
+        if (error) {
+            break;
+        }
+        // hugepages-1048576kB
+        std::string name = it->path().filename().string();
+        if (name.compare(0, 10, "hugepages-") != 0) {
+            continue;
+        }
+        uint64_t pageBytes = std::strtoull(name.c_str() + 10, nullptr, 10) * 1024;
+        if (pageBytes == 0 || pageBytes == defaultPageBytes) {
+            continue;
+        }
+
+        // Empty pools are kept too: pages can be allocated to them at any time
+        HugePagePool pool;
+        pool.pageBytes = pageBytes;
+        pool.total = std::make_unique<CachedFile>((it->path() / "nr_hugepages").string());
+        pool.free = std::make_unique<CachedFile>((it->path() / "free_hugepages").string());
+        pool.reserved = std::make_unique<CachedFile>((it->path() / "resv_hugepages").string());
+        pool.surplus = std::make_unique<CachedFile>((it->path() / "surplus_hugepages").string());
+        pools_.push_back(std::move(pool));
+    }
+    std::sort(pools_.begin(), pools_.end(),
+              [](const HugePagePool& a, const HugePagePool& b) { return a.pageBytes < b.pageBytes; });
+}
+
 MemoryStats MemoryMonitor::getCurrentStats() {
+    return getCurrentStats(std::chrono::steady_clock::now());
+}
+
+MemoryStats MemoryMonitor::getCurrentStats(std::chrono::steady_clock::time_point now) {
+    // Populate MemoryStats structure
+    MemoryStats stats{};
+
+#ifdef _WIN32
     // Initialize structure for GlobalMemoryStatusEx
     MEMORYSTATUSEX memStatus;
     memStatus.dwLength = sizeof(MEMORYSTATUSEX);
@@ -14,34 +126,28 @@ MemoryStats MemoryMonitor::getCurrentStats() {
         throw std::runtime_error("GlobalMemoryStatusEx failed");
     }
 
-    // Populate MemoryStats structure
-    MemoryStats stats;
-    
     // Physical memory
     stats.totalPhysicalBytes = memStatus.ullTotalPhys;
     stats.availablePhysicalBytes = memStatus.ullAvailPhys;
-    stats.usedPhysicalBytes = stats.totalPhysicalBytes - stats.availablePhysicalBytes;
-    
-    // Calculate physical memory usage percentage
-    if (stats.totalPhysicalBytes > 0) {
-        stats.usagePercent = (static_cast<double>(stats.usedPhysicalBytes) / 
-                             stats.totalPhysicalBytes) * 100.0;
-    } else {
-        stats.usagePercent = 0.0;
-    }
 
     // Page file (virtual memory)
     stats.totalPageFileBytes = memStatus.ullTotalPageFile;
     stats.availablePageFileBytes = memStatus.ullAvailPageFile;
-    stats.usedPageFileBytes = stats.totalPageFileBytes - stats.availablePageFileBytes;
-    
-    // Calculate page file usage percentage
-    if (stats.totalPageFileBytes > 0) {
-        stats.pageFilePercent = (static_cast<double>(stats.usedPageFileBytes) / 
-                                stats.totalPageFileBytes) * 100.0;
-    } else {
-        stats.pageFilePercent = 0.0;
+
+    readProcMemory(stats, now);
+#else
+    // RAM and swap come from the same meminfo pass as the huge pages
+    if (!readProcMemory(stats, now)) {
+        throw std::runtime_error("Cannot read meminfo");
     }
+#endif
+
+    stats.usedPhysicalBytes = stats.totalPhysicalBytes - stats.availablePhysicalBytes;
+    stats.usedPageFileBytes = stats.totalPageFileBytes - stats.availablePageFileBytes;
+
+    // Usage percentages
+    stats.usagePercent = percentOf(stats.usedPhysicalBytes, stats.totalPhysicalBytes);
+    stats.pageFilePercent = percentOf(stats.usedPageFileBytes, stats.totalPageFileBytes);
 
     // Optional fields: Not populated in v1.0
     // stats.cachedBytes - Would require additional API calls (GetPerformanceInfo)
@@ -50,5 +156,101 @@ MemoryStats MemoryMonitor::getCurrentStats() {
     return stats;
 }
 
-}  // namespace WinHKMon
+bool MemoryMonitor::readProcMemory(MemoryStats& stats, std::chrono::steady_clock::time_point now) {
+    if (!meminfo_) {
+        return false;
+    }
+    WINHKMON_TRACE_SPAN("collect", "meminfo-read");
+    if (!meminfo_->read(buffer_)) {
+        return false;
+    }
+
+    HugePageStats huge{};
+    HugePagePoolStats defaultPool{};
+    uint64_t memTotal = 0;
+    uint64_t memAvailable = 0;
+    uint64_t swapTotal = 0;
+    uint64_t swapFree = 0;
+    forEachLine(buffer_, ':', [&](std::string_view key, uint64_t value) {
+        if (key == "MemTotal") {
+            memTotal = value * 1024;
+        } else if (key == "MemAvailable") {
+            memAvailable = value * 1024;
+        } else if (key == "SwapTotal") {
+            swapTotal = value * 1024;
+        } else if (key == "SwapFree") {
+            swapFree = value * 1024;
+        } else if (key == "AnonHugePages") {
+            huge.anonHugeBytes = value * 1024;
+        } else if (key == "HugePages_Total") {
+            defaultPool.totalPages = value;
+        } else if (key == "HugePages_Free") {
+            defaultPool.freePages = value;
+        } else if (key == "HugePages_Rsvd") {
+            defaultPool.reservedPages = value;
+        } else if (key == "HugePages_Surp") {
+            defaultPool.surplusPages = value;
+        } else if (key == "Hugepagesize") {
+            defaultPool.pageBytes = value * 1024;
+        }
+    });
+
+#ifndef _WIN32
+    stats.totalPhysicalBytes = memTotal;
+    stats.availablePhysicalBytes = memAvailable;
+    stats.totalPageFileBytes = swapTotal;
+    stats.availablePageFileBytes = swapFree;
+#endif
+
+    if (defaultPool.pageBytes > 0) {
+        huge.pools.push_back(defaultPool);
+    }
+    for (HugePagePool& pool : pools_) {
+        HugePagePoolStats poolStats{};
+        poolStats.pageBytes = pool.pageBytes;
+        poolStats.totalPages = readValue(*pool.total, buffer_);
+        if (poolStats.totalPages == 0) {
+            continue;  // Empty: one read per tick, and not listed
+        }
+        poolStats.freePages = readValue(*pool.free, buffer_);
+        poolStats.reservedPages = readValue(*pool.reserved, buffer_);
+        poolStats.surplusPages = readValue(*pool.surplus, buffer_);
+        huge.pools.push_back(poolStats);
+    }
+
+    // THP counters (kernels without THP have none of them)
+    if (vmstat_->read(buffer_)) {
+        uint64_t faults = 0;
+        uint64_t fallbacks = 0;
+        uint64_t stalls = 0;
+        forEachLine(buffer_, ' ', [&](std::string_view key, uint64_t value) {
+            if (key == "thp_fault_alloc") {
+                faults = value;
+            } else if (key == "thp_fault_fallback") {
+                fallbacks = value;
+            } else if (key == "compact_stall") {
+                stalls = value;
+            }
+        });
+        if (primed_) {
+            DeltaCalculator deltaCalc;
+            double elapsedSeconds = std::chrono::duration<double>(now - previousTime_).count();
+            huge.thpFaultsPerSec = static_cast<uint64_t>(
+                deltaCalc.calculateRate(faults, thpFaults_, elapsedSeconds));
+            huge.thpFallbacksPerSec = static_cast<uint64_t>(
+                deltaCalc.calculateRate(fallbacks, thpFallbacks_, elapsedSeconds));
+            huge.compactStallsPerSec = static_cast<uint64_t>(
+                deltaCalc.calculateRate(stalls, compactStalls_, elapsedSeconds));
+        }
+        thpFaults_ = faults;
+        thpFallbacks_ = fallbacks;
+        compactStalls_ = stalls;
+        previousTime_ = now;
+        primed_ = true;
+    }
 
+    stats.hugePages = std::move(huge);
+    return true;
+}
+
+}  // namespace WinHKMon
@@ -0,0 +1,303 @@
+#include "WinHKMonLib/MetricsEngine.h"
+#include "WinHKMonLib/CollectorModule.h"
+#include "WinHKMonLib/CpuMonitor.h"
+#include "WinHKMonLib/DeltaCalculator.h"
+#include "WinHKMonLib/DiskMonitor.h"
+#include "WinHKMonLib/MemoryMonitor.h"
+#include "WinHKMonLib/NetworkMonitor.h"
+#include "WinHKMonLib/Tracer.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace WinHKMon {
+
+/**
+ * @brief Built-in collectors, started per field on first use
+ *
+ * Mirrors the CLI's collectMetrics(): network rates come from the previous
+ * pass that included the network (DeltaCalculator::applyInterfaceRates), disk
+ * totals are DiskMonitor's raw counters. A collector that throws leaves its
+ * field unset and its bit set in failedFields.
+ */
+class MetricsEngine::MonitorSet {
+public:
+    ~MonitorSet() {
+        if (cpu_) {
+            cpu_->cleanup();
+        }
+        if (disk_) {
+            disk_->cleanup();
+        }
+    }
+
+    // Start monitors for fields not seen before (takes their PDH baseline)
+    void prepare(uint32_t fieldMask) {
+        if ((fieldMask & FIELD_CPU) && !cpu_) {
+            cpu_ = std::make_unique<CpuMonitor>();
+            cpu_->initialize();
+        }
+        if ((fieldMask & FIELD_NETWORK) && !network_) {
+            network_ = std::make_unique<NetworkMonitor>();
+            network_->initialize();
+        }
+        if ((fieldMask & FIELD_DISK) && !disk_) {
+            disk_ = std::make_unique<DiskMonitor>();
+            disk_->initialize();
+        }
+    }
+
+    SystemMetrics collect(uint32_t fieldMask) {
+        WINHKMON_TRACE_SPAN("collect", "engine");
+        prepare(fieldMask);
+
+        SystemMetrics metrics;
+        metrics.timestamp = deltaCalc_.getCurrentTimestamp();
+
+        if (fieldMask & FIELD_CPU) {
+            try {
+                metrics.cpu = cpu_->getCurrentStats();
+            } catch (const std::exception&) {
+                metrics.failedFields |= FIELD_CPU;
+            }
+        }
+
+        if (fieldMask & FIELD_MEMORY) {
+            try {
+                metrics.memory = memory_.getCurrentStats();
+            } catch (const std::exception&) {
+                metrics.failedFields |= FIELD_MEMORY;
+            }
+        }
+
+        if (fieldMask & FIELD_NETWORK) {
+            try {
+                std::vector<InterfaceStats> interfaces = network_->getCurrentStats();
+                double elapsed = deltaCalc_.calculateElapsedSeconds(
+                    metrics.timestamp, previousNetworkTimestamp_, frequency_);
+                deltaCalc_.applyInterfaceRates(interfaces, previousNetwork_, elapsed);
+                previousNetwork_ = interfaces;
+                previousNetworkTimestamp_ = metrics.timestamp;
+                metrics.network = std::move(interfaces);
+            } catch (const std::exception&) {
+                metrics.failedFields |= FIELD_NETWORK;
+            }
+        }
+
+        if (fieldMask & FIELD_DISK) {
+            try {
+                metrics.disks = disk_->getCurrentStats();
+            } catch (const std::exception&) {
+                metrics.failedFields |= FIELD_DISK;
+            }
+        }
+
+        if ((fieldMask & FIELD_MODULES) && !modules_.empty()) {
+            modules_.sample(metrics.modules.emplace(), [&metrics](const std::exception&) {
+                metrics.failedFields |= FIELD_MODULES;
+            });
+        }
+
+        return metrics;
+    }
+
+    uint32_t loadModule(const std::string& path) {
+        return modules_.load(path);
+    }
+
+private:
+    std::unique_ptr<CpuMonitor> cpu_;
+    MemoryMonitor memory_;
+    std::unique_ptr<NetworkMonitor> network_;
+    std::unique_ptr<DiskMonitor> disk_;
+    ModuleSet modules_;
+    DeltaCalculator deltaCalc_;
+    uint64_t frequency_ = deltaCalc_.getPerformanceFrequency();
+
+    std::vector<InterfaceStats> previousNetwork_;
+    uint64_t previousNetworkTimestamp_ = 0;
+};
+
+MetricsEngine::MetricsEngine()
+    : monitors_(std::make_unique<MonitorSet>())
+    , epoch_(Clock::now())
+    , nextId_(1)
+    , passCount_(0)
+    , stopping_(false) {
+    MonitorSet* monitors = monitors_.get();
+    collector_ = [monitors](uint32_t fieldMask) { return monitors->collect(fieldMask); };
+}
+
+MetricsEngine::MetricsEngine(FieldCollector collector)
+    : collector_(std::move(collector))
+    , epoch_(Clock::now())
+    , nextId_(1)
+    , passCount_(0)
+    , stopping_(false) {
+    if (!collector_) {
+        throw std::invalid_argument("MetricsEngine requires a collector");
+    }
+}
+
+MetricsEngine::~MetricsEngine() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+MetricsEngine::SubscriptionId MetricsEngine::subscribe(uint32_t fieldMask, double intervalSeconds,
+                                                       FrameCallback callback) {
+    if ((fieldMask & FIELD_ALL) == 0) {
+        throw std::invalid_argument("Subscription field mask selects no fields");
+    }
+    if (!(intervalSeconds > 0.0)) {
+        throw std::invalid_argument("Subscription interval must be greater than 0");
+    }
+    if (!callback) {
+        throw std::invalid_argument("Subscription callback must not be empty");
+    }
+
+    if (monitors_) {
+        std::lock_guard<std::mutex> collectLock(collectMutex_);
+        monitors_->prepare(fieldMask);
+    }
+
+    auto subscription = std::make_shared<Subscription>();
+    subscription->fieldMask = fieldMask & FIELD_ALL;
+    subscription->interval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(intervalSeconds));
+    subscription->nextDue = nextGridPoint(subscription->interval, Clock::now());
+    subscription->callback = std::move(callback);
+
+    SubscriptionId id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        id = nextId_++;
+        subscription->id = id;
+        subscriptions_.push_back(std::move(subscription));
+        if (!worker_.joinable()) {
+            worker_ = std::thread(&MetricsEngine::run, this);
+        }
+    }
+    wake_.notify_all();
+    return id;
+}
+
+bool MetricsEngine::unsubscribe(SubscriptionId id) {
+    bool onWorker = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find_if(subscriptions_.begin(), subscriptions_.end(),
+            [id](const std::shared_ptr<Subscription>& s) { return s->id == id; });
+        if (it == subscriptions_.end()) {
+            return false;
+        }
+        (*it)->active.store(false);
+        subscriptions_.erase(it);
+        onWorker = std::this_thread::get_id() == worker_.get_id();
+    }
+    wake_.notify_all();
+
+    // Wait for an in-flight delivery (the worker itself must not block here)
+    if (!onWorker) {
+        std::lock_guard<std::mutex> delivery(deliveryMutex_);
+    }
+    return true;
+}
+
+MetricsFrame MetricsEngine::sample(uint32_t fieldMask) {
+    return collect(fieldMask & FIELD_ALL);
+}
+
+uint32_t MetricsEngine::loadModule(const std::string& path) {
+    if (!monitors_) {
+        throw std::runtime_error("Modules need the built-in collectors");
+    }
+    std::lock_guard<std::mutex> collectLock(collectMutex_);
+    return monitors_->loadModule(path);
+}
+
+uint64_t MetricsEngine::passCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return passCount_;
+}
+
+MetricsEngine::Clock::time_point MetricsEngine::nextGridPoint(Clock::duration interval,
+                                                             Clock::time_point after) const {
+    auto periods = (after - epoch_) / interval;
+    return epoch_ + (periods + 1) * interval;
+}
+
+MetricsFrame MetricsEngine::collect(uint32_t fieldMask) {
+    MetricsFrame frame;
+    {
+        std::lock_guard<std::mutex> collectLock(collectMutex_);
+        frame = std::make_shared<const SystemMetrics>(collector_(fieldMask));
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    passCount_++;
+    return frame;
+}
+
+void MetricsEngine::run() {
+    if (Tracer::instance().isEnabled()) {
+        Tracer::instance().setThreadName("metrics-engine");
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!stopping_) {
+        if (subscriptions_.empty()) {
+            wake_.wait(lock);
+            continue;
+        }
+
+        Clock::time_point earliest = Clock::time_point::max();
+        for (const auto& s : subscriptions_) {
+            earliest = std::min(earliest, s->nextDue);
+        }
+        if (Clock::now() < earliest) {
+            // Woken early by subscribe/unsubscribe/stop: re-evaluate
+            wake_.wait_until(lock, earliest);
+            continue;
+        }
+
+        // Everyone due within the coalescing window shares this pass
+        Clock::time_point now = Clock::now();
+        std::vector<std::shared_ptr<Subscription>> due;
+        uint32_t unionMask = 0;
+        for (const auto& s : subscriptions_) {
+            if (s->nextDue <= now + COALESCE_WINDOW) {
+                due.push_back(s);
+                unionMask |= s->fieldMask;
+                // Stay on the grid; skip missed periods rather than bursting
+                s->nextDue += s->interval;
+                if (s->nextDue <= now) {
+                    s->nextDue = nextGridPoint(s->interval, now);
+                }
+            }
+        }
+
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> delivery(deliveryMutex_);
+            MetricsFrame frame = collect(unionMask);
+            for (const auto& s : due) {
+                if (!s->active.load()) {
+                    continue;
+                }
+                try {
+                    s->callback(frame);
+                } catch (...) {
+                    // A failing subscriber must not stop the others
+                }
+            }
+        }
+        lock.lock();
+    }
+}
+
+}  // namespace WinHKMon
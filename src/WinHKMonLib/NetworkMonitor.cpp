@@ -3,7 +3,7 @@
  * @brief Network interface statistics monitoring implementation
  * 
  * Uses Windows IP Helper API (GetIfTable2) to enumerate network interfaces
- * and collect traffic statistics.
+ * and collect traffic statistics; selected interfaces are read with GetIfEntry2.
  */
 
 // Define Windows version BEFORE any system headers
@@ -31,6 +31,7 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cstring>
+#include <utility>
 
 // Link against IP Helper API and Winsock
 #pragma comment(lib, "iphlpapi.lib")
@@ -55,9 +56,69 @@ void NetworkMonitor::initialize() {
     }
 }
 
+namespace {
+
+/**
+ * @brief Counters and state of one interface row (rates are left to the caller)
+ */
+InterfaceStats rowStats(const MIB_IF_ROW2& ifaceRow, std::string name, std::string description) {
+    InterfaceStats stats;
+    
+    // Interface identification
+    stats.name = std::move(name);  // User-friendly name (e.g., "Ethernet", "Wi-Fi")
+    stats.description = std::move(description);  // Hardware description
+    
+    // Connection state
+    stats.isConnected = (ifaceRow.MediaConnectState == MediaConnectStateConnected);
+    
+    // Link speed (bits per second)
+    stats.linkSpeedBitsPerSec = ifaceRow.TransmitLinkSpeed;  // or ReceiveLinkSpeed (typically same)
+    
+    // Cumulative traffic counters (octets = bytes)
+    stats.totalInOctets = ifaceRow.InOctets;
+    stats.totalOutOctets = ifaceRow.OutOctets;
+    
+    // Rate calculations (set to 0 initially, caller will use DeltaCalculator)
+    stats.inBytesPerSec = 0;
+    stats.outBytesPerSec = 0;
+    
+    // Optional packet-level stats (if available)
+    if (ifaceRow.InUcastPkts != 0 || ifaceRow.InNUcastPkts != 0) {
+        stats.inPacketsPerSec = 0;  // Will be calculated by caller
+    }
+    if (ifaceRow.OutUcastPkts != 0 || ifaceRow.OutNUcastPkts != 0) {
+        stats.outPacketsPerSec = 0;  // Will be calculated by caller
+    }
+    
+    // Error counters
+    if (ifaceRow.InErrors != 0) {
+        stats.inErrors = ifaceRow.InErrors;
+    }
+    if (ifaceRow.OutErrors != 0) {
+        stats.outErrors = ifaceRow.OutErrors;
+    }
+    
+    return stats;
+}
+
+}  // anonymous namespace
+
 std::vector<InterfaceStats> NetworkMonitor::getCurrentStats() {
     std::vector<InterfaceStats> interfaces;
     
+    // Selected interfaces: one row each, no table
+    if (selected_) {
+        interfaces.reserve(selectedInterfaces_.size());
+        for (const SelectedInterface& selected : selectedInterfaces_) {
+            MIB_IF_ROW2 ifaceRow{};
+            ifaceRow.InterfaceLuid.Value = selected.luid;
+            if (GetIfEntry2(&ifaceRow) == NO_ERROR) {
+                interfaces.push_back(rowStats(ifaceRow, selected.name, selected.description));
+            }
+        }
+        return interfaces;
+    }
+    
     // Get network interface table
     PMIB_IF_TABLE2 pIfTable = nullptr;
     DWORD result = GetIfTable2(&pIfTable);
@@ -74,54 +135,51 @@ std::vector<InterfaceStats> NetworkMonitor::getCurrentStats() {
     
     // Enumerate all interfaces
     for (ULONG i = 0; i < pIfTable->NumEntries; i++) {
-        MIB_IF_ROW2 ifaceRow = pIfTable->Table[i];
+        const MIB_IF_ROW2& ifaceRow = pIfTable->Table[i];
         
-        // Skip loopback interfaces
-        if (isLoopback(ifaceRow.Type)) {
+        // Skip loopback interfaces unless a caller named one
+        if (isLoopback(ifaceRow.Type) && !includeLoopback_) {
             continue;
         }
         
-        // Create InterfaceStats entry
-        InterfaceStats stats;
-        
-        // Interface identification
-        stats.name = wideToUtf8(ifaceRow.Alias);  // User-friendly name (e.g., "Ethernet", "Wi-Fi")
-        stats.description = wideToUtf8(ifaceRow.Description);  // Hardware description
-        
-        // Connection state
-        stats.isConnected = (ifaceRow.MediaConnectState == MediaConnectStateConnected);
-        
-        // Link speed (bits per second)
-        stats.linkSpeedBitsPerSec = ifaceRow.TransmitLinkSpeed;  // or ReceiveLinkSpeed (typically same)
-        
-        // Cumulative traffic counters (octets = bytes)
-        stats.totalInOctets = ifaceRow.InOctets;
-        stats.totalOutOctets = ifaceRow.OutOctets;
-        
-        // Rate calculations (set to 0 initially, caller will use DeltaCalculator)
-        stats.inBytesPerSec = 0;
-        stats.outBytesPerSec = 0;
-        
-        // Optional packet-level stats (if available)
-        if (ifaceRow.InUcastPkts != 0 || ifaceRow.InNUcastPkts != 0) {
-            stats.inPacketsPerSec = 0;  // Will be calculated by caller
-        }
-        if (ifaceRow.OutUcastPkts != 0 || ifaceRow.OutNUcastPkts != 0) {
-            stats.outPacketsPerSec = 0;  // Will be calculated by caller
+        interfaces.push_back(rowStats(ifaceRow, wideToUtf8(ifaceRow.Alias), wideToUtf8(ifaceRow.Description)));
+    }
+    
+    return interfaces;
+}
+
+void NetworkMonitor::selectInterfaces(const std::vector<std::string>& names) {
+    PMIB_IF_TABLE2 pIfTable = nullptr;
+    DWORD result = GetIfTable2(&pIfTable);
+    if (result != NO_ERROR) {
+        throw std::runtime_error("GetIfTable2 failed with error " + std::to_string(result));
+    }
+    struct TableGuard {
+        PMIB_IF_TABLE2 table;
+        ~TableGuard() { if (table) FreeMibTable(table); }
+    } guard{pIfTable};
+    
+    std::vector<SelectedInterface> selected;
+    for (ULONG i = 0; i < pIfTable->NumEntries; i++) {
+        const MIB_IF_ROW2& ifaceRow = pIfTable->Table[i];
+        if (isLoopback(ifaceRow.Type) && names.empty()) {
+            continue;
         }
-        
-        // Error counters
-        if (ifaceRow.InErrors != 0) {
-            stats.inErrors = ifaceRow.InErrors;
+        std::string name = wideToUtf8(ifaceRow.Alias);
+        if (names.empty() || std::find(names.begin(), names.end(), name) != names.end()) {
+            selected.push_back({ifaceRow.InterfaceLuid.Value, name, wideToUtf8(ifaceRow.Description)});
         }
-        if (ifaceRow.OutErrors != 0) {
-            stats.outErrors = ifaceRow.OutErrors;
+    }
+    for (const std::string& name : names) {
+        auto it = std::find_if(selected.begin(), selected.end(),
+            [&name](const SelectedInterface& iface) { return iface.name == name; });
+        if (it == selected.end()) {
+            throw std::runtime_error("Network interface '" + name + "' not found");
         }
-        
-        interfaces.push_back(stats);
     }
     
-    return interfaces;
+    selectedInterfaces_ = std::move(selected);
+    selected_ = true;
 }
 
 std::string NetworkMonitor::selectPrimaryInterface(const std::vector<InterfaceStats>& interfaces) {
@@ -0,0 +1,129 @@
+#include "WinHKMonLib/NumaMonitor.h"
+#include "WinHKMonLib/DeltaCalculator.h"
+#include "WinHKMonLib/Tracer.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace WinHKMon {
+
+namespace {
+
+// "Node 0 MemFree:   123456 kB" -> bytes; 0 if absent
+uint64_t meminfoBytes(const std::string& text, const char* key) {
+    std::string needle = std::string(" ") + key + ":";
+    size_t pos = text.find(needle);
+    if (pos == std::string::npos) {
+        return 0;
+    }
+    return std::strtoull(text.c_str() + pos + needle.size(), nullptr, 10) * 1024;
+}
+
+// "numa_hit 123" line of numastat; 0 if absent
+uint64_t numastatValue(const std::string& text, const char* key) {
+    size_t keyLength = std::strlen(key);
+    size_t pos = 0;
+    while (pos < text.size()) {
+        if (text.compare(pos, keyLength, key) == 0 && pos + keyLength < text.size() &&
+            text[pos + keyLength] == ' ') {
+            return std::strtoull(text.c_str() + pos + keyLength + 1, nullptr, 10);
+        }
+        pos = text.find('\n', pos);
+        if (pos == std::string::npos) {
+            break;
+        }
+        pos++;
+    }
+    return 0;
+}
+
+// node<N> -> N, or -1 for other entries (cpu lists, power, has_memory, ...)
+int nodeId(const std::string& name) {
+    if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+        !std::all_of(name.begin() + 4, name.end(), [](unsigned char c) { return std::isdigit(c) != 0; })) {
+        return -1;
+    }
+    return std::atoi(name.c_str() + 4);
+}
+
+}  // anonymous namespace
+
+NumaMonitor::NumaMonitor(std::string root)
+    : root_(std::move(root)) {
+}
+
+NumaMonitor::~NumaMonitor() = default;
+
+void NumaMonitor::initialize() {
+    std::error_code error;
+    for (fs::directory_iterator it(root_, error), end; !error && it != end; it.increment(error)) {
+        int id = nodeId(it->path().filename().string());
+        if (id < 0 || !fs::exists(it->path() / "meminfo", error)) {
+            continue;
+        }
+        Node node;
+        node.id = id;
+        node.meminfo = std::make_unique<CachedFile>((it->path() / "meminfo").string());
+        node.numastat = std::make_unique<CachedFile>((it->path() / "numastat").string());
+        nodes_.push_back(std::move(node));
+    }
+    std::sort(nodes_.begin(), nodes_.end(), [](const Node& a, const Node& b) { return a.id < b.id; });
+
+    if (getCurrentStats().empty()) {
+        nodes_.clear();
+        throw std::runtime_error("No NUMA nodes under '" + root_ + "'");
+    }
+}
+
+std::vector<NumaNodeStats> NumaMonitor::getCurrentStats() {
+    return getCurrentStats(std::chrono::steady_clock::now());
+}
+
+std::vector<NumaNodeStats> NumaMonitor::getCurrentStats(std::chrono::steady_clock::time_point now) {
+    WINHKMON_TRACE_SPAN("collect", "numa-read");
+    DeltaCalculator deltaCalc;
+    std::vector<NumaNodeStats> stats;
+    stats.reserve(nodes_.size());
+    for (Node& node : nodes_) {
+        if (!node.meminfo->read(buffer_)) {
+            continue;
+        }
+        NumaNodeStats nodeStats{};
+        nodeStats.nodeId = node.id;
+        nodeStats.totalBytes = meminfoBytes(buffer_, "MemTotal");
+        nodeStats.freeBytes = meminfoBytes(buffer_, "MemFree");
+        nodeStats.fileBytes = meminfoBytes(buffer_, "FilePages");
+        nodeStats.anonBytes = meminfoBytes(buffer_, "AnonPages");
+
+        if (node.numastat->read(buffer_)) {
+            uint64_t hits = numastatValue(buffer_, "numa_hit");
+            uint64_t misses = numastatValue(buffer_, "numa_miss");
+            uint64_t foreign = numastatValue(buffer_, "numa_foreign");
+            if (node.primed) {
+                double elapsedSeconds = std::chrono::duration<double>(now - node.previousTime).count();
+                nodeStats.hitsPerSec = static_cast<uint64_t>(
+                    deltaCalc.calculateRate(hits, node.hits, elapsedSeconds));
+                nodeStats.missesPerSec = static_cast<uint64_t>(
+                    deltaCalc.calculateRate(misses, node.misses, elapsedSeconds));
+                nodeStats.foreignPerSec = static_cast<uint64_t>(
+                    deltaCalc.calculateRate(foreign, node.foreign, elapsedSeconds));
+            }
+            node.hits = hits;
+            node.misses = misses;
+            node.foreign = foreign;
+            node.previousTime = now;
+            node.primed = true;
+        }
+        stats.push_back(nodeStats);
+    }
+    return stats;
+}
+
+}  // namespace WinHKMon
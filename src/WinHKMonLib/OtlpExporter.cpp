@@ -0,0 +1,630 @@
+#ifdef _WIN32
+#define _WINSOCKAPI_
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "WinHKMonLib/OtlpExporter.h"
+#include "WinHKMonLib/Gzip.h"
+#include "WinHKMonLib/Tracer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace WinHKMon {
+
+namespace {
+
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+const SocketHandle NO_SOCKET = INVALID_SOCKET;
+void closeSocket(SocketHandle connection) { closesocket(connection); }
+#else
+using SocketHandle = int;
+const SocketHandle NO_SOCKET = -1;
+void closeSocket(SocketHandle connection) { close(connection); }
+#endif
+
+constexpr size_t RESPONSE_HEAD_BYTES = 1024;   // Enough for the status line
+
+uint64_t unixTimeNano() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+// Wall-clock time of the last boot, the origin of the OS counters
+uint64_t bootTimeUnixNano() {
+#ifdef _WIN32
+    uint64_t uptime = GetTickCount64() * 1000000ull;
+#elif defined(CLOCK_BOOTTIME)
+    timespec sinceBoot{};
+    clock_gettime(CLOCK_BOOTTIME, &sinceBoot);
+    uint64_t uptime = static_cast<uint64_t>(sinceBoot.tv_sec) * 1000000000ull +
+                      static_cast<uint64_t>(sinceBoot.tv_nsec);
+#else
+    uint64_t uptime = 0;
+#endif
+    uint64_t now = unixTimeNano();
+    return uptime < now ? now - uptime : 0;
+}
+
+std::string escapeJson(const std::string& str) {
+    std::string escaped;
+    escaped.reserve(str.size());
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(c));
+            escaped += code;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::string stringAttribute(const char* key, const std::string& value) {
+    return std::string("{\"key\":\"") + key + "\",\"value\":{\"stringValue\":\"" + escapeJson(value) + "\"}}";
+}
+
+// OTLP JSON carries 64-bit integers as strings
+std::string intAttribute(const char* key, int64_t value) {
+    return std::string("{\"key\":\"") + key + "\",\"value\":{\"intValue\":\"" + std::to_string(value) + "\"}}";
+}
+
+std::string joinAttributes(const std::string& first, const std::string& second) {
+    return first + "," + second;
+}
+
+/**
+ * @brief Data points grouped by metric, in first-seen order
+ */
+class MetricSet {
+public:
+    enum class Kind {
+        GAUGE,              ///< Sampled value
+        CUMULATIVE,         ///< Monotonic counter (start time per series)
+        UP_DOWN             ///< Non-monotonic sum (a current amount, e.g. bytes in use)
+    };
+
+    explicit MetricSet(CumulativeStarts& starts) : starts_(starts) {}
+
+    void addDouble(const char* name, const char* unit, Kind kind, const std::string& attributes,
+                   uint64_t timeUnixNano, double value) {
+        if (!std::isfinite(value)) {
+            return;
+        }
+        char number[32];
+        std::snprintf(number, sizeof(number), "%.10g", value);
+        addPoint(name, unit, kind, attributes, timeUnixNano, starts_.origin(),
+                 std::string("\"asDouble\":") + number);
+    }
+
+    void addInt(const char* name, const char* unit, Kind kind, const std::string& attributes,
+                uint64_t timeUnixNano, uint64_t value) {
+        uint64_t start = kind == Kind::CUMULATIVE
+            ? starts_.startFor(std::string(name) + '|' + attributes, timeUnixNano, value)
+            : starts_.origin();
+        addPoint(name, unit, kind, attributes, timeUnixNano, start, "\"asInt\":\"" + std::to_string(value) + "\"");
+    }
+
+    std::string json() const {
+        std::string out;
+        for (size_t i = 0; i < metrics_.size(); i++) {
+            const Metric& metric = metrics_[i];
+            if (i > 0) {
+                out += ',';
+            }
+            out += "{\"name\":\"";
+            out += metric.name;
+            out += "\",\"unit\":\"";
+            out += metric.unit;
+            out += "\",";
+            switch (metric.kind) {
+                case Kind::GAUGE:
+                    out += "\"gauge\":{";
+                    break;
+                case Kind::CUMULATIVE:
+                    out += "\"sum\":{\"aggregationTemporality\":2,\"isMonotonic\":true,";
+                    break;
+                case Kind::UP_DOWN:
+                    out += "\"sum\":{\"aggregationTemporality\":2,\"isMonotonic\":false,";
+                    break;
+            }
+            out += "\"dataPoints\":[";
+            out += metric.points;
+            out += "]}}";
+        }
+        return out;
+    }
+
+private:
+    struct Metric {
+        const char* name;
+        const char* unit;
+        Kind kind;
+        std::string points;
+    };
+
+    void addPoint(const char* name, const char* unit, Kind kind, const std::string& attributes,
+                  uint64_t timeUnixNano, uint64_t startUnixNano, const std::string& value) {
+        Metric* metric = nullptr;
+        for (Metric& existing : metrics_) {
+            if (std::strcmp(existing.name, name) == 0) {
+                metric = &existing;
+                break;
+            }
+        }
+        if (metric == nullptr) {
+            metrics_.push_back(Metric{name, unit, kind, std::string()});
+            metric = &metrics_.back();
+        } else {
+            metric->points += ',';
+        }
+
+        std::string& out = metric->points;
+        out += '{';
+        if (!attributes.empty()) {
+            out += "\"attributes\":[";
+            out += attributes;
+            out += "],";
+        }
+        if (kind != Kind::GAUGE) {
+            out += "\"startTimeUnixNano\":\"";
+            out += std::to_string(startUnixNano);
+            out += "\",";
+        }
+        out += "\"timeUnixNano\":\"";
+        out += std::to_string(timeUnixNano);
+        out += "\",";
+        out += value;
+        out += '}';
+    }
+
+    CumulativeStarts& starts_;
+    std::vector<Metric> metrics_;
+};
+
+void addSample(MetricSet& set, const SystemMetrics& metrics, uint64_t time) {
+    using Kind = MetricSet::Kind;
+
+    if (metrics.cpu) {
+        const CpuStats& cpu = *metrics.cpu;
+        if (cpu.cores.empty()) {
+            set.addDouble("system.cpu.utilization", "1", Kind::GAUGE, "", time, cpu.totalUsagePercent / 100.0);
+        }
+        for (const CoreStats& core : cpu.cores) {
+            std::string attributes = intAttribute("cpu.logical_number", core.coreId);
+            set.addDouble("system.cpu.utilization", "1", Kind::GAUGE, attributes, time, core.usagePercent / 100.0);
+            if (core.frequencyMhz > 0) {
+                set.addInt("system.cpu.frequency", "Hz", Kind::GAUGE, attributes, time,
+                           core.frequencyMhz * 1000000);
+            }
+        }
+    }
+
+    if (metrics.memory) {
+        const MemoryStats& memory = *metrics.memory;
+        set.addInt("system.memory.usage", "By", Kind::UP_DOWN, stringAttribute("system.memory.state", "used"),
+                   time, memory.usedPhysicalBytes);
+        set.addInt("system.memory.usage", "By", Kind::UP_DOWN, stringAttribute("system.memory.state", "free"),
+                   time, memory.availablePhysicalBytes);
+        if (memory.cachedBytes) {
+            set.addInt("system.memory.usage", "By", Kind::UP_DOWN,
+                       stringAttribute("system.memory.state", "cached"), time, *memory.cachedBytes);
+        }
+        set.addInt("system.memory.limit", "By", Kind::UP_DOWN, "", time, memory.totalPhysicalBytes);
+        set.addDouble("system.memory.utilization", "1", Kind::GAUGE,
+                      stringAttribute("system.memory.state", "used"), time, memory.usagePercent / 100.0);
+        if (memory.totalPageFileBytes > 0) {
+            set.addInt("system.paging.usage", "By", Kind::UP_DOWN, stringAttribute("system.paging.state", "used"),
+                       time, memory.usedPageFileBytes);
+            set.addInt("system.paging.usage", "By", Kind::UP_DOWN, stringAttribute("system.paging.state", "free"),
+                       time, memory.availablePageFileBytes);
+        }
+    }
+
+    if (metrics.disks) {
+        for (const DiskStats& disk : *metrics.disks) {
+            std::string device = stringAttribute("system.device", disk.deviceName);
+            set.addInt("system.disk.io", "By", Kind::CUMULATIVE,
+                       joinAttributes(device, stringAttribute("disk.io.direction", "read")), time,
+                       disk.totalBytesRead);
+            set.addInt("system.disk.io", "By", Kind::CUMULATIVE,
+                       joinAttributes(device, stringAttribute("disk.io.direction", "write")), time,
+                       disk.totalBytesWritten);
+            if (disk.totalSizeBytes > 0) {
+                set.addInt("system.filesystem.usage", "By", Kind::UP_DOWN,
+                           joinAttributes(device, stringAttribute("system.filesystem.state", "used")), time,
+                           disk.usedBytes);
+                set.addInt("system.filesystem.usage", "By", Kind::UP_DOWN,
+                           joinAttributes(device, stringAttribute("system.filesystem.state", "free")), time,
+                           disk.freeBytes);
+                set.addDouble("system.filesystem.utilization", "1", Kind::GAUGE, device, time,
+                              static_cast<double>(disk.usedBytes) / static_cast<double>(disk.totalSizeBytes));
+            }
+        }
+    }
+
+    if (metrics.network) {
+        for (const InterfaceStats& iface : *metrics.network) {
+            std::string name = stringAttribute("network.interface.name", iface.name);
+            std::string receive = joinAttributes(name, stringAttribute("network.io.direction", "receive"));
+            std::string transmit = joinAttributes(name, stringAttribute("network.io.direction", "transmit"));
+            set.addInt("system.network.io", "By", Kind::CUMULATIVE, receive, time, iface.totalInOctets);
+            set.addInt("system.network.io", "By", Kind::CUMULATIVE, transmit, time, iface.totalOutOctets);
+            if (iface.inErrors) {
+                set.addInt("system.network.errors", "{error}", Kind::CUMULATIVE, receive, time, *iface.inErrors);
+            }
+            if (iface.outErrors) {
+                set.addInt("system.network.errors", "{error}", Kind::CUMULATIVE, transmit, time, *iface.outErrors);
+            }
+        }
+    }
+}
+
+// Connect with a timeout; NO_SOCKET on failure
+SocketHandle connectTo(const OtlpEndpoint& endpoint, int timeoutMs) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(endpoint.host.c_str(), std::to_string(endpoint.port).c_str(), &hints, &result) != 0) {
+        return NO_SOCKET;
+    }
+
+    SocketHandle connected = NO_SOCKET;
+    for (addrinfo* address = result; address != nullptr && connected == NO_SOCKET; address = address->ai_next) {
+        SocketHandle candidate = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (candidate == NO_SOCKET) {
+            continue;
+        }
+        // Non-blocking connect, then wait for writability up to the timeout
+#ifdef _WIN32
+        u_long mode = 1;
+        ioctlsocket(candidate, FIONBIO, &mode);
+        bool pending = connect(candidate, address->ai_addr, static_cast<int>(address->ai_addrlen)) != 0 &&
+                       WSAGetLastError() == WSAEWOULDBLOCK;
+        WSAPOLLFD entry{candidate, POLLOUT, 0};
+        bool ready = !pending || WSAPoll(&entry, 1, timeoutMs) == 1;
+#else
+        int flags = fcntl(candidate, F_GETFL, 0);
+        fcntl(candidate, F_SETFL, flags | O_NONBLOCK);
+        bool pending = connect(candidate, address->ai_addr, address->ai_addrlen) != 0 && errno == EINPROGRESS;
+        pollfd entry{candidate, POLLOUT, 0};
+        bool ready = !pending || poll(&entry, 1, timeoutMs) == 1;
+#endif
+        int error = 0;
+        socklen_t errorLength = sizeof(error);
+        if (ready && getsockopt(candidate, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &errorLength) == 0 &&
+            error == 0) {
+#ifdef _WIN32
+            mode = 0;
+            ioctlsocket(candidate, FIONBIO, &mode);
+            DWORD timeout = static_cast<DWORD>(timeoutMs);
+#else
+            fcntl(candidate, F_SETFL, flags);
+            timeval timeout{timeoutMs / 1000, (timeoutMs % 1000) * 1000};
+#endif
+            setsockopt(candidate, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+            setsockopt(candidate, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+            connected = candidate;
+        } else {
+            closeSocket(candidate);
+        }
+    }
+    freeaddrinfo(result);
+    return connected;
+}
+
+bool sendAll(SocketHandle connection, const std::string& data) {
+#ifdef _WIN32
+    const int flags = 0;
+#else
+    const int flags = MSG_NOSIGNAL;  // A collector closing early must not raise SIGPIPE
+#endif
+    size_t sent = 0;
+    while (sent < data.size()) {
+        size_t chunk = std::min<size_t>(data.size() - sent, 1 << 20);
+        auto result = ::send(connection, data.data() + sent, static_cast<int>(chunk), flags);
+        if (result <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+// Status code from "HTTP/1.x NNN ..." (0 if the response is not HTTP)
+int readStatus(SocketHandle connection) {
+    std::string head;
+    char buffer[256];
+    while (head.find("\r\n") == std::string::npos && head.size() < RESPONSE_HEAD_BYTES) {
+        auto received = recv(connection, buffer, static_cast<int>(sizeof(buffer)), 0);
+        if (received <= 0) {
+            break;
+        }
+        head.append(buffer, static_cast<size_t>(received));
+    }
+    size_t space = head.find(' ');
+    if (head.compare(0, 5, "HTTP/") != 0 || space == std::string::npos) {
+        return 0;
+    }
+    return std::atoi(head.c_str() + space + 1);
+}
+
+// OTLP/HTTP: throttling and gateway errors are transient, other errors are not
+bool isRetryable(int status) {
+    return status == 0 || status == 429 || status == 502 || status == 503 || status == 504;
+}
+
+}  // anonymous namespace
+
+OtlpEndpoint parseOtlpUrl(const std::string& url) {
+    const std::string scheme = "http://";
+    if (url.compare(0, scheme.size(), scheme) != 0) {
+        throw std::invalid_argument("OTLP URL must start with http:// (got '" + url + "')");
+    }
+    std::string rest = url.substr(scheme.size());
+    OtlpEndpoint endpoint;
+    size_t slash = rest.find('/');
+    if (slash != std::string::npos) {
+        endpoint.path = rest.substr(slash);
+        rest.erase(slash);
+    }
+    size_t colon = rest.rfind(':');
+    if (colon != std::string::npos && rest.find(']', colon) == std::string::npos) {
+        std::string port = rest.substr(colon + 1);
+        rest.erase(colon);
+        char* end = nullptr;
+        long value = std::strtol(port.c_str(), &end, 10);
+        if (port.empty() || *end != '\0' || value < 1 || value > 65535) {
+            throw std::invalid_argument("Invalid port in OTLP URL '" + url + "'");
+        }
+        endpoint.port = static_cast<uint16_t>(value);
+    }
+    // [::1] style IPv6 literals
+    if (rest.size() >= 2 && rest.front() == '[' && rest.back() == ']') {
+        rest = rest.substr(1, rest.size() - 2);
+    }
+    if (rest.empty()) {
+        throw std::invalid_argument("Missing host in OTLP URL '" + url + "'");
+    }
+    endpoint.host = rest;
+    return endpoint;
+}
+
+CumulativeStarts::CumulativeStarts(uint64_t originUnixNano)
+    : origin_(originUnixNano) {
+}
+
+uint64_t CumulativeStarts::startFor(const std::string& series, uint64_t timeUnixNano, uint64_t value) {
+    auto it = series_.find(series);
+    if (it == series_.end()) {
+        it = series_.emplace(series, Series{origin_, timeUnixNano, value}).first;
+    } else if (value < it->second.lastValue) {
+        it->second.startUnixNano = it->second.lastUnixNano;
+    }
+    it->second.lastUnixNano = timeUnixNano;
+    it->second.lastValue = value;
+    return it->second.startUnixNano;
+}
+
+std::string encodeOtlpJson(const std::vector<OtlpSample>& samples, const std::string& hostName,
+                           CumulativeStarts& starts) {
+    MetricSet set(starts);
+    for (const OtlpSample& sample : samples) {
+        addSample(set, *sample.metrics, sample.timeUnixNano);
+    }
+
+    std::string out = "{\"resourceMetrics\":[{\"resource\":{\"attributes\":[";
+    out += stringAttribute("host.name", hostName);
+    out += ',';
+    out += stringAttribute("service.name", "winhkmon");
+    out += "]},\"scopeMetrics\":[{\"scope\":{\"name\":\"winhkmon\"},\"metrics\":[";
+    out += set.json();
+    out += "]}]}]}";
+    return out;
+}
+
+int postOtlpRequest(const OtlpEndpoint& endpoint, const std::string& body, bool gzip, int timeoutMs) {
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        return 0;
+    }
+#endif
+    int status = 0;
+    SocketHandle connection = connectTo(endpoint, timeoutMs);
+    if (connection != NO_SOCKET) {
+        std::string request = "POST " + endpoint.path + " HTTP/1.1\r\n"
+                              "Host: " + endpoint.host + ":" + std::to_string(endpoint.port) + "\r\n"
+                              "Content-Type: application/json\r\n";
+        if (gzip) {
+            request += "Content-Encoding: gzip\r\n";
+        }
+        request += "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                   "Connection: close\r\n\r\n";
+        if (sendAll(connection, request) && sendAll(connection, body)) {
+            status = readStatus(connection);
+        }
+        closeSocket(connection);
+    }
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    return status;
+}
+
+OtlpExporter::OtlpExporter(const OtlpConfig& config, const std::string& hostName, Transport transport)
+    : config_(config)
+    , hostName_(hostName)
+    , transport_(std::move(transport))
+    , starts_(bootTimeUnixNano())
+    , busy_(false)
+    , flushing_(false)
+    , stopping_(false)
+    , exported_(0)
+    , dropped_(0)
+    , failed_(0) {
+    if (config_.batchSamples == 0 || config_.maxQueuedSamples == 0) {
+        throw std::invalid_argument("OTLP batch and queue sizes must be positive");
+    }
+    if (!transport_) {
+        OtlpEndpoint endpoint = config_.endpoint;
+        int timeoutMs = config_.timeoutMs;
+        transport_ = [endpoint, timeoutMs](const std::string& body, bool gzip) {
+            return postOtlpRequest(endpoint, body, gzip, timeoutMs);
+        };
+    }
+    exporter_ = std::thread(&OtlpExporter::run, this);
+}
+
+OtlpExporter::~OtlpExporter() {
+    stop();
+}
+
+void OtlpExporter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    if (exporter_.joinable()) {
+        exporter_.join();
+    }
+}
+
+void OtlpExporter::submit(MetricsFrame frame, uint64_t timeUnixNano) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() >= config_.maxQueuedSamples) {
+            queue_.pop_front();
+            dropped_++;
+        }
+        queue_.push_back(OtlpSample{std::move(frame), timeUnixNano});
+    }
+    changed_.notify_all();
+}
+
+void OtlpExporter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    flushing_ = true;
+    changed_.notify_all();
+    changed_.wait(lock, [this] { return queue_.empty() && !busy_; });
+    flushing_ = false;
+}
+
+uint64_t OtlpExporter::exportedSamples() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return exported_;
+}
+
+uint64_t OtlpExporter::droppedSamples() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+}
+
+uint64_t OtlpExporter::failedExports() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
+
+void OtlpExporter::run() {
+    using Clock = std::chrono::steady_clock;
+    if (Tracer::instance().isEnabled()) {
+        Tracer::instance().setThreadName("otlp-exporter");
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    Clock::time_point batchDue = Clock::time_point::max();
+    for (;;) {
+        // A partial batch goes out once its first sample has waited maxBatchDelay
+        if (queue_.empty()) {
+            batchDue = Clock::time_point::max();
+        } else if (batchDue == Clock::time_point::max()) {
+            batchDue = Clock::now() + config_.maxBatchDelay;
+        }
+        auto ready = [this] {
+            return stopping_ || queue_.size() >= config_.batchSamples || (flushing_ && !queue_.empty());
+        };
+        if (batchDue == Clock::time_point::max()) {
+            changed_.wait(lock, [&] { return ready() || !queue_.empty(); });
+            if (!ready()) {
+                continue;  // First sample of a new batch: start its delay
+            }
+        } else if (!changed_.wait_until(lock, batchDue, ready) && Clock::now() < batchDue) {
+            continue;
+        }
+        if (queue_.empty()) {
+            return;  // Stopping, and everything queued has been sent or dropped
+        }
+
+        size_t count = std::min(queue_.size(), config_.batchSamples);
+        std::vector<OtlpSample> batch(std::make_move_iterator(queue_.begin()),
+                                      std::make_move_iterator(queue_.begin() + static_cast<std::ptrdiff_t>(count)));
+        queue_.erase(queue_.begin(), queue_.begin() + static_cast<std::ptrdiff_t>(count));
+        batchDue = Clock::time_point::max();
+        busy_ = true;
+        lock.unlock();
+
+        bool accepted = send(batch);
+
+        lock.lock();
+        busy_ = false;
+        if (accepted) {
+            exported_ += batch.size();
+        } else {
+            failed_++;
+            dropped_ += batch.size();
+            // Shutting down with the collector away: do not wait out every remaining batch
+            if (stopping_) {
+                dropped_ += queue_.size();
+                queue_.clear();
+            }
+        }
+        changed_.notify_all();  // flush() waits for the exporter to go idle
+    }
+}
+
+bool OtlpExporter::send(const std::vector<OtlpSample>& batch) {
+    std::string body = encodeOtlpJson(batch, hostName_, starts_);
+    if (config_.gzip) {
+        body = gzipCompress(body);
+    }
+
+    std::chrono::milliseconds delay = config_.retryDelay;
+    for (int attempt = 1;; attempt++) {
+        int status = transport_(body, config_.gzip);
+        if (status >= 200 && status < 300) {
+            return true;
+        }
+        if (!isRetryable(status) || attempt >= config_.maxAttempts) {
+            return false;
+        }
+        // Back off; shutting down ends the retries
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (changed_.wait_for(lock, delay, [this] { return stopping_; })) {
+            return false;
+        }
+        delay *= 2;
+    }
+}
+
+}  // namespace WinHKMon
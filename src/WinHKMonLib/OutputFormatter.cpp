@@ -1,4 +1,9 @@
 #include "WinHKMonLib/OutputFormatter.h"
+#include "WinHKMonLib/FieldProjection.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
 #include <sstream>
 #include <iomanip>
 #include <ctime>
@@ -117,6 +122,28 @@ std::string formatBitsPerSec(uint64_t bitsPerSec) {
     return oss.str();
 }
 
+// Format a cluster statistic in the unit its slot name implies
+std::string formatClusterValue(const std::string& name, double value) {
+    auto endsWith = [&name](const char* suffix) {
+        std::string tail(suffix);
+        return name.size() >= tail.size() && name.compare(name.size() - tail.size(), tail.size(), tail) == 0;
+    };
+    if (endsWith("_bytes_per_sec")) {
+        return formatBytesPerSec(static_cast<uint64_t>(value));
+    }
+    if (endsWith("_bytes")) {
+        return formatBytes(static_cast<uint64_t>(value));
+    }
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1) << value;
+    if (endsWith("_percent")) {
+        oss << "%";
+    } else if (endsWith("_mhz")) {
+        oss << " MHz";
+    }
+    return oss.str();
+}
+
 // Get current timestamp as ISO 8601 string
 std::string getTimestampString() {
     auto now = std::time(nullptr);
@@ -135,9 +162,279 @@ std::string getTimestampString() {
     return oss.str();
 }
 
+// Format Unix epoch milliseconds as ISO 8601 with milliseconds (aligned tick times)
+std::string formatUnixMs(uint64_t unixMs) {
+    auto seconds = static_cast<std::time_t>(unixMs / 1000);
+    std::tm tm{};
+    
+#ifdef _WIN32
+    gmtime_s(&tm, &seconds);
+#else
+    tm = *std::gmtime(&seconds);
+#endif
+    
+    std::ostringstream oss;
+    oss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%S") << "."
+        << std::setw(3) << std::setfill('0') << (unixMs % 1000) << "Z";
+    return oss.str();
+}
+
+// Projected value: whole numbers (bytes, MHz) without decimals, others with one
+void writeFieldValue(std::ostringstream& out, double value) {
+    if (value == std::floor(value) && std::fabs(value) < 1e15) {
+        out << static_cast<long long>(value);
+    } else {
+        out << std::fixed << std::setprecision(1) << value;
+    }
+}
+
+// --fields: only the selected values, flat, named by their field paths
+std::string formatProjectedText(const SystemMetrics& metrics, bool singleLine, const CliOptions& options) {
+    std::ostringstream output;
+    for (const FieldValue& field : projectFields(metrics, options.fields)) {
+        if (output.tellp() > 0) {
+            output << (singleLine ? "  " : "\n");
+        }
+        output << field.path << (singleLine ? "=" : ": ");
+        writeFieldValue(output, field.value);
+    }
+    return output.str();
+}
+
+std::string formatProjectedJson(const SystemMetrics& metrics, const CliOptions& options) {
+    std::ostringstream json;
+    json << "{\n";
+    json << "  \"schemaVersion\": \"1.0\",\n";
+    json << "  \"timestamp\": \"" << getTimestampString() << "\"";
+    if (metrics.nominalTimeMs) {
+        json << ",\n  \"nominalTime\": \"" << formatUnixMs(*metrics.nominalTimeMs) << "\"";
+    }
+    for (const FieldValue& field : projectFields(metrics, options.fields)) {
+        json << ",\n  \"" << escapeJson(field.path) << "\": ";
+        writeFieldValue(json, field.value);
+    }
+    json << "\n}";
+    return json.str();
+}
+
+std::string formatProjectedCsv(const SystemMetrics& metrics, bool includeHeader, const CliOptions& options) {
+    std::vector<FieldValue> fields = projectFields(metrics, options.fields);
+    std::ostringstream csv;
+    if (includeHeader) {
+        csv << "timestamp";
+        for (const FieldValue& field : fields) {
+            csv << "," << escapeCsv(field.path);
+        }
+        csv << "\n";
+    }
+    csv << getTimestampString();
+    for (const FieldValue& field : fields) {
+        csv << ",";
+        writeFieldValue(csv, field.value);
+    }
+    csv << "\n";
+    return csv.str();
+}
+
+// --cores histogram: ten 10% bins, 100% counted in the last
+constexpr size_t CORE_HISTOGRAM_BINS = 10;
+
+// Spread of per-core usage for the compact --cores views
+struct CoreSummary {
+    double minPercent;
+    double meanPercent;
+    double maxPercent;
+};
+
+CoreSummary summarizeCores(const std::vector<CoreStats>& cores) {
+    CoreSummary summary{cores.front().usagePercent, 0.0, cores.front().usagePercent};
+    double sum = 0.0;
+    for (const CoreStats& core : cores) {
+        summary.minPercent = std::min(summary.minPercent, core.usagePercent);
+        summary.maxPercent = std::max(summary.maxPercent, core.usagePercent);
+        sum += core.usagePercent;
+    }
+    summary.meanPercent = sum / static_cast<double>(cores.size());
+    return summary;
+}
+
+std::array<size_t, CORE_HISTOGRAM_BINS> coreHistogram(const std::vector<CoreStats>& cores) {
+    std::array<size_t, CORE_HISTOGRAM_BINS> counts{};
+    for (const CoreStats& core : cores) {
+        double bin = std::floor(core.usagePercent / 10.0);
+        size_t index = bin > 0.0 ? std::min(static_cast<size_t>(bin), CORE_HISTOGRAM_BINS - 1) : 0;
+        counts[index]++;
+    }
+    return counts;
+}
+
+// Indices of the busiest cores, busiest first (lower index first on ties)
+std::vector<size_t> busiestCores(const std::vector<CoreStats>& cores, size_t count) {
+    std::vector<size_t> order(cores.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    count = std::min(count, order.size());
+    std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(count), order.end(),
+                      [&cores](size_t a, size_t b) {
+                          if (cores[a].usagePercent != cores[b].usagePercent) {
+                              return cores[a].usagePercent > cores[b].usagePercent;
+                          }
+                          return a < b;
+                      });
+    order.resize(count);
+    return order;
+}
+
+// Packed view: per-core frequencies add nothing when all equal the average
+bool coreFrequenciesDiffer(const CpuStats& cpu) {
+    for (const CoreStats& core : cpu.cores) {
+        if (core.frequencyMhz != cpu.averageFrequencyMhz) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Per-core members of the JSON "cpu" object, each preceded by ",\n"
+void writeCoreJson(std::ostringstream& json, const CpuStats& cpu, const CliOptions& options) {
+    const std::vector<CoreStats>& cores = cpu.cores;
+    switch (options.coreView) {
+        case CoreView::FULL:
+            json << ",\n    \"cores\": [\n";
+            for (size_t i = 0; i < cores.size(); i++) {
+                json << "      {\"id\": " << cores[i].coreId
+                     << ", \"usagePercent\": " << cores[i].usagePercent
+                     << ", \"frequencyMhz\": " << cores[i].frequencyMhz << "}";
+                if (i < cores.size() - 1) {
+                    json << ",";
+                }
+                json << "\n";
+            }
+            json << "    ]";
+            break;
+        case CoreView::PACKED:
+            // Array index is the core ID (cores are reported in ID order)
+            json << ",\n    \"coreUsage\": [";
+            for (size_t i = 0; i < cores.size(); i++) {
+                json << (i > 0 ? ", " : "") << cores[i].usagePercent;
+            }
+            json << "]";
+            if (coreFrequenciesDiffer(cpu)) {
+                json << ",\n    \"coreFrequencyMhz\": [";
+                for (size_t i = 0; i < cores.size(); i++) {
+                    json << (i > 0 ? ", " : "") << cores[i].frequencyMhz;
+                }
+                json << "]";
+            }
+            break;
+        case CoreView::HISTOGRAM:
+        case CoreView::TOP: {
+            CoreSummary summary = summarizeCores(cores);
+            json << ",\n    \"coreSummary\": {\"count\": " << cores.size()
+                 << ", \"minPercent\": " << summary.minPercent
+                 << ", \"meanPercent\": " << summary.meanPercent
+                 << ", \"maxPercent\": " << summary.maxPercent << "}";
+            if (options.coreView == CoreView::HISTOGRAM) {
+                json << ",\n    \"coreHistogram\": {\"binPercent\": " << (100 / CORE_HISTOGRAM_BINS)
+                     << ", \"counts\": [";
+                std::array<size_t, CORE_HISTOGRAM_BINS> counts = coreHistogram(cores);
+                for (size_t bin = 0; bin < counts.size(); bin++) {
+                    json << (bin > 0 ? ", " : "") << counts[bin];
+                }
+                json << "]}";
+            } else {
+                json << ",\n    \"topCores\": [";
+                std::vector<size_t> top = busiestCores(cores, options.topCores);
+                for (size_t i = 0; i < top.size(); i++) {
+                    const CoreStats& core = cores[top[i]];
+                    json << (i > 0 ? ", " : "") << "{\"id\": " << core.coreId
+                         << ", \"usagePercent\": " << core.usagePercent
+                         << ", \"frequencyMhz\": " << core.frequencyMhz << "}";
+                }
+                json << "]";
+            }
+            break;
+        }
+        case CoreView::NONE:
+            break;
+    }
+}
+
+// Per-core text lines after the CPU line, each followed by the separator
+void writeCoreText(std::ostringstream& output, const CpuStats& cpu, bool singleLine, const CliOptions& options,
+                   const char* separator) {
+    const std::vector<CoreStats>& cores = cpu.cores;
+    switch (options.coreView) {
+        case CoreView::PACKED:
+            // Whole percentages by core ID, 16 cores per line
+            if (singleLine) {
+                output << "CORES:";
+                for (size_t i = 0; i < cores.size(); i++) {
+                    output << (i > 0 ? "/" : "") << std::lround(cores[i].usagePercent);
+                }
+                output << separator;
+            } else {
+                for (size_t first = 0; first < cores.size(); first += 16) {
+                    size_t last = std::min(first + 16, cores.size());
+                    std::ostringstream range;
+                    range << "CORE " << cores[first].coreId << "-" << cores[last - 1].coreId << ":";
+                    output << std::left << std::setw(14) << range.str() << std::right;
+                    for (size_t i = first; i < last; i++) {
+                        output << std::setw(4) << std::lround(cores[i].usagePercent);
+                    }
+                    output << separator;
+                }
+            }
+            break;
+        case CoreView::HISTOGRAM:
+        case CoreView::TOP: {
+            CoreSummary summary = summarizeCores(cores);
+            if (singleLine) {
+                output << "CORES:" << cores.size() << ":" << summary.minPercent << "/" << summary.meanPercent
+                       << "/" << summary.maxPercent << "%";
+            } else {
+                output << "CORES: " << cores.size() << "  min " << summary.minPercent << "%  mean "
+                       << summary.meanPercent << "%  max " << summary.maxPercent << "%";
+            }
+            output << separator;
+            
+            if (options.coreView == CoreView::HISTOGRAM) {
+                std::array<size_t, CORE_HISTOGRAM_BINS> counts = coreHistogram(cores);
+                output << "HIST:";
+                for (size_t bin = 0; bin < counts.size(); bin++) {
+                    if (singleLine) {
+                        output << (bin > 0 ? "/" : "") << counts[bin];
+                    } else {
+                        output << "  " << (bin * 10) << "-" << (bin * 10 + 10) << "%:" << counts[bin];
+                    }
+                }
+            } else {
+                output << (singleLine ? "TOP:" : "TOP:  ");
+                std::vector<size_t> top = busiestCores(cores, options.topCores);
+                for (size_t i = 0; i < top.size(); i++) {
+                    const CoreStats& core = cores[top[i]];
+                    if (singleLine) {
+                        output << (i > 0 ? "," : "") << "#" << core.coreId << ":" << core.usagePercent << "%";
+                    } else {
+                        output << (i > 0 ? "  " : "") << "#" << core.coreId << " " << core.usagePercent << "%";
+                    }
+                }
+            }
+            output << separator;
+            break;
+        }
+        case CoreView::FULL:
+        case CoreView::NONE:
+            break;
+    }
+}
+
 }  // anonymous namespace
 
 std::string formatText(const SystemMetrics& metrics, bool singleLine, const CliOptions& options) {
+    if (!options.fields.empty()) {
+        return formatProjectedText(metrics, singleLine, options);
+    }
+    
     std::ostringstream output;
     output << std::fixed << std::setprecision(1);
     
@@ -156,6 +453,9 @@ std::string formatText(const SystemMetrics& metrics, bool singleLine, const CliO
                    << formatFrequency(metrics.cpu->averageFrequencyMhz);
         }
         output << separator;
+        if (!metrics.cpu->cores.empty()) {
+            writeCoreText(output, *metrics.cpu, singleLine, options, separator);
+        }
     }
     
     // Memory
@@ -168,6 +468,49 @@ std::string formatText(const SystemMetrics& metrics, bool singleLine, const CliO
                    << metrics.memory->usagePercent << "% used)";
         }
         output << separator;
+        
+        // Huge page pools and THP (Linux)
+        if (metrics.memory->hugePages) {
+            const auto& huge = *metrics.memory->hugePages;
+            if (singleLine) {
+                for (const auto& pool : huge.pools) {
+                    if (pool.totalPages > 0) {
+                        output << "HP" << (pool.pageBytes / (1024 * 1024)) << "M:" << pool.freePages << "/"
+                               << pool.totalPages << separator;
+                    }
+                }
+                if (huge.compactStallsPerSec > 0) {
+                    output << "STALL:" << huge.compactStallsPerSec << separator;
+                }
+            } else {
+                for (const auto& pool : huge.pools) {
+                    output << "HUGE: " << formatBytes(pool.pageBytes) << " pages  " << pool.freePages
+                           << " free / " << pool.totalPages << "  (" << pool.reservedPages << " reserved, "
+                           << pool.surplusPages << " surplus)" << separator;
+                }
+                output << "THP:  " << formatBytes(huge.anonHugeBytes) << " anon  " << huge.thpFaultsPerSec
+                       << " faults/s  " << huge.thpFallbacksPerSec << " fallbacks/s  "
+                       << huge.compactStallsPerSec << " compaction stalls/s" << separator;
+            }
+        }
+    }
+    
+    // NUMA nodes
+    if (metrics.numa) {
+        for (const auto& node : *metrics.numa) {
+            if (singleLine) {
+                output << "N" << node.nodeId << ":" << (node.freeBytes / (1024 * 1024)) << "M";
+                if (node.missesPerSec > 0) {
+                    output << "/" << node.missesPerSec << "miss";
+                }
+            } else {
+                output << "NUMA: node" << node.nodeId << " " << formatBytes(node.freeBytes) << " free / "
+                       << formatBytes(node.totalBytes) << "  (file " << formatBytes(node.fileBytes)
+                       << ", anon " << formatBytes(node.anonBytes) << ")  hit " << node.hitsPerSec
+                       << "/s  miss " << node.missesPerSec << "/s  foreign " << node.foreignPerSec << "/s";
+            }
+            output << separator;
+        }
     }
     
     // Disk Space (DISK metric)
@@ -245,6 +588,170 @@ std::string formatText(const SystemMetrics& metrics, bool singleLine, const CliO
         output << separator;
     }
     
+    // cgroup v2 groups
+    if (metrics.cgroups) {
+        for (const auto& group : *metrics.cgroups) {
+            uint64_t readPerSec = 0;
+            uint64_t writePerSec = 0;
+            for (const auto& io : group.io) {
+                readPerSec += io.readBytesPerSec;
+                writePerSec += io.writeBytesPerSec;
+            }
+            if (singleLine) {
+                output << "CG:" << group.path << ":" << group.cpuPercent << "%/"
+                       << formatBytes(group.memoryCurrentBytes);
+            } else {
+                output << "CGRP: " << group.path << "  " << group.cpuPercent << "% CPU";
+                if (group.throttledPercent > 0.0) {
+                    output << " (" << group.throttledPercent << "% throttled)";
+                }
+                output << "  " << formatBytes(group.memoryCurrentBytes)
+                       << "  " << arrowUp << " " << formatBytesPerSec(readPerSec)
+                       << "  " << arrowDown << " " << formatBytesPerSec(writePerSec);
+                if (group.cpuPressure || group.memoryPressure || group.ioPressure) {
+                    output << "  PSI cpu " << (group.cpuPressure ? group.cpuPressure->someAvg10 : 0.0)
+                           << "% mem " << (group.memoryPressure ? group.memoryPressure->someAvg10 : 0.0)
+                           << "% io " << (group.ioPressure ? group.ioPressure->someAvg10 : 0.0) << "%";
+                }
+                if (group.oomKillEvents > 0) {
+                    output << "  " << group.oomKillEvents << " OOM kills";
+                }
+            }
+            output << separator;
+        }
+    }
+    
+    // RAPL power
+    if (metrics.power) {
+        if (singleLine) {
+            output << "PWR:" << metrics.power->hostWatts << "W";
+        } else {
+            output << "PWR:  " << metrics.power->hostWatts << " W";
+            for (size_t i = 0; i < metrics.power->zones.size(); i++) {
+                const auto& zone = metrics.power->zones[i];
+                output << (i == 0 ? "  (" : ", ") << zone.name << " " << zone.watts << " W";
+            }
+            if (!metrics.power->zones.empty()) {
+                output << ")";
+            }
+        }
+        output << separator;
+    }
+    
+    // Kernel resources
+    if (metrics.kernelResources) {
+        const auto& kres = *metrics.kernelResources;
+        output << (singleLine ? "KRES:" : "KRES: ");
+        std::string gap = singleLine ? "/" : "  ";
+        std::string next;
+        if (kres.handleCount) {
+            output << next << *kres.handleCount << (singleLine ? "h" : " handles");
+            next = gap;
+        }
+        if (kres.threadCount) {
+            output << next << *kres.threadCount << (singleLine ? "t" : " threads");
+            next = gap;
+        }
+        if (kres.processCount && !singleLine) {
+            output << next << *kres.processCount << " processes";
+            next = gap;
+        }
+        if (kres.fileHandlesAllocated && kres.fileHandlesMax) {
+            if (singleLine) {
+                output << next << "fd" << *kres.fileHandlePercent << "%";
+            } else {
+                output << next << "files " << *kres.fileHandlesAllocated << " / " << *kres.fileHandlesMax
+                       << " (" << *kres.fileHandlePercent << "%)";
+            }
+            next = gap;
+        }
+        if (kres.socketsUsed) {
+            output << next << (singleLine ? "sock" : "sockets ") << *kres.socketsUsed;
+            next = gap;
+        }
+        if (!singleLine) {
+            for (const auto& protocol : kres.protocols) {
+                if (protocol.inUse == 0 && !protocol.memoryBytes.value_or(0)) {
+                    continue;
+                }
+                output << next << protocol.protocol << " " << protocol.inUse;
+                if (protocol.memoryBytes) {
+                    output << " (" << formatBytes(*protocol.memoryBytes);
+                    if (protocol.memoryPercent) {
+                        output << ", " << *protocol.memoryPercent << "% of limit";
+                    }
+                    output << ")";
+                }
+                next = gap;
+            }
+        }
+        output << separator;
+    }
+    
+    // Collector modules (counters the module reported this tick)
+    if (metrics.modules) {
+        const ModuleFrame& modules = *metrics.modules;
+        for (const ModuleSchema& schema : *modules.schemas) {
+            output << (singleLine ? "" : "MOD:  ") << schema.name << (singleLine ? ":" : " ");
+            std::string next;
+            for (size_t i = 0; i < schema.counters.size(); i++) {
+                size_t slot = schema.firstSlot + i;
+                if (((modules.validMask >> slot) & 1) == 0) {
+                    continue;
+                }
+                output << next;
+                if (!singleLine) {
+                    output << " " << schema.counters[i] << " ";
+                }
+                writeFieldValue(output, modules.values[slot]);
+                if (!singleLine && !schema.units[i].empty()) {
+                    output << " " << schema.units[i];
+                }
+                next = singleLine ? "/" : ",";
+            }
+            output << std::fixed << std::setprecision(1) << separator;
+        }
+    }
+    
+    // Cluster distribution (aggregate mode)
+    if (metrics.cluster) {
+        if (singleLine) {
+            output << "HOSTS:" << metrics.cluster->hostCount;
+        } else {
+            output << "HOSTS: " << metrics.cluster->hostCount << "  ("
+                   << metrics.cluster->bucketSeconds << " s bucket)";
+            for (const auto& metric : metrics.cluster->metrics) {
+                output << "\n  " << std::left << std::setw(26) << metric.name << std::right
+                       << "p50 " << formatClusterValue(metric.name, metric.p50)
+                       << "  p90 " << formatClusterValue(metric.name, metric.p90)
+                       << "  p99 " << formatClusterValue(metric.name, metric.p99)
+                       << "  max " << formatClusterValue(metric.name, metric.max);
+            }
+        }
+        output << separator;
+    }
+    
+    // Aligned tick and how late the capture started (--align)
+    if (options.align && metrics.nominalTimeMs && metrics.captureTimeMs) {
+        auto lagMs = static_cast<int64_t>(*metrics.captureTimeMs) - static_cast<int64_t>(*metrics.nominalTimeMs);
+        if (singleLine) {
+            output << "TICK:" << formatUnixMs(*metrics.nominalTimeMs) << "+" << lagMs << "ms";
+        } else {
+            output << "TICK: " << formatUnixMs(*metrics.nominalTimeMs) << " (captured +" << lagMs << " ms)";
+        }
+        output << separator;
+    }
+    
+    // Actual sampling interval (adaptive mode only, keeps fixed-rate output unchanged)
+    if (options.adaptive && metrics.intervalSeconds) {
+        if (singleLine) {
+            output << "INT:" << std::setprecision(2) << *metrics.intervalSeconds << "s";
+        } else {
+            output << "INT:  " << std::setprecision(2) << *metrics.intervalSeconds << " s";
+        }
+        output << separator;
+    }
+    
     std::string result = output.str();
     
     // If no metrics were output, provide minimal feedback
@@ -262,8 +769,10 @@ std::string formatText(const SystemMetrics& metrics, bool singleLine, const CliO
 }
 
 std::string formatJson(const SystemMetrics& metrics, const CliOptions& options) {
-    // Note: options parameter is for API consistency; JSON always includes all available fields
-    (void)options;
+    // JSON includes all available fields unless --fields selects some
+    if (!options.fields.empty()) {
+        return formatProjectedJson(metrics, options);
+    }
     
     std::ostringstream json;
     json << std::fixed << std::setprecision(1);
@@ -272,6 +781,20 @@ std::string formatJson(const SystemMetrics& metrics, const CliOptions& options)
     json << "  \"schemaVersion\": \"1.0\",\n";
     json << "  \"timestamp\": \"" << getTimestampString() << "\"";
     
+    // Actual sampling interval (continuous mode)
+    if (metrics.intervalSeconds) {
+        json << ",\n  \"intervalSeconds\": " << std::setprecision(3) << *metrics.intervalSeconds
+             << std::setprecision(1);
+    }
+    
+    // Aligned tick and actual capture time (--align)
+    if (metrics.nominalTimeMs) {
+        json << ",\n  \"nominalTime\": \"" << formatUnixMs(*metrics.nominalTimeMs) << "\"";
+    }
+    if (metrics.captureTimeMs) {
+        json << ",\n  \"captureTime\": \"" << formatUnixMs(*metrics.captureTimeMs) << "\"";
+    }
+    
     // CPU
     if (metrics.cpu) {
         json << ",\n  \"cpu\": {\n";
@@ -279,18 +802,7 @@ std::string formatJson(const SystemMetrics& metrics, const CliOptions& options)
         json << "    \"averageFrequencyMhz\": " << metrics.cpu->averageFrequencyMhz;
         
         if (!metrics.cpu->cores.empty()) {
-            json << ",\n    \"cores\": [\n";
-            for (size_t i = 0; i < metrics.cpu->cores.size(); i++) {
-                const auto& core = metrics.cpu->cores[i];
-                json << "      {\"id\": " << core.coreId
-                     << ", \"usagePercent\": " << core.usagePercent
-                     << ", \"frequencyMhz\": " << core.frequencyMhz << "}";
-                if (i < metrics.cpu->cores.size() - 1) {
-                    json << ",";
-                }
-                json << "\n";
-            }
-            json << "    ]";
+            writeCoreJson(json, *metrics.cpu, options);
         }
         
         json << "\n  }";
@@ -307,8 +819,46 @@ std::string formatJson(const SystemMetrics& metrics, const CliOptions& options)
         json << "      \"totalMB\": " << (metrics.memory->totalPageFileBytes / (1024 * 1024)) << ",\n";
         json << "      \"usedMB\": " << (metrics.memory->usedPageFileBytes / (1024 * 1024)) << ",\n";
         json << "      \"usagePercent\": " << metrics.memory->pageFilePercent << "\n";
-        json << "    }\n";
-        json << "  }";
+        json << "    }";
+        if (metrics.memory->hugePages) {
+            const auto& huge = *metrics.memory->hugePages;
+            json << ",\n    \"hugePages\": {\n";
+            json << "      \"pools\": [";
+            for (size_t i = 0; i < huge.pools.size(); i++) {
+                const auto& pool = huge.pools[i];
+                json << (i > 0 ? ", " : "") << "{\"pageBytes\": " << pool.pageBytes
+                     << ", \"total\": " << pool.totalPages << ", \"free\": " << pool.freePages
+                     << ", \"reserved\": " << pool.reservedPages << ", \"surplus\": " << pool.surplusPages << "}";
+            }
+            json << "],\n";
+            json << "      \"anonHugeMB\": " << (huge.anonHugeBytes / (1024 * 1024)) << ",\n";
+            json << "      \"thpFaultsPerSec\": " << huge.thpFaultsPerSec << ",\n";
+            json << "      \"thpFallbacksPerSec\": " << huge.thpFallbacksPerSec << ",\n";
+            json << "      \"compactStallsPerSec\": " << huge.compactStallsPerSec << "\n";
+            json << "    }";
+        }
+        json << "\n  }";
+    }
+    
+    // NUMA nodes
+    if (metrics.numa && !metrics.numa->empty()) {
+        json << ",\n  \"numa\": [\n";
+        for (size_t i = 0; i < metrics.numa->size(); i++) {
+            const auto& node = (*metrics.numa)[i];
+            json << "    {\"node\": " << node.nodeId
+                 << ", \"totalMB\": " << (node.totalBytes / (1024 * 1024))
+                 << ", \"freeMB\": " << (node.freeBytes / (1024 * 1024))
+                 << ", \"fileMB\": " << (node.fileBytes / (1024 * 1024))
+                 << ", \"anonMB\": " << (node.anonBytes / (1024 * 1024))
+                 << ", \"hitsPerSec\": " << node.hitsPerSec
+                 << ", \"missesPerSec\": " << node.missesPerSec
+                 << ", \"foreignPerSec\": " << node.foreignPerSec << "}";
+            if (i < metrics.numa->size() - 1) {
+                json << ",";
+            }
+            json << "\n";
+        }
+        json << "  ]";
     }
     
     // Disks (includes both space and I/O data)
@@ -325,6 +875,8 @@ std::string formatJson(const SystemMetrics& metrics, const CliOptions& options)
             // I/O information (IO metric)
             json << "      \"bytesReadPerSec\": " << disk.bytesReadPerSec << ",\n";
             json << "      \"bytesWrittenPerSec\": " << disk.bytesWrittenPerSec << ",\n";
+            json << "      \"totalBytesRead\": " << disk.totalBytesRead << ",\n";
+            json << "      \"totalBytesWritten\": " << disk.totalBytesWritten << ",\n";
             json << "      \"percentBusy\": " << disk.percentBusy << "\n";
             json << "    }";
             if (i < metrics.disks->size() - 1) {
@@ -368,12 +920,205 @@ std::string formatJson(const SystemMetrics& metrics, const CliOptions& options)
         json << "\n  }";
     }
     
+    // cgroup v2 groups
+    if (metrics.cgroups && !metrics.cgroups->empty()) {
+        auto pressure = [](const std::optional<PressureStats>& stats) {
+            std::ostringstream out;
+            if (stats) {
+                out << "{\"someAvg10\": " << stats->someAvg10 << ", \"fullAvg10\": " << stats->fullAvg10
+                    << ", \"someTotalUsec\": " << stats->someTotalUsec << "}";
+            } else {
+                out << "null";
+            }
+            return out.str();
+        };
+        json << ",\n  \"cgroups\": [\n";
+        for (size_t i = 0; i < metrics.cgroups->size(); i++) {
+            const auto& group = (*metrics.cgroups)[i];
+            json << "    {\n";
+            json << "      \"path\": \"" << escapeJson(group.path) << "\",\n";
+            json << "      \"cpuPercent\": " << group.cpuPercent << ",\n";
+            json << "      \"throttledPercent\": " << group.throttledPercent << ",\n";
+            json << "      \"throttledPeriodsPerSec\": " << group.throttledPeriodsPerSec << ",\n";
+            json << "      \"totalThrottledPeriods\": " << group.totalThrottledPeriods << ",\n";
+            json << "      \"memoryCurrentBytes\": " << group.memoryCurrentBytes << ",\n";
+            json << "      \"memoryEvents\": {\"high\": " << group.memoryHighEvents
+                 << ", \"max\": " << group.memoryMaxEvents
+                 << ", \"oom\": " << group.oomEvents
+                 << ", \"oomKill\": " << group.oomKillEvents << "},\n";
+            json << "      \"io\": [";
+            for (size_t d = 0; d < group.io.size(); d++) {
+                const auto& io = group.io[d];
+                json << (d == 0 ? "" : ", ")
+                     << "{\"device\": \"" << escapeJson(io.device) << "\""
+                     << ", \"readBytesPerSec\": " << io.readBytesPerSec
+                     << ", \"writeBytesPerSec\": " << io.writeBytesPerSec
+                     << ", \"readsPerSec\": " << io.readsPerSec
+                     << ", \"writesPerSec\": " << io.writesPerSec << "}";
+            }
+            json << "],\n";
+            json << "      \"pressure\": {\"cpu\": " << pressure(group.cpuPressure)
+                 << ", \"memory\": " << pressure(group.memoryPressure)
+                 << ", \"io\": " << pressure(group.ioPressure) << "}\n";
+            json << "    }";
+            if (i < metrics.cgroups->size() - 1) {
+                json << ",";
+            }
+            json << "\n";
+        }
+        json << "  ]";
+    }
+    
+    // RAPL power
+    if (metrics.power) {
+        json << ",\n  \"power\": {\n";
+        json << "    \"hostWatts\": " << metrics.power->hostWatts << ",\n";
+        json << "    \"zones\": [";
+        for (size_t i = 0; i < metrics.power->zones.size(); i++) {
+            const auto& zone = metrics.power->zones[i];
+            json << (i == 0 ? "\n" : ",\n");
+            json << "      {\"name\": \"" << escapeJson(zone.name) << "\""
+                 << ", \"watts\": " << zone.watts
+                 << ", \"energyMicrojoules\": " << zone.energyMicrojoules << "}";
+        }
+        json << "\n    ]\n";
+        json << "  }";
+    }
+    
+    // Kernel resources (only the sources this host has)
+    if (metrics.kernelResources) {
+        const auto& kres = *metrics.kernelResources;
+        std::string next = "\n";
+        json << ",\n  \"kernelResources\": {";
+        if (kres.handleCount) {
+            json << next << "    \"handleCount\": " << *kres.handleCount;
+            next = ",\n";
+        }
+        if (kres.threadCount) {
+            json << next << "    \"threadCount\": " << *kres.threadCount;
+            next = ",\n";
+        }
+        if (kres.processCount) {
+            json << next << "    \"processCount\": " << *kres.processCount;
+            next = ",\n";
+        }
+        if (kres.fileHandlesAllocated && kres.fileHandlesMax) {
+            json << next << "    \"fileHandles\": {\"allocated\": " << *kres.fileHandlesAllocated
+                 << ", \"max\": " << *kres.fileHandlesMax
+                 << ", \"percent\": " << *kres.fileHandlePercent << "}";
+            next = ",\n";
+        }
+        if (kres.socketsUsed) {
+            json << next << "    \"socketsUsed\": " << *kres.socketsUsed;
+            next = ",\n";
+        }
+        if (!kres.protocols.empty()) {
+            json << next << "    \"sockets\": [";
+            for (size_t i = 0; i < kres.protocols.size(); i++) {
+                const auto& protocol = kres.protocols[i];
+                json << (i == 0 ? "\n" : ",\n");
+                json << "      {\"protocol\": \"" << escapeJson(protocol.protocol) << "\""
+                     << ", \"inUse\": " << protocol.inUse;
+                if (protocol.memoryBytes) {
+                    json << ", \"memoryBytes\": " << *protocol.memoryBytes;
+                }
+                if (protocol.memoryPercent) {
+                    json << ", \"memoryPercent\": " << *protocol.memoryPercent;
+                }
+                json << "}";
+            }
+            json << "\n    ]";
+        }
+        json << "\n  }";
+    }
+    
+    // Collector modules: counters by name (absent when not reported this tick)
+    if (metrics.modules) {
+        json << ",\n  \"modules\": {";
+        const ModuleFrame& modules = *metrics.modules;
+        for (size_t m = 0; m < modules.schemas->size(); m++) {
+            const ModuleSchema& schema = (*modules.schemas)[m];
+            json << (m == 0 ? "\n" : ",\n");
+            json << "    \"" << escapeJson(schema.name) << "\": {";
+            std::string next;
+            for (size_t i = 0; i < schema.counters.size(); i++) {
+                size_t slot = schema.firstSlot + i;
+                if (((modules.validMask >> slot) & 1) == 0 || !std::isfinite(modules.values[slot])) {
+                    continue;
+                }
+                json << next << "\"" << schema.counters[i] << "\": ";
+                writeFieldValue(json, modules.values[slot]);
+                json << std::fixed << std::setprecision(1);
+                next = ", ";
+            }
+            json << "}";
+        }
+        json << "\n  }";
+    }
+    
+    // Cluster statistics (aggregate mode)
+    if (metrics.cluster) {
+        json << ",\n  \"cluster\": {\n";
+        json << "    \"bucketStartMs\": " << metrics.cluster->bucketStartMs << ",\n";
+        json << "    \"bucketSeconds\": " << metrics.cluster->bucketSeconds << ",\n";
+        json << "    \"hosts\": " << metrics.cluster->hostCount << ",\n";
+        json << "    \"metrics\": {";
+        for (size_t i = 0; i < metrics.cluster->metrics.size(); i++) {
+            const auto& metric = metrics.cluster->metrics[i];
+            json << (i == 0 ? "\n" : ",\n");
+            json << "      \"" << escapeJson(metric.name) << "\": {"
+                 << "\"hosts\": " << metric.hosts
+                 << ", \"sum\": " << metric.sum
+                 << ", \"min\": " << metric.min
+                 << ", \"max\": " << metric.max
+                 << ", \"mean\": " << metric.mean
+                 << ", \"p50\": " << metric.p50
+                 << ", \"p90\": " << metric.p90
+                 << ", \"p99\": " << metric.p99 << "}";
+        }
+        json << "\n    }\n";
+        json << "  }";
+    }
+    
     json << "\n}";
     
     return json.str();
 }
 
+std::string formatNdjson(const SystemMetrics& metrics, const CliOptions& options) {
+    std::string json = formatJson(metrics, options);
+    
+    // Drop the layout whitespace; string contents are kept as they are
+    std::string line;
+    line.reserve(json.size());
+    bool inString = false;
+    bool escaped = false;
+    for (char c : json) {
+        if (inString) {
+            line.push_back(c);
+            if (escaped) {
+                escaped = false;
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == '"') {
+                inString = false;
+            }
+        } else if (c == '"') {
+            inString = true;
+            line.push_back(c);
+        } else if (c != '\n' && c != ' ') {
+            line.push_back(c);
+        }
+    }
+    line.push_back('\n');
+    return line;
+}
+
 std::string formatCsv(const SystemMetrics& metrics, bool includeHeader, const CliOptions& options) {
+    if (!options.fields.empty()) {
+        return formatProjectedCsv(metrics, includeHeader, options);
+    }
+    
     std::ostringstream csv;
     
     if (includeHeader) {
@@ -395,6 +1140,49 @@ std::string formatCsv(const SystemMetrics& metrics, bool includeHeader, const Cl
             csv << ",temp_celsius";
         }
         
+        if (metrics.cgroups) {
+            csv << ",cgroups";
+        }
+        
+        if (metrics.power) {
+            csv << ",power_watts";
+        }
+        
+        if (metrics.kernelResources) {
+            csv << ",kres_handles,kres_threads,kres_file_handles,kres_file_percent,kres_sockets";
+        }
+        
+        if (metrics.memory && metrics.memory->hugePages) {
+            csv << ",hugepages_free,thp_fallback_per_sec,compact_stall_per_sec";
+        }
+        
+        if (metrics.numa) {
+            for (const auto& node : *metrics.numa) {
+                std::string prefix = ",numa" + std::to_string(node.nodeId);
+                csv << prefix << "_free_mb" << prefix << "_miss_per_sec" << prefix << "_foreign_per_sec";
+            }
+        }
+        
+        if (metrics.modules) {
+            for (const ModuleSchema& schema : *metrics.modules->schemas) {
+                for (const auto& counter : schema.counters) {
+                    csv << "," << schema.name << "_" << counter;
+                }
+            }
+        }
+        
+        if (options.adaptive) {
+            csv << ",interval_sec";
+        }
+        
+        if (options.align) {
+            csv << ",nominal_time,capture_time";
+        }
+        
+        if (metrics.cluster) {
+            csv << ",hosts";
+        }
+        
         csv << "\n";
     }
     
@@ -456,6 +1244,83 @@ std::string formatCsv(const SystemMetrics& metrics, bool includeHeader, const Cl
         csv << "," << metrics.temperature->maxCpuTempCelsius;
     }
     
+    // Group count (per-group values: --fields cgroup.*.cpu etc.)
+    if (metrics.cgroups) {
+        csv << "," << metrics.cgroups->size();
+    }
+    
+    // Host power (per zone: --fields rapl.*.watts)
+    if (metrics.power) {
+        csv << "," << std::fixed << std::setprecision(1) << metrics.power->hostWatts;
+    }
+    
+    // Kernel resources (empty where this host has no such source)
+    if (metrics.kernelResources) {
+        const auto& kres = *metrics.kernelResources;
+        auto count = [&csv](const std::optional<uint64_t>& value) {
+            csv << ",";
+            if (value) {
+                csv << *value;
+            }
+        };
+        count(kres.handleCount);
+        count(kres.threadCount);
+        count(kres.fileHandlesAllocated);
+        csv << ",";
+        if (kres.fileHandlePercent) {
+            csv << std::fixed << std::setprecision(1) << *kres.fileHandlePercent;
+        }
+        count(kres.socketsUsed);
+    }
+    
+    // Huge pages of the default size (per size: --fields hugepages.*.free)
+    if (metrics.memory && metrics.memory->hugePages) {
+        const auto& huge = *metrics.memory->hugePages;
+        csv << "," << (huge.pools.empty() ? 0 : huge.pools.front().freePages) << ","
+            << huge.thpFallbacksPerSec << "," << huge.compactStallsPerSec;
+    }
+    
+    // Every NUMA node (a node count does not change while running)
+    if (metrics.numa) {
+        for (const auto& node : *metrics.numa) {
+            csv << "," << (node.freeBytes / (1024 * 1024)) << "," << node.missesPerSec
+                << "," << node.foreignPerSec;
+        }
+    }
+    
+    // Every declared module counter (empty when not reported this tick)
+    if (metrics.modules) {
+        const ModuleFrame& modules = *metrics.modules;
+        for (const ModuleSchema& schema : *modules.schemas) {
+            for (size_t i = 0; i < schema.counters.size(); i++) {
+                size_t slot = schema.firstSlot + i;
+                csv << ",";
+                if (((modules.validMask >> slot) & 1) != 0 && std::isfinite(modules.values[slot])) {
+                    writeFieldValue(csv, modules.values[slot]);
+                }
+            }
+        }
+    }
+    
+    // Actual sampling interval (adaptive mode)
+    if (options.adaptive) {
+        csv << ",";
+        if (metrics.intervalSeconds) {
+            csv << std::fixed << std::setprecision(3) << *metrics.intervalSeconds;
+        }
+    }
+    
+    // Aligned tick and actual capture time (--align)
+    if (options.align) {
+        csv << "," << (metrics.nominalTimeMs ? formatUnixMs(*metrics.nominalTimeMs) : "")
+            << "," << (metrics.captureTimeMs ? formatUnixMs(*metrics.captureTimeMs) : "");
+    }
+    
+    // Hosts in the aggregation bucket (aggregate mode)
+    if (metrics.cluster) {
+        csv << "," << metrics.cluster->hostCount;
+    }
+    
     csv << "\n";
     
     return csv.str();
@@ -0,0 +1,115 @@
+#include "WinHKMonLib/PowerMonitor.h"
+#include "WinHKMonLib/Tracer.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace WinHKMon {
+
+namespace {
+
+constexpr const char* ZONE_PREFIX = "intel-rapl:";
+
+// One-line attribute read once at discovery (name, max_energy_range_uj)
+std::string readAttribute(const fs::path& path) {
+    std::ifstream file(path);
+    std::string value;
+    std::getline(file, value);
+    return value;
+}
+
+}  // anonymous namespace
+
+PowerMonitor::PowerMonitor(std::string root)
+    : root_(std::move(root)) {
+}
+
+PowerMonitor::~PowerMonitor() = default;
+
+void PowerMonitor::initialize() {
+    // intel-rapl:<package>[:<subzone>]; intel-rapl-mmio duplicates the package counters
+    std::map<std::string, fs::path> found;
+    std::error_code error;
+    for (fs::directory_iterator it(root_, error), end; !error && it != end; it.increment(error)) {
+        std::string id = it->path().filename().string();
+        if (id.compare(0, std::char_traits<char>::length(ZONE_PREFIX), ZONE_PREFIX) == 0 &&
+            fs::exists(it->path() / "energy_uj", error)) {
+            found[id] = it->path();
+        }
+    }
+    if (found.empty()) {
+        throw std::runtime_error("No RAPL zones under '" + root_ + "'");
+    }
+
+    bool hasPlatformZone = false;
+    std::map<std::string, std::string> names;
+    for (const auto& [id, path] : found) {
+        std::string name = readAttribute(path / "name");
+        size_t lastColon = id.rfind(':');
+        bool subzone = lastColon >= std::char_traits<char>::length(ZONE_PREFIX);
+        std::string parentId = subzone ? id.substr(0, lastColon) : "";
+
+        Zone zone;
+        zone.name = subzone && names.count(parentId) ? names[parentId] + "/" + name : name;
+        zone.counted = subzone ? name == "dram" : name.compare(0, 8, "package-") == 0 || name == "dram";
+        zone.range = std::strtoull(readAttribute(path / "max_energy_range_uj").c_str(), nullptr, 10);
+        zone.energy = std::make_unique<CachedFile>((path / "energy_uj").string());
+        names[id] = zone.name;
+        hasPlatformZone = hasPlatformZone || (!subzone && name == "psys");
+        zones_.push_back(std::move(zone));
+    }
+
+    // psys covers the whole platform; counting packages too would count them twice
+    if (hasPlatformZone) {
+        for (Zone& zone : zones_) {
+            zone.counted = zone.name == "psys";
+        }
+    }
+
+    if (getCurrentStats().zones.empty()) {
+        zones_.clear();
+        throw std::runtime_error("RAPL energy counters under '" + root_ +
+                                 "' are not readable (root is required on Linux 5.10 and later)");
+    }
+}
+
+PowerStats PowerMonitor::getCurrentStats() {
+    return getCurrentStats(std::chrono::steady_clock::now());
+}
+
+PowerStats PowerMonitor::getCurrentStats(std::chrono::steady_clock::time_point now) {
+    WINHKMON_TRACE_SPAN("collect", "power-read");
+    PowerStats stats{0.0, {}};
+    for (Zone& zone : zones_) {
+        if (!zone.energy->read(buffer_)) {
+            continue;
+        }
+        uint64_t energy = std::strtoull(buffer_.c_str(), nullptr, 10);
+
+        PowerZoneStats zoneStats;
+        zoneStats.name = zone.name;
+        zoneStats.energyMicrojoules = energy;
+        zoneStats.watts = 0.0;
+        if (zone.primed) {
+            double elapsedSeconds = std::chrono::duration<double>(now - zone.previousTime).count();
+            zoneStats.watts = deltaCalc_.calculateWrappingRate(energy, zone.previous, zone.range,
+                                                               elapsedSeconds) / 1e6;
+        }
+        if (zone.counted) {
+            stats.hostWatts += zoneStats.watts;
+        }
+        zone.previous = energy;
+        zone.previousTime = now;
+        zone.primed = true;
+        stats.zones.push_back(std::move(zoneStats));
+    }
+    return stats;
+}
+
+}  // namespace WinHKMon
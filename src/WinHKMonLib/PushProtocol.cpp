@@ -0,0 +1,162 @@
+#include "WinHKMonLib/PushProtocol.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace WinHKMon {
+
+namespace {
+
+// magic + version + slotCount + timestampMs + validMask + hostLen
+constexpr size_t FIXED_BODY_BYTES = 4 + 2 + 2 + 8 + 8 + 1;
+
+void putLe(std::string& out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; i++) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+uint64_t getLe(const char* data, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; i++) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+    }
+    return value;
+}
+
+uint64_t doubleBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsDouble(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+int popCount(uint64_t mask) {
+    int count = 0;
+    while (mask != 0) {
+        mask &= mask - 1;
+        count++;
+    }
+    return count;
+}
+
+}  // anonymous namespace
+
+void encodePushSample(const PushSample& sample, std::string& out) {
+    size_t hostLen = sample.hostId.size() < MAX_HOST_ID_BYTES ? sample.hostId.size() : MAX_HOST_ID_BYTES;
+    uint64_t validMask = sample.validMask;
+    size_t bodyBytes = FIXED_BODY_BYTES + hostLen + 8 * static_cast<size_t>(popCount(validMask));
+
+    out.reserve(out.size() + 4 + bodyBytes);
+    putLe(out, bodyBytes, 4);
+    putLe(out, PUSH_MAGIC, 4);
+    putLe(out, PUSH_VERSION, 2);
+    putLe(out, MAX_FRAME_SLOTS, 2);
+    putLe(out, sample.timestampMs, 8);
+    putLe(out, validMask, 8);
+    putLe(out, hostLen, 1);
+    out.append(sample.hostId, 0, hostLen);
+    for (uint32_t slot = 0; slot < MAX_FRAME_SLOTS; slot++) {
+        if (validMask & (1ULL << slot)) {
+            putLe(out, doubleBits(sample.values[slot]), 8);
+        }
+    }
+}
+
+void PushDecoder::feed(const char* data, size_t size) {
+    // Drop consumed bytes before growing so the buffer stays small
+    if (offset_ > 0 && offset_ == buffer_.size()) {
+        buffer_.clear();
+        offset_ = 0;
+    } else if (offset_ > MAX_PUSH_MESSAGE_BYTES) {
+        buffer_.erase(0, offset_);
+        offset_ = 0;
+    }
+    buffer_.append(data, size);
+}
+
+bool PushDecoder::next(PushSample& sample) {
+    size_t available = buffer_.size() - offset_;
+    if (available < 4) {
+        return false;
+    }
+    const char* p = buffer_.data() + offset_;
+    size_t bodyBytes = static_cast<size_t>(getLe(p, 4));
+    if (bodyBytes < FIXED_BODY_BYTES || bodyBytes > MAX_PUSH_MESSAGE_BYTES) {
+        throw std::runtime_error("Invalid push message length");
+    }
+    if (available < 4 + bodyBytes) {
+        return false;
+    }
+    p += 4;
+    const char* end = p + bodyBytes;
+
+    if (getLe(p, 4) != PUSH_MAGIC) {
+        throw std::runtime_error("Invalid push message magic");
+    }
+    if (getLe(p + 4, 2) != PUSH_VERSION) {
+        throw std::runtime_error("Unsupported push protocol version");
+    }
+    uint32_t senderSlots = static_cast<uint32_t>(getLe(p + 6, 2));
+    sample.timestampMs = getLe(p + 8, 8);
+    uint64_t validMask = getLe(p + 16, 8);
+    size_t hostLen = static_cast<size_t>(getLe(p + 24, 1));
+    p += FIXED_BODY_BYTES;
+
+    if (senderSlots > MAX_FRAME_SLOTS || (senderSlots < MAX_FRAME_SLOTS && (validMask >> senderSlots) != 0) ||
+        static_cast<size_t>(end - p) != hostLen + 8 * static_cast<size_t>(popCount(validMask))) {
+        throw std::runtime_error("Inconsistent push message body");
+    }
+    sample.hostId.assign(p, hostLen);
+    p += hostLen;
+
+    sample.validMask = validMask;
+    for (uint32_t slot = 0; slot < senderSlots; slot++) {
+        if (validMask & (1ULL << slot)) {
+            sample.values[slot] = bitsDouble(getLe(p, 8));
+            p += 8;
+        }
+    }
+
+    offset_ += 4 + bodyBytes;
+    return true;
+}
+
+Endpoint parseEndpoint(const std::string& text) {
+    Endpoint endpoint;
+    std::string rest = text;
+
+    if (text.compare(0, 5, "unix:") == 0) {
+        endpoint.kind = Endpoint::Kind::UNIX;
+        endpoint.path = text.substr(5);
+        if (endpoint.path.empty()) {
+            throw std::invalid_argument("Endpoint '" + text + "' has no socket path");
+        }
+        return endpoint;
+    }
+    if (text.compare(0, 4, "tcp:") == 0) {
+        rest = text.substr(4);
+    }
+
+    size_t colon = rest.rfind(':');
+    if (colon == std::string::npos || colon == 0 || colon + 1 == rest.size()) {
+        throw std::invalid_argument("Endpoint '" + text + "' must be tcp:host:port or unix:path");
+    }
+    endpoint.host = rest.substr(0, colon);
+    std::string portText = rest.substr(colon + 1);
+    if (portText.find_first_not_of("0123456789") != std::string::npos || portText.size() > 5) {
+        throw std::invalid_argument("Invalid port in endpoint '" + text + "'");
+    }
+    unsigned long port = std::stoul(portText);
+    if (port == 0 || port > 65535) {
+        throw std::invalid_argument("Port out of range in endpoint '" + text + "'");
+    }
+    endpoint.port = static_cast<uint16_t>(port);
+    return endpoint;
+}
+
+}  // namespace WinHKMon
@@ -0,0 +1,91 @@
+#include "WinHKMonLib/QuantileSketch.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace WinHKMon {
+
+namespace {
+
+// Values below this are counted as zero (keeps bucket indices bounded)
+constexpr double MIN_POSITIVE = 1e-9;
+
+}  // anonymous namespace
+
+QuantileSketch::QuantileSketch(double relativeAccuracy)
+    : alpha_(relativeAccuracy)
+    , gamma_(0.0)
+    , logGamma_(0.0)
+    , zeroCount_(0)
+    , count_(0)
+    , sum_(0.0)
+    , min_(0.0)
+    , max_(0.0) {
+    if (!(relativeAccuracy > 0.0 && relativeAccuracy < 1.0)) {
+        throw std::invalid_argument("Sketch relative accuracy must be between 0 and 1");
+    }
+    gamma_ = (1.0 + alpha_) / (1.0 - alpha_);
+    logGamma_ = std::log(gamma_);
+}
+
+void QuantileSketch::add(double value) {
+    if (!std::isfinite(value)) {
+        return;
+    }
+    value = std::max(0.0, value);
+
+    if (value < MIN_POSITIVE) {
+        zeroCount_++;
+    } else {
+        auto index = static_cast<int32_t>(std::ceil(std::log(value) / logGamma_));
+        buckets_[index]++;
+    }
+
+    min_ = count_ ? std::min(min_, value) : value;
+    max_ = count_ ? std::max(max_, value) : value;
+    count_++;
+    sum_ += value;
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.alpha_ != alpha_) {
+        throw std::invalid_argument("Cannot merge sketches with different accuracy");
+    }
+    if (other.count_ == 0) {
+        return;
+    }
+    for (const auto& bucket : other.buckets_) {
+        buckets_[bucket.first] += bucket.second;
+    }
+    min_ = count_ ? std::min(min_, other.min_) : other.min_;
+    max_ = count_ ? std::max(max_, other.max_) : other.max_;
+    zeroCount_ += other.zeroCount_;
+    count_ += other.count_;
+    sum_ += other.sum_;
+}
+
+double QuantileSketch::quantile(double q) const {
+    if (count_ == 0) {
+        return 0.0;
+    }
+    q = std::clamp(q, 0.0, 1.0);
+
+    // Rank of the requested value among count_ sorted values (0-based)
+    auto rank = static_cast<uint64_t>(q * static_cast<double>(count_ - 1));
+    if (rank < zeroCount_) {
+        return 0.0;
+    }
+
+    uint64_t seen = zeroCount_;
+    for (const auto& bucket : buckets_) {
+        seen += bucket.second;
+        if (seen > rank) {
+            // Bucket midpoint (in relative terms) of (gamma^(i-1), gamma^i]
+            double estimate = 2.0 * std::pow(gamma_, bucket.first) / (gamma_ + 1.0);
+            return std::clamp(estimate, min_, max_);
+        }
+    }
+    return max_;
+}
+
+}  // namespace WinHKMon
@@ -0,0 +1,567 @@
+#define _WINSOCKAPI_
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <afunix.h>
+#include <windows.h>
+
+#include "WinHKMonLib/RemoteTransport.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace WinHKMon {
+
+namespace {
+
+constexpr size_t READ_BUFFER_BYTES = 64 * 1024;
+constexpr size_t MAX_PENDING_SEND_BYTES = 64 * 1024;     // Unsent bytes before samples are dropped
+constexpr size_t MAX_PENDING_PULL_BYTES = 64 * 1024;     // Unsent responses before a puller is dropped
+constexpr int CONNECT_TIMEOUT_MS = 500;
+constexpr auto RECONNECT_INTERVAL = std::chrono::seconds(5);
+
+void startWinsock() {
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        throw std::runtime_error("WSAStartup failed");
+    }
+}
+
+bool setNonBlocking(SOCKET socket) {
+    u_long nonBlocking = 1;
+    return ioctlsocket(socket, FIONBIO, &nonBlocking) == 0;
+}
+
+// Fill a sockaddr for the endpoint; returns its length (0 on failure)
+int resolve(const Endpoint& endpoint, sockaddr_storage& storage, bool passive) {
+    std::memset(&storage, 0, sizeof(storage));
+
+    if (endpoint.kind == Endpoint::Kind::UNIX) {
+        auto* addr = reinterpret_cast<SOCKADDR_UN*>(&storage);
+        if (endpoint.path.size() >= sizeof(addr->sun_path)) {
+            return 0;
+        }
+        addr->sun_family = AF_UNIX;
+        std::memcpy(addr->sun_path, endpoint.path.c_str(), endpoint.path.size() + 1);
+        return static_cast<int>(sizeof(SOCKADDR_UN));
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(endpoint.host.c_str(), std::to_string(endpoint.port).c_str(), &hints, &result) != 0) {
+        return 0;
+    }
+    int length = static_cast<int>(result->ai_addrlen);
+    std::memcpy(&storage, result->ai_addr, result->ai_addrlen);
+    freeaddrinfo(result);
+    return length;
+}
+
+std::string describe(const Endpoint& endpoint) {
+    return endpoint.kind == Endpoint::Kind::UNIX
+        ? "unix:" + endpoint.path
+        : "tcp:" + endpoint.host + ":" + std::to_string(endpoint.port);
+}
+
+// Bound, listening, non-blocking socket; calls WSACleanup before throwing
+SOCKET openListener(const Endpoint& endpoint) {
+    sockaddr_storage addr;
+    int addrLen = resolve(endpoint, addr, true);
+    int family = endpoint.kind == Endpoint::Kind::UNIX ? AF_UNIX : AF_INET;
+    SOCKET listener = addrLen > 0 ? socket(family, SOCK_STREAM, 0) : INVALID_SOCKET;
+    if (listener == INVALID_SOCKET) {
+        WSACleanup();
+        throw std::runtime_error("Cannot create listening socket for " + describe(endpoint));
+    }
+
+    if (endpoint.kind == Endpoint::Kind::UNIX) {
+        DeleteFileA(endpoint.path.c_str());  // Stale socket file from a previous run
+    } else {
+        BOOL exclusive = TRUE;
+        setsockopt(listener, SOL_SOCKET, SO_EXCLUSIVEADDRUSE,
+                   reinterpret_cast<const char*>(&exclusive), sizeof(exclusive));
+    }
+
+    if (bind(listener, reinterpret_cast<sockaddr*>(&addr), addrLen) != 0 ||
+        listen(listener, SOMAXCONN) != 0 || !setNonBlocking(listener)) {
+        int error = WSAGetLastError();
+        closesocket(listener);
+        WSACleanup();
+        throw std::runtime_error("Cannot listen on " + describe(endpoint) +
+                                 " (error " + std::to_string(error) + ")");
+    }
+    return listener;
+}
+
+// Connected socket (non-blocking) or INVALID_SOCKET, bounded by timeoutMs
+SOCKET connectTo(const Endpoint& endpoint, int timeoutMs) {
+    sockaddr_storage addr;
+    int addrLen = resolve(endpoint, addr, false);
+    if (addrLen == 0) {
+        return INVALID_SOCKET;
+    }
+    int family = endpoint.kind == Endpoint::Kind::UNIX ? AF_UNIX : AF_INET;
+    SOCKET socket = ::socket(family, SOCK_STREAM, 0);
+    if (socket == INVALID_SOCKET || !setNonBlocking(socket)) {
+        if (socket != INVALID_SOCKET) {
+            closesocket(socket);
+        }
+        return INVALID_SOCKET;
+    }
+
+    if (::connect(socket, reinterpret_cast<sockaddr*>(&addr), addrLen) != 0) {
+        if (WSAGetLastError() != WSAEWOULDBLOCK) {
+            closesocket(socket);
+            return INVALID_SOCKET;
+        }
+        WSAPOLLFD fd{};
+        fd.fd = socket;
+        fd.events = POLLWRNORM;
+        if (WSAPoll(&fd, 1, timeoutMs) != 1 || (fd.revents & (POLLERR | POLLHUP))) {
+            closesocket(socket);
+            return INVALID_SOCKET;
+        }
+    }
+
+    if (endpoint.kind == Endpoint::Kind::TCP) {
+        BOOL noDelay = TRUE;  // Messages are small and periodic; do not wait to coalesce
+        setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+    }
+    return socket;
+}
+
+// Blocking receive of exactly size bytes
+bool receiveAll(SOCKET socket, char* data, size_t size) {
+    while (size > 0) {
+        int bytes = recv(socket, data, static_cast<int>(size), 0);
+        if (bytes <= 0) {
+            return false;
+        }
+        data += bytes;
+        size -= static_cast<size_t>(bytes);
+    }
+    return true;
+}
+
+}  // anonymous namespace
+
+// ============================================================================
+// AggregateServer
+// ============================================================================
+
+AggregateServer::AggregateServer(const Endpoint& endpoint, SampleHandler handler)
+    : endpoint_(endpoint)
+    , handler_(std::move(handler))
+    , listenSocket_(INVALID_SOCKET)
+    , readBuffer_(READ_BUFFER_BYTES)
+    , rejected_(0) {
+    startWinsock();
+    listenSocket_ = static_cast<uintptr_t>(openListener(endpoint));
+}
+
+AggregateServer::~AggregateServer() {
+    for (const Connection& connection : connections_) {
+        closesocket(static_cast<SOCKET>(connection.socket));
+    }
+    closesocket(static_cast<SOCKET>(listenSocket_));
+    if (endpoint_.kind == Endpoint::Kind::UNIX) {
+        DeleteFileA(endpoint_.path.c_str());
+    }
+    WSACleanup();
+}
+
+void AggregateServer::pollEntries(std::vector<PollEntry>& entries) {
+    // Listener first, then connections_ in order
+    entries.push_back(PollEntry{listenSocket_, true, false, false, false});
+    for (const Connection& connection : connections_) {
+        entries.push_back(PollEntry{connection.socket, true, false, false, false});
+    }
+}
+
+void AggregateServer::dispatch(PollEntry* entries, size_t count) {
+    std::vector<Connection> kept;
+    kept.reserve(connections_.size());
+    for (size_t i = 0; i < connections_.size(); i++) {
+        bool open = true;
+        if (i + 1 < count && entries[i + 1].readable) {
+            open = readConnection(connections_[i]);
+        }
+        if (open) {
+            kept.push_back(std::move(connections_[i]));
+        } else {
+            closesocket(static_cast<SOCKET>(connections_[i].socket));
+        }
+    }
+    connections_.swap(kept);
+
+    // Accept after reading so new sockets are polled from the next wait
+    if (entries[0].readable) {
+        acceptPending();
+    }
+}
+
+void AggregateServer::acceptPending() {
+    for (;;) {
+        SOCKET client = accept(static_cast<SOCKET>(listenSocket_), nullptr, nullptr);
+        if (client == INVALID_SOCKET) {
+            return;  // WSAEWOULDBLOCK: backlog drained
+        }
+        if (!setNonBlocking(client)) {
+            closesocket(client);
+            continue;
+        }
+        connections_.push_back(Connection{static_cast<uintptr_t>(client), PushDecoder()});
+    }
+}
+
+bool AggregateServer::readConnection(Connection& connection) {
+    SOCKET socket = static_cast<SOCKET>(connection.socket);
+    for (;;) {
+        int bytes = recv(socket, readBuffer_.data(), static_cast<int>(readBuffer_.size()), 0);
+        if (bytes == 0) {
+            return false;  // Agent closed the connection
+        }
+        if (bytes < 0) {
+            return WSAGetLastError() == WSAEWOULDBLOCK;
+        }
+
+        connection.decoder.feed(readBuffer_.data(), static_cast<size_t>(bytes));
+        try {
+            PushSample sample;
+            while (connection.decoder.next(sample)) {
+                handler_(sample);
+            }
+        } catch (const std::runtime_error&) {
+            rejected_++;
+            return false;
+        }
+
+        if (static_cast<size_t>(bytes) < readBuffer_.size()) {
+            return true;  // Socket drained
+        }
+    }
+}
+
+// ============================================================================
+// PushClient
+// ============================================================================
+
+PushClient::PushClient(const Endpoint& endpoint)
+    : endpoint_(endpoint)
+    , socket_(INVALID_HANDLE)
+    , nextAttempt_(std::chrono::steady_clock::now()) {
+    startWinsock();
+}
+
+PushClient::~PushClient() {
+    disconnect();
+    WSACleanup();
+}
+
+bool PushClient::send(const PushSample& sample) {
+    if (!isConnected()) {
+        if (std::chrono::steady_clock::now() < nextAttempt_) {
+            return false;
+        }
+        if (!connect()) {
+            nextAttempt_ = std::chrono::steady_clock::now() + RECONNECT_INTERVAL;
+            return false;
+        }
+    }
+
+    // Aggregator not reading: drop this sample, keep whole messages queued
+    if (sendBuffer_.size() > MAX_PENDING_SEND_BYTES) {
+        return false;
+    }
+    encodePushSample(sample, sendBuffer_);
+    if (!flush()) {
+        disconnect();
+        nextAttempt_ = std::chrono::steady_clock::now() + RECONNECT_INTERVAL;
+        return false;
+    }
+    return true;
+}
+
+void PushClient::pollEntries(std::vector<PollEntry>& entries) {
+    // Readable only when the aggregator closed the connection (it never sends)
+    if (isConnected()) {
+        entries.push_back(PollEntry{socket_, true, !sendBuffer_.empty(), false, false});
+    }
+}
+
+void PushClient::dispatch(PollEntry* entries, size_t count) {
+    if (count == 0 || !isConnected()) {
+        return;
+    }
+    bool open = true;
+    if (entries[0].readable) {
+        char byte;
+        int bytes = recv(static_cast<SOCKET>(socket_), &byte, 1, 0);
+        open = bytes > 0 || (bytes < 0 && WSAGetLastError() == WSAEWOULDBLOCK);
+    }
+    if (open && entries[0].writable) {
+        open = flush();
+    }
+    if (!open) {
+        disconnect();
+        nextAttempt_ = std::chrono::steady_clock::now() + RECONNECT_INTERVAL;
+    }
+}
+
+// Send as much of sendBuffer_ as the socket takes; false if the connection failed
+bool PushClient::flush() {
+    SOCKET socket = static_cast<SOCKET>(socket_);
+    size_t offset = 0;
+    while (offset < sendBuffer_.size()) {
+        int bytes = ::send(socket, sendBuffer_.data() + offset,
+                           static_cast<int>(sendBuffer_.size() - offset), 0);
+        if (bytes == SOCKET_ERROR) {
+            if (WSAGetLastError() == WSAEWOULDBLOCK) {
+                break;  // Rest goes out when the socket is writable
+            }
+            return false;
+        }
+        offset += static_cast<size_t>(bytes);
+    }
+    sendBuffer_.erase(0, offset);
+    return true;
+}
+
+bool PushClient::connect() {
+    SOCKET socket = connectTo(endpoint_, CONNECT_TIMEOUT_MS);
+    if (socket == INVALID_SOCKET) {
+        return false;
+    }
+    socket_ = static_cast<uintptr_t>(socket);
+    sendBuffer_.clear();
+    return true;
+}
+
+void PushClient::disconnect() {
+    if (isConnected()) {
+        closesocket(static_cast<SOCKET>(socket_));
+        socket_ = INVALID_HANDLE;
+    }
+    sendBuffer_.clear();
+}
+
+// ============================================================================
+// PullServer
+// ============================================================================
+
+PullServer::PullServer(const Endpoint& endpoint, const FrameRing& ring, uint64_t epoch)
+    : endpoint_(endpoint)
+    , ring_(ring)
+    , epoch_(epoch)
+    , listenSocket_(INVALID_SOCKET)
+    , readBuffer_(READ_BUFFER_BYTES)
+    , answered_(0) {
+    startWinsock();
+    listenSocket_ = static_cast<uintptr_t>(openListener(endpoint));
+}
+
+PullServer::~PullServer() {
+    for (const Connection& connection : connections_) {
+        closesocket(static_cast<SOCKET>(connection.socket));
+    }
+    closesocket(static_cast<SOCKET>(listenSocket_));
+    if (endpoint_.kind == Endpoint::Kind::UNIX) {
+        DeleteFileA(endpoint_.path.c_str());
+    }
+    WSACleanup();
+}
+
+void PullServer::pollEntries(std::vector<PollEntry>& entries) {
+    // Listener first, then connections_ in order
+    entries.push_back(PollEntry{listenSocket_, true, false, false, false});
+    for (const Connection& connection : connections_) {
+        entries.push_back(PollEntry{connection.socket, true, !connection.outbox.empty(), false, false});
+    }
+}
+
+void PullServer::dispatch(PollEntry* entries, size_t count) {
+    std::vector<Connection> kept;
+    kept.reserve(connections_.size());
+    for (size_t i = 0; i < connections_.size(); i++) {
+        bool open = true;
+        if (i + 1 < count && (entries[i + 1].readable || entries[i + 1].writable)) {
+            open = serviceConnection(connections_[i], entries[i + 1].readable);
+        }
+        if (open) {
+            kept.push_back(std::move(connections_[i]));
+        } else {
+            closesocket(static_cast<SOCKET>(connections_[i].socket));
+        }
+    }
+    connections_.swap(kept);
+
+    if (entries[0].readable) {
+        acceptPending();
+    }
+}
+
+void PullServer::acceptPending() {
+    for (;;) {
+        SOCKET client = accept(static_cast<SOCKET>(listenSocket_), nullptr, nullptr);
+        if (client == INVALID_SOCKET) {
+            return;  // WSAEWOULDBLOCK: backlog drained
+        }
+        if (!setNonBlocking(client)) {
+            closesocket(client);
+            continue;
+        }
+        if (endpoint_.kind == Endpoint::Kind::TCP) {
+            BOOL noDelay = TRUE;
+            setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+        }
+        connections_.push_back(Connection{static_cast<uintptr_t>(client), std::string(), std::string()});
+    }
+}
+
+bool PullServer::serviceConnection(Connection& connection, bool readable) {
+    SOCKET socket = static_cast<SOCKET>(connection.socket);
+
+    while (readable) {
+        int bytes = recv(socket, readBuffer_.data(), static_cast<int>(readBuffer_.size()), 0);
+        if (bytes == 0) {
+            return false;  // Client closed the connection
+        }
+        if (bytes < 0) {
+            if (WSAGetLastError() != WSAEWOULDBLOCK) {
+                return false;
+            }
+            break;
+        }
+        connection.inbox.append(readBuffer_.data(), static_cast<size_t>(bytes));
+        readable = static_cast<size_t>(bytes) == readBuffer_.size();
+    }
+
+    // Answer every complete request
+    try {
+        size_t offset = 0;
+        uint64_t clientEpoch = 0;
+        uint64_t clientSequence = 0;
+        while (size_t used = decodePullRequest(connection.inbox.data() + offset,
+                                               connection.inbox.size() - offset,
+                                               clientEpoch, clientSequence)) {
+            encodeSnapshotResponse(ring_, epoch_, clientEpoch, clientSequence, connection.outbox);
+            offset += used;
+            answered_++;
+        }
+        connection.inbox.erase(0, offset);
+    } catch (const std::runtime_error&) {
+        return false;  // Malformed request
+    }
+
+    // Client sending requests without reading responses
+    if (connection.outbox.size() > MAX_PENDING_PULL_BYTES) {
+        return false;
+    }
+
+    size_t offset = 0;
+    while (offset < connection.outbox.size()) {
+        int bytes = ::send(socket, connection.outbox.data() + offset,
+                           static_cast<int>(connection.outbox.size() - offset), 0);
+        if (bytes == SOCKET_ERROR) {
+            if (WSAGetLastError() != WSAEWOULDBLOCK) {
+                return false;
+            }
+            break;  // Rest goes out when the socket is writable
+        }
+        offset += static_cast<size_t>(bytes);
+    }
+    connection.outbox.erase(0, offset);
+    return true;
+}
+
+// ============================================================================
+// PullClient
+// ============================================================================
+
+PullClient::PullClient(const Endpoint& endpoint, int timeoutMs)
+    : endpoint_(endpoint)
+    , timeoutMs_(timeoutMs)
+    , socket_(INVALID_HANDLE) {
+    startWinsock();
+}
+
+PullClient::~PullClient() {
+    disconnect();
+    WSACleanup();
+}
+
+SnapshotKind PullClient::pull(SnapshotDecoder& decoder, size_t* responseBytes) {
+    exchange(decoder, responseBytes);
+    try {
+        return decoder.apply(message_.data(), message_.size());
+    } catch (const std::runtime_error&) {
+        if (decoder.lastSequence() == 0) {
+            disconnect();
+            throw;
+        }
+    }
+
+    // Held frame is not what the agent based its delta on: start over
+    decoder.reset();
+    exchange(decoder, responseBytes);
+    return decoder.apply(message_.data(), message_.size());
+}
+
+void PullClient::exchange(const SnapshotDecoder& decoder, size_t* responseBytes) {
+    if (socket_ == INVALID_HANDLE) {
+        connect();
+    }
+    SOCKET socket = static_cast<SOCKET>(socket_);
+
+    std::string request;
+    encodePullRequest(decoder.epoch(), decoder.lastSequence(), request);
+    if (::send(socket, request.data(), static_cast<int>(request.size()), 0) !=
+        static_cast<int>(request.size())) {
+        disconnect();
+        throw std::runtime_error("Cannot send pull request to " + describe(endpoint_));
+    }
+
+    unsigned char prefix[4];
+    if (!receiveAll(socket, reinterpret_cast<char*>(prefix), sizeof(prefix))) {
+        disconnect();
+        throw std::runtime_error("No snapshot response from " + describe(endpoint_));
+    }
+    uint32_t length = prefix[0] | (prefix[1] << 8) | (prefix[2] << 16) | (static_cast<uint32_t>(prefix[3]) << 24);
+    if (length == 0 || length > MAX_SNAPSHOT_MESSAGE_BYTES) {
+        disconnect();
+        throw std::runtime_error("Invalid snapshot response length");
+    }
+    message_.resize(length);
+    if (!receiveAll(socket, &message_[0], length)) {
+        disconnect();
+        throw std::runtime_error("Truncated snapshot response from " + describe(endpoint_));
+    }
+    if (responseBytes != nullptr) {
+        *responseBytes = sizeof(prefix) + length;
+    }
+}
+
+void PullClient::connect() {
+    SOCKET socket = connectTo(endpoint_, timeoutMs_);
+    if (socket == INVALID_SOCKET) {
+        throw std::runtime_error("Cannot connect to " + describe(endpoint_));
+    }
+
+    // Requests are strictly request/response: block with timeouts
+    u_long nonBlocking = 0;
+    DWORD timeout = static_cast<DWORD>(timeoutMs_);
+    ioctlsocket(socket, FIONBIO, &nonBlocking);
+    setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+    setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+    socket_ = static_cast<uintptr_t>(socket);
+}
+
+void PullClient::disconnect() {
+    if (socket_ != INVALID_HANDLE) {
+        closesocket(static_cast<SOCKET>(socket_));
+        socket_ = INVALID_HANDLE;
+    }
+}
+
+}  // namespace WinHKMon
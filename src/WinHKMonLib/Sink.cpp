@@ -0,0 +1,426 @@
+#include "WinHKMonLib/Sink.h"
+#include "WinHKMonLib/OutputFormatter.h"
+#include "WinHKMonLib/Tracer.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+namespace WinHKMon {
+
+namespace {
+
+std::string toLower(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return str;
+}
+
+const char* formatName(OutputFormat format) {
+    switch (format) {
+        case OutputFormat::JSON: return "json";
+        case OutputFormat::CSV: return "csv";
+        case OutputFormat::NDJSON: return "ndjson";
+        case OutputFormat::SQLITE: return "sqlite";
+        case OutputFormat::TEXT: break;
+    }
+    return "text";
+}
+
+bool isConsole(const std::string& target) {
+    return target == "stdout" || target == "stderr";
+}
+
+// stdout/stderr, or the file target opened for appending (nullptr on failure)
+std::FILE* openTarget(const std::string& target) {
+    if (target == "stdout") {
+        return stdout;
+    }
+    if (target == "stderr") {
+        return stderr;
+    }
+    std::FILE* file = nullptr;
+#ifdef _WIN32
+    if (fopen_s(&file, target.c_str(), "ab") != 0) {
+        return nullptr;
+    }
+#else
+    file = std::fopen(target.c_str(), "ab");
+#endif
+    return file;
+}
+
+// Wall-clock time of a sample: its aligned tick or capture time, else now
+uint64_t sampleTimeMs(const SystemMetrics& metrics) {
+    if (metrics.nominalTimeMs) {
+        return *metrics.nominalTimeMs;
+    }
+    if (metrics.captureTimeMs) {
+        return *metrics.captureTimeMs;
+    }
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+// A file target that already has content (appending continues under its header)
+bool hasContent(std::FILE* file) {
+    return std::fseek(file, 0, SEEK_END) == 0 && std::ftell(file) > 0;
+}
+
+/**
+ * @brief One sample in the sink's format
+ *
+ * @param header Start a CSV target with its header
+ * @param first First sample of this target (no blank separator line before it)
+ */
+std::string formatSample(const SinkSpec& spec, const CliOptions& options, const SystemMetrics& metrics,
+                         bool header, bool first) {
+    WINHKMON_TRACE_SPAN("output", "format");
+    std::string output;
+    switch (spec.format) {
+        case OutputFormat::JSON:
+            output = formatJson(metrics, options) + "\n";
+            break;
+        case OutputFormat::NDJSON:
+            output = formatNdjson(metrics, options);
+            break;
+        case OutputFormat::CSV:
+            // Header from the first frame, which has the columns of this run
+            output = formatCsv(metrics, header, options);
+            break;
+        case OutputFormat::TEXT:
+            // Multi-line samples in continuous mode are separated by a blank line
+            if (!first && !options.singleLine) {
+                output = "\n";
+            }
+            output += formatText(metrics, options.singleLine, options);
+            // A single-shot single line has no newline, for status bars
+            if (options.continuous || !options.singleLine || !isConsole(spec.target)) {
+                output += "\n";
+            }
+            break;
+        case OutputFormat::SQLITE:
+            break;  // Rows, not text (see SqliteStore)
+    }
+    return output;
+}
+
+bool writeAll(std::FILE* out, const std::string& output) {
+    WINHKMON_TRACE_SPAN("output", "write");
+    bool written = std::fwrite(output.data(), 1, output.size(), out) == output.size();
+    return std::fflush(out) == 0 && written;
+}
+
+}  // anonymous namespace
+
+// ============================================================================
+// Specs
+// ============================================================================
+
+SinkSpec parseSinkSpec(const std::string& value) {
+    size_t colon = value.find(':');
+    if (colon == std::string::npos || colon + 1 == value.size()) {
+        throw std::invalid_argument("Invalid --sink '" + value + "'. Expected format:target "
+                                    "(e.g., text:stdout, csv:C:\\logs\\whk.csv)");
+    }
+
+    SinkSpec spec;
+    std::string format = toLower(value.substr(0, colon));
+    size_t plus = format.find('+');
+    if (plus != std::string::npos) {
+        std::string policy = format.substr(plus + 1);
+        if (policy == "block") {
+            spec.policy = SinkPolicy::BLOCK;
+        } else if (policy == "drop") {
+            spec.policy = SinkPolicy::DROP_OLDEST;
+        } else {
+            throw std::invalid_argument("Invalid sink policy '" + policy + "'. Valid policies: block, drop");
+        }
+        format = format.substr(0, plus);
+    }
+
+    if (format == "text") {
+        spec.format = OutputFormat::TEXT;
+    } else if (format == "json") {
+        spec.format = OutputFormat::JSON;
+    } else if (format == "ndjson") {
+        spec.format = OutputFormat::NDJSON;
+    } else if (format == "csv") {
+        spec.format = OutputFormat::CSV;
+    } else if (format == "sqlite") {
+        spec.format = OutputFormat::SQLITE;
+    } else {
+        throw std::invalid_argument("Invalid sink format '" + format +
+                                    "'. Valid formats: text, json, ndjson, csv, sqlite");
+    }
+    spec.target = value.substr(colon + 1);
+    if (spec.format == OutputFormat::SQLITE && isConsole(spec.target)) {
+        throw std::invalid_argument("A sqlite sink needs a database file, not " + spec.target);
+    }
+    return spec;
+}
+
+std::vector<SinkSpec> effectiveSinks(const CliOptions& options) {
+    if (!options.sinks.empty()) {
+        return options.sinks;
+    }
+    SinkSpec console;
+    console.format = options.format;
+    return {console};
+}
+
+std::string describeSink(const SinkSpec& spec) {
+    return std::string(formatName(spec.format)) +
+           (spec.policy == SinkPolicy::DROP_OLDEST ? "+drop" : "") + ":" + spec.target;
+}
+
+bool writeSample(const SinkSpec& spec, const CliOptions& options, const SystemMetrics& metrics) {
+    if (spec.format == OutputFormat::SQLITE) {
+        try {
+            SqliteStore store(spec.target, 1, options.sqliteCommitSeconds);
+            return store.append(metrics, sampleTimeMs(metrics)) && store.commit();
+        } catch (const std::runtime_error&) {
+            return false;
+        }
+    }
+    std::FILE* out = openTarget(spec.target);
+    if (out == nullptr) {
+        return false;
+    }
+    bool console = isConsole(spec.target);
+    bool header = spec.format == OutputFormat::CSV && (console || !hasContent(out));
+    bool written = writeAll(out, formatSample(spec, options, metrics, header, true));
+    if (!console) {
+        written = std::fclose(out) == 0 && written;
+    }
+    return written;
+}
+
+// ============================================================================
+// Writer pool
+// ============================================================================
+
+SinkWriterPool::SinkWriterPool(size_t threads, std::function<void()> onWriterStart)
+    : maxThreads_(std::max<size_t>(threads, 1))
+    , onWriterStart_(std::move(onWriterStart))
+    , cursor_(0)
+    , stopping_(false) {
+}
+
+SinkWriterPool::~SinkWriterPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+}
+
+size_t SinkWriterPool::threadCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return threads_.size();
+}
+
+void SinkWriterPool::attach(Sink* sink) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sinks_.push_back(sink);
+    // One thread per sink until the limit: a lone console sink costs one thread
+    if (threads_.size() < maxThreads_ && threads_.size() < sinks_.size()) {
+        threads_.emplace_back(&SinkWriterPool::run, this, threads_.size());
+    }
+}
+
+void SinkWriterPool::detach(Sink* sink) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [sink] { return !sink->running_; });
+    sinks_.erase(std::find(sinks_.begin(), sinks_.end(), sink));
+    cursor_ = 0;
+}
+
+void SinkWriterPool::schedule(Sink* sink) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sink->due_ = Clock::time_point::min();
+    }
+    changed_.notify_one();
+}
+
+void SinkWriterPool::run(size_t index) {
+    if (Tracer::instance().isEnabled()) {
+        Tracer::instance().setThreadName("sink-writer " + std::to_string(index));
+    }
+    if (onWriterStart_) {
+        onWriterStart_();
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        // Earliest due sink not taken by another thread, starting after the last one served
+        Sink* next = nullptr;
+        size_t nextIndex = 0;
+        for (size_t i = 0; i < sinks_.size(); i++) {
+            size_t at = (cursor_ + i) % sinks_.size();
+            Sink* sink = sinks_[at];
+            if (!sink->running_ && (next == nullptr || sink->due_ < next->due_)) {
+                next = sink;
+                nextIndex = at;
+            }
+        }
+        if (next == nullptr || next->due_ == Clock::time_point::max()) {
+            changed_.wait(lock);
+            continue;
+        }
+        if (next->due_ > Clock::now()) {
+            changed_.wait_until(lock, next->due_);
+            continue;
+        }
+
+        cursor_ = nextIndex + 1;
+        next->running_ = true;
+        next->due_ = Clock::time_point::max();
+        lock.unlock();
+        Clock::time_point again = next->service();
+        lock.lock();
+        next->running_ = false;
+        next->due_ = std::min(next->due_, again);  // A submit() during service() stays due
+        changed_.notify_all();  // Other threads may take it; detach() waits for it
+    }
+}
+
+// ============================================================================
+// Sink
+// ============================================================================
+
+Sink::Sink(const SinkSpec& spec, const CliOptions& options, SinkWriterPool& writers,
+           bool forceHeader)
+    : writers_(writers)
+    , spec_(spec)
+    , options_(options)
+    , out_(nullptr)
+    , ownsFile_(!isConsole(spec.target) && spec.format != OutputFormat::SQLITE)
+    , headerPending_(spec.format == OutputFormat::CSV)
+    , written_(0)
+    , busy_(false)
+    , stopping_(false)
+    , dropped_(0)
+    , failed_(false)
+    , due_(SinkWriterPool::Clock::time_point::max())
+    , running_(false) {
+    if (spec_.format == OutputFormat::SQLITE) {
+        store_ = std::make_unique<SqliteStore>(spec_.target, options.sqliteBatchSamples,
+                                               options.sqliteCommitSeconds);
+    } else {
+        out_ = openTarget(spec_.target);
+        if (out_ == nullptr) {
+            throw std::runtime_error("Cannot open sink file '" + spec_.target + "'");
+        }
+        // Appending to an existing CSV file continues under its header
+        if (ownsFile_ && hasContent(out_) && !forceHeader) {
+            headerPending_ = false;
+        }
+    }
+    writers_.attach(this);
+}
+
+Sink::~Sink() {
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    writers_.detach(this);
+    if (ownsFile_) {
+        std::fclose(out_);
+    }
+}
+
+void Sink::submit(MetricsFrame frame, bool canWait) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (queue_.size() >= SINK_QUEUE_FRAMES) {
+            if (spec_.policy == SinkPolicy::DROP_OLDEST || !canWait) {
+                queue_.pop_front();
+                dropped_++;
+            } else {
+                WINHKMON_TRACE_SPAN("output", "sink-backpressure");
+                changed_.wait(lock, [this] { return queue_.size() < SINK_QUEUE_FRAMES; });
+            }
+        }
+        queue_.push_back(std::move(frame));
+    }
+    writers_.schedule(this);
+}
+
+void Sink::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this] { return queue_.empty() && !busy_; });
+}
+
+bool Sink::mustWait() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return spec_.policy == SinkPolicy::BLOCK && queue_.size() >= SINK_QUEUE_FRAMES;
+}
+
+uint64_t Sink::droppedFrames() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+}
+
+bool Sink::writeFailed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
+
+SinkWriterPool::Clock::time_point Sink::service() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (size_t n = 0; n < SINK_QUEUE_FRAMES && !queue_.empty(); n++) {
+        MetricsFrame frame = std::move(queue_.front());
+        queue_.pop_front();
+        busy_ = true;
+        lock.unlock();
+        changed_.notify_all();  // Room for a blocked submit()
+
+        bool failed = !write(*frame);
+
+        lock.lock();
+        busy_ = false;
+        failed_ = failed_ || failed;
+        changed_.notify_all();  // flush() waits for the sink to go idle
+    }
+    if (!queue_.empty()) {
+        return SinkWriterPool::Clock::time_point::min();
+    }
+    if (!store_ || store_->pendingSamples() == 0 || stopping_) {
+        return SinkWriterPool::Clock::time_point::max();  // The store commits what is left on close
+    }
+    if (store_->commitDue() > SinkWriterPool::Clock::now()) {
+        return store_->commitDue();
+    }
+
+    // Idle with uncommitted rows that reached the commit age
+    busy_ = true;
+    lock.unlock();
+    bool failed = !store_->commit();
+    lock.lock();
+    busy_ = false;
+    failed_ = failed_ || failed;
+    changed_.notify_all();
+    if (failed) {
+        return SinkWriterPool::Clock::now() + std::chrono::seconds(1);  // Retry later, not in a spin
+    }
+    return SinkWriterPool::Clock::time_point::max();
+}
+
+bool Sink::write(const SystemMetrics& metrics) {
+    if (store_) {
+        return store_->append(metrics, sampleTimeMs(metrics));
+    }
+    std::string output = formatSample(spec_, options_, metrics, headerPending_, written_ == 0);
+    headerPending_ = false;
+    written_++;
+    return writeAll(out_, output);
+}
+
+}  // namespace WinHKMon
@@ -0,0 +1,357 @@
+#include "WinHKMonLib/SqliteStore.h"
+#include <stdexcept>
+
+#ifdef WINHKMON_HAVE_SQLITE
+#include <sqlite3.h>
+#endif
+
+namespace WinHKMon {
+
+#ifdef WINHKMON_HAVE_SQLITE
+
+namespace {
+
+const char* const SCHEMA =
+    "CREATE TABLE IF NOT EXISTS samples ("
+    "  id INTEGER PRIMARY KEY,"
+    "  time_ms INTEGER NOT NULL,"
+    "  interval_s REAL);"
+    "CREATE INDEX IF NOT EXISTS samples_time ON samples(time_ms);"
+    "CREATE TABLE IF NOT EXISTS devices ("
+    "  id INTEGER PRIMARY KEY,"
+    "  kind TEXT NOT NULL,"
+    "  name TEXT NOT NULL,"
+    "  UNIQUE(kind, name));"
+    "CREATE TABLE IF NOT EXISTS cpu ("
+    "  sample_id INTEGER PRIMARY KEY REFERENCES samples(id),"
+    "  usage_percent REAL NOT NULL,"
+    "  avg_freq_mhz INTEGER,"
+    "  user_percent REAL,"
+    "  system_percent REAL);"
+    "CREATE TABLE IF NOT EXISTS cpu_core ("
+    "  sample_id INTEGER NOT NULL REFERENCES samples(id),"
+    "  core_id INTEGER NOT NULL,"
+    "  usage_percent REAL NOT NULL,"
+    "  freq_mhz INTEGER,"
+    "  PRIMARY KEY(sample_id, core_id)) WITHOUT ROWID;"
+    "CREATE TABLE IF NOT EXISTS memory ("
+    "  sample_id INTEGER PRIMARY KEY REFERENCES samples(id),"
+    "  total_bytes INTEGER NOT NULL,"
+    "  available_bytes INTEGER NOT NULL,"
+    "  usage_percent REAL NOT NULL,"
+    "  page_file_used_bytes INTEGER,"
+    "  page_file_percent REAL);"
+    "CREATE TABLE IF NOT EXISTS disk ("
+    "  sample_id INTEGER NOT NULL REFERENCES samples(id),"
+    "  device_id INTEGER NOT NULL REFERENCES devices(id),"
+    "  total_bytes INTEGER,"
+    "  used_bytes INTEGER,"
+    "  free_bytes INTEGER,"
+    "  read_bytes_per_sec INTEGER,"
+    "  write_bytes_per_sec INTEGER,"
+    "  busy_percent REAL,"
+    "  PRIMARY KEY(sample_id, device_id)) WITHOUT ROWID;"
+    "CREATE TABLE IF NOT EXISTS interface ("
+    "  sample_id INTEGER NOT NULL REFERENCES samples(id),"
+    "  device_id INTEGER NOT NULL REFERENCES devices(id),"
+    "  in_bytes_per_sec INTEGER,"
+    "  out_bytes_per_sec INTEGER,"
+    "  total_in_octets INTEGER,"
+    "  total_out_octets INTEGER,"
+    "  PRIMARY KEY(sample_id, device_id)) WITHOUT ROWID;";
+
+// sqlite3 stores integers as signed 64-bit; counters never get near the top bit
+sqlite3_int64 toInt(uint64_t value) {
+    return static_cast<sqlite3_int64>(value);
+}
+
+std::string coresInsert(size_t rows) {
+    std::string sql = "INSERT INTO cpu_core(sample_id, core_id, usage_percent, freq_mhz) VALUES ";
+    for (size_t i = 0; i < rows; i++) {
+        sql += i == 0 ? "(?,?,?,?)" : ",(?,?,?,?)";
+    }
+    return sql;
+}
+
+}  // anonymous namespace
+
+bool sqliteAvailable() {
+    return true;
+}
+
+SqliteStore::SqliteStore(const std::string& path, size_t batchSamples, double commitSeconds)
+    : db_(nullptr)
+    , statements_{}
+    , batchSamples_(batchSamples > 0 ? batchSamples : 1)
+    , commitAge_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(commitSeconds)))
+    , pending_(0) {
+    auto fail = [this, &path](const std::string& what) {
+        std::string message = "SQLite sink '" + path + "': " + what +
+                              (db_ != nullptr ? std::string(" (") + sqlite3_errmsg(db_) + ")" : std::string());
+        for (sqlite3_stmt*& statement : statements_) {
+            sqlite3_finalize(statement);
+            statement = nullptr;
+        }
+        sqlite3_close(db_);
+        db_ = nullptr;
+        return std::runtime_error(message);
+    };
+
+    if (sqlite3_open_v2(path.c_str(), &db_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) != SQLITE_OK) {
+        throw fail("cannot open database");
+    }
+    sqlite3_busy_timeout(db_, 1000);  // Readers in other processes hold brief locks
+
+    // WAL: readers never block the writer, and a commit appends instead of
+    // rewriting pages; NORMAL syncs at checkpoints only, still crash-safe in WAL
+    if (sqlite3_exec(db_, "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL;", nullptr, nullptr, nullptr) !=
+            SQLITE_OK ||
+        sqlite3_exec(db_, SCHEMA, nullptr, nullptr, nullptr) != SQLITE_OK) {
+        throw fail("cannot create tables");
+    }
+
+    const std::string sql[STATEMENT_COUNT] = {
+        "BEGIN",
+        "COMMIT",
+        "INSERT INTO samples(time_ms, interval_s) VALUES (?, ?)",
+        "INSERT INTO cpu(sample_id, usage_percent, avg_freq_mhz, user_percent, system_percent) "
+        "VALUES (?, ?, ?, ?, ?)",
+        coresInsert(1),
+        coresInsert(SQLITE_CORE_ROWS_PER_INSERT),
+        "INSERT INTO memory(sample_id, total_bytes, available_bytes, usage_percent, "
+        "page_file_used_bytes, page_file_percent) VALUES (?, ?, ?, ?, ?, ?)",
+        "INSERT INTO disk(sample_id, device_id, total_bytes, used_bytes, free_bytes, "
+        "read_bytes_per_sec, write_bytes_per_sec, busy_percent) VALUES (?, ?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO interface(sample_id, device_id, in_bytes_per_sec, out_bytes_per_sec, "
+        "total_in_octets, total_out_octets) VALUES (?, ?, ?, ?, ?, ?)",
+        "INSERT OR IGNORE INTO devices(kind, name) VALUES (?, ?)",
+        "SELECT id FROM devices WHERE kind = ? AND name = ?",
+    };
+    for (int i = 0; i < STATEMENT_COUNT; i++) {
+        if (sqlite3_prepare_v3(db_, sql[i].c_str(), -1, SQLITE_PREPARE_PERSISTENT, &statements_[i], nullptr) !=
+            SQLITE_OK) {
+            throw fail("cannot prepare statements");
+        }
+    }
+}
+
+SqliteStore::~SqliteStore() {
+    commit();
+    for (sqlite3_stmt* statement : statements_) {
+        sqlite3_finalize(statement);
+    }
+    sqlite3_close(db_);
+}
+
+bool SqliteStore::run(sqlite3_stmt* statement) {
+    int result = sqlite3_step(statement);
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+    return result == SQLITE_DONE || result == SQLITE_ROW;
+}
+
+int64_t SqliteStore::deviceId(const char* kind, const std::string& name) {
+    std::string key = std::string(kind) + "/" + name;
+    auto cached = devices_.find(key);
+    if (cached != devices_.end()) {
+        return cached->second;
+    }
+
+    sqlite3_stmt* insert = statements_[INSERT_DEVICE];
+    sqlite3_bind_text(insert, 1, kind, -1, SQLITE_STATIC);
+    sqlite3_bind_text(insert, 2, name.c_str(), static_cast<int>(name.size()), SQLITE_STATIC);
+    if (!run(insert)) {
+        return -1;
+    }
+    // Existing rows are found too (a reopened database keeps its IDs)
+    sqlite3_stmt* select = statements_[SELECT_DEVICE];
+    sqlite3_bind_text(select, 1, kind, -1, SQLITE_STATIC);
+    sqlite3_bind_text(select, 2, name.c_str(), static_cast<int>(name.size()), SQLITE_STATIC);
+    int64_t id = -1;
+    if (sqlite3_step(select) == SQLITE_ROW) {
+        id = sqlite3_column_int64(select, 0);
+    }
+    sqlite3_reset(select);
+    sqlite3_clear_bindings(select);
+    if (id >= 0) {
+        devices_[key] = id;
+    }
+    return id;
+}
+
+bool SqliteStore::insertCores(int64_t sampleId, const CpuStats& cpu) {
+    bool ok = true;
+    size_t index = 0;
+    const size_t count = cpu.cores.size();
+    while (index < count) {
+        // Full multi-row statements first, then single rows for the remainder
+        bool chunk = count - index >= SQLITE_CORE_ROWS_PER_INSERT;
+        sqlite3_stmt* statement = statements_[chunk ? INSERT_CORES : INSERT_CORE];
+        size_t rows = chunk ? SQLITE_CORE_ROWS_PER_INSERT : 1;
+        for (size_t row = 0; row < rows; row++, index++) {
+            const CoreStats& core = cpu.cores[index];
+            int base = static_cast<int>(row * 4);
+            sqlite3_bind_int64(statement, base + 1, sampleId);
+            sqlite3_bind_int(statement, base + 2, core.coreId);
+            sqlite3_bind_double(statement, base + 3, core.usagePercent);
+            if (core.frequencyMhz > 0) {
+                sqlite3_bind_int64(statement, base + 4, toInt(core.frequencyMhz));
+            }
+        }
+        ok = run(statement) && ok;
+    }
+    return ok;
+}
+
+bool SqliteStore::append(const SystemMetrics& metrics, uint64_t timeMs) {
+    // No open transaction: none yet, or SQLite rolled it back after an error
+    if (sqlite3_get_autocommit(db_)) {
+        if (!run(statements_[BEGIN])) {
+            return false;
+        }
+        pending_ = 0;
+        transactionStart_ = std::chrono::steady_clock::now();
+    }
+    pending_++;
+
+    sqlite3_stmt* sample = statements_[INSERT_SAMPLE];
+    sqlite3_bind_int64(sample, 1, toInt(timeMs));
+    if (metrics.intervalSeconds) {
+        sqlite3_bind_double(sample, 2, *metrics.intervalSeconds);
+    }
+    if (!run(sample)) {
+        return false;
+    }
+    int64_t sampleId = sqlite3_last_insert_rowid(db_);
+    bool ok = true;
+
+    if (metrics.cpu) {
+        const CpuStats& cpu = *metrics.cpu;
+        sqlite3_stmt* statement = statements_[INSERT_CPU];
+        sqlite3_bind_int64(statement, 1, sampleId);
+        sqlite3_bind_double(statement, 2, cpu.totalUsagePercent);
+        if (cpu.averageFrequencyMhz > 0) {
+            sqlite3_bind_int64(statement, 3, toInt(cpu.averageFrequencyMhz));
+        }
+        if (cpu.userPercent) {
+            sqlite3_bind_double(statement, 4, *cpu.userPercent);
+        }
+        if (cpu.systemPercent) {
+            sqlite3_bind_double(statement, 5, *cpu.systemPercent);
+        }
+        ok = run(statement) && ok;
+        ok = insertCores(sampleId, cpu) && ok;
+    }
+
+    if (metrics.memory) {
+        const MemoryStats& memory = *metrics.memory;
+        sqlite3_stmt* statement = statements_[INSERT_MEMORY];
+        sqlite3_bind_int64(statement, 1, sampleId);
+        sqlite3_bind_int64(statement, 2, toInt(memory.totalPhysicalBytes));
+        sqlite3_bind_int64(statement, 3, toInt(memory.availablePhysicalBytes));
+        sqlite3_bind_double(statement, 4, memory.usagePercent);
+        if (memory.totalPageFileBytes > 0) {
+            sqlite3_bind_int64(statement, 5, toInt(memory.usedPageFileBytes));
+            sqlite3_bind_double(statement, 6, memory.pageFilePercent);
+        }
+        ok = run(statement) && ok;
+    }
+
+    if (metrics.disks) {
+        for (const DiskStats& disk : *metrics.disks) {
+            int64_t device = deviceId("disk", disk.deviceName);
+            if (device < 0) {
+                ok = false;
+                continue;
+            }
+            sqlite3_stmt* statement = statements_[INSERT_DISK];
+            sqlite3_bind_int64(statement, 1, sampleId);
+            sqlite3_bind_int64(statement, 2, device);
+            sqlite3_bind_int64(statement, 3, toInt(disk.totalSizeBytes));
+            sqlite3_bind_int64(statement, 4, toInt(disk.usedBytes));
+            sqlite3_bind_int64(statement, 5, toInt(disk.freeBytes));
+            sqlite3_bind_int64(statement, 6, toInt(disk.bytesReadPerSec));
+            sqlite3_bind_int64(statement, 7, toInt(disk.bytesWrittenPerSec));
+            sqlite3_bind_double(statement, 8, disk.percentBusy);
+            ok = run(statement) && ok;
+        }
+    }
+
+    if (metrics.network) {
+        for (const InterfaceStats& iface : *metrics.network) {
+            int64_t device = deviceId("interface", iface.name);
+            if (device < 0) {
+                ok = false;
+                continue;
+            }
+            sqlite3_stmt* statement = statements_[INSERT_INTERFACE];
+            sqlite3_bind_int64(statement, 1, sampleId);
+            sqlite3_bind_int64(statement, 2, device);
+            sqlite3_bind_int64(statement, 3, toInt(iface.inBytesPerSec));
+            sqlite3_bind_int64(statement, 4, toInt(iface.outBytesPerSec));
+            sqlite3_bind_int64(statement, 5, toInt(iface.totalInOctets));
+            sqlite3_bind_int64(statement, 6, toInt(iface.totalOutOctets));
+            ok = run(statement) && ok;
+        }
+    }
+
+    if (pending_ >= batchSamples_ || std::chrono::steady_clock::now() - transactionStart_ >= commitAge_) {
+        ok = commit() && ok;
+    }
+    return ok;
+}
+
+bool SqliteStore::commit() {
+    if (sqlite3_get_autocommit(db_)) {
+        pending_ = 0;
+        return true;
+    }
+    // A failed (e.g. busy) commit leaves the transaction open for the next try
+    if (!run(statements_[COMMIT])) {
+        return false;
+    }
+    pending_ = 0;
+    return true;
+}
+
+#else  // No SQLite in this build
+
+bool sqliteAvailable() {
+    return false;
+}
+
+SqliteStore::SqliteStore(const std::string&, size_t, double)
+    : db_(nullptr)
+    , statements_{}
+    , batchSamples_(0)
+    , commitAge_()
+    , pending_(0) {
+    throw std::runtime_error("This build of WinHKMon has no SQLite support (sqlite sinks are unavailable)");
+}
+
+SqliteStore::~SqliteStore() = default;
+
+bool SqliteStore::append(const SystemMetrics&, uint64_t) {
+    return false;
+}
+
+bool SqliteStore::commit() {
+    return true;
+}
+
+bool SqliteStore::run(sqlite3_stmt*) {
+    return false;
+}
+
+int64_t SqliteStore::deviceId(const char*, const std::string&) {
+    return -1;
+}
+
+bool SqliteStore::insertCores(int64_t, const CpuStats&) {
+    return false;
+}
+
+#endif
+
+}  // namespace WinHKMon
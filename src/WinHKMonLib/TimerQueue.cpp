@@ -0,0 +1,53 @@
+#include "WinHKMonLib/TimerQueue.h"
+#include <vector>
+
+namespace WinHKMon {
+
+uint64_t TimerQueue::add(Clock::time_point due, Callback callback) {
+    uint64_t id = nextId_++;
+    timers_.emplace(Key(due, id), std::move(callback));
+    deadlines_.emplace(id, due);
+    return id;
+}
+
+bool TimerQueue::cancel(uint64_t id) {
+    auto it = deadlines_.find(id);
+    if (it == deadlines_.end()) {
+        return false;
+    }
+    timers_.erase(Key(it->second, id));
+    deadlines_.erase(it);
+    return true;
+}
+
+std::optional<TimerQueue::Clock::time_point> TimerQueue::nextDue() const {
+    if (timers_.empty()) {
+        return std::nullopt;
+    }
+    return timers_.begin()->first.first;
+}
+
+size_t TimerQueue::runDue(Clock::time_point now) {
+    // Fix the batch first: timers added by callbacks wait for the next call
+    std::vector<uint64_t> batch;
+    for (auto it = timers_.begin(); it != timers_.end() && it->first.first <= now; ++it) {
+        batch.push_back(it->first.second);
+    }
+
+    size_t ran = 0;
+    for (uint64_t id : batch) {
+        auto deadline = deadlines_.find(id);
+        if (deadline == deadlines_.end()) {
+            continue;  // Cancelled by an earlier callback in this batch
+        }
+        auto timer = timers_.find(Key(deadline->second, id));
+        Callback callback = std::move(timer->second);
+        timers_.erase(timer);
+        deadlines_.erase(deadline);
+        callback();
+        ran++;
+    }
+    return ran;
+}
+
+}  // namespace WinHKMon
@@ -0,0 +1,170 @@
+#include "WinHKMonLib/Tracer.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace WinHKMon {
+
+namespace {
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Escape string for JSON (names are code literals, but thread names are caller-supplied)
+std::string escapeJson(const std::string& str) {
+    static const char HEX[] = "0123456789abcdef";
+    std::string escaped;
+    escaped.reserve(str.size());
+    for (char c : str) {
+        auto byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (byte < 0x20) {
+            escaped += "\\u00";
+            escaped += HEX[byte >> 4];
+            escaped += HEX[byte & 0xF];
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// Nanoseconds to the microsecond timestamps used by the trace-event format
+std::string toMicros(uint64_t ns) {
+    std::ostringstream oss;
+    oss << (ns / 1000) << "." << std::setw(3) << std::setfill('0') << (ns % 1000);
+    return oss.str();
+}
+
+}  // anonymous namespace
+
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer()
+    : enabled_(false)
+    , dropped_(0)
+    , originNs_(steadyNowNs())
+    , generation_(0) {
+}
+
+void Tracer::start() {
+    originNs_.store(steadyNowNs(), std::memory_order_relaxed);
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::stop() {
+    enabled_.store(false, std::memory_order_relaxed);
+}
+
+uint64_t Tracer::now() const noexcept {
+    int64_t delta = steadyNowNs() - originNs_.load(std::memory_order_relaxed);
+    return delta > 0 ? static_cast<uint64_t>(delta) : 0;
+}
+
+Tracer::ThreadBuffer& Tracer::localBuffer() {
+    thread_local ThreadBuffer* cached = nullptr;
+    thread_local uint64_t cachedGeneration = 0;
+
+    // Fast path: buffer already registered for this thread
+    uint64_t generation = generation_.load(std::memory_order_acquire);
+    if (cached != nullptr && cachedGeneration == generation) {
+        return *cached;
+    }
+
+    // First use on this thread (or after clear()) - register a buffer; its
+    // span storage is allocated by the first record()
+    auto buffer = std::make_unique<ThreadBuffer>();
+
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    buffer->threadId = static_cast<uint32_t>(buffers_.size() + 1);
+    cached = buffer.get();
+    cachedGeneration = generation;
+    buffers_.push_back(std::move(buffer));
+    return *cached;
+}
+
+void Tracer::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    buffer.name = name;
+}
+
+void Tracer::record(const char* name, const char* category, uint64_t startNs, uint64_t endNs) {
+    ThreadBuffer& buffer = localBuffer();
+
+    size_t index = buffer.count.load(std::memory_order_relaxed);
+    if (!buffer.events) {
+        // Published to the exporter by the count store below
+        buffer.events = std::make_unique<TraceEvent[]>(EVENTS_PER_THREAD);
+    }
+    if (index >= EVENTS_PER_THREAD) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events[index] = TraceEvent{name, category, startNs,
+                                      endNs > startNs ? endNs - startNs : 0};
+    // Publish the event to the exporter
+    buffer.count.store(index + 1, std::memory_order_release);
+}
+
+std::string Tracer::toChromeTraceJson() const {
+    std::ostringstream json;
+    json << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    std::lock_guard<std::mutex> lock(registryMutex_);
+
+    for (const auto& buffer : buffers_) {
+        // Thread name metadata
+        if (!buffer->name.empty()) {
+            json << (first ? "\n" : ",\n");
+            first = false;
+            json << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                 << ",\"args\":{\"name\":\"" << escapeJson(buffer->name) << "\"}}";
+        }
+
+        size_t count = buffer->count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; i++) {
+            const TraceEvent& event = buffer->events[i];
+            json << (first ? "\n" : ",\n");
+            first = false;
+            json << "{\"name\":\"" << escapeJson(event.name)
+                 << "\",\"cat\":\"" << escapeJson(event.category)
+                 << "\",\"ph\":\"X\",\"ts\":" << toMicros(event.startNs)
+                 << ",\"dur\":" << toMicros(event.durationNs)
+                 << ",\"pid\":1,\"tid\":" << buffer->threadId << "}";
+        }
+    }
+
+    json << "\n]}\n";
+    return json.str();
+}
+
+bool Tracer::writeChromeTrace(const std::string& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << toChromeTraceJson();
+    file.close();
+    return file.good();
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    buffers_.clear();
+    generation_.fetch_add(1, std::memory_order_release);
+    dropped_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace WinHKMon
@@ -0,0 +1,211 @@
+#include "WinHKMonLib/WinHKMonC.h"
+#include "WinHKMonLib/DeltaCalculator.h"
+#include "WinHKMonLib/FrameSlots.h"
+#include "WinHKMonLib/MetricsEngine.h"
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+static_assert(sizeof(whk_frame) % 8 == 0, "whk_frame must keep 8-byte alignment for per-core data");
+static_assert(WHK_FRAME_MIN_BYTES % 8 == 0, "Slots must start 8-byte aligned");
+static_assert(WHK_FIELD_CPU == WinHKMon::FIELD_CPU && WHK_FIELD_MEMORY == WinHKMon::FIELD_MEMORY &&
+              WHK_FIELD_DISK == WinHKMon::FIELD_DISK && WHK_FIELD_NETWORK == WinHKMon::FIELD_NETWORK &&
+              WHK_FIELD_MODULES == WinHKMon::FIELD_MODULES && WHK_FIELD_ALL == WinHKMon::FIELD_ALL,
+              "C field bits must match MetricField");
+
+/**
+ * @brief Engine handle behind the C API
+ */
+struct whk_engine {
+    WinHKMon::MetricsEngine engine;
+    std::mutex lastMutex;                ///< Guards last and sequence
+    WinHKMon::MetricsFrame last;         ///< Most recent sample (shared, immutable)
+    uint32_t lastMask = 0;
+    uint64_t sequence = 0;
+    double nsPerTick = 0.0;
+};
+
+namespace {
+
+constexpr double NOT_VALID = std::numeric_limits<double>::quiet_NaN();
+
+// Flatten a shared frame into the caller's buffer (no allocation)
+//
+// The buffer may come from a caller built against an older header with
+// fewer slots, so only the header layout is fixed: as many slots as fit
+// follow it, then as many per-core values as fit, and slot_count and
+// core_count say how many were written.
+whk_status encode(const WinHKMon::SystemMetrics& metrics, uint32_t fieldMask, uint64_t sequence,
+                  double nsPerTick, whk_frame* frame, size_t frameBytes) {
+    if (frame == nullptr) {
+        return WHK_ERR_INVALID_ARGUMENT;
+    }
+    if (frameBytes < WHK_FRAME_MIN_BYTES) {
+        return WHK_ERR_BUFFER_TOO_SMALL;
+    }
+
+    size_t slotCount = WinHKMon::frameSlotCount(metrics);
+    size_t capacity = (frameBytes - WHK_FRAME_MIN_BYTES) / sizeof(double);
+    size_t slots = capacity < slotCount ? capacity : slotCount;
+    double* values = reinterpret_cast<double*>(reinterpret_cast<char*>(frame) + WHK_FRAME_MIN_BYTES);
+
+    frame->magic = WHK_FRAME_MAGIC;
+    frame->version = WHK_FRAME_VERSION;
+    frame->header_bytes = static_cast<uint16_t>(WHK_FRAME_MIN_BYTES);
+    frame->slot_count = static_cast<uint32_t>(slots);
+    frame->core_count = 0;
+    frame->core_total = 0;
+    frame->field_mask = fieldMask;
+    frame->sequence = sequence;
+    frame->timestamp_ns = static_cast<uint64_t>(static_cast<double>(metrics.timestamp) * nsPerTick);
+
+    double scalars[WinHKMon::MAX_FRAME_SLOTS];
+    for (double& value : scalars) {
+        value = NOT_VALID;
+    }
+    uint64_t valid = WinHKMon::flattenSlots(metrics, scalars);
+    for (size_t slot = 0; slot < slots; slot++) {
+        values[slot] = scalars[slot];
+    }
+    frame->valid_mask = slots < 64 ? valid & ((1ULL << slots) - 1) : valid;
+
+    if (metrics.cpu) {
+        size_t cores = metrics.cpu->cores.size();
+        size_t written = cores < capacity - slots ? cores : capacity - slots;
+        double* coreValues = values + slots;
+        for (size_t i = 0; i < written; i++) {
+            coreValues[i] = metrics.cpu->cores[i].usagePercent;
+        }
+        frame->core_count = static_cast<uint32_t>(written);
+        frame->core_total = static_cast<uint32_t>(cores);
+    }
+
+    return WHK_OK;
+}
+
+}  // anonymous namespace
+
+extern "C" {
+
+uint32_t whk_abi_version(void) {
+    return WHK_ABI_VERSION;
+}
+
+const char* whk_status_string(whk_status status) {
+    switch (status) {
+        case WHK_OK: return "ok";
+        case WHK_ERR_INVALID_ARGUMENT: return "invalid argument";
+        case WHK_ERR_BUFFER_TOO_SMALL: return "buffer too small";
+        case WHK_ERR_NO_DATA: return "no data";
+        case WHK_ERR_INTERNAL: return "internal error";
+        case WHK_ERR_MODULE: return "module error";
+    }
+    return "unknown status";
+}
+
+whk_status whk_engine_create(whk_engine** out) {
+    if (out == nullptr) {
+        return WHK_ERR_INVALID_ARGUMENT;
+    }
+    *out = nullptr;
+    try {
+        whk_engine* engine = new whk_engine();
+        WinHKMon::DeltaCalculator deltaCalc;
+        engine->nsPerTick = 1.0e9 / static_cast<double>(deltaCalc.getPerformanceFrequency());
+        *out = engine;
+        return WHK_OK;
+    } catch (...) {
+        return WHK_ERR_INTERNAL;
+    }
+}
+
+void whk_engine_destroy(whk_engine* engine) {
+    delete engine;
+}
+
+whk_status whk_engine_load_module(whk_engine* engine, const char* path, uint32_t* first_slot) {
+    if (engine == nullptr || path == nullptr) {
+        return WHK_ERR_INVALID_ARGUMENT;
+    }
+    try {
+        uint32_t first = engine->engine.loadModule(path);
+        if (first_slot != nullptr) {
+            *first_slot = first;
+        }
+        return WHK_OK;
+    } catch (const std::runtime_error&) {
+        return WHK_ERR_MODULE;
+    } catch (...) {
+        return WHK_ERR_INTERNAL;
+    }
+}
+
+whk_status whk_engine_sample(whk_engine* engine, uint32_t field_mask,
+                             whk_frame* frame, size_t frame_bytes) {
+    if (engine == nullptr || frame == nullptr || (field_mask & WHK_FIELD_ALL) == 0) {
+        return WHK_ERR_INVALID_ARGUMENT;
+    }
+    if (frame_bytes < WHK_FRAME_MIN_BYTES) {
+        return WHK_ERR_BUFFER_TOO_SMALL;
+    }
+    try {
+        uint32_t mask = field_mask & WHK_FIELD_ALL;
+        WinHKMon::MetricsFrame sampled = engine->engine.sample(mask);
+        uint64_t sequence;
+        {
+            std::lock_guard<std::mutex> lock(engine->lastMutex);
+            engine->last = sampled;
+            engine->lastMask = mask;
+            sequence = ++engine->sequence;
+        }
+        return encode(*sampled, mask, sequence, engine->nsPerTick, frame, frame_bytes);
+    } catch (...) {
+        return WHK_ERR_INTERNAL;
+    }
+}
+
+whk_status whk_engine_last_frame(whk_engine* engine, whk_frame* frame, size_t frame_bytes) {
+    if (engine == nullptr || frame == nullptr) {
+        return WHK_ERR_INVALID_ARGUMENT;
+    }
+    WinHKMon::MetricsFrame last;
+    uint32_t mask;
+    uint64_t sequence;
+    {
+        std::lock_guard<std::mutex> lock(engine->lastMutex);
+        last = engine->last;
+        mask = engine->lastMask;
+        sequence = engine->sequence;
+    }
+    if (!last) {
+        return WHK_ERR_NO_DATA;
+    }
+    return encode(*last, mask, sequence, engine->nsPerTick, frame, frame_bytes);
+}
+
+double whk_frame_get_double(const whk_frame* frame, uint32_t slot) {
+    if (frame == nullptr || slot >= frame->slot_count || slot >= 64 ||
+        (frame->valid_mask & (1ULL << slot)) == 0) {
+        return NOT_VALID;
+    }
+    const double* values = reinterpret_cast<const double*>(
+        reinterpret_cast<const char*>(frame) + frame->header_bytes);
+    return values[slot];
+}
+
+int whk_frame_has(const whk_frame* frame, uint32_t slot) {
+    return frame != nullptr && slot < frame->slot_count && slot < 64 &&
+           (frame->valid_mask & (1ULL << slot)) != 0;
+}
+
+const double* whk_frame_cores(const whk_frame* frame) {
+    if (frame == nullptr) {
+        return nullptr;
+    }
+    const double* values = reinterpret_cast<const double*>(
+        reinterpret_cast<const char*>(frame) + frame->header_bytes);
+    return values + frame->slot_count;
+}
+
+}  // extern "C"
@@ -0,0 +1,378 @@
+/**
+ * @file main.cpp
+ * @brief WinHKMonLoad - ground-truth workload generator
+ *
+ * Produces known, steady workloads so WinHKMon's reported rates can be
+ * checked against ground truth:
+ * - CPU: N busy threads at X% duty cycle (10 ms periods)
+ * - Disk: sequential unbuffered writes at Y MB/s to a temp file
+ * - Network: TCP traffic at Z Mbps to a sink (loopback by default)
+ *
+ * The key=value summary printed on exit states what was actually generated,
+ * so callers compare against achieved rather than requested load.
+ */
+
+#define _WINSOCKAPI_
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#pragma comment(lib, "ws2_32.lib")
+
+namespace {
+
+std::atomic<bool> g_running{true};
+
+/**
+ * @brief Requested workload
+ */
+struct LoadOptions {
+    int cpuThreads = 0;              ///< Busy threads
+    double cpuDutyPercent = 100.0;   ///< Busy fraction of each 10 ms period
+    double diskWriteMBps = 0.0;      ///< Sequential write rate (MB = 1,000,000 bytes)
+    double netMbps = 0.0;            ///< TCP send rate (megabits/sec)
+    std::string netTarget;           ///< host:port sink (empty = built-in loopback sink)
+    int netSinkPort = 0;             ///< Run only a sink on this port
+    double durationSeconds = 10.0;   ///< Run time (0 = until Ctrl+C)
+};
+
+/**
+ * @brief Achieved workload counters
+ */
+struct LoadCounters {
+    std::atomic<uint64_t> diskBytes{0};
+    std::atomic<uint64_t> netBytes{0};
+};
+
+using Clock = std::chrono::steady_clock;
+
+BOOL WINAPI consoleHandler(DWORD ctrlType) {
+    if (ctrlType == CTRL_C_EVENT || ctrlType == CTRL_BREAK_EVENT) {
+        g_running = false;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/**
+ * @brief Spin for dutyPercent of every 10 ms period, sleep for the rest
+ */
+void cpuWorker(double dutyPercent) {
+    const auto period = std::chrono::milliseconds(10);
+    const auto busy = std::chrono::duration_cast<Clock::duration>(period * (dutyPercent / 100.0));
+    volatile uint64_t sink = 0;
+
+    auto periodStart = Clock::now();
+    while (g_running) {
+        while (Clock::now() - periodStart < busy) {
+            sink = sink + 1;
+        }
+        periodStart += period;
+        std::this_thread::sleep_until(periodStart);
+    }
+}
+
+/**
+ * @brief Write 1 MB blocks at a fixed pace, bypassing the file cache
+ *
+ * FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH makes every write reach
+ * the physical disk, so PhysicalDisk counters see exactly this traffic.
+ */
+void diskWorker(double megabytesPerSec, LoadCounters& counters) {
+    constexpr DWORD BLOCK_BYTES = 1024 * 1024;
+    constexpr uint64_t MAX_FILE_BYTES = 256ULL * 1024 * 1024;
+
+    wchar_t tempDir[MAX_PATH];
+    wchar_t tempFile[MAX_PATH];
+    GetTempPathW(MAX_PATH, tempDir);
+    GetTempFileNameW(tempDir, L"whk", 0, tempFile);
+
+    HANDLE file = CreateFileW(tempFile, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                              FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH |
+                              FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "[ERROR] Cannot create disk load file: " << GetLastError() << std::endl;
+        return;
+    }
+
+    // Unbuffered I/O requires sector-aligned buffers (VirtualAlloc is page-aligned)
+    void* buffer = VirtualAlloc(nullptr, BLOCK_BYTES, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    std::fill_n(static_cast<unsigned char*>(buffer), BLOCK_BYTES, static_cast<unsigned char>(0xA5));
+
+    const double bytesPerSec = megabytesPerSec * 1000000.0;
+    const auto start = Clock::now();
+    uint64_t written = 0;
+    uint64_t offset = 0;
+
+    while (g_running) {
+        // Pace: write the next block only when it is due
+        auto due = start + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(static_cast<double>(written) / bytesPerSec));
+        std::this_thread::sleep_until(due);
+        if (!g_running) {
+            break;
+        }
+
+        // Wrap to keep the temp file bounded
+        if (offset >= MAX_FILE_BYTES) {
+            offset = 0;
+            SetFilePointer(file, 0, nullptr, FILE_BEGIN);
+        }
+
+        DWORD bytesWritten = 0;
+        if (!WriteFile(file, buffer, BLOCK_BYTES, &bytesWritten, nullptr)) {
+            std::cerr << "[ERROR] Disk load write failed: " << GetLastError() << std::endl;
+            break;
+        }
+        written += bytesWritten;
+        offset += bytesWritten;
+        counters.diskBytes += bytesWritten;
+    }
+
+    VirtualFree(buffer, 0, MEM_RELEASE);
+    CloseHandle(file);
+}
+
+/**
+ * @brief Accept one connection and discard everything received
+ */
+void sinkWorker(SOCKET listener) {
+    SOCKET conn = accept(listener, nullptr, nullptr);
+    if (conn == INVALID_SOCKET) {
+        return;
+    }
+    std::vector<char> buffer(64 * 1024);
+    while (g_running) {
+        int received = recv(conn, buffer.data(), static_cast<int>(buffer.size()), 0);
+        if (received <= 0) {
+            break;
+        }
+    }
+    closesocket(conn);
+}
+
+SOCKET openListener(int port, int& boundPort) {
+    SOCKET listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(port == 0 ? INADDR_LOOPBACK : INADDR_ANY);
+    addr.sin_port = htons(static_cast<u_short>(port));
+    if (bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(listener, 1) != 0) {
+        closesocket(listener);
+        throw std::runtime_error("Cannot open TCP sink: " + std::to_string(WSAGetLastError()));
+    }
+    int len = sizeof(addr);
+    getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len);
+    boundPort = ntohs(addr.sin_port);
+    return listener;
+}
+
+/**
+ * @brief Send 64 KB chunks paced to the requested bit rate
+ */
+void netWorker(double megabitsPerSec, const std::string& host, int port, LoadCounters& counters) {
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &result) != 0) {
+        std::cerr << "[ERROR] Cannot resolve network target " << host << std::endl;
+        return;
+    }
+
+    SOCKET conn = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    if (connect(conn, result->ai_addr, static_cast<int>(result->ai_addrlen)) != 0) {
+        std::cerr << "[ERROR] Cannot connect to " << host << ":" << port << std::endl;
+        freeaddrinfo(result);
+        closesocket(conn);
+        return;
+    }
+    freeaddrinfo(result);
+
+    std::vector<char> chunk(64 * 1024, 'x');
+    const double bytesPerSec = megabitsPerSec * 1000000.0 / 8.0;
+    const auto start = Clock::now();
+    uint64_t sent = 0;
+
+    while (g_running) {
+        auto due = start + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(static_cast<double>(sent) / bytesPerSec));
+        std::this_thread::sleep_until(due);
+        if (!g_running) {
+            break;
+        }
+        int bytes = send(conn, chunk.data(), static_cast<int>(chunk.size()), 0);
+        if (bytes <= 0) {
+            std::cerr << "[ERROR] Network load send failed: " << WSAGetLastError() << std::endl;
+            break;
+        }
+        sent += static_cast<uint64_t>(bytes);
+        counters.netBytes += static_cast<uint64_t>(bytes);
+    }
+
+    shutdown(conn, SD_SEND);
+    closesocket(conn);
+}
+
+std::string helpMessage() {
+    return R"(WinHKMonLoad - ground-truth workload generator for WinHKMon validation
+
+USAGE:
+  WinHKMonLoad [OPTIONS...]
+
+OPTIONS:
+  --cpu-threads <n>      Busy threads (default: 0)
+  --cpu-duty <pct>       Busy percentage per thread, 1-100 (default: 100)
+  --disk-write <MB/s>    Sequential unbuffered writes to a temp file
+  --net <Mbps>           TCP send rate
+  --net-target <h:p>     Send to host:port (default: built-in loopback sink)
+  --net-sink <port>      Only run a TCP sink on <port> (for a remote sender)
+  --duration <sec>       Run time, 0 = until Ctrl+C (default: 10)
+  --help, -h             Show this help
+
+OUTPUT:
+  One summary line per generator on exit, e.g.:
+    disk_write_bytes_per_sec=20000000
+  Note: WinHKMon excludes loopback interfaces, so NET validation needs
+  --net-target pointing at a sink on another host.
+)";
+}
+
+LoadOptions parseOptions(int argc, char* argv[]) {
+    LoadOptions opts;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--help" || arg == "-h") {
+            std::cout << helpMessage();
+            std::exit(0);
+        } else if (arg == "--cpu-threads" && hasValue) {
+            opts.cpuThreads = std::stoi(argv[++i]);
+        } else if (arg == "--cpu-duty" && hasValue) {
+            opts.cpuDutyPercent = std::stod(argv[++i]);
+            if (opts.cpuDutyPercent <= 0.0 || opts.cpuDutyPercent > 100.0) {
+                throw std::invalid_argument("--cpu-duty must be between 1 and 100");
+            }
+        } else if (arg == "--disk-write" && hasValue) {
+            opts.diskWriteMBps = std::stod(argv[++i]);
+        } else if (arg == "--net" && hasValue) {
+            opts.netMbps = std::stod(argv[++i]);
+        } else if (arg == "--net-target" && hasValue) {
+            opts.netTarget = argv[++i];
+        } else if (arg == "--net-sink" && hasValue) {
+            opts.netSinkPort = std::stoi(argv[++i]);
+        } else if (arg == "--duration" && hasValue) {
+            opts.durationSeconds = std::stod(argv[++i]);
+        } else {
+            throw std::invalid_argument("Invalid argument '" + arg + "'. Use --help for usage.");
+        }
+    }
+    return opts;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        LoadOptions opts = parseOptions(argc, argv);
+        SetConsoleCtrlHandler(consoleHandler, TRUE);
+
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+            throw std::runtime_error("WSAStartup failed");
+        }
+
+        LoadCounters counters;
+        std::vector<std::thread> workers;
+        SOCKET listener = INVALID_SOCKET;
+
+        // Sink-only mode (remote end of a --net-target run)
+        if (opts.netSinkPort > 0) {
+            int boundPort = 0;
+            listener = openListener(opts.netSinkPort, boundPort);
+            std::cerr << "[load] TCP sink listening on port " << boundPort << std::endl;
+            while (g_running) {
+                sinkWorker(listener);
+            }
+            closesocket(listener);
+            WSACleanup();
+            return 0;
+        }
+
+        for (int i = 0; i < opts.cpuThreads; i++) {
+            workers.emplace_back(cpuWorker, opts.cpuDutyPercent);
+        }
+
+        if (opts.diskWriteMBps > 0.0) {
+            workers.emplace_back(diskWorker, opts.diskWriteMBps, std::ref(counters));
+        }
+
+        if (opts.netMbps > 0.0) {
+            std::string host = "127.0.0.1";
+            int port = 0;
+            if (opts.netTarget.empty()) {
+                listener = openListener(0, port);
+                workers.emplace_back(sinkWorker, listener);
+            } else {
+                size_t colon = opts.netTarget.rfind(':');
+                if (colon == std::string::npos) {
+                    throw std::invalid_argument("--net-target must be host:port");
+                }
+                host = opts.netTarget.substr(0, colon);
+                port = std::stoi(opts.netTarget.substr(colon + 1));
+            }
+            workers.emplace_back(netWorker, opts.netMbps, host, port, std::ref(counters));
+        }
+
+        // Run for the requested duration (or until Ctrl+C)
+        auto start = Clock::now();
+        while (g_running) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            if (opts.durationSeconds > 0.0 && elapsed >= opts.durationSeconds) {
+                g_running = false;
+            }
+        }
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        if (listener != INVALID_SOCKET) {
+            closesocket(listener);  // Unblocks accept() if no sender connected
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        WSACleanup();
+
+        // Achieved load summary
+        std::cout << std::fixed << std::setprecision(0);
+        std::cout << "elapsed_ms=" << elapsed * 1000.0 << "\n";
+        if (opts.cpuThreads > 0) {
+            std::cout << "cpu_threads=" << opts.cpuThreads << "\n";
+            std::cout << "cpu_duty_percent=" << opts.cpuDutyPercent << "\n";
+        }
+        if (opts.diskWriteMBps > 0.0) {
+            std::cout << "disk_write_bytes_per_sec=" << static_cast<double>(counters.diskBytes.load()) / elapsed << "\n";
+        }
+        if (opts.netMbps > 0.0) {
+            std::cout << "net_send_bytes_per_sec=" << static_cast<double>(counters.netBytes.load()) / elapsed << "\n";
+        }
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+        return 2;
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * @file whk_sample.c
+ * @brief Sample collector module (whk_sample.dll / whk_sample.so)
+ *
+ * Reference implementation of the WinHKMonModule.h ABI, used by the tests
+ * and as a starting point for site-specific modules:
+ *
+ *   WinHKMon --module sample --module-dir <build dir>
+ *
+ * Counters:
+ * - samples: sample() calls since open()
+ * - interval: seconds since the previous sample (absent on the first one)
+ *
+ * Plain C with no dependencies beyond the C runtime.
+ */
+
+#include "WinHKMonLib/WinHKMonModule.h"
+#include <stdlib.h>
+#include <time.h>
+
+typedef struct SampleState {
+    uint64_t samples;
+    struct timespec previous;
+} SampleState;
+
+static const whk_module_counter COUNTERS[] = {
+    {"samples", ""},
+    {"interval", "s"},
+};
+
+static double secondsBetween(const struct timespec* from, const struct timespec* to) {
+    return (double)(to->tv_sec - from->tv_sec) + (double)(to->tv_nsec - from->tv_nsec) / 1.0e9;
+}
+
+static int sampleOpen(void** state) {
+    SampleState* sample = (SampleState*)calloc(1, sizeof(SampleState));
+    if (sample == NULL) {
+        return 1;
+    }
+    *state = sample;
+    return 0;
+}
+
+static int sampleSample(void* state, double* values, uint64_t* valid_mask) {
+    SampleState* sample = (SampleState*)state;
+    struct timespec now;
+    if (timespec_get(&now, TIME_UTC) != TIME_UTC) {
+        return 1;
+    }
+
+    sample->samples++;
+    values[0] = (double)sample->samples;
+    *valid_mask |= 1u;
+    if (sample->samples > 1) {
+        values[1] = secondsBetween(&sample->previous, &now);
+        *valid_mask |= 2u;
+    }
+    sample->previous = now;
+    return 0;
+}
+
+static void sampleClose(void* state) {
+    free(state);
+}
+
+static const whk_module MODULE = {
+    WHK_MODULE_ABI_VERSION,
+    "sample",
+    "Sample module: call count and sampling interval",
+    (uint32_t)(sizeof(COUNTERS) / sizeof(COUNTERS[0])),
+    COUNTERS,
+    sampleOpen,
+    sampleSample,
+    sampleClose,
+};
+
+WHK_MODULE_EXPORT const whk_module* whk_module_entry(void) {
+    return &MODULE;
+}
@@ -0,0 +1,116 @@
+#include "WinHKMonLib/AdaptiveSampler.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: AdaptiveSampler
+ *
+ * Tests for the AdaptiveSampler component that shortens the continuous-mode
+ * interval during activity and lengthens it when metrics are quiet.
+ *
+ * Coverage:
+ * - Constructor validation and clamping
+ * - First sample seeds averages without changing the interval
+ * - Quiet samples grow the interval up to the upper bound
+ * - CPU and rate spikes shrink the interval down to the lower bound
+ * - Idle-level noise below the floors is ignored
+ */
+
+namespace {
+
+SystemMetrics makeCpuSample(double usage) {
+    SystemMetrics metrics;
+    metrics.timestamp = 0;
+    CpuStats cpu;
+    cpu.totalUsagePercent = usage;
+    cpu.averageFrequencyMhz = 0;
+    metrics.cpu = cpu;
+    return metrics;
+}
+
+SystemMetrics makeNetSample(uint64_t inBytesPerSec) {
+    SystemMetrics metrics;
+    metrics.timestamp = 0;
+    InterfaceStats iface{};
+    iface.name = "Ethernet";
+    iface.inBytesPerSec = inBytesPerSec;
+    iface.outBytesPerSec = 0;
+    metrics.network = std::vector<InterfaceStats>{iface};
+    return metrics;
+}
+
+}  // anonymous namespace
+
+// Test 1: Invalid bounds are rejected
+TEST(AdaptiveSamplerTest, RejectsInvalidBounds) {
+    EXPECT_THROW(AdaptiveSampler(0.0, 10.0, 0.2, 1.0), std::invalid_argument);
+    EXPECT_THROW(AdaptiveSampler(5.0, 1.0, 0.2, 1.0), std::invalid_argument);
+    EXPECT_THROW(AdaptiveSampler(0.5, 10.0, 0.0, 1.0), std::invalid_argument);
+}
+
+// Test 2: Initial interval is clamped into bounds
+TEST(AdaptiveSamplerTest, ClampsInitialInterval) {
+    AdaptiveSampler sampler(2.0, 10.0, 0.2, 1.0);
+    EXPECT_DOUBLE_EQ(sampler.currentInterval(), 2.0);
+}
+
+// Test 3: First sample keeps the starting interval
+TEST(AdaptiveSamplerTest, FirstSampleKeepsInterval) {
+    AdaptiveSampler sampler(0.25, 10.0, 0.2, 1.0);
+    EXPECT_DOUBLE_EQ(sampler.update(makeCpuSample(50.0)), 1.0);
+}
+
+// Test 4: Quiet samples grow the interval up to the maximum
+TEST(AdaptiveSamplerTest, QuietSamplesGrowToMax) {
+    AdaptiveSampler sampler(0.25, 10.0, 0.2, 1.0);
+    sampler.update(makeCpuSample(2.0));
+
+    double interval = 0.0;
+    for (int i = 0; i < 50; i++) {
+        interval = sampler.update(makeCpuSample(2.0));
+    }
+    EXPECT_DOUBLE_EQ(interval, 10.0);
+}
+
+// Test 5: CPU spike shrinks the interval
+TEST(AdaptiveSamplerTest, CpuSpikeShrinksInterval) {
+    AdaptiveSampler sampler(0.25, 10.0, 0.2, 4.0);
+    sampler.update(makeCpuSample(5.0));
+
+    double interval = sampler.update(makeCpuSample(80.0));
+    EXPECT_DOUBLE_EQ(interval, 2.0);
+    EXPECT_GT(sampler.lastChangeScore(), 0.2);
+}
+
+// Test 6: Repeated activity stops at the minimum
+TEST(AdaptiveSamplerTest, ActivityShrinksToMin) {
+    AdaptiveSampler sampler(0.25, 10.0, 0.2, 4.0);
+    sampler.update(makeCpuSample(0.0));
+
+    double interval = 0.0;
+    for (int i = 0; i < 20; i++) {
+        interval = sampler.update(makeCpuSample(i % 2 == 0 ? 90.0 : 5.0));
+    }
+    EXPECT_DOUBLE_EQ(interval, 0.25);
+}
+
+// Test 7: Idle-level CPU noise is below the floor and does not count as activity
+TEST(AdaptiveSamplerTest, IgnoresIdleCpuNoise) {
+    AdaptiveSampler sampler(0.25, 10.0, 0.2, 1.0);
+    sampler.update(makeCpuSample(0.5));
+
+    double interval = sampler.update(makeCpuSample(1.5));
+    EXPECT_GT(interval, 1.0);
+}
+
+// Test 8: Network rate jump relative to EWMA shrinks the interval
+TEST(AdaptiveSamplerTest, NetworkRateJumpShrinksInterval) {
+    AdaptiveSampler sampler(0.25, 10.0, 0.2, 2.0);
+    sampler.update(makeNetSample(1000000));
+    sampler.update(makeNetSample(1000000));
+
+    double interval = sampler.update(makeNetSample(5000000));
+    EXPECT_LT(interval, 2.5);
+}
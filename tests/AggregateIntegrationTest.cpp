@@ -0,0 +1,100 @@
+#include "IntegrationHelpers.h"
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Test Suite: Aggregate (integration)
+ *
+ * Runs "WinHKMon aggregate" with dozens of local WinHKMon agents pushing to
+ * it over loopback and checks the merged cluster view.
+ *
+ * Coverage:
+ * - Every agent is counted in a bucket once all have connected (TCP)
+ * - Cluster sums match hosts x local value (all agents see the same RAM)
+ * - AF_UNIX endpoint
+ *
+ * @note Executable path is injected by CMake (WINHKMON_EXE_PATH)
+ */
+
+namespace {
+
+constexpr int TCP_AGENTS = 24;
+constexpr int UNIX_AGENTS = 4;
+constexpr DWORD RUN_MS = 8000;
+
+// Port unlikely to collide with other test runs on the same machine
+int testPort() {
+    return 40000 + static_cast<int>(GetCurrentProcessId() % 20000);
+}
+
+struct AggregateRun {
+    int maxHosts = 0;
+    double ramTotalSum = 0.0;   ///< ram_total_bytes sum from the bucket with maxHosts
+    size_t buckets = 0;
+};
+
+/**
+ * @brief Start an aggregator plus agents on the endpoint and collect its JSON output
+ */
+AggregateRun runFleet(const std::string& endpoint, int agentCount, const std::string& tag) {
+    ChildProcess aggregator(WINHKMON_EXE_PATH, "aggregate --listen \"" + endpoint + "\" --format json",
+                            tempFilePath("WinHKMon_aggregate_" + tag + ".json"));
+    EXPECT_TRUE(aggregator.started());
+    Sleep(500);  // Let the aggregator bind before agents connect
+
+    std::vector<std::unique_ptr<ChildProcess>> agents;
+    for (int i = 0; i < agentCount; i++) {
+        std::string args = "RAM -c -i 1 --format csv --push \"" + endpoint +
+                           "\" --host-id " + tag + "-agent" + std::to_string(i);
+        agents.push_back(std::make_unique<ChildProcess>(
+            WINHKMON_EXE_PATH, args, tempFilePath("WinHKMon_agent_" + tag + std::to_string(i) + ".csv")));
+        EXPECT_TRUE(agents.back()->started());
+    }
+
+    Sleep(RUN_MS);
+    agents.clear();
+    aggregator.terminate();
+
+    AggregateRun run;
+    std::vector<std::string> samples = splitSamples(aggregator.output());
+    run.buckets = samples.size();
+    for (const std::string& sample : samples) {
+        double hosts = 0.0;
+        if (extractNumber(sample, "\"cluster\"", "hosts", hosts) && hosts > run.maxHosts) {
+            run.maxHosts = static_cast<int>(hosts);
+            extractNumber(sample, "\"ram_total_bytes\"", "sum", run.ramTotalSum);
+        }
+    }
+    return run;
+}
+
+double localRamBytes() {
+    MEMORYSTATUSEX status{};
+    status.dwLength = sizeof(status);
+    GlobalMemoryStatusEx(&status);
+    return static_cast<double>(status.ullTotalPhys);
+}
+
+}  // anonymous namespace
+
+// Test 1: Dozens of agents over TCP loopback
+TEST(AggregateIntegrationTest, MergesAgentsOverTcp) {
+    std::string endpoint = "tcp:127.0.0.1:" + std::to_string(testPort());
+    AggregateRun run = runFleet(endpoint, TCP_AGENTS, "tcp");
+
+    ASSERT_GE(run.buckets, 3u);
+    EXPECT_EQ(run.maxHosts, TCP_AGENTS);
+    EXPECT_NEAR(run.ramTotalSum, localRamBytes() * TCP_AGENTS, localRamBytes() * 0.001);
+}
+
+// Test 2: AF_UNIX endpoint
+TEST(AggregateIntegrationTest, MergesAgentsOverUnixSocket) {
+    std::string endpoint = "unix:" + tempFilePath("WinHKMon_aggregate.sock");
+    AggregateRun run = runFleet(endpoint, UNIX_AGENTS, "unix");
+
+    ASSERT_GE(run.buckets, 3u);
+    EXPECT_EQ(run.maxHosts, UNIX_AGENTS);
+}
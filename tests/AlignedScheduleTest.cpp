@@ -0,0 +1,120 @@
+#include "WinHKMonLib/AlignedSchedule.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: AlignedSchedule
+ *
+ * Tests for wall-clock-aligned ticks (--align). Clock readings are
+ * simulated: the steady clock starts at 0 and the wall clock at an
+ * arbitrary Unix time.
+ *
+ * Coverage:
+ * - Interval validation
+ * - Ticks on multiples of the interval, deadlines on the steady clock
+ * - No drift over many ticks; no repeated tick after an early wake
+ * - Forward and backward wall-clock steps; slewing is not a step
+ */
+
+namespace {
+
+constexpr uint64_t WALL_START_MS = 1760000000123ULL;  // Not on a second boundary
+
+}  // anonymous namespace
+
+// Test 1: Interval must be at least 1 ms
+TEST(AlignedScheduleTest, ValidatesInterval) {
+    EXPECT_THROW(AlignedSchedule(0.0), std::invalid_argument);
+    EXPECT_THROW(AlignedSchedule(0.0004), std::invalid_argument);
+    EXPECT_EQ(AlignedSchedule(0.25).intervalMs(), 250u);
+}
+
+// Test 2: First tick is the next boundary; deadline is on the steady clock
+TEST(AlignedScheduleTest, AlignsToIntervalMultiples) {
+    AlignedSchedule schedule(5.0);
+    AlignedTick tick = schedule.next(1000, WALL_START_MS);
+
+    EXPECT_EQ(tick.nominalMs % 5000, 0u);
+    EXPECT_GT(tick.nominalMs, WALL_START_MS);
+    EXPECT_LE(tick.nominalMs - WALL_START_MS, 5000u);
+    EXPECT_EQ(tick.steadyDeadlineMs, 1000 + static_cast<int64_t>(tick.nominalMs - WALL_START_MS));
+}
+
+// Test 3: Consecutive ticks stay on boundaries despite wake-up and collection delays
+TEST(AlignedScheduleTest, DoesNotDrift) {
+    AlignedSchedule schedule(1.0);
+    int64_t steady = 0;
+    uint64_t wall = WALL_START_MS;
+    AlignedTick previous = schedule.next(steady, wall);
+    for (int i = 0; i < 1000; i++) {
+        // Wake 0-15 ms late, spend 20 ms collecting
+        int64_t late = i % 16;
+        steady = previous.steadyDeadlineMs + late + 20;
+        wall = previous.nominalMs + static_cast<uint64_t>(late) + 20;
+        AlignedTick tick = schedule.next(steady, wall);
+        EXPECT_EQ(tick.nominalMs, previous.nominalMs + 1000);
+        EXPECT_EQ(tick.nominalMs % 1000, 0u);
+        previous = tick;
+    }
+    EXPECT_EQ(schedule.clockSteps(), 0u);
+}
+
+// Test 4: Waking just before the boundary does not repeat the tick
+TEST(AlignedScheduleTest, EarlyWakeDoesNotRepeatTick) {
+    AlignedSchedule schedule(1.0);
+    AlignedTick first = schedule.next(0, WALL_START_MS);
+    AlignedTick second = schedule.next(first.steadyDeadlineMs - 1, first.nominalMs - 1);
+    EXPECT_EQ(second.nominalMs, first.nominalMs + 1000);
+}
+
+// Test 5: Forward step skips the boundaries jumped over
+TEST(AlignedScheduleTest, HandlesForwardStep) {
+    AlignedSchedule schedule(1.0);
+    AlignedTick tick = schedule.next(0, WALL_START_MS);
+
+    // Wall clock jumps 1 hour ahead while waiting
+    int64_t steady = tick.steadyDeadlineMs;
+    uint64_t wall = tick.nominalMs + 3600 * 1000;
+    EXPECT_TRUE(schedule.clockStepped(steady, wall));
+
+    AlignedTick replanned = schedule.next(steady, wall);
+    EXPECT_EQ(schedule.clockSteps(), 1u);
+    EXPECT_EQ(replanned.nominalMs, tick.nominalMs + 3600 * 1000 + 1000);
+    EXPECT_EQ(replanned.steadyDeadlineMs, steady + 1000);
+    EXPECT_FALSE(schedule.clockStepped(replanned.steadyDeadlineMs, replanned.nominalMs));
+}
+
+// Test 6: Backward step follows the wall clock
+TEST(AlignedScheduleTest, HandlesBackwardStep) {
+    AlignedSchedule schedule(1.0);
+    AlignedTick tick = schedule.next(0, WALL_START_MS);
+
+    int64_t steady = tick.steadyDeadlineMs;
+    uint64_t wall = tick.nominalMs - 10 * 1000 + 300;
+    AlignedTick replanned = schedule.next(steady, wall);
+    EXPECT_EQ(schedule.clockSteps(), 1u);
+    EXPECT_EQ(replanned.nominalMs, tick.nominalMs - 9 * 1000);
+    EXPECT_EQ(replanned.steadyDeadlineMs, steady + 700);
+}
+
+// Test 7: Slewing below the threshold is absorbed, not counted as a step
+TEST(AlignedScheduleTest, AbsorbsSlew) {
+    AlignedSchedule schedule(1.0);
+    AlignedTick tick = schedule.next(0, WALL_START_MS);
+
+    // Wall clock runs 5 ms fast over one tick
+    int64_t steady = tick.steadyDeadlineMs + 10;
+    uint64_t wall = tick.nominalMs + 15;
+    EXPECT_FALSE(schedule.clockStepped(steady, wall));
+    AlignedTick nextTick = schedule.next(steady, wall);
+    EXPECT_EQ(schedule.clockSteps(), 0u);
+    EXPECT_EQ(nextTick.nominalMs, tick.nominalMs + 1000);
+    EXPECT_EQ(nextTick.steadyDeadlineMs, steady + 985);
+
+    // Long intervals tolerate proportionally more slew
+    AlignedSchedule hourly(3600.0);
+    AlignedTick hour = hourly.next(0, WALL_START_MS);
+    EXPECT_FALSE(hourly.clockStepped(hour.steadyDeadlineMs, hour.nominalMs + 1000));
+}
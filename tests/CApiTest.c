@@ -0,0 +1,132 @@
+/**
+ * Test Suite: C API (plain C program, registered with ctest)
+ *
+ * Compiled as C to prove WinHKMonC.h is usable without C++.
+ *
+ * Coverage:
+ * - ABI and frame versioning fields
+ * - Argument and buffer-size errors
+ * - Memory sample into a reused stack buffer
+ * - Slots not collected read as NaN
+ * - Per-core truncation when the buffer is short
+ * - Buffers sized for an older frame with fewer slots
+ * - Re-reading the last frame without collecting
+ * - Module counters in the slots after the built-in ones; duplicate names rejected
+ */
+
+#include "WinHKMonLib/WinHKMonC.h"
+#include <stdio.h>
+
+static int g_failures = 0;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond);       \
+            g_failures++;                                                  \
+        }                                                                  \
+    } while (0)
+
+static int isNan(double value) {
+    return value != value;
+}
+
+/* Frame with room for 256 per-core values (8-byte aligned via the union) */
+typedef union FrameBuffer {
+    whk_frame frame;
+    unsigned char bytes[WHK_FRAME_BYTES(256)];
+} FrameBuffer;
+
+int main(void) {
+    whk_engine* engine = NULL;
+    FrameBuffer buffer;
+    whk_frame small;
+    int i;
+
+    /* Test 1: ABI version and argument checks */
+    CHECK(whk_abi_version() == WHK_ABI_VERSION);
+    CHECK(whk_engine_create(NULL) == WHK_ERR_INVALID_ARGUMENT);
+    CHECK(whk_engine_create(&engine) == WHK_OK);
+    CHECK(engine != NULL);
+    if (engine == NULL) {
+        return 1;
+    }
+    CHECK(whk_engine_sample(engine, 0, &buffer.frame, sizeof(buffer)) == WHK_ERR_INVALID_ARGUMENT);
+    CHECK(whk_engine_sample(engine, WHK_FIELD_MEMORY, &buffer.frame, WHK_FRAME_MIN_BYTES - 1) ==
+          WHK_ERR_BUFFER_TOO_SMALL);
+
+    /* Test 2: No last frame before the first sample */
+    CHECK(whk_engine_last_frame(engine, &buffer.frame, sizeof(buffer)) == WHK_ERR_NO_DATA);
+
+    /* Test 3: Memory sample, buffer reused across calls */
+    for (i = 1; i <= 3; i++) {
+        CHECK(whk_engine_sample(engine, WHK_FIELD_MEMORY, &buffer.frame, sizeof(buffer)) == WHK_OK);
+        CHECK(buffer.frame.magic == WHK_FRAME_MAGIC);
+        CHECK(buffer.frame.version == WHK_FRAME_VERSION);
+        CHECK(buffer.frame.slot_count == WHK_SLOT_COUNT);
+        CHECK(buffer.frame.sequence == (uint64_t)i);
+        CHECK(buffer.frame.field_mask == WHK_FIELD_MEMORY);
+    }
+    CHECK(whk_frame_has(&buffer.frame, WHK_SLOT_MEM_TOTAL_BYTES));
+    CHECK(whk_frame_get_double(&buffer.frame, WHK_SLOT_MEM_TOTAL_BYTES) > 0.0);
+    CHECK(buffer.frame.values[WHK_SLOT_MEM_USAGE_PERCENT] >= 0.0);
+    CHECK(buffer.frame.values[WHK_SLOT_MEM_USAGE_PERCENT] <= 100.0);
+
+    /* Test 4: Fields not collected and unknown slots read as NaN */
+    CHECK(!whk_frame_has(&buffer.frame, WHK_SLOT_CPU_TOTAL_PERCENT));
+    CHECK(isNan(whk_frame_get_double(&buffer.frame, WHK_SLOT_CPU_TOTAL_PERCENT)));
+    CHECK(isNan(whk_frame_get_double(&buffer.frame, WHK_SLOT_COUNT + 10)));
+    CHECK(buffer.frame.core_count == 0);
+
+    /* Test 5: CPU sample into a header-only buffer truncates per-core data */
+    CHECK(whk_engine_sample(engine, WHK_FIELD_CPU, &small, sizeof(small)) == WHK_OK);
+    CHECK(whk_frame_has(&small, WHK_SLOT_CPU_TOTAL_PERCENT));
+    CHECK(small.core_count == 0);
+    CHECK(small.core_total > 0);
+
+    /* Test 6: Full buffer receives every core */
+    CHECK(whk_engine_last_frame(engine, &buffer.frame, sizeof(buffer)) == WHK_OK);
+    CHECK(buffer.frame.core_count == buffer.frame.core_total || buffer.frame.core_count == 256);
+    for (i = 0; i < (int)buffer.frame.core_count; i++) {
+        double usage = whk_frame_cores(&buffer.frame)[i];
+        CHECK(usage >= 0.0 && usage <= 100.0);
+    }
+    CHECK(buffer.frame.sequence == small.sequence);
+
+    /* Test 7: A caller built with fewer slots gets those slots, nothing past its buffer */
+    buffer.frame.values[WHK_SLOT_MEM_USED_BYTES] = -1.0;
+    CHECK(whk_engine_sample(engine, WHK_FIELD_MEMORY, &buffer.frame,
+                            WHK_FRAME_MIN_BYTES + 4 * sizeof(double)) == WHK_OK);
+    CHECK(buffer.frame.slot_count == 4);
+    CHECK(buffer.frame.core_count == 0);
+    CHECK(whk_frame_has(&buffer.frame, WHK_SLOT_MEM_AVAILABLE_BYTES));
+    CHECK(!whk_frame_has(&buffer.frame, WHK_SLOT_MEM_USED_BYTES));
+    CHECK(isNan(whk_frame_get_double(&buffer.frame, WHK_SLOT_MEM_USAGE_PERCENT)));
+    CHECK(buffer.frame.values[WHK_SLOT_MEM_USED_BYTES] == -1.0);
+
+    /* Test 8: Module counters follow the built-in slots; a second copy is rejected */
+    {
+        uint32_t first = 0;
+        CHECK(whk_engine_load_module(engine, "no_such_module", &first) == WHK_ERR_MODULE);
+        CHECK(whk_engine_load_module(engine, WHK_SAMPLE_MODULE_PATH, &first) == WHK_OK);
+        CHECK(first == WHK_SLOT_COUNT);
+        CHECK(whk_engine_load_module(engine, WHK_SAMPLE_MODULE_PATH, NULL) == WHK_ERR_MODULE);
+        for (i = 1; i <= 2; i++) {
+            CHECK(whk_engine_sample(engine, WHK_FIELD_MODULES, &buffer.frame, sizeof(buffer)) == WHK_OK);
+        }
+        CHECK(buffer.frame.slot_count == WHK_SLOT_COUNT + 2);
+        CHECK(!whk_frame_has(&buffer.frame, WHK_SLOT_MEM_TOTAL_BYTES));
+        CHECK(whk_frame_get_double(&buffer.frame, first) == 2.0);
+        CHECK(whk_frame_has(&buffer.frame, first + 1));
+    }
+
+    whk_engine_destroy(engine);
+    whk_engine_destroy(NULL);
+
+    if (g_failures > 0) {
+        printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    printf("All C API checks passed\n");
+    return 0;
+}
@@ -0,0 +1,267 @@
+#include "WinHKMonLib/CgroupMonitor.h"
+#include "TempTree.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+using namespace WinHKMon;
+namespace fs = std::filesystem;
+
+/**
+ * Test Suite: CgroupMonitor
+ *
+ * Tests for the CGROUP metric against a fixture cgroupfs tree written to
+ * a temporary directory (the files have the kernel's formats).
+ *
+ * Coverage:
+ * - Path globs and filtered discovery
+ * - cpu.stat, memory.current, memory.events, io.stat and PSI parsing
+ * - Rates from counter deltas over the sampled interval
+ * - Incremental discovery: new, removed and many (parallel) groups
+ * - A thousand groups: fixed reader threads, the group cap, and groups
+ *   that run out of descriptors staying tracked
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string cpuStat(uint64_t usageUsec, uint64_t nrThrottled, uint64_t throttledUsec) {
+    return "usage_usec " + std::to_string(usageUsec) + "\nuser_usec 0\nsystem_usec 0\n"
+           "nr_periods 100\nnr_throttled " + std::to_string(nrThrottled) +
+           "\nthrottled_usec " + std::to_string(throttledUsec) + "\n";
+}
+
+// A group with every controller file; counters start at the given values
+void writeGroup(const fs::path& dir, uint64_t usageUsec, uint64_t readBytes) {
+    fs::create_directories(dir);
+    writeFile(dir / "cpu.stat", cpuStat(usageUsec, 0, 0));
+    writeFile(dir / "memory.current", "536870912\n");
+    writeFile(dir / "memory.events", "low 0\nhigh 4\nmax 2\noom 1\noom_kill 1\n");
+    writeFile(dir / "io.stat", "8:0 rbytes=" + std::to_string(readBytes) +
+                               " wbytes=0 rios=10 wios=0 dbytes=0 dios=0\n");
+    writeFile(dir / "cpu.pressure", "some avg10=1.50 avg60=0.80 avg300=0.20 total=123456\n"
+                                    "full avg10=0.25 avg60=0.00 avg300=0.00 total=1000\n");
+    writeFile(dir / "memory.pressure", "some avg10=0.00 avg60=0.00 avg300=0.00 total=0\n"
+                                       "full avg10=0.00 avg60=0.00 avg300=0.00 total=0\n");
+    writeFile(dir / "io.pressure", "some avg10=3.00 avg60=0.00 avg300=0.00 total=42\n"
+                                   "full avg10=2.00 avg60=0.00 avg300=0.00 total=40\n");
+}
+
+// Let this process keep thousands of group files open (the monitor never raises the limit itself)
+void allowManyOpenFiles() {
+#ifdef _WIN32
+    _setmaxstdio(8192);
+#elif defined(__linux__)
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+        limit.rlim_cur = limit.rlim_max == RLIM_INFINITY ? 16384 : std::min<rlim_t>(limit.rlim_max, 16384);
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+#endif
+}
+
+#ifdef __linux__
+size_t threadCount() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 8, "Threads:") == 0) {
+            return std::stoul(line.substr(8));
+        }
+    }
+    return 0;
+}
+
+size_t openDescriptors() {
+    return static_cast<size_t>(std::distance(fs::directory_iterator("/proc/self/fd"), fs::directory_iterator()));
+}
+#endif
+
+class CgroupMonitorTest : public TempTreeTest {
+protected:
+    CgroupMonitorTest()
+        : TempTreeTest("cgroup") {
+    }
+
+    void SetUp() override {
+        TempTreeTest::SetUp();
+        writeFile(root_ / "cgroup.controllers", "cpuset cpu io memory pids\n");
+        writeFile(root_ / "cpu.stat", cpuStat(999999, 0, 0));
+        fs::create_directories(root_ / "system.slice");
+        writeFile(root_ / "system.slice" / "cpu.stat", cpuStat(1000000, 0, 0));
+        writeGroup(root_ / "system.slice" / "nginx.service", 1000000, 0);
+        writeGroup(root_ / "system.slice" / "sshd.service", 0, 0);
+
+        // Only cpu.stat: controllers not enabled for this subtree
+        fs::create_directories(root_ / "user.slice");
+        writeFile(root_ / "user.slice" / "cpu.stat", cpuStat(0, 0, 0));
+    }
+};
+
+}  // anonymous namespace
+
+// Test 1: * spans path components, ? matches one character
+TEST(CgroupGlobTest, MatchesPaths) {
+    EXPECT_TRUE(matchCgroupGlob("*", "system.slice/nginx.service"));
+    EXPECT_TRUE(matchCgroupGlob("system.slice/*", "system.slice/nginx.service"));
+    EXPECT_FALSE(matchCgroupGlob("system.slice/*", "system.slice"));
+    EXPECT_TRUE(matchCgroupGlob("*.service", "system.slice/docker-1.scope/app.service"));
+    EXPECT_TRUE(matchCgroupGlob("user-100?.slice", "user-1000.slice"));
+    EXPECT_FALSE(matchCgroupGlob("user-100?.slice", "user-100.slice"));
+    EXPECT_TRUE(matchCgroupGlob("user.slice", "user.slice"));
+}
+
+// Test 2: Every file of a group is parsed; the filter picks the groups
+TEST_F(CgroupMonitorTest, ReadsFilteredGroups) {
+    CgroupMonitor all(root_.string(), "*");
+    all.initialize();
+    std::vector<CgroupStats> groups = all.getCurrentStats();
+    ASSERT_EQ(groups.size(), 4u);   // system.slice, its two services, user.slice
+    EXPECT_EQ(groups[0].path, "system.slice");
+    EXPECT_EQ(groups[3].path, "user.slice");
+    EXPECT_EQ(groups[3].memoryCurrentBytes, 0u);
+    EXPECT_FALSE(groups[3].cpuPressure.has_value());
+
+    CgroupMonitor services(root_.string(), "system.slice/*");
+    services.initialize();
+    groups = services.getCurrentStats();
+    ASSERT_EQ(groups.size(), 2u);
+    const CgroupStats& nginx = groups[0];
+    EXPECT_EQ(nginx.path, "system.slice/nginx.service");
+    EXPECT_EQ(nginx.memoryCurrentBytes, 536870912u);
+    EXPECT_EQ(nginx.memoryHighEvents, 4u);
+    EXPECT_EQ(nginx.memoryMaxEvents, 2u);
+    EXPECT_EQ(nginx.oomEvents, 1u);
+    EXPECT_EQ(nginx.oomKillEvents, 1u);
+    ASSERT_EQ(nginx.io.size(), 1u);
+    EXPECT_EQ(nginx.io[0].device, "8:0");
+    ASSERT_TRUE(nginx.cpuPressure.has_value());
+    EXPECT_DOUBLE_EQ(nginx.cpuPressure->someAvg10, 1.5);
+    EXPECT_DOUBLE_EQ(nginx.cpuPressure->fullAvg10, 0.25);
+    EXPECT_EQ(nginx.cpuPressure->someTotalUsec, 123456u);
+    ASSERT_TRUE(nginx.ioPressure.has_value());
+    EXPECT_DOUBLE_EQ(nginx.ioPressure->someAvg10, 3.0);
+
+    EXPECT_THROW(CgroupMonitor((root_ / "missing").string(), "*").initialize(), std::runtime_error);
+}
+
+// Test 3: CPU, throttling and I/O rates cover the time between samples
+TEST_F(CgroupMonitorTest, ComputesRatesFromCounters) {
+    fs::path nginx = root_ / "system.slice" / "nginx.service";
+    CgroupMonitor monitor(root_.string(), "system.slice/nginx.service");
+    Clock::time_point start = Clock::now();
+    std::vector<CgroupStats> first = monitor.getCurrentStats(start);
+    ASSERT_EQ(first.size(), 1u);
+    EXPECT_DOUBLE_EQ(first[0].cpuPercent, 0.0);   // No baseline yet
+
+    // 2 s later: 1.5 CPU-seconds used, throttled 0.5 s over 10 periods, 4 MiB read
+    writeFile(nginx / "cpu.stat", cpuStat(2500000, 10, 500000));
+    writeFile(nginx / "io.stat", "8:0 rbytes=4194304 wbytes=0 rios=110 wios=0 dbytes=0 dios=0\n"
+                                 "8:16 rbytes=0 wbytes=0 rios=0 wios=0 dbytes=0 dios=0\n");
+    std::vector<CgroupStats> second = monitor.getCurrentStats(start + std::chrono::seconds(2));
+    ASSERT_EQ(second.size(), 1u);
+    EXPECT_NEAR(second[0].cpuPercent, 75.0, 1e-9);
+    EXPECT_NEAR(second[0].throttledPercent, 25.0, 1e-9);
+    EXPECT_EQ(second[0].throttledPeriodsPerSec, 5u);
+    EXPECT_EQ(second[0].totalThrottledPeriods, 10u);
+    ASSERT_EQ(second[0].io.size(), 2u);
+    EXPECT_EQ(second[0].io[0].readBytesPerSec, 2097152u);
+    EXPECT_EQ(second[0].io[0].readsPerSec, 50u);
+    EXPECT_EQ(second[0].io[1].readBytesPerSec, 0u);   // New device: baseline only
+}
+
+// Test 4: Known groups stay open; new ones wait for a rescan, removed ones drop out
+TEST_F(CgroupMonitorTest, DiscoversIncrementally) {
+    CgroupMonitor monitor(root_.string(), "system.slice/*", std::chrono::seconds(10));
+    Clock::time_point start = Clock::now();
+    EXPECT_EQ(monitor.getCurrentStats(start).size(), 2u);
+
+    writeGroup(root_ / "system.slice" / "cron.service", 0, 0);
+    EXPECT_EQ(monitor.getCurrentStats(start + std::chrono::seconds(1)).size(), 2u);
+    EXPECT_EQ(monitor.getCurrentStats(start + std::chrono::seconds(11)).size(), 3u);
+
+#ifndef _WIN32
+    // cgroupfs fails reads of a removed group at once; a plain directory
+    // tree keeps unlinked files readable, so here the next rescan drops it
+    fs::remove_all(root_ / "system.slice" / "sshd.service");
+    size_t expected = 2;
+#else
+    size_t expected = 3;   // Windows cannot delete files the monitor holds open
+#endif
+    fs::create_directories(root_ / "system.slice" / "tmp");   // No cpu.stat: not a group
+    std::vector<CgroupStats> groups = monitor.getCurrentStats(start + std::chrono::seconds(21));
+    ASSERT_EQ(groups.size(), expected);
+    EXPECT_EQ(groups[0].path, "system.slice/cron.service");
+    EXPECT_EQ(groups[1].path, "system.slice/nginx.service");
+    EXPECT_EQ(monitor.groupCount(), expected);
+
+    // Enough groups to be read in parallel; every one is reported in path order
+    allowManyOpenFiles();
+    for (int i = 0; i < 200; i++) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "pod%03d.scope", i);
+        writeGroup(root_ / "kubepods.slice" / name, 1000, 0);
+    }
+    CgroupMonitor pods(root_.string(), "kubepods.slice/*");
+    groups = pods.getCurrentStats();
+    ASSERT_EQ(groups.size(), 200u);
+    EXPECT_EQ(groups[0].path, "kubepods.slice/pod000.scope");
+    EXPECT_EQ(groups[199].path, "kubepods.slice/pod199.scope");
+    EXPECT_EQ(groups[123].memoryCurrentBytes, 536870912u);
+}
+
+// Test 5: A thousand groups on fixed threads; the cap and descriptor shortages keep groups in place
+TEST_F(CgroupMonitorTest, TracksThousandGroups) {
+    allowManyOpenFiles();
+    for (int i = 0; i < 1000; i++) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "pod%04d.scope", i);
+        writeGroup(root_ / "kubepods.slice" / name, 1000, 0);
+    }
+
+    // A cap keeps the groups it has and counts the rest
+    CgroupMonitor capped(root_.string(), "kubepods.slice/*", CGROUP_RESCAN_INTERVAL, 100);
+    EXPECT_EQ(capped.getCurrentStats().size(), 100u);
+    EXPECT_EQ(capped.untrackedGroups(), 900u);
+
+    CgroupMonitor monitor(root_.string(), "kubepods.slice/*", CGROUP_RESCAN_INTERVAL, 1000);
+    Clock::time_point start = Clock::now();
+    std::vector<CgroupStats> groups = monitor.getCurrentStats(start);
+    ASSERT_EQ(groups.size(), 1000u);
+    EXPECT_EQ(groups[999].path, "kubepods.slice/pod0999.scope");
+    EXPECT_EQ(monitor.untrackedGroups(), 0u);
+
+#ifdef __linux__
+    // Later ticks reuse the reader threads instead of starting new ones
+    size_t threads = threadCount();
+    for (int tick = 1; tick <= 5; tick++) {
+        EXPECT_EQ(monitor.getCurrentStats(start + std::chrono::seconds(tick)).size(), 1000u);
+        EXPECT_EQ(threadCount(), threads);
+    }
+
+    // Out of descriptors: unopened groups sit out the sample but are not dropped or rediscovered
+    CgroupMonitor starved(root_.string(), "kubepods.slice/*", CGROUP_RESCAN_INTERVAL, 1000);
+    rlimit saved{};
+    ASSERT_EQ(getrlimit(RLIMIT_NOFILE, &saved), 0);
+    rlimit tight = saved;
+    tight.rlim_cur = static_cast<rlim_t>(openDescriptors() + 50 * 7);
+    ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &tight), 0);
+    size_t reported = starved.getCurrentStats(start).size();
+    ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &saved), 0);
+    EXPECT_GT(reported, 0u);
+    EXPECT_LT(reported, 1000u);
+    EXPECT_EQ(starved.groupCount(), 1000u);
+    EXPECT_EQ(starved.getCurrentStats(start + std::chrono::seconds(1)).size(), 1000u);
+#endif
+}
@@ -2,7 +2,10 @@
 #include <gtest/gtest.h>
 #include <vector>
 #include <string>
+#include <cstdio>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
 
 using namespace WinHKMon;
 
@@ -299,3 +302,293 @@ TEST(CliParserTest, ParsesComplexCombination) {
     EXPECT_DOUBLE_EQ(opts.intervalSeconds, 2.5);
 }
 
+
+// Test adaptive sampling options
+TEST(CliParserTest, ParsesAdaptiveOptions) {
+    ArgvHelper args({"WinHKMon", "CPU", "-c", "--adaptive", "--min-interval", "0.5",
+                     "--max-interval", "30", "--sensitivity", "0.1"});
+    CliOptions opts = parseArguments(args.argc(), args.argv());
+    
+    EXPECT_TRUE(opts.adaptive);
+    EXPECT_DOUBLE_EQ(opts.minIntervalSeconds, 0.5);
+    EXPECT_DOUBLE_EQ(opts.maxIntervalSeconds, 30.0);
+    EXPECT_DOUBLE_EQ(opts.adaptiveSensitivity, 0.1);
+}
+
+TEST(CliParserTest, RejectsInvertedAdaptiveBounds) {
+    ArgvHelper args({"WinHKMon", "CPU", "--adaptive", "--min-interval", "5", "--max-interval", "1"});
+    
+    EXPECT_THROW({
+        parseArguments(args.argc(), args.argv());
+    }, std::invalid_argument);
+}
+
+// Test low-impact mode options
+TEST(CliParserTest, ParsesLowImpactCpuSet) {
+    ArgvHelper args({"WinHKMon", "CPU", "-c", "--low-impact", "--cpu-set", "4,0-1,1"});
+    CliOptions opts = parseArguments(args.argc(), args.argv());
+    
+    EXPECT_TRUE(opts.lowImpact);
+    EXPECT_EQ(opts.housekeepingCpus, (std::vector<unsigned>{0, 1, 4}));
+}
+
+TEST(CliParserTest, RejectsInvalidCpuSet) {
+    for (const char* cpuSet : {"", "a", "3-1", "1-", "0,64", "2x"}) {
+        ArgvHelper args({"WinHKMon", "CPU", "--low-impact", "--cpu-set", cpuSet});
+        EXPECT_THROW(parseArguments(args.argc(), args.argv()), std::invalid_argument) << cpuSet;
+    }
+}
+
+TEST(CliParserTest, RejectsCpuSetWithoutLowImpact) {
+    ArgvHelper args({"WinHKMon", "CPU", "--cpu-set", "0"});
+    
+    EXPECT_THROW({
+        parseArguments(args.argc(), args.argv());
+    }, std::invalid_argument);
+}
+
+// Test fleet aggregation options
+TEST(CliParserTest, ParsesAggregateSubcommand) {
+    ArgvHelper args({"WinHKMon", "aggregate", "--listen", "unix:C:\\temp\\whk.sock",
+                     "--bucket", "5", "-f", "json"});
+    CliOptions opts = parseArguments(args.argc(), args.argv());
+    
+    EXPECT_TRUE(opts.aggregate);
+    EXPECT_TRUE(opts.continuous);
+    EXPECT_EQ(opts.listenEndpoint, "unix:C:\\temp\\whk.sock");
+    EXPECT_DOUBLE_EQ(opts.bucketSeconds, 5.0);
+    EXPECT_EQ(opts.format, OutputFormat::JSON);
+}
+
+TEST(CliParserTest, RejectsInvalidAggregateUsage) {
+    ArgvHelper withMetric({"WinHKMon", "aggregate", "CPU"});
+    EXPECT_THROW(parseArguments(withMetric.argc(), withMetric.argv()), std::invalid_argument);
+    
+    ArgvHelper badListen({"WinHKMon", "aggregate", "--listen", "tcp:nohostport"});
+    EXPECT_THROW(parseArguments(badListen.argc(), badListen.argv()), std::invalid_argument);
+    
+    ArgvHelper notFirst({"WinHKMon", "CPU", "aggregate"});
+    EXPECT_THROW(parseArguments(notFirst.argc(), notFirst.argv()), std::invalid_argument);
+}
+
+TEST(CliParserTest, ParsesPushOptions) {
+    ArgvHelper args({"WinHKMon", "CPU", "RAM", "-c", "--push", "tcp:monitor01:9410",
+                     "--host-id", "web-07"});
+    CliOptions opts = parseArguments(args.argc(), args.argv());
+    
+    EXPECT_EQ(opts.pushEndpoint, "tcp:monitor01:9410");
+    EXPECT_EQ(opts.hostId, "web-07");
+    
+    ArgvHelper singleShot({"WinHKMon", "CPU", "--push", "tcp:monitor01:9410"});
+    EXPECT_THROW(parseArguments(singleShot.argc(), singleShot.argv()), std::invalid_argument);
+}
+
+// Test remote pull options
+TEST(CliParserTest, ParsesServeOptions) {
+    ArgvHelper args({"WinHKMon", "CPU", "NET", "-c", "--serve", "tcp:0.0.0.0:9411", "--ring", "50"});
+    CliOptions opts = parseArguments(args.argc(), args.argv());
+    
+    EXPECT_EQ(opts.serveEndpoint, "tcp:0.0.0.0:9411");
+    EXPECT_EQ(opts.ringFrames, 50u);
+    
+    ArgvHelper defaults({"WinHKMon", "CPU"});
+    EXPECT_EQ(parseArguments(defaults.argc(), defaults.argv()).ringFrames, 600u);
+    
+    ArgvHelper singleShot({"WinHKMon", "CPU", "--serve", "tcp:0.0.0.0:9411"});
+    EXPECT_THROW(parseArguments(singleShot.argc(), singleShot.argv()), std::invalid_argument);
+    
+    ArgvHelper tinyRing({"WinHKMon", "CPU", "-c", "--ring", "1"});
+    EXPECT_THROW(parseArguments(tinyRing.argc(), tinyRing.argv()), std::invalid_argument);
+    
+    ArgvHelper badRing({"WinHKMon", "CPU", "-c", "--ring", "10x"});
+    EXPECT_THROW(parseArguments(badRing.argc(), badRing.argv()), std::invalid_argument);
+}
+
+// Test wall-clock alignment option
+TEST(CliParserTest, ParsesAlignOption) {
+    ArgvHelper args({"WinHKMon", "CPU", "-c", "-i", "5", "--align"});
+    CliOptions opts = parseArguments(args.argc(), args.argv());
+    EXPECT_TRUE(opts.align);
+    
+    ArgvHelper singleShot({"WinHKMon", "CPU", "--align"});
+    EXPECT_THROW(parseArguments(singleShot.argc(), singleShot.argv()), std::invalid_argument);
+    
+    ArgvHelper adaptive({"WinHKMon", "CPU", "-c", "--align", "--adaptive"});
+    EXPECT_THROW(parseArguments(adaptive.argc(), adaptive.argv()), std::invalid_argument);
+}
+
+// Test config file profiles: profile first, command line overrides
+TEST(CliParserTest, AppliesProfileFromConfigFile) {
+    std::string path = (std::filesystem::temp_directory_path() / "WinHKMon_cli_profile.ini").string();
+    {
+        std::ofstream config(path);
+        config << "interval = 5\n[server]\nmetrics = CPU RAM\ncontinuous = true\nformat = json\n";
+    }
+    
+    ArgvHelper args({"WinHKMon", "--config", path, "--profile", "server", "NET", "-i", "2"});
+    CliOptions opts = parseArguments(args.argc(), args.argv());
+    EXPECT_TRUE(opts.showCpu);
+    EXPECT_TRUE(opts.showMemory);
+    EXPECT_TRUE(opts.showNetwork);
+    EXPECT_TRUE(opts.continuous);
+    EXPECT_EQ(opts.format, OutputFormat::JSON);
+    EXPECT_DOUBLE_EQ(opts.intervalSeconds, 2.0);
+    EXPECT_EQ(opts.configPath, path);
+    EXPECT_EQ(opts.profile, "server");
+    
+    ArgvHelper missing({"WinHKMon", "--config", path, "--profile", "laptop"});
+    EXPECT_THROW(parseArguments(missing.argc(), missing.argv()), std::invalid_argument);
+    
+    ArgvHelper noName({"WinHKMon", "CPU", "--profile"});
+    EXPECT_THROW(parseArguments(noName.argc(), noName.argv()), std::invalid_argument);
+    
+    std::remove(path.c_str());
+}
+
+// Test repeatable --sink options
+TEST(CliParserTest, ParsesSinkOptions) {
+    ArgvHelper args({"WinHKMon", "CPU", "-c", "--sink", "text:stdout", "--sink", "csv+drop:C:\\logs\\whk.csv"});
+    CliOptions opts = parseArguments(args.argc(), args.argv());
+    ASSERT_EQ(opts.sinks.size(), 2u);
+    EXPECT_EQ(opts.sinks[0].format, OutputFormat::TEXT);
+    EXPECT_EQ(opts.sinks[1].format, OutputFormat::CSV);
+    EXPECT_EQ(opts.sinks[1].policy, SinkPolicy::DROP_OLDEST);
+    EXPECT_EQ(opts.sinks[1].target, "C:\\logs\\whk.csv");
+    
+    ArgvHelper ndjson({"WinHKMon", "CPU", "--format", "ndjson"});
+    EXPECT_EQ(parseArguments(ndjson.argc(), ndjson.argv()).format, OutputFormat::NDJSON);
+    
+    ArgvHelper twice({"WinHKMon", "CPU", "--sink", "text:stdout", "--sink", "json:stdout"});
+    EXPECT_THROW(parseArguments(twice.argc(), twice.argv()), std::invalid_argument);
+}
+
+// Test --fields: compiled at parse time and implies the metrics
+TEST(CliParserTest, ParsesFieldsOption) {
+    ArgvHelper args({"WinHKMon", "--fields", "cpu.total,net.*.in"});
+    CliOptions opts = parseArguments(args.argc(), args.argv());
+    EXPECT_EQ(opts.fields.size(), 2u);
+    EXPECT_TRUE(opts.showCpu);
+    EXPECT_TRUE(opts.showNetwork);
+    EXPECT_FALSE(opts.showMemory);
+    
+    ArgvHelper unknown({"WinHKMon", "--fields", "cpu.bogus"});
+    EXPECT_THROW(parseArguments(unknown.argc(), unknown.argv()), std::invalid_argument);
+    
+    ArgvHelper aggregate({"WinHKMon", "aggregate", "--fields", "cpu.total"});
+    EXPECT_THROW(parseArguments(aggregate.argc(), aggregate.argv()), std::invalid_argument);
+}
+
+// Test CGROUP metric with --cgroup and --cgroup-root
+TEST(CliParserTest, ParsesCgroupOptions) {
+    ArgvHelper defaults({"WinHKMon", "cgroup"});
+    CliOptions opts = parseArguments(defaults.argc(), defaults.argv());
+    EXPECT_TRUE(opts.showCgroup);
+    EXPECT_EQ(opts.cgroupFilter, "*");
+    EXPECT_EQ(opts.cgroupRoot, "/sys/fs/cgroup");
+    
+    ArgvHelper args({"WinHKMon", "CGROUP", "--cgroup", "system.slice/*", "--cgroup-root", "/mnt/wsl/cgroup"});
+    opts = parseArguments(args.argc(), args.argv());
+    EXPECT_EQ(opts.cgroupFilter, "system.slice/*");
+    EXPECT_EQ(opts.cgroupRoot, "/mnt/wsl/cgroup");
+    
+    ArgvHelper fields({"WinHKMon", "--fields", "cgroup.*.cpu"});
+    opts = parseArguments(fields.argc(), fields.argv());
+    EXPECT_TRUE(opts.showCgroup);
+    EXPECT_FALSE(opts.showCpu);
+    
+    ArgvHelper missing({"WinHKMon", "CGROUP", "--cgroup"});
+    EXPECT_THROW(parseArguments(missing.argc(), missing.argv()), std::invalid_argument);
+}
+
+// Test repeatable --module with --module-dir
+TEST(CliParserTest, ParsesModuleOptions) {
+    ArgvHelper args({"WinHKMon", "--module", "gpu", "--module", "./whk_nic.so", "--module-dir", "/opt/whk"});
+    CliOptions opts = parseArguments(args.argc(), args.argv());
+    EXPECT_EQ(opts.modules, (std::vector<std::string>{"gpu", "./whk_nic.so"}));
+    EXPECT_EQ(opts.moduleDir, "/opt/whk");
+    EXPECT_FALSE(opts.showCpu) << "A module alone is a metric";
+    
+    ArgvHelper twice({"WinHKMon", "--module", "gpu", "--module", "gpu"});
+    EXPECT_THROW(parseArguments(twice.argc(), twice.argv()), std::invalid_argument);
+    
+    ArgvHelper missing({"WinHKMon", "CPU", "--module"});
+    EXPECT_THROW(parseArguments(missing.argc(), missing.argv()), std::invalid_argument);
+}
+
+// Test --high-rate: sub-100 ms intervals for CPU and NET with NDJSON output
+TEST(CliParserTest, ParsesHighRateMode) {
+    ArgvHelper args({"WinHKMon", "CPU", "NET", "-c", "-i", "0.001", "--high-rate", "-f", "ndjson"});
+    CliOptions opts = parseArguments(args.argc(), args.argv());
+    EXPECT_TRUE(opts.highRate);
+    EXPECT_DOUBLE_EQ(opts.intervalSeconds, 0.001);
+    
+    ArgvHelper sink({"WinHKMon", "CPU", "-c", "-i", "0.01", "--high-rate", "--sink", "ndjson:cpu.ndjson"});
+    EXPECT_TRUE(parseArguments(sink.argc(), sink.argv()).highRate);
+    
+    ArgvHelper noFlag({"WinHKMon", "CPU", "-c", "-i", "0.01", "-f", "ndjson"});
+    EXPECT_THROW(parseArguments(noFlag.argc(), noFlag.argv()), std::invalid_argument);
+    
+    ArgvHelper tooFast({"WinHKMon", "CPU", "-c", "-i", "0.0005", "--high-rate", "-f", "ndjson"});
+    EXPECT_THROW(parseArguments(tooFast.argc(), tooFast.argv()), std::invalid_argument);
+    
+    ArgvHelper expensive({"WinHKMon", "CPU", "DISK", "-c", "-i", "0.01", "--high-rate", "-f", "ndjson"});
+    EXPECT_THROW(parseArguments(expensive.argc(), expensive.argv()), std::invalid_argument);
+    
+    ArgvHelper text({"WinHKMon", "CPU", "-c", "-i", "0.01", "--high-rate"});
+    EXPECT_THROW(parseArguments(text.argc(), text.argv()), std::invalid_argument);
+    
+    ArgvHelper single({"WinHKMon", "CPU", "-i", "0.01", "--high-rate", "-f", "ndjson"});
+    EXPECT_THROW(parseArguments(single.argc(), single.argv()), std::invalid_argument);
+}
+
+// Test --otlp: collector URL and batch size, continuous mode only
+TEST(CliParserTest, ParsesOtlpExport) {
+    ArgvHelper args({"WinHKMon", "CPU", "RAM", "-c", "--otlp", "http://otel:4318", "--otlp-batch", "30"});
+    CliOptions opts = parseArguments(args.argc(), args.argv());
+    EXPECT_EQ(opts.otlpUrl, "http://otel:4318");
+    EXPECT_EQ(opts.otlpBatchSamples, 30u);
+    
+    ArgvHelper defaults({"WinHKMon", "CPU", "-c", "--otlp", "http://otel"});
+    EXPECT_EQ(parseArguments(defaults.argc(), defaults.argv()).otlpBatchSamples, 10u);
+    
+    ArgvHelper single({"WinHKMon", "CPU", "--otlp", "http://otel:4318"});
+    EXPECT_THROW(parseArguments(single.argc(), single.argv()), std::invalid_argument);
+    
+    ArgvHelper https({"WinHKMon", "CPU", "-c", "--otlp", "https://otel:4318"});
+    EXPECT_THROW(parseArguments(https.argc(), https.argv()), std::invalid_argument);
+    
+    ArgvHelper batch({"WinHKMon", "CPU", "-c", "--otlp", "http://otel", "--otlp-batch", "0"});
+    EXPECT_THROW(parseArguments(batch.argc(), batch.argv()), std::invalid_argument);
+}
+
+// Test --cores: per-core views and the top count
+TEST(CliParserTest, ParsesCoreView) {
+    ArgvHelper defaults({"WinHKMon", "CPU"});
+    EXPECT_EQ(parseArguments(defaults.argc(), defaults.argv()).coreView, CoreView::FULL);
+    
+    ArgvHelper packed({"WinHKMon", "CPU", "--cores", "packed"});
+    EXPECT_EQ(parseArguments(packed.argc(), packed.argv()).coreView, CoreView::PACKED);
+    
+    ArgvHelper histogram({"WinHKMon", "CPU", "--cores", "HISTOGRAM"});
+    EXPECT_EQ(parseArguments(histogram.argc(), histogram.argv()).coreView, CoreView::HISTOGRAM);
+    
+    ArgvHelper top({"WinHKMon", "CPU", "--cores", "top:16"});
+    CliOptions opts = parseArguments(top.argc(), top.argv());
+    EXPECT_EQ(opts.coreView, CoreView::TOP);
+    EXPECT_EQ(opts.topCores, 16u);
+    
+    ArgvHelper topDefault({"WinHKMon", "CPU", "--cores", "top"});
+    EXPECT_EQ(parseArguments(topDefault.argc(), topDefault.argv()).topCores, 8u);
+    
+    ArgvHelper none({"WinHKMon", "CPU", "--cores", "none"});
+    EXPECT_EQ(parseArguments(none.argc(), none.argv()).coreView, CoreView::NONE);
+    
+    ArgvHelper unknown({"WinHKMon", "CPU", "--cores", "sparse"});
+    EXPECT_THROW(parseArguments(unknown.argc(), unknown.argv()), std::invalid_argument);
+    
+    ArgvHelper zero({"WinHKMon", "CPU", "--cores", "top:0"});
+    EXPECT_THROW(parseArguments(zero.argc(), zero.argv()), std::invalid_argument);
+    
+    ArgvHelper missing({"WinHKMon", "CPU", "--cores"});
+    EXPECT_THROW(parseArguments(missing.argc(), missing.argv()), std::invalid_argument);
+}
@@ -0,0 +1,141 @@
+#include "WinHKMonLib/CollectorModule.h"
+#include "WinHKMonLib/DeltaProtocol.h"
+#include "WinHKMonLib/FrameSlots.h"
+#include "WinHKMonLib/PushProtocol.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+using namespace WinHKMon;
+namespace fs = std::filesystem;
+
+/**
+ * Test Suite: CollectorModule
+ *
+ * Tests for run-time collector modules, loading the sample module built
+ * with the tests (src/WinHKMonSampleModule, path in WHK_SAMPLE_MODULE_PATH).
+ *
+ * Coverage:
+ * - Bare names resolve to whk_<name> in the module directory; paths are kept
+ * - Declared counters and units become the schema
+ * - The module fills its frame slots and valid bits in place
+ * - A library that cannot be loaded fails initialize()
+ * - Module slots follow the built-in ones and reach push and pull frames
+ * - Export names already taken fail the load
+ */
+
+// Test 1: Module path resolution
+TEST(CollectorModuleTest, ResolvesModulePaths) {
+#ifdef _WIN32
+    EXPECT_EQ(resolveModulePath("GPU", "C:\\mods"), (fs::path("C:\\mods") / "whk_gpu.dll").string());
+#else
+    EXPECT_EQ(resolveModulePath("GPU", "/opt/mods"), "/opt/mods/whk_gpu.so");
+#endif
+    EXPECT_EQ(resolveModulePath("./whk_gpu.so", "/opt/mods"), "./whk_gpu.so");
+    EXPECT_EQ(resolveModulePath("mods/whk_gpu", "/opt/mods"), "mods/whk_gpu");
+}
+
+// Test 2: The schema comes from the module's declarations
+TEST(CollectorModuleTest, LoadsSampleModuleSchema) {
+    CollectorModule module(WHK_SAMPLE_MODULE_PATH);
+    ASSERT_NO_THROW(module.initialize());
+
+    ASSERT_TRUE(module.schema());
+    EXPECT_EQ(module.schema()->name, "sample");
+    EXPECT_FALSE(module.schema()->description.empty());
+    ASSERT_EQ(module.schema()->counters.size(), 2u);
+    EXPECT_EQ(module.schema()->counters[0], "samples");
+    EXPECT_EQ(module.schema()->counters[1], "interval");
+    EXPECT_EQ(module.schema()->units[1], "s");
+}
+
+// Test 3: Samples are written by the module, with counters it skipped left invalid
+TEST(CollectorModuleTest, SampleModuleFillsValues) {
+    CollectorModule module(WHK_SAMPLE_MODULE_PATH);
+    module.initialize();
+    module.bindSlots(20);
+
+    ModuleFrame frame;
+    module.sample(frame);
+    EXPECT_DOUBLE_EQ(frame.values[20], 1.0);
+    EXPECT_EQ(frame.validMask, 1ULL << 20) << "No interval before the second sample";
+
+    module.sample(frame);
+    EXPECT_DOUBLE_EQ(frame.values[20], 2.0);
+    EXPECT_EQ(frame.validMask, 3ULL << 20);
+    EXPECT_GE(frame.values[21], 0.0);
+}
+
+// Test 4: Missing library
+TEST(CollectorModuleTest, MissingLibraryFails) {
+    CollectorModule module((fs::temp_directory_path() / "WinHKMon_no_such_module.so").string());
+    EXPECT_THROW(module.initialize(), std::runtime_error);
+    ModuleFrame frame;
+    EXPECT_THROW(module.sample(frame), std::runtime_error);
+    EXPECT_EQ(frame.validMask, 0u);
+}
+
+// Test 5: Module counters take the slots after the built-in ones, through push and pull
+TEST(CollectorModuleTest, CountersReachFrameSlots) {
+    ModuleSet modules;
+    ASSERT_EQ(modules.load(WHK_SAMPLE_MODULE_PATH), SLOT_COUNT);
+    EXPECT_EQ(modules.layout().slotCount(), SLOT_COUNT + 2);
+    EXPECT_EQ(modules.layout().name(SLOT_COUNT), "sample_samples");
+    EXPECT_EQ(modules.layout().name(SLOT_COUNT + 1), "sample_interval");
+
+    SystemMetrics metrics{};
+    modules.sample(metrics.modules.emplace());
+    modules.sample(*metrics.modules);
+    ASSERT_EQ(metrics.modules->schemas->size(), 1u);
+    EXPECT_EQ((*metrics.modules->schemas)[0].firstSlot, SLOT_COUNT);
+    EXPECT_EQ(frameSlotCount(metrics), SLOT_COUNT + 2);
+
+    PushSample sample;
+    sample.hostId = "host-a";
+    sample.validMask = flattenSlots(metrics, sample.values.data());
+    EXPECT_EQ(sample.validMask, 3ULL << SLOT_COUNT);
+    std::string wire;
+    encodePushSample(sample, wire);
+    PushDecoder decoder;
+    decoder.feed(wire.data(), wire.size());
+    PushSample decoded;
+    ASSERT_TRUE(decoder.next(decoded));
+    EXPECT_EQ(decoded.validMask, sample.validMask);
+    EXPECT_DOUBLE_EQ(decoded.values[SLOT_COUNT], 2.0);
+
+    FrameRing ring(4);
+    SnapshotFrame frame;
+    frame.validMask = flattenSlots(metrics, frame.values.data());
+    ring.push(frame);
+    std::string response;
+    ASSERT_EQ(encodeSnapshotResponse(ring, 7, 0, 0, response), SnapshotKind::KEYFRAME);
+    SnapshotDecoder client;
+    ASSERT_EQ(client.apply(response.data() + 4, response.size() - 4), SnapshotKind::KEYFRAME);
+    EXPECT_EQ(client.frame().validMask, 3ULL << SLOT_COUNT);
+    EXPECT_DOUBLE_EQ(client.frame().values[SLOT_COUNT], 2.0);
+}
+
+// Test 6: A module whose export names are taken is not loaded
+TEST(CollectorModuleTest, RejectsDuplicateExportNames) {
+    ModuleSet modules;
+    modules.load(WHK_SAMPLE_MODULE_PATH);
+    EXPECT_THROW(modules.load(WHK_SAMPLE_MODULE_PATH), std::runtime_error);
+    EXPECT_EQ(modules.layout().slotCount(), SLOT_COUNT + 2);
+    EXPECT_EQ(modules.layout().modules()->size(), 1u);
+
+    // Built-in slot names are taken too, and slots are finite
+    SlotLayout layout;
+    ModuleSchema cpu;
+    cpu.name = "cpu";
+    cpu.counters = {"temp", "percent"};
+    EXPECT_THROW(layout.addModule(cpu), std::runtime_error);
+    ModuleSchema wide;
+    wide.name = "wide";
+    wide.counters.resize(MAX_FRAME_SLOTS - SLOT_COUNT + 1, "c");
+    for (size_t i = 0; i < wide.counters.size(); i++) {
+        wide.counters[i] += std::to_string(i);
+    }
+    EXPECT_THROW(layout.addModule(wide), std::runtime_error);
+    EXPECT_EQ(layout.slotCount(), SLOT_COUNT);
+}
@@ -0,0 +1,93 @@
+#include "WinHKMonLib/ConfigProfile.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: ConfigProfile
+ *
+ * Tests for config file profiles (--profile/--config).
+ *
+ * Coverage:
+ * - Shared keys, then the selected section, as command-line arguments
+ * - Switches, metric lists, comments and quoting
+ * - Errors carry the line number; unknown profiles are rejected
+ * - Which option changes need a restart instead of a live reload
+ */
+
+namespace {
+
+const char* const CONFIG = R"(
+# Shared by every profile
+interval = 5
+format = json
+
+[desktop]
+metrics = CPU, RAM
+line = true
+
+[server]
+metrics = CPU RAM NET IO
+continuous = yes
+adaptive = false
+interface = "Ethernet 2"   # quoted to keep the space
+push = tcp:monitor01:9410
+)";
+
+}  // anonymous namespace
+
+// Test 1: Shared keys come first, then only the selected section
+TEST(ConfigProfileTest, ExpandsSharedKeysThenProfile) {
+    std::vector<std::string> expected = {
+        "--interval", "5", "--format", "json",
+        "CPU", "RAM", "NET", "IO", "--continuous",
+        "--interface", "Ethernet 2", "--push", "tcp:monitor01:9410"
+    };
+    EXPECT_EQ(profileArguments(CONFIG, "server"), expected);
+
+    std::vector<std::string> desktop = {"--interval", "5", "--format", "json", "CPU", "RAM", "--line"};
+    EXPECT_EQ(profileArguments(CONFIG, "desktop"), desktop);
+
+    std::vector<std::string> shared = {"--interval", "5", "--format", "json"};
+    EXPECT_EQ(profileArguments(CONFIG, ""), shared);
+}
+
+// Test 2: Mistakes are reported with their line, even in other profiles
+TEST(ConfigProfileTest, RejectsInvalidConfig) {
+    EXPECT_THROW(profileArguments(CONFIG, "laptop"), std::invalid_argument);
+
+    try {
+        profileArguments("[a]\nmetrics = CPU\n\n[b]\nintervall = 5\n", "a");
+        FAIL() << "Expected std::invalid_argument";
+    } catch (const std::invalid_argument& e) {
+        EXPECT_NE(std::string(e.what()).find("line 5"), std::string::npos) << e.what();
+        EXPECT_NE(std::string(e.what()).find("intervall"), std::string::npos) << e.what();
+    }
+
+    EXPECT_THROW(profileArguments("[a\n", "a"), std::invalid_argument);
+    EXPECT_THROW(profileArguments("interval 5\n", ""), std::invalid_argument);
+    EXPECT_THROW(profileArguments("continuous = maybe\n", ""), std::invalid_argument);
+    EXPECT_THROW(profileArguments("push =\n", ""), std::invalid_argument);
+    EXPECT_THROW(loadProfileArguments("no_such_dir/WinHKMon.ini", "server"), std::invalid_argument);
+}
+
+// Test 3: Endpoints, tracing and the mode need a restart; the rest reloads live
+TEST(ConfigProfileTest, ReportsRestartOnlyChanges) {
+    CliOptions current;
+    current.continuous = true;
+    current.showCpu = true;
+
+    CliOptions next = current;
+    next.showNetwork = true;
+    next.intervalSeconds = 10.0;
+    next.format = OutputFormat::CSV;
+    next.adaptive = true;
+    EXPECT_EQ(restartOnlyChanges(current, next), "");
+
+    next.pushEndpoint = "tcp:monitor01:9410";
+    next.ringFrames = 100;
+    EXPECT_EQ(restartOnlyChanges(current, next), "push, ring");
+}
@@ -0,0 +1,53 @@
+#include "IntegrationHelpers.h"
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <fstream>
+#include <string>
+
+/**
+ * Test Suite: ConfigReload (integration)
+ *
+ * Runs "WinHKMon -c --config" and rewrites the config file while it runs.
+ *
+ * Coverage:
+ * - A reload to a sink that cannot be opened is rejected with a warning;
+ *   the monitor keeps running and writing to its old sink
+ *
+ * @note Executable path is injected by CMake (WINHKMON_EXE_PATH)
+ */
+
+namespace {
+
+void writeConfig(const std::string& path, const std::string& contents) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << contents;
+}
+
+}  // anonymous namespace
+
+// Test 1: A failed reload keeps the running pipeline instead of exiting
+TEST(ConfigReloadIntegrationTest, UnopenableSinkKeepsCurrentPipeline) {
+    std::string config = tempFilePath("WinHKMon_reload.ini");
+    writeConfig(config, "interval = 1\n");
+
+    ChildProcess monitor(WINHKMON_EXE_PATH, "RAM -c --format json --config \"" + config + "\"",
+                         tempFilePath("WinHKMon_reload.json"));
+    ASSERT_TRUE(monitor.started());
+    Sleep(2500);
+
+    // The parent directory does not exist, so the new sink cannot be opened
+    std::string unopenable = tempFilePath("WinHKMon_no_such_dir\\sub\\samples.csv");
+    writeConfig(config, "interval = 1\nsink = csv:" + unopenable + "\n");
+    Sleep(2000);
+    size_t samplesAtReload = splitSamples(monitor.output()).size();
+    Sleep(3000);
+
+    EXPECT_TRUE(monitor.running()) << monitor.output();
+    std::string output = monitor.output();
+    EXPECT_NE(output.find("Config reload failed, keeping current options"), std::string::npos) << output;
+    EXPECT_GE(splitSamples(output).size(), samplesAtReload + 2)
+        << "No JSON samples after the failed reload";
+
+    monitor.terminate();
+    DeleteFileA(config.c_str());
+}
@@ -0,0 +1,108 @@
+#include "WinHKMonLib/ConfigWatcher.h"
+#include "WinHKMonLib/CliParser.h"
+#include "WinHKMonLib/EventLoop.h"
+#include "TempTree.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: ConfigWatcher
+ *
+ * Tests for live config reload: the watcher thread notices a rewritten
+ * config file and, as in continuous mode, posts the reload to the event
+ * loop, which parses the command line again with the new file.
+ *
+ * Coverage:
+ * - A rewrite reaches the loop and the reparsed options carry the new value
+ * - Writes to other files in the directory are ignored
+ * - Destruction stops the watcher thread promptly
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Fresh directory per test holding the watched config file
+class ConfigWatcherTest : public TempTreeTest {
+protected:
+    ConfigWatcherTest()
+        : TempTreeTest("watch") {
+    }
+
+    void SetUp() override {
+        TempTreeTest::SetUp();
+        path_ = (root_ / "WinHKMon.ini").string();
+        writeFile(path_, "interval = 1\n");
+    }
+
+    std::string path_;
+};
+
+}  // anonymous namespace
+
+// Test 1: Rewriting the file drives a reload through the event loop
+TEST_F(ConfigWatcherTest, RewriteReloadsOnLoop) {
+    EventLoop loop;
+    std::vector<double> reloadedIntervals;
+    std::thread::id loopThread;
+    std::thread::id reloadThread;
+
+    auto reload = [&]() {
+        reloadThread = std::this_thread::get_id();
+        std::string config = path_;
+        std::vector<std::string> args = {"WinHKMon", "CPU", "-c", "--config", config};
+        std::vector<char*> argv;
+        for (std::string& arg : args) {
+            argv.push_back(&arg[0]);
+        }
+        CliOptions options = parseArguments(static_cast<int>(argv.size()), argv.data());
+        reloadedIntervals.push_back(options.intervalSeconds);
+        loop.stop();
+    };
+    ConfigWatcher watcher(path_, [&loop, &reload]() { loop.post(reload); });
+
+    // Let the watcher take its first stamp, then save new settings
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    writeFile(path_, "interval = 5\n");
+
+    // Give up after a few seconds instead of hanging the suite
+    loop.addTimer(Clock::now() + std::chrono::seconds(5), [&loop]() { loop.stop(); });
+    loopThread = std::this_thread::get_id();
+    loop.run();
+
+    ASSERT_EQ(reloadedIntervals.size(), 1u);
+    EXPECT_DOUBLE_EQ(reloadedIntervals[0], 5.0);
+    EXPECT_EQ(reloadThread, loopThread);
+}
+
+// Test 2: Other files in the directory do not trigger a reload
+TEST_F(ConfigWatcherTest, IgnoresOtherFiles) {
+    std::atomic<int> changes{0};
+    {
+        ConfigWatcher watcher(path_, [&changes]() { changes++; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        writeFile((root_ / "other.txt").string(), "unrelated\n");
+        std::this_thread::sleep_for(std::chrono::milliseconds(600));
+        EXPECT_EQ(changes.load(), 0);
+
+        writeFile(path_, "interval = 2\nformat = json\n");
+        auto deadline = Clock::now() + std::chrono::seconds(5);
+        while (changes.load() == 0 && Clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        EXPECT_EQ(changes.load(), 1);
+
+        // Destruction joins the thread without waiting for another change
+        auto stopStart = Clock::now();
+        {
+            ConfigWatcher idle(path_, []() {});
+        }
+        EXPECT_LT(Clock::now() - stopStart, std::chrono::seconds(1));
+    }
+}
@@ -20,6 +20,7 @@ using namespace WinHKMon;
  * - Frequency values
  * - Error handling
  * - Resource leak prevention
+ * - Raw processor-time sampling (high-rate mode) without the PDH wait
  */
 
 // Test fixture for CpuMonitor tests
@@ -289,3 +290,33 @@ TEST_F(CpuMonitorTest, ReinitializeAfterCleanup) {
     EXPECT_EQ(stats1.cores.size(), stats2.cores.size());
 }
 
+
+// Test 15: Raw processor-time samples (high-rate mode) return without waiting
+TEST_F(CpuMonitorTest, RawTimesSampleDoesNotSleep) {
+    CpuMonitor monitor(CpuSampling::RAW_TIMES);
+    ASSERT_NO_THROW(monitor.initialize());
+
+    // One PDH sample alone waits 100 ms; 100 raw samples must fit well within that
+    auto start = std::chrono::steady_clock::now();
+    CpuStats stats;
+    for (int i = 0; i < 100; i++) {
+        stats = monitor.getCurrentStats();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::milliseconds(100));
+
+    // Usage over a busy stretch is still a valid percentage per core
+    auto busyUntil = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+    volatile uint64_t spin = 0;
+    while (std::chrono::steady_clock::now() < busyUntil) {
+        spin = spin + 1;
+    }
+    stats = monitor.getCurrentStats();
+    EXPECT_GE(stats.totalUsagePercent, 0.0);
+    EXPECT_LE(stats.totalUsagePercent, 100.0);
+    EXPECT_GT(stats.cores.size(), 0u);
+    for (const auto& core : stats.cores) {
+        EXPECT_GE(core.usagePercent, 0.0);
+        EXPECT_LE(core.usagePercent, 100.0);
+    }
+}
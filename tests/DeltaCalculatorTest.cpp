@@ -16,6 +16,8 @@ using namespace WinHKMon;
  * - First run handling (no previous data)
  * - Zero elapsed time handling
  * - Counter rollover handling
+ * - Counters that wrap at a known range
+ * - Interface rates matched by name across samples
  * - Negative delta handling
  * - Monotonic timestamp usage
  */
@@ -227,3 +229,46 @@ TEST(DeltaCalculatorTest, RealWorldNetworkTrafficSimulation) {
     EXPECT_NEAR(mbps, 80.0, 0.1);  // 10 MB/s = 80 Mbps
 }
 
+// Test 16: Counters with a known range (RAPL energy) wrap instead of resetting
+TEST(DeltaCalculatorTest, CalculateWrappingRate) {
+    DeltaCalculator calc;
+    const uint64_t range = 262143328850;   // Typical max_energy_range_uj
+    
+    // No wrap: same as calculateRate
+    EXPECT_NEAR(calc.calculateWrappingRate(3000000, 1000000, range, 2.0), 1000000.0, 0.001);
+    
+    // One wrap: 1000 before the range, 500 after it
+    EXPECT_NEAR(calc.calculateWrappingRate(500, range - 1000, range, 1.0), 1500.0, 0.001);
+    
+    // Unknown range or out-of-range values are resets, not wraps
+    EXPECT_DOUBLE_EQ(calc.calculateWrappingRate(500, range - 1000, 0, 1.0), 0.0);
+    EXPECT_DOUBLE_EQ(calc.calculateWrappingRate(500, range + 1, range, 1.0), 0.0);
+    EXPECT_DOUBLE_EQ(calc.calculateWrappingRate(500, range - 1000, range, 0.0), 0.0);
+}
+
+// Test 17: Interface rates come from the previous sample of the same name
+TEST(DeltaCalculatorTest, ApplyInterfaceRatesMatchesByName) {
+    DeltaCalculator calc;
+    InterfaceStats eth{};
+    eth.name = "eth";
+    eth.totalInOctets = 3000;
+    eth.totalOutOctets = 1000;
+    InterfaceStats wifi{};
+    wifi.name = "wifi";
+    wifi.totalInOctets = 500;
+    
+    InterfaceStats ethBefore = eth;
+    ethBefore.totalInOctets = 1000;
+    ethBefore.totalOutOctets = 1000;
+    
+    std::vector<InterfaceStats> current = {eth, wifi};
+    calc.applyInterfaceRates(current, {ethBefore}, 2.0);
+    EXPECT_EQ(current[0].inBytesPerSec, 1000u);
+    EXPECT_EQ(current[0].outBytesPerSec, 0u);
+    EXPECT_EQ(current[1].inBytesPerSec, 0u);   // No previous entry
+    
+    // No elapsed time: rates are left alone
+    current[0].inBytesPerSec = 7;
+    calc.applyInterfaceRates(current, {ethBefore}, 0.0);
+    EXPECT_EQ(current[0].inBytesPerSec, 7u);
+}
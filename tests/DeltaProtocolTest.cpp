@@ -0,0 +1,172 @@
+#include "WinHKMonLib/DeltaProtocol.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: DeltaProtocol
+ *
+ * Tests for the delta-compressed pull protocol. Socket transport is
+ * exercised by the pull benchmark scenario in WinHKMonBench.
+ *
+ * Coverage:
+ * - Frame ring lookup and eviction
+ * - Request round trip and partial requests
+ * - Keyframe on first contact, after a ring gap and after an epoch change
+ * - Deltas carry only changed slots and reconstruct exact values
+ * - Slots becoming valid/invalid
+ * - Delta against the wrong base is rejected
+ */
+
+namespace {
+
+constexpr uint64_t EPOCH = 77;
+
+SnapshotFrame makeFrame(uint64_t timestampMs, double cpu, double netIn) {
+    SnapshotFrame frame;
+    frame.timestampMs = timestampMs;
+    frame.values[WHK_SLOT_CPU_TOTAL_PERCENT] = cpu;
+    frame.values[WHK_SLOT_MEM_TOTAL_BYTES] = 34359738368.0;
+    frame.values[WHK_SLOT_MEM_AVAILABLE_BYTES] = 21474836480.0;
+    frame.values[WHK_SLOT_NET_IN_BYTES_PER_SEC] = netIn;
+    frame.validMask = (1ULL << WHK_SLOT_CPU_TOTAL_PERCENT) | (1ULL << WHK_SLOT_MEM_TOTAL_BYTES) |
+                      (1ULL << WHK_SLOT_MEM_AVAILABLE_BYTES) | (1ULL << WHK_SLOT_NET_IN_BYTES_PER_SEC);
+    return frame;
+}
+
+// Run one request/response exchange; returns the response size in bytes
+size_t exchange(const FrameRing& ring, uint64_t agentEpoch, SnapshotDecoder& client, SnapshotKind& kind) {
+    std::string response;
+    encodeSnapshotResponse(ring, agentEpoch, client.epoch(), client.lastSequence(), response);
+    kind = client.apply(response.data() + 4, response.size() - 4);
+    return response.size();
+}
+
+}  // anonymous namespace
+
+// Test 1: Ring keeps the last N frames
+TEST(DeltaProtocolTest, RingKeepsRecentFrames) {
+    EXPECT_THROW(FrameRing(0), std::invalid_argument);
+
+    FrameRing ring(3);
+    EXPECT_EQ(ring.latest(), nullptr);
+    for (int i = 1; i <= 5; i++) {
+        EXPECT_EQ(ring.push(makeFrame(1000 * i, i, 0)), static_cast<uint64_t>(i));
+    }
+    EXPECT_EQ(ring.latest()->sequence, 5u);
+    EXPECT_NE(ring.find(3), nullptr);
+    EXPECT_EQ(ring.find(2), nullptr);   // Evicted
+    EXPECT_EQ(ring.find(6), nullptr);   // Not yet taken
+    EXPECT_EQ(ring.find(0), nullptr);
+}
+
+// Test 2: Requests round trip and wait for missing bytes
+TEST(DeltaProtocolTest, RequestRoundTrip) {
+    std::string request;
+    encodePullRequest(123456789, 300, request);
+
+    uint64_t epoch = 0;
+    uint64_t sequence = 0;
+    EXPECT_EQ(decodePullRequest(request.data(), request.size() - 1, epoch, sequence), 0u);
+    EXPECT_EQ(decodePullRequest(request.data(), request.size(), epoch, sequence), request.size());
+    EXPECT_EQ(epoch, 123456789u);
+    EXPECT_EQ(sequence, 300u);
+}
+
+// Test 3: First contact gets a keyframe, then small deltas
+TEST(DeltaProtocolTest, KeyframeThenDeltas) {
+    FrameRing ring(8);
+    SnapshotDecoder client;
+    SnapshotKind kind;
+
+    std::string empty;
+    EXPECT_EQ(encodeSnapshotResponse(ring, EPOCH, 0, 0, empty), SnapshotKind::NONE);
+
+    ring.push(makeFrame(1000, 12.5, 1.0e6));
+    size_t keyBytes = exchange(ring, EPOCH, client, kind);
+    EXPECT_EQ(kind, SnapshotKind::KEYFRAME);
+    EXPECT_EQ(client.lastSequence(), 1u);
+    EXPECT_DOUBLE_EQ(client.frame().values[WHK_SLOT_MEM_TOTAL_BYTES], 34359738368.0);
+
+    // Only CPU changes: one slot in the delta
+    ring.push(makeFrame(1100, 13.0, 1.0e6));
+    size_t deltaBytes = exchange(ring, EPOCH, client, kind);
+    EXPECT_EQ(kind, SnapshotKind::DELTA);
+    EXPECT_EQ(client.lastSequence(), 2u);
+    EXPECT_EQ(client.frame().timestampMs, 1100u);
+    EXPECT_DOUBLE_EQ(client.frame().values[WHK_SLOT_CPU_TOTAL_PERCENT], 13.0);
+    EXPECT_DOUBLE_EQ(client.frame().values[WHK_SLOT_NET_IN_BYTES_PER_SEC], 1.0e6);
+    EXPECT_LT(deltaBytes, keyBytes);
+    EXPECT_LE(deltaBytes, 4u + 16u);
+
+    // Nothing new: empty delta
+    size_t idleBytes = exchange(ring, EPOCH, client, kind);
+    EXPECT_EQ(kind, SnapshotKind::DELTA);
+    EXPECT_LE(idleBytes, 4u + 8u);
+}
+
+// Test 4: Values are reconstructed bit-exactly over many deltas
+TEST(DeltaProtocolTest, ReconstructsExactValues) {
+    FrameRing ring(4);
+    SnapshotDecoder client;
+    SnapshotKind kind;
+    for (int i = 0; i < 200; i++) {
+        double cpu = 50.0 + 40.0 * std::sin(i * 0.1);
+        double net = 1.0e6 + i * 1234.5;
+        SnapshotFrame frame = makeFrame(1000 + 100 * i, cpu, net);
+        if (i % 50 == 25) {
+            frame.validMask &= ~(1ULL << WHK_SLOT_NET_IN_BYTES_PER_SEC);  // Slot drops out
+        }
+        ring.push(frame);
+        exchange(ring, EPOCH, client, kind);
+
+        EXPECT_EQ(client.frame().validMask, frame.validMask);
+        for (uint32_t slot = 0; slot < SLOT_COUNT; slot++) {
+            if (frame.validMask & (1ULL << slot)) {
+                EXPECT_EQ(client.frame().values[slot], frame.values[slot]) << "slot " << slot;
+            }
+        }
+    }
+}
+
+// Test 5: Keyframe after a gap longer than the ring or an agent restart
+TEST(DeltaProtocolTest, KeyframeAfterGapOrRestart) {
+    FrameRing ring(2);
+    SnapshotDecoder client;
+    SnapshotKind kind;
+    ring.push(makeFrame(1000, 1.0, 0));
+    exchange(ring, EPOCH, client, kind);
+
+    for (int i = 0; i < 3; i++) {
+        ring.push(makeFrame(2000 + i, 2.0 + i, 0));
+    }
+    exchange(ring, EPOCH, client, kind);
+    EXPECT_EQ(kind, SnapshotKind::KEYFRAME);
+    EXPECT_EQ(client.lastSequence(), 4u);
+
+    FrameRing restarted(2);
+    restarted.push(makeFrame(9000, 9.0, 0));
+    exchange(restarted, EPOCH + 1, client, kind);
+    EXPECT_EQ(kind, SnapshotKind::KEYFRAME);
+    EXPECT_EQ(client.epoch(), EPOCH + 1);
+    EXPECT_DOUBLE_EQ(client.frame().values[WHK_SLOT_CPU_TOTAL_PERCENT], 9.0);
+}
+
+// Test 6: A delta for a different base is rejected
+TEST(DeltaProtocolTest, RejectsDeltaForWrongBase) {
+    FrameRing ring(8);
+    ring.push(makeFrame(1000, 1.0, 0));
+    ring.push(makeFrame(1100, 2.0, 0));
+
+    std::string response;
+    encodeSnapshotResponse(ring, EPOCH, EPOCH, 1, response);  // Delta against sequence 1
+
+    SnapshotDecoder fresh;
+    EXPECT_THROW(fresh.apply(response.data() + 4, response.size() - 4), std::runtime_error);
+
+    std::string garbage = "\xff\x01";
+    EXPECT_THROW(fresh.apply(garbage.data(), garbage.size()), std::runtime_error);
+}
@@ -0,0 +1,86 @@
+#include "WinHKMonLib/EventLoop.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: EventLoop
+ *
+ * Tests for the single-threaded reactor behind continuous and aggregate mode.
+ *
+ * Coverage:
+ * - Timers run in deadline order on the loop thread
+ * - An idle loop wakes once per timer
+ * - post() and stop() from another thread
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+}  // anonymous namespace
+
+// Test 1: Timers run in deadline order; cancelled ones never run
+TEST(EventLoopTest, RunsTimersInDeadlineOrder) {
+    EventLoop loop;
+    std::vector<int> order;
+    auto now = Clock::now();
+    loop.addTimer(now + std::chrono::milliseconds(30), [&]() { order.push_back(3); loop.stop(); });
+    loop.addTimer(now + std::chrono::milliseconds(10), [&]() { order.push_back(1); });
+    uint64_t cancelled = loop.addTimer(now + std::chrono::milliseconds(15), [&]() { order.push_back(99); });
+    loop.addTimer(now + std::chrono::milliseconds(20), [&]() { order.push_back(2); });
+    EXPECT_TRUE(loop.cancelTimer(cancelled));
+
+    loop.run();
+
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+    EXPECT_FALSE(loop.cancelTimer(cancelled));
+}
+
+// Test 2: With nothing else to do, the loop wakes once per tick
+TEST(EventLoopTest, IdleLoopWakesOncePerTick) {
+    EventLoop loop;
+    int ticks = 0;
+    std::function<void()> tick;
+    tick = [&]() {
+        if (++ticks == 5) {
+            loop.stop();
+            return;
+        }
+        loop.addTimer(Clock::now() + std::chrono::milliseconds(20), tick);
+    };
+    loop.addTimer(Clock::now() + std::chrono::milliseconds(20), tick);
+
+    loop.run();
+
+    // One wake-up per tick (allow one early return from the OS wait)
+    EXPECT_EQ(ticks, 5);
+    EXPECT_GE(loop.wakeups(), 5u);
+    EXPECT_LE(loop.wakeups(), 6u);
+}
+
+// Test 3: Tasks posted from another thread run on the loop; stop() ends run()
+TEST(EventLoopTest, PostAndStopFromAnotherThread) {
+    EventLoop loop;
+    std::thread::id loopThread = std::this_thread::get_id();
+    std::thread::id taskThread;
+    int tasks = 0;
+
+    std::thread other([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        loop.post([&]() {
+            taskThread = std::this_thread::get_id();
+            tasks++;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        loop.stop();
+    });
+    loop.run();
+    other.join();
+
+    EXPECT_EQ(tasks, 1);
+    EXPECT_EQ(taskThread, loopThread);
+}
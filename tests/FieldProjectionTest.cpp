@@ -0,0 +1,191 @@
+#include "WinHKMonLib/FieldProjection.h"
+#include "WinHKMonLib/FrameSlots.h"
+#include "WinHKMonLib/OutputFormatter.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: FieldProjection
+ *
+ * Tests for --fields compilation, collector selection and projected output.
+ *
+ * Coverage:
+ * - Patterns with instances, wildcards and bare groups
+ * - Unknown groups and fields are rejected
+ * - Only the collectors of selected fields run
+ * - Formatters write only the selected values
+ * - Collector module counters as module.<module>.<counter>
+ * - Instance names that contain dots
+ */
+
+namespace {
+
+SystemMetrics sampleMetrics() {
+    SystemMetrics metrics;
+    CpuStats cpu;
+    cpu.totalUsagePercent = 23.5;
+    cpu.averageFrequencyMhz = 2400;
+    cpu.cores.push_back({0, 45.0, 2800});
+    cpu.cores.push_back({1, 12.0, 2100});
+    metrics.cpu = cpu;
+
+    DiskStats c{};
+    c.deviceName = "C:";
+    c.percentBusy = 7.5;
+    DiskStats d{};
+    d.deviceName = "D:";
+    d.percentBusy = 90.0;
+    metrics.disks = std::vector<DiskStats>{c, d};
+
+    InterfaceStats ethernet{};
+    ethernet.name = "Ethernet";
+    ethernet.inBytesPerSec = 1000;
+    InterfaceStats wifi{};
+    wifi.name = "Wi-Fi";
+    wifi.inBytesPerSec = 250;
+    metrics.network = std::vector<InterfaceStats>{ethernet, wifi};
+    return metrics;
+}
+
+std::vector<std::string> paths(const std::vector<FieldValue>& values) {
+    std::vector<std::string> result;
+    for (const FieldValue& value : values) {
+        result.push_back(value.path);
+    }
+    return result;
+}
+
+}  // anonymous namespace
+
+// Test 1: Instances, wildcards and duplicates
+TEST(FieldProjectionTest, ProjectsSelectedValues) {
+    SystemMetrics metrics = sampleMetrics();
+    std::vector<FieldValue> values =
+        projectFields(metrics, compileFields("cpu.total, net.*.in, disk.C:.busy, cpu.total"));
+
+    std::vector<std::string> expected = {"cpu.total", "net.Ethernet.in", "net.Wi-Fi.in", "disk.C:.busy"};
+    EXPECT_EQ(paths(values), expected);
+    EXPECT_DOUBLE_EQ(values[0].value, 23.5);
+    EXPECT_DOUBLE_EQ(values[2].value, 250.0);
+    EXPECT_DOUBLE_EQ(values[3].value, 7.5);
+
+    // Bare groups and field wildcards select every field
+    EXPECT_EQ(paths(projectFields(metrics, compileFields("cpu"))),
+              (std::vector<std::string>{"cpu.total", "cpu.mhz"}));
+    EXPECT_EQ(paths(projectFields(metrics, compileFields("core.1.*"))),
+              (std::vector<std::string>{"core.1.usage", "core.1.mhz"}));
+
+    // Absent groups and instances produce nothing
+    EXPECT_TRUE(projectFields(metrics, compileFields("ram.percent,disk.E:.busy")).empty());
+}
+
+// Test 2: Mistakes are reported at parse time
+TEST(FieldProjectionTest, RejectsUnknownFields) {
+    EXPECT_THROW(compileFields("gpu.total"), std::invalid_argument);
+    EXPECT_THROW(compileFields("cpu.usage"), std::invalid_argument);
+    EXPECT_THROW(compileFields("net.*.bogus"), std::invalid_argument);
+    EXPECT_THROW(compileFields("disk..busy"), std::invalid_argument);
+    EXPECT_THROW(compileFields(" , "), std::invalid_argument);
+}
+
+// Test 3: Collectors follow the fields, not the metric words
+TEST(FieldProjectionTest, SelectsOnlyNeededCollectors) {
+    CliOptions options;
+    options.showMemory = true;
+    options.showNetwork = true;
+    options.fields = compileFields("cpu.total,disk.*.busy");
+    selectCollectors(options);
+
+    EXPECT_TRUE(options.showCpu);
+    EXPECT_TRUE(options.showDiskIO);
+    EXPECT_FALSE(options.showDiskSpace);
+    EXPECT_FALSE(options.showMemory);
+    EXPECT_FALSE(options.showNetwork);
+}
+
+// Test 4: Formatters write only the selected values
+TEST(FieldProjectionTest, FormattersWriteOnlySelectedFields) {
+    SystemMetrics metrics = sampleMetrics();
+    CliOptions options;
+    options.fields = compileFields("cpu.total,net.Ethernet.in");
+
+    std::string json = formatJson(metrics, options);
+    EXPECT_NE(json.find("\"cpu.total\": 23.5"), std::string::npos);
+    EXPECT_NE(json.find("\"net.Ethernet.in\": 1000"), std::string::npos);
+    EXPECT_EQ(json.find("cores"), std::string::npos);
+    EXPECT_EQ(json.find("Wi-Fi"), std::string::npos);
+
+    std::string csv = formatCsv(metrics, true, options);
+    EXPECT_EQ(csv.substr(0, csv.find('\n')), "timestamp,cpu.total,net.Ethernet.in");
+
+    EXPECT_EQ(formatText(metrics, true, options), "cpu.total=23.5  net.Ethernet.in=1000");
+}
+
+// Test 5: Module counters are registered from the schema the module declared
+TEST(FieldProjectionTest, ProjectsModuleCounters) {
+    ModuleSchema gpu;
+    gpu.name = "gpu";
+    gpu.counters = {"busy", "vram", "fan"};
+    gpu.units = {"percent", "bytes", "rpm"};
+    SlotLayout layout;
+    uint32_t first = layout.addModule(gpu);
+    ModuleFrame modules;
+    modules.schemas = layout.modules();
+    modules.values[first] = 55.0;
+    modules.values[first + 1] = 2048.0;
+    modules.validMask = 0x3ULL << first;  // No fan reading
+    SystemMetrics metrics = sampleMetrics();
+    metrics.modules = modules;
+
+    std::vector<FieldValue> values = projectFields(metrics, compileFields("module.gpu.*"));
+    EXPECT_EQ(paths(values), (std::vector<std::string>{"module.gpu.busy", "module.gpu.vram"}));
+    EXPECT_DOUBLE_EQ(values[1].value, 2048.0);
+    EXPECT_EQ(paths(projectFields(metrics, compileFields("module.gpu.busy,cpu.total"))),
+              (std::vector<std::string>{"module.gpu.busy", "cpu.total"}));
+    EXPECT_EQ(projectFields(metrics, compileFields("module")).size(), 2u);
+
+    // Modules stay loaded only when a module field is selected
+    CliOptions options;
+    options.modules = {"gpu"};
+    options.fields = compileFields("cpu.total");
+    selectCollectors(options);
+    EXPECT_TRUE(options.modules.empty());
+    options.modules = {"gpu"};
+    options.fields = compileFields("module.gpu.busy");
+    selectCollectors(options);
+    EXPECT_EQ(options.modules.size(), 1u);
+}
+
+// Test 6: Dotted instance names are kept whole unless the last part is a field
+TEST(FieldProjectionTest, KeepsDottedInstances) {
+    SystemMetrics metrics;
+    CgroupStats system{};
+    system.path = "system.slice";
+    system.cpuPercent = 12.5;
+    CgroupStats docker{};
+    docker.path = "system.slice/docker.service";
+    docker.cpuPercent = 40.0;
+    metrics.cgroups = std::vector<CgroupStats>{system, docker};
+
+    std::vector<FieldValue> values = projectFields(metrics, compileFields("cgroup.system.slice"));
+    ASSERT_FALSE(values.empty());
+    for (const FieldValue& value : values) {
+        EXPECT_EQ(value.path.rfind("cgroup.system.slice.", 0), 0u) << value.path;
+    }
+    EXPECT_EQ(values[0].path, "cgroup.system.slice.cpu");
+    EXPECT_DOUBLE_EQ(values[0].value, 12.5);
+
+    values = projectFields(metrics, compileFields("cgroup.system.slice/docker.service.cpu"));
+    ASSERT_EQ(values.size(), 1u);
+    EXPECT_EQ(values[0].path, "cgroup.system.slice/docker.service.cpu");
+    EXPECT_DOUBLE_EQ(values[0].value, 40.0);
+
+    // A wildcard instance still needs a real field after it
+    EXPECT_EQ(paths(projectFields(metrics, compileFields("cgroup.*.cpu"))),
+              (std::vector<std::string>{"cgroup.system.slice.cpu", "cgroup.system.slice/docker.service.cpu"}));
+    EXPECT_THROW(compileFields("cgroup.*.bogus"), std::invalid_argument);
+}
@@ -0,0 +1,341 @@
+#include "WinHKMonLib/FleetAggregator.h"
+#include "WinHKMonLib/PushProtocol.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: FleetAggregator and PushProtocol
+ *
+ * Tests for aggregate mode's wire format and time-bucketed statistics.
+ * Socket transport is covered by the aggregate integration test.
+ *
+ * Coverage:
+ * - Endpoint parsing
+ * - Encode/decode round trip, byte-at-a-time feeds, malformed streams
+ * - Slots past the built-in ones (module counters) are kept
+ * - Bucket alignment, latest-sample-per-host, late and future samples
+ * - NaN and infinite slot values are dropped and counted
+ * - Cluster sums, means and percentiles; SystemMetrics view
+ * - Throughput: 1,000 agents at 1 Hz decode + ingest well within one core
+ */
+
+namespace {
+
+PushSample makeSample(const std::string& host, uint64_t timestampMs, double cpuPercent) {
+    PushSample sample;
+    sample.hostId = host;
+    sample.timestampMs = timestampMs;
+    sample.values[WHK_SLOT_CPU_TOTAL_PERCENT] = cpuPercent;
+    sample.values[WHK_SLOT_MEM_TOTAL_BYTES] = 16.0 * 1024 * 1024 * 1024;
+    sample.values[WHK_SLOT_MEM_USED_BYTES] = 4.0 * 1024 * 1024 * 1024;
+    sample.values[WHK_SLOT_NET_IN_BYTES_PER_SEC] = 1000.0;
+    sample.values[WHK_SLOT_NET_OUT_BYTES_PER_SEC] = 500.0;
+    sample.validMask = (1ULL << WHK_SLOT_CPU_TOTAL_PERCENT) | (1ULL << WHK_SLOT_MEM_TOTAL_BYTES) |
+                       (1ULL << WHK_SLOT_MEM_USED_BYTES) | (1ULL << WHK_SLOT_NET_IN_BYTES_PER_SEC) |
+                       (1ULL << WHK_SLOT_NET_OUT_BYTES_PER_SEC);
+    return sample;
+}
+
+const ClusterMetricStats* findMetric(const ClusterStats& stats, const std::string& name) {
+    for (const auto& metric : stats.metrics) {
+        if (metric.name == name) {
+            return &metric;
+        }
+    }
+    return nullptr;
+}
+
+}  // anonymous namespace
+
+// Test 1: Endpoint parsing
+TEST(FleetAggregatorTest, ParsesEndpoints) {
+    Endpoint tcp = parseEndpoint("tcp:127.0.0.1:9410");
+    EXPECT_EQ(tcp.kind, Endpoint::Kind::TCP);
+    EXPECT_EQ(tcp.host, "127.0.0.1");
+    EXPECT_EQ(tcp.port, 9410);
+
+    Endpoint bare = parseEndpoint("monitor01:80");
+    EXPECT_EQ(bare.host, "monitor01");
+    EXPECT_EQ(bare.port, 80);
+
+    Endpoint local = parseEndpoint("unix:C:\\temp\\whk.sock");
+    EXPECT_EQ(local.kind, Endpoint::Kind::UNIX);
+    EXPECT_EQ(local.path, "C:\\temp\\whk.sock");
+
+    EXPECT_THROW(parseEndpoint("tcp:host"), std::invalid_argument);
+    EXPECT_THROW(parseEndpoint("tcp:host:0"), std::invalid_argument);
+    EXPECT_THROW(parseEndpoint("tcp:host:70000"), std::invalid_argument);
+    EXPECT_THROW(parseEndpoint("unix:"), std::invalid_argument);
+}
+
+// Test 2: Round trip through a stream delivered one byte at a time
+TEST(FleetAggregatorTest, ProtocolRoundTripAcrossPartialReads) {
+    std::string wire;
+    encodePushSample(makeSample("host-a", 1000, 12.5), wire);
+    encodePushSample(makeSample("host-b", 2000, 99.0), wire);
+    EXPECT_LT(wire.size(), 2u * 100u);  // Compact: 5 slots + header < 100 bytes each
+
+    PushDecoder decoder;
+    std::vector<PushSample> decoded;
+    PushSample sample;
+    for (char byte : wire) {
+        decoder.feed(&byte, 1);
+        while (decoder.next(sample)) {
+            decoded.push_back(sample);
+        }
+    }
+
+    ASSERT_EQ(decoded.size(), 2u);
+    EXPECT_EQ(decoded[0].hostId, "host-a");
+    EXPECT_EQ(decoded[0].timestampMs, 1000u);
+    EXPECT_EQ(decoded[0].validMask, makeSample("x", 0, 0).validMask);
+    EXPECT_DOUBLE_EQ(decoded[0].values[WHK_SLOT_CPU_TOTAL_PERCENT], 12.5);
+    EXPECT_EQ(decoded[1].hostId, "host-b");
+    EXPECT_DOUBLE_EQ(decoded[1].values[WHK_SLOT_NET_OUT_BYTES_PER_SEC], 500.0);
+    EXPECT_EQ(decoder.buffered(), 0u);
+}
+
+// Test 3: Malformed streams are rejected
+TEST(FleetAggregatorTest, RejectsMalformedStream) {
+    std::string wire;
+    encodePushSample(makeSample("host-a", 1000, 1.0), wire);
+
+    std::string badMagic = wire;
+    badMagic[4] = 'X';
+    PushDecoder decoder;
+    PushSample sample;
+    decoder.feed(badMagic.data(), badMagic.size());
+    EXPECT_THROW(decoder.next(sample), std::runtime_error);
+
+    std::string hugeLength("\xff\xff\xff\x7f", 4);
+    PushDecoder second;
+    second.feed(hugeLength.data(), hugeLength.size());
+    EXPECT_THROW(second.next(sample), std::runtime_error);
+
+    std::string httpProbe = "GET / HTTP/1.1\r\n\r\n";
+    PushDecoder third;
+    third.feed(httpProbe.data(), httpProbe.size());
+    EXPECT_THROW(third.next(sample), std::runtime_error);
+}
+
+// Test 4: Slots past the built-in ones (module counters) are kept by number
+TEST(FleetAggregatorTest, KeepsSlotsPastBuiltIns) {
+    // Hand-built v1 message from a sender that knows 16 slots (0 and 15 set)
+    std::string body;
+    auto put = [&body](uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            body.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    };
+    double cpu = 42.0;
+    double module = 7.0;
+    uint64_t cpuBits;
+    uint64_t moduleBits;
+    std::memcpy(&cpuBits, &cpu, 8);
+    std::memcpy(&moduleBits, &module, 8);
+    put(PUSH_MAGIC, 4);
+    put(PUSH_VERSION, 2);
+    put(16, 2);
+    put(5000, 8);
+    put((1ULL << 0) | (1ULL << 15), 8);
+    put(1, 1);
+    body.push_back('n');
+    put(cpuBits, 8);
+    put(moduleBits, 8);
+
+    std::string wire;
+    uint64_t length = body.size();
+    for (int i = 0; i < 4; i++) {
+        wire.push_back(static_cast<char>((length >> (8 * i)) & 0xFF));
+    }
+    wire += body;
+
+    PushDecoder decoder;
+    PushSample sample;
+    decoder.feed(wire.data(), wire.size());
+    ASSERT_TRUE(decoder.next(sample));
+    EXPECT_EQ(sample.validMask, (1ULL << 0) | (1ULL << 15));
+    EXPECT_DOUBLE_EQ(sample.values[0], 42.0);
+    EXPECT_DOUBLE_EQ(sample.values[15], 7.0);
+    EXPECT_EQ(sample.hostId, "n");
+
+    FleetAggregator aggregator(1000, 0);
+    aggregator.ingest(sample, 5000);
+    std::vector<ClusterStats> closed = aggregator.closeBuckets(7000);
+    ASSERT_EQ(closed.size(), 1u);
+    ASSERT_EQ(closed[0].metrics.size(), 2u);
+    EXPECT_EQ(closed[0].metrics[1].name, "slot_15");
+}
+
+// Test 5: Buckets align to multiples of the width; latest sample per host wins
+TEST(FleetAggregatorTest, AlignsBucketsAndKeepsLatestPerHost) {
+    FleetAggregator aggregator(1000, 500);
+    aggregator.ingest(makeSample("a", 10100, 10.0), 11000);
+    aggregator.ingest(makeSample("a", 10900, 30.0), 11000);   // Same bucket: replaces 10.0
+    aggregator.ingest(makeSample("b", 10500, 50.0), 11000);
+    aggregator.ingest(makeSample("a", 11200, 70.0), 11000);   // Next bucket
+
+    EXPECT_TRUE(aggregator.closeBuckets(11400).empty());   // Within grace
+    std::vector<ClusterStats> closed = aggregator.closeBuckets(11500);
+    ASSERT_EQ(closed.size(), 1u);
+    EXPECT_EQ(closed[0].bucketStartMs, 10000u);
+    EXPECT_EQ(closed[0].hostCount, 2u);
+
+    const ClusterMetricStats* cpu = findMetric(closed[0], "cpu_percent");
+    ASSERT_NE(cpu, nullptr);
+    EXPECT_EQ(cpu->hosts, 2u);
+    EXPECT_DOUBLE_EQ(cpu->sum, 80.0);
+    EXPECT_DOUBLE_EQ(cpu->mean, 40.0);
+    EXPECT_DOUBLE_EQ(cpu->min, 30.0);
+    EXPECT_DOUBLE_EQ(cpu->max, 50.0);
+    EXPECT_EQ(aggregator.openBuckets(), 1u);
+}
+
+// Test 6: Samples for closed buckets are counted as late and dropped
+TEST(FleetAggregatorTest, DropsLateSamples) {
+    FleetAggregator aggregator(1000, 0);
+    aggregator.ingest(makeSample("a", 1500, 1.0), 1500);
+    ASSERT_EQ(aggregator.closeBuckets(2000).size(), 1u);
+
+    aggregator.ingest(makeSample("b", 1999, 1.0), 2000);
+    EXPECT_EQ(aggregator.lateSamples(), 1u);
+
+    // A bucket that closed empty also rejects late samples
+    aggregator.closeBuckets(5000);
+    aggregator.ingest(makeSample("c", 3100, 1.0), 5000);
+    EXPECT_EQ(aggregator.lateSamples(), 2u);
+    EXPECT_EQ(aggregator.openBuckets(), 0u);
+
+    EXPECT_THROW(FleetAggregator(0, 0), std::invalid_argument);
+}
+
+// Test 7: Samples stamped beyond now plus one bucket are dropped, not bucketed
+TEST(FleetAggregatorTest, RejectsFutureSamples) {
+    FleetAggregator aggregator(1000, 500);
+    aggregator.ingest(makeSample("a", 10500, 1.0), 10000);   // Within one bucket ahead
+    aggregator.ingest(makeSample("b", 11000, 1.0), 10000);   // Exactly one bucket ahead
+    EXPECT_EQ(aggregator.futureSamples(), 0u);
+    EXPECT_EQ(aggregator.openBuckets(), 2u);
+
+    // A skewed or hostile agent cannot open buckets far ahead
+    for (uint64_t i = 1; i <= 1000; i++) {
+        aggregator.ingest(makeSample("skewed", 11001 + i * 1000, 1.0), 10000);
+    }
+    aggregator.ingest(makeSample("skewed", UINT64_MAX, 1.0), 10000);
+    EXPECT_EQ(aggregator.futureSamples(), 1001u);
+    EXPECT_EQ(aggregator.openBuckets(), 2u);
+    EXPECT_EQ(aggregator.lateSamples(), 0u);
+}
+
+// Test 8: NaN and infinite slots pushed by an agent are dropped and counted
+TEST(FleetAggregatorTest, DropsNonFiniteValues) {
+    PushSample hostile = makeSample("hostile", 60000, std::numeric_limits<double>::infinity());
+    hostile.values[WHK_SLOT_MEM_USED_BYTES] = std::nan("");
+    hostile.values[WHK_SLOT_NET_IN_BYTES_PER_SEC] = -std::numeric_limits<double>::infinity();
+    std::string wire;
+    encodePushSample(hostile, wire);
+    encodePushSample(makeSample("healthy", 60000, 40.0), wire);
+
+    FleetAggregator aggregator(1000, 0);
+    PushDecoder decoder;
+    PushSample decoded;
+    decoder.feed(wire.data(), wire.size());
+    while (decoder.next(decoded)) {
+        aggregator.ingest(decoded, 60500);
+    }
+    EXPECT_EQ(aggregator.invalidValues(), 3u);
+
+    std::vector<ClusterStats> closed = aggregator.closeBuckets(61000);
+    ASSERT_EQ(closed.size(), 1u);
+    EXPECT_EQ(closed[0].hostCount, 2u);
+
+    // Only the healthy host contributes to the poisoned slots
+    const ClusterMetricStats* cpu = findMetric(closed[0], "cpu_percent");
+    ASSERT_NE(cpu, nullptr);
+    EXPECT_EQ(cpu->hosts, 1u);
+    EXPECT_DOUBLE_EQ(cpu->sum, 40.0);
+    EXPECT_DOUBLE_EQ(cpu->p99, cpu->max);
+    const ClusterMetricStats* netIn = findMetric(closed[0], "net_in_bytes_per_sec");
+    ASSERT_NE(netIn, nullptr);
+    EXPECT_EQ(netIn->hosts, 1u);
+
+    // The hostile host's finite slots still count
+    const ClusterMetricStats* total = findMetric(closed[0], "ram_total_bytes");
+    ASSERT_NE(total, nullptr);
+    EXPECT_EQ(total->hosts, 2u);
+}
+
+// Test 9: Percentiles over many hosts and the SystemMetrics view
+TEST(FleetAggregatorTest, ComputesClusterPercentilesAndView) {
+    FleetAggregator aggregator(1000, 0);
+    for (int host = 1; host <= 100; host++) {
+        aggregator.ingest(makeSample("host" + std::to_string(host), 60000, static_cast<double>(host)), 60500);
+    }
+    std::vector<ClusterStats> closed = aggregator.closeBuckets(61000);
+    ASSERT_EQ(closed.size(), 1u);
+
+    const ClusterMetricStats* cpu = findMetric(closed[0], "cpu_percent");
+    ASSERT_NE(cpu, nullptr);
+    EXPECT_NEAR(cpu->p50, 50.0, 0.5);
+    EXPECT_NEAR(cpu->p90, 90.0, 0.9);
+    EXPECT_NEAR(cpu->p99, 99.0, 1.0);
+    EXPECT_DOUBLE_EQ(cpu->sum, 5050.0);
+
+    SystemMetrics view = FleetAggregator::toSystemMetrics(closed[0]);
+    ASSERT_TRUE(view.cpu.has_value());
+    EXPECT_DOUBLE_EQ(view.cpu->totalUsagePercent, 50.5);
+    ASSERT_TRUE(view.memory.has_value());
+    EXPECT_EQ(view.memory->totalPhysicalBytes, 100ULL * 16 * 1024 * 1024 * 1024);
+    EXPECT_DOUBLE_EQ(view.memory->usagePercent, 25.0);
+    ASSERT_TRUE(view.network.has_value());
+    ASSERT_EQ(view.network->size(), 1u);
+    EXPECT_EQ((*view.network)[0].name, "cluster");
+    EXPECT_EQ((*view.network)[0].inBytesPerSec, 100000u);
+    EXPECT_FALSE(view.disks.has_value());
+    ASSERT_TRUE(view.cluster.has_value());
+    EXPECT_EQ(view.cluster->hostCount, 100u);
+}
+
+// Test 10: 1,000 agents x 60 buckets decoded and aggregated in well under a minute of CPU
+TEST(FleetAggregatorTest, HandlesThousandAgentsAtOneHertz) {
+    const int agents = 1000;
+    const int seconds = 60;
+    FleetAggregator aggregator(1000, 1000);
+    PushDecoder decoder;
+    PushSample decoded;
+    std::string wire;
+    size_t buckets = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int second = 0; second < seconds; second++) {
+        uint64_t nowMs = 1000000 + static_cast<uint64_t>(second) * 1000;
+        wire.clear();
+        for (int agent = 0; agent < agents; agent++) {
+            encodePushSample(makeSample("agent" + std::to_string(agent), nowMs + agent % 900,
+                                        static_cast<double>(agent % 100)), wire);
+        }
+        decoder.feed(wire.data(), wire.size());
+        while (decoder.next(decoded)) {
+            aggregator.ingest(decoded, nowMs);
+        }
+        for (const ClusterStats& stats : aggregator.closeBuckets(nowMs + 999)) {
+            EXPECT_EQ(stats.hostCount, static_cast<uint32_t>(agents));
+            buckets++;
+        }
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_GE(buckets, static_cast<size_t>(seconds - 2));
+    EXPECT_EQ(aggregator.lateSamples(), 0u);
+    // 60 s of fleet traffic must cost a small fraction of one core (generous for debug builds)
+    EXPECT_LT(elapsed, 6.0) << "Aggregation took " << elapsed << " s for " << seconds << " s of traffic";
+    RecordProperty("secondsPerMinuteOfTraffic", std::to_string(elapsed));
+}
@@ -0,0 +1,170 @@
+#include "WinHKMonLib/Gzip.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: Gzip
+ *
+ * Tests for the gzip encoder used by the OTLP exporter. Output is decoded
+ * by a minimal fixed-Huffman inflater below, so the tests check the bit
+ * stream itself rather than only its size.
+ *
+ * Coverage:
+ * - CRC-32 check value
+ * - Header and trailer layout
+ * - Round trips of empty, short, repetitive and incompressible input
+ * - Repetitive metric JSON compresses well
+ */
+
+namespace {
+
+class BitReader {
+public:
+    explicit BitReader(const std::string& data, size_t offset) : data_(data), position_(offset), bit_(0) {}
+
+    uint32_t bits(unsigned count) {
+        uint32_t value = 0;
+        for (unsigned i = 0; i < count; i++) {
+            if (position_ >= data_.size()) {
+                throw std::runtime_error("Truncated deflate stream");
+            }
+            value |= static_cast<uint32_t>((static_cast<unsigned char>(data_[position_]) >> bit_) & 1) << i;
+            if (++bit_ == 8) {
+                bit_ = 0;
+                position_++;
+            }
+        }
+        return value;
+    }
+
+    // Huffman codes are stored MSB-first
+    uint32_t code(unsigned count) {
+        uint32_t value = 0;
+        for (unsigned i = 0; i < count; i++) {
+            value = (value << 1) | bits(1);
+        }
+        return value;
+    }
+
+private:
+    const std::string& data_;
+    size_t position_;
+    unsigned bit_;
+};
+
+unsigned readSymbol(BitReader& reader) {
+    uint32_t code = reader.code(7);
+    if (code <= 0x17) {
+        return 256 + code;
+    }
+    code = (code << 1) | reader.code(1);
+    if (code >= 0x30 && code <= 0xBF) {
+        return code - 0x30;
+    }
+    if (code >= 0xC0 && code <= 0xC7) {
+        return 280 + (code - 0xC0);
+    }
+    code = (code << 1) | reader.code(1);
+    return 144 + (code - 0x190);
+}
+
+// Decode a gzip member holding one fixed-Huffman block
+std::string gunzip(const std::string& gz) {
+    static const uint16_t LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27,
+                                             31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    static const uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                             2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    static const uint16_t DISTANCE_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129,
+                                               193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097,
+                                               6145, 8193, 12289, 16385, 24577};
+    static const uint8_t DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+                                               6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+    BitReader reader(gz, 10);
+    EXPECT_EQ(reader.bits(1), 1u);  // BFINAL
+    EXPECT_EQ(reader.bits(2), 1u);  // Fixed Huffman
+    std::string out;
+    for (;;) {
+        unsigned symbol = readSymbol(reader);
+        if (symbol < 256) {
+            out.push_back(static_cast<char>(symbol));
+        } else if (symbol == 256) {
+            return out;
+        } else {
+            unsigned index = symbol - 257;
+            size_t length = LENGTH_BASE[index] + reader.bits(LENGTH_EXTRA[index]);
+            unsigned distanceCode = reader.code(5);
+            size_t distance = DISTANCE_BASE[distanceCode] + reader.bits(DISTANCE_EXTRA[distanceCode]);
+            if (distance > out.size()) {
+                throw std::runtime_error("Distance before start of output");
+            }
+            for (size_t i = 0; i < length; i++) {
+                out.push_back(out[out.size() - distance]);
+            }
+        }
+    }
+}
+
+uint32_t readLittleEndian(const std::string& data, size_t offset) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; i--) {
+        value = (value << 8) | static_cast<unsigned char>(data[offset + static_cast<size_t>(i)]);
+    }
+    return value;
+}
+
+}  // anonymous namespace
+
+// Test 1: Standard CRC-32 check value, and incremental use
+TEST(GzipTest, ComputesCrc32) {
+    EXPECT_EQ(crc32("123456789", 9), 0xCBF43926u);
+    EXPECT_EQ(crc32("", 0), 0u);
+    EXPECT_EQ(crc32("6789", 4, crc32("12345", 5)), 0xCBF43926u);
+}
+
+// Test 2: Header magic, and a trailer with the CRC and size of the input
+TEST(GzipTest, WritesHeaderAndTrailer) {
+    std::string input = "hello, hello, hello";
+    std::string gz = gzipCompress(input);
+    ASSERT_GE(gz.size(), 18u);
+    EXPECT_EQ(static_cast<unsigned char>(gz[0]), 0x1Fu);
+    EXPECT_EQ(static_cast<unsigned char>(gz[1]), 0x8Bu);
+    EXPECT_EQ(gz[2], 8);  // Deflate
+    EXPECT_EQ(readLittleEndian(gz, gz.size() - 8), crc32(input.data(), input.size()));
+    EXPECT_EQ(readLittleEndian(gz, gz.size() - 4), input.size());
+}
+
+// Test 3: Round trips, including matches of every length class and long distances
+TEST(GzipTest, RoundTrips) {
+    std::string binary;
+    uint32_t state = 12345;
+    for (int i = 0; i < 70000; i++) {
+        state = state * 1103515245u + 12345u;
+        binary.push_back(static_cast<char>(state >> 24));
+    }
+    std::string runs(1000, 'a');
+    runs += std::string(300, 'b') + "abc" + std::string(5, 'a');
+
+    for (const std::string& input : {std::string(), std::string("x"), std::string("abcabcabcabc"), runs,
+                                     binary, binary + binary.substr(0, 40000)}) {
+        EXPECT_EQ(gunzip(gzipCompress(input)), input) << "input size " << input.size();
+    }
+}
+
+// Test 4: Metric JSON repeats its keys on every point and shrinks several times
+TEST(GzipTest, CompressesRepetitiveJson) {
+    std::string json = "[";
+    for (int core = 0; core < 192; core++) {
+        json += "{\"attributes\":[{\"key\":\"cpu.logical_number\",\"value\":{\"intValue\":\"" +
+                std::to_string(core) + "\"}}],\"timeUnixNano\":\"1700000000000000000\",\"asDouble\":0." +
+                std::to_string(core * 37 % 100) + "},";
+    }
+    json += "]";
+    std::string gz = gzipCompress(json);
+    EXPECT_EQ(gunzip(gz), json);
+    EXPECT_LT(gz.size() * 5, json.size());
+}
@@ -0,0 +1,93 @@
+#include "WinHKMonLib/HighRateTimer.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <stdexcept>
+
+using namespace WinHKMon;
+using namespace std::chrono_literals;
+
+/**
+ * Test Suite: HighRateTimer
+ *
+ * Tests for high-rate mode timing (--high-rate). TickPacer is driven with
+ * simulated clock readings; DeadlineTimer sleeps for real.
+ *
+ * Coverage:
+ * - Period validation
+ * - Deadlines on a fixed grid regardless of lateness and tick run time
+ * - Overrun deadlines are skipped and counted as missed
+ * - Lateness statistics
+ * - DeadlineTimer never wakes before its deadline; past deadlines return at once
+ */
+
+namespace {
+
+const TickPacer::Clock::time_point START{};
+
+}  // anonymous namespace
+
+// Test 1: Period must be positive
+TEST(HighRateTimerTest, ValidatesPeriod) {
+    EXPECT_THROW(TickPacer(0ms, START), std::invalid_argument);
+    EXPECT_THROW(TickPacer(-1ms, START), std::invalid_argument);
+    EXPECT_EQ(TickPacer(1ms, START).deadline(), START + 1ms);
+}
+
+// Test 2: Lateness and run time do not shift later deadlines
+TEST(HighRateTimerTest, KeepsDeadlinesOnGrid) {
+    TickPacer pacer(1ms, START);
+    for (int i = 1; i <= 1000; i++) {
+        auto deadline = pacer.deadline();
+        EXPECT_EQ(deadline, START + i * 1ms);
+        EXPECT_EQ(pacer.complete(deadline + 50us, deadline + 300us), 0u);
+    }
+    EXPECT_EQ(pacer.deadline(), START + 1001ms);
+}
+
+// Test 3: A tick running past later deadlines skips them
+TEST(HighRateTimerTest, SkipsOverrunDeadlines) {
+    TickPacer pacer(1ms, START);
+    // Tick for 1 ms ends at 3.5 ms: deadlines 2 ms and 3 ms are gone
+    EXPECT_EQ(pacer.complete(START + 1ms, START + 3500us), 2u);
+    EXPECT_EQ(pacer.deadline(), START + 4ms);
+    // Ending exactly on a deadline skips it too
+    EXPECT_EQ(pacer.complete(START + 4ms, START + 5ms), 1u);
+    EXPECT_EQ(pacer.deadline(), START + 6ms);
+    EXPECT_EQ(pacer.stats().missed, 3u);
+}
+
+// Test 4: Lateness statistics in microseconds; early wake-ups count as on time
+TEST(HighRateTimerTest, ReportsLateness) {
+    TickPacer pacer(10ms, START);
+    for (int i = 0; i < 99; i++) {
+        auto deadline = pacer.deadline();
+        pacer.complete(deadline + 20us, deadline + 100us);
+    }
+    auto deadline = pacer.deadline();
+    pacer.complete(deadline + 2000us, deadline + 2100us);
+    deadline = pacer.deadline();
+    pacer.complete(deadline - 5us, deadline);
+
+    JitterStats stats = pacer.stats();
+    EXPECT_EQ(stats.ticks, 101u);
+    EXPECT_EQ(stats.missed, 0u);
+    EXPECT_NEAR(stats.p50Us, 20.0, 0.5);
+    EXPECT_NEAR(stats.maxUs, 2000.0, 0.01);
+    EXPECT_NEAR(stats.meanUs, (99 * 20.0 + 2000.0) / 101.0, 0.01);
+    EXPECT_GE(stats.p99Us, stats.p50Us);
+}
+
+// Test 5: Real sleeps end at or after their deadline
+TEST(HighRateTimerTest, DeadlineTimerSleepsUntilDeadline) {
+    DeadlineTimer timer;
+    auto start = DeadlineTimer::Clock::now();
+    for (int i = 1; i <= 20; i++) {
+        auto deadline = start + i * 1ms;
+        EXPECT_GE(timer.sleepUntil(deadline), deadline);
+    }
+
+    // A deadline in the past does not sleep
+    auto before = DeadlineTimer::Clock::now();
+    auto woke = timer.sleepUntil(before - 1s);
+    EXPECT_LT(woke - before, 100ms);
+}
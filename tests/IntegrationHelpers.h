@@ -0,0 +1,122 @@
+#pragma once
+
+#include <windows.h>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @file IntegrationHelpers.h
+ * @brief Process and output helpers shared by the integration tests
+ */
+
+inline std::string tempFilePath(const std::string& name) {
+    char tempDir[MAX_PATH];
+    GetTempPathA(MAX_PATH, tempDir);
+    return std::string(tempDir) + name;
+}
+
+/**
+ * @brief Child process with stdout captured to a temp file
+ */
+class ChildProcess {
+public:
+    ChildProcess(const std::string& exe, const std::string& args, const std::string& outputPath)
+        : outputPath_(outputPath) {
+        SECURITY_ATTRIBUTES sa{sizeof(sa), nullptr, TRUE};
+        HANDLE out = CreateFileA(outputPath.c_str(), GENERIC_WRITE, FILE_SHARE_READ, &sa,
+                                 CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY, nullptr);
+        STARTUPINFOA si{};
+        si.cb = sizeof(si);
+        si.dwFlags = STARTF_USESTDHANDLES;
+        si.hStdOutput = out;
+        si.hStdError = out;
+
+        std::string cmd = "\"" + exe + "\" " + args;
+        started_ = CreateProcessA(exe.c_str(), &cmd[0], nullptr, nullptr, TRUE,
+                                  CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi_) != FALSE;
+        CloseHandle(out);
+    }
+
+    ChildProcess(const ChildProcess&) = delete;
+    ChildProcess& operator=(const ChildProcess&) = delete;
+
+    ~ChildProcess() {
+        if (started_) {
+            TerminateProcess(pi_.hProcess, 0);
+            WaitForSingleObject(pi_.hProcess, 5000);
+            CloseHandle(pi_.hThread);
+            CloseHandle(pi_.hProcess);
+        }
+        DeleteFileA(outputPath_.c_str());
+    }
+
+    bool started() const { return started_; }
+
+    void waitForExit(DWORD timeoutMs) { WaitForSingleObject(pi_.hProcess, timeoutMs); }
+
+    bool running() const { return started_ && WaitForSingleObject(pi_.hProcess, 0) == WAIT_TIMEOUT; }
+
+    void terminate() {
+        TerminateProcess(pi_.hProcess, 0);
+        WaitForSingleObject(pi_.hProcess, 5000);
+    }
+
+    /// CPU time used so far, in seconds
+    double cpuSeconds() const {
+        FILETIME creation, exitTime, kernel, user;
+        GetProcessTimes(pi_.hProcess, &creation, &exitTime, &kernel, &user);
+        auto toSeconds = [](const FILETIME& ft) {
+            return static_cast<double>((static_cast<uint64_t>(ft.dwHighDateTime) << 32) |
+                                       ft.dwLowDateTime) / 1.0e7;
+        };
+        return toSeconds(kernel) + toSeconds(user);
+    }
+
+    std::string output() const {
+        std::ifstream file(outputPath_);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+
+private:
+    std::string outputPath_;
+    PROCESS_INFORMATION pi_{};
+    bool started_ = false;
+};
+
+/**
+ * @brief Split concatenated continuous-mode JSON output into samples
+ */
+inline std::vector<std::string> splitSamples(const std::string& output) {
+    std::vector<std::string> samples;
+    const std::string marker = "\"schemaVersion\"";
+    size_t pos = output.find(marker);
+    while (pos != std::string::npos) {
+        size_t next = output.find(marker, pos + marker.size());
+        samples.push_back(output.substr(pos, next == std::string::npos ? std::string::npos : next - pos));
+        pos = next;
+    }
+    return samples;
+}
+
+/**
+ * @brief Read the number following "key": after an optional anchor string
+ */
+inline bool extractNumber(const std::string& sample, const std::string& anchor,
+                   const std::string& key, double& value) {
+    size_t start = anchor.empty() ? 0 : sample.find(anchor);
+    if (start == std::string::npos) {
+        return false;
+    }
+    size_t pos = sample.find("\"" + key + "\": ", start);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    value = std::atof(sample.c_str() + pos + key.size() + 4);
+    return true;
+}
@@ -0,0 +1,253 @@
+// Winsock 2 before windows.h (pulled in by IntegrationHelpers.h), for the IP Helper API
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include "IntegrationHelpers.h"
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <iphlpapi.h>
+#include <netioapi.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Test Suite: LoadAccuracy (integration)
+ *
+ * Runs WinHKMon.exe against known workloads from WinHKMonLoad.exe and checks
+ * the reported rates against the achieved load, at several sampling intervals.
+ * Also measures WinHKMon's own CPU overhead while the host is under load.
+ *
+ * Coverage:
+ * - CPU usage with N threads at 50% duty cycle
+ * - Disk write rate (_Total) with sequential unbuffered writes
+ * - Disk write total (_Total) grows by the bytes written over the window
+ * - Network send rate over loopback TCP to a WinHKMonLoad --net-sink on
+ *   127.0.0.1, measured on the loopback adapter named with --interface.
+ *   A remote sink can be used instead:
+ *     WINHKMON_LOAD_NET_TARGET=host:port      (run "WinHKMonLoad --net-sink <port>" there)
+ *     WINHKMON_LOAD_NET_INTERFACE=<alias>     (local interface that carries the traffic)
+ * - WinHKMon CPU overhead under load (NFR-1.1)
+ *
+ * @note Executable paths are injected by CMake (WINHKMON_EXE_PATH, WINHKMON_LOAD_EXE_PATH)
+ */
+
+// Loopback interface lookup
+#pragma comment(lib, "iphlpapi.lib")
+
+namespace {
+
+constexpr double CPU_DUTY_PERCENT = 50.0;
+constexpr double DISK_WRITE_MBPS = 20.0;
+constexpr double NET_MBPS = 50.0;
+constexpr double WARMUP_SECONDS = 3.0;
+
+double median(std::vector<double> values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+/**
+ * @brief Parse WinHKMonLoad's key=value summary
+ */
+std::map<std::string, double> parseLoadSummary(const std::string& output) {
+    std::map<std::string, double> summary;
+    std::istringstream lines(output);
+    std::string line;
+    while (std::getline(lines, line)) {
+        size_t eq = line.find('=');
+        if (eq != std::string::npos) {
+            summary[line.substr(0, eq)] = std::atof(line.c_str() + eq + 1);
+        }
+    }
+    return summary;
+}
+
+/**
+ * @brief Alias of the software loopback interface ("Loopback Pseudo-Interface 1" on English systems)
+ */
+std::string loopbackAlias() {
+    PMIB_IF_TABLE2 table = nullptr;
+    if (GetIfTable2(&table) != NO_ERROR) {
+        return "";
+    }
+    std::string alias;
+    for (ULONG i = 0; i < table->NumEntries && alias.empty(); i++) {
+        if (table->Table[i].Type == IF_TYPE_SOFTWARE_LOOPBACK) {
+            char buffer[IF_MAX_STRING_SIZE + 1];
+            int length = WideCharToMultiByte(CP_UTF8, 0, table->Table[i].Alias, -1, buffer,
+                                             static_cast<int>(sizeof(buffer)), nullptr, nullptr);
+            alias.assign(buffer, length > 0 ? static_cast<size_t>(length - 1) : 0);
+        }
+    }
+    FreeMibTable(table);
+    return alias;
+}
+
+unsigned logicalCpuCount() {
+    SYSTEM_INFO sysInfo;
+    GetSystemInfo(&sysInfo);
+    return sysInfo.dwNumberOfProcessors;
+}
+
+/**
+ * @brief Run load + monitor at one interval and check reported rates
+ */
+void checkRatesAtInterval(double intervalSeconds) {
+    const unsigned cpus = logicalCpuCount();
+    const int loadThreads = static_cast<int>(std::max(1u, cpus / 2));
+    const double windowSeconds = std::max(8.0, intervalSeconds * 6.0);
+    const double loadSeconds = WARMUP_SECONDS + windowSeconds + 4.0;
+
+    std::ostringstream loadArgs;
+    loadArgs << "--cpu-threads " << loadThreads << " --cpu-duty " << CPU_DUTY_PERCENT
+             << " --disk-write " << DISK_WRITE_MBPS << " --duration " << loadSeconds;
+    ChildProcess load(WINHKMON_LOAD_EXE_PATH, loadArgs.str(), tempFilePath("WinHKMonLoad_out.txt"));
+    ASSERT_TRUE(load.started());
+    Sleep(static_cast<DWORD>(WARMUP_SECONDS * 1000));
+
+    std::ostringstream monArgs;
+    monArgs << "CPU IO -c -i " << intervalSeconds << " --format json";
+    ChildProcess monitor(WINHKMON_EXE_PATH, monArgs.str(), tempFilePath("WinHKMon_load_out.json"));
+    ASSERT_TRUE(monitor.started());
+    Sleep(static_cast<DWORD>(windowSeconds * 1000));
+    double monitorCpuSeconds = monitor.cpuSeconds();
+    monitor.terminate();
+
+    load.waitForExit(static_cast<DWORD>((loadSeconds + 10.0) * 1000));
+    std::map<std::string, double> achieved = parseLoadSummary(load.output());
+    ASSERT_TRUE(achieved.count("disk_write_bytes_per_sec")) << load.output();
+
+    std::vector<std::string> samples = splitSamples(monitor.output());
+    ASSERT_GE(samples.size(), 3u) << "Too few samples at interval " << intervalSeconds;
+
+    // Skip the first sample (PDH baseline)
+    std::vector<double> cpuValues;
+    std::vector<double> diskWriteValues;
+    double firstWriteTotal = 0.0;
+    double lastWriteTotal = 0.0;
+    double totalSeconds = 0.0;   ///< Time covered by samples after the first
+    for (size_t i = 1; i < samples.size(); i++) {
+        double value = 0.0;
+        if (extractNumber(samples[i], "", "totalUsagePercent", value)) {
+            cpuValues.push_back(value);
+        }
+        if (extractNumber(samples[i], "\"deviceName\": \"_Total\"", "bytesWrittenPerSec", value)) {
+            diskWriteValues.push_back(value);
+        }
+        extractNumber(samples[i], "\"deviceName\": \"_Total\"", "totalBytesWritten", lastWriteTotal);
+        if (i == 1) {
+            firstWriteTotal = lastWriteTotal;
+        } else if (extractNumber(samples[i], "", "intervalSeconds", value)) {
+            totalSeconds += value;
+        }
+    }
+
+    // CPU: load contributes threads * duty / cpus; allow for background activity
+    double expectedCpu = loadThreads * CPU_DUTY_PERCENT / cpus;
+    double reportedCpu = median(cpuValues);
+    EXPECT_GE(reportedCpu, expectedCpu - 5.0) << "interval " << intervalSeconds;
+    EXPECT_LE(reportedCpu, expectedCpu + 15.0) << "interval " << intervalSeconds;
+
+    // Disk: within 25% of what the generator actually wrote
+    double expectedDisk = achieved["disk_write_bytes_per_sec"];
+    double reportedDisk = median(diskWriteValues);
+    EXPECT_NEAR(reportedDisk, expectedDisk, expectedDisk * 0.25) << "interval " << intervalSeconds;
+    
+    // Disk total: grows by what the generator wrote between the first and last sample
+    double expectedGrowth = expectedDisk * totalSeconds;
+    double reportedGrowth = lastWriteTotal - firstWriteTotal;
+    EXPECT_GT(totalSeconds, 0.0) << "interval " << intervalSeconds;
+    EXPECT_NEAR(reportedGrowth, expectedGrowth, expectedGrowth * 0.25) << "interval " << intervalSeconds;
+
+    // WinHKMon overhead under load (NFR-1.1: < 1% system-wide)
+    double overheadPercent = monitorCpuSeconds / windowSeconds * 100.0 / cpus;
+    ::testing::Test::RecordProperty("overheadPercentSystem_i" + std::to_string(intervalSeconds),
+                                    std::to_string(overheadPercent));
+    EXPECT_LT(overheadPercent, 1.0) << "interval " << intervalSeconds;
+}
+
+}  // anonymous namespace
+
+// Test 1: CPU and disk rates at a fast interval
+TEST(LoadAccuracyTest, CpuAndDiskRatesAtHalfSecond) {
+    checkRatesAtInterval(0.5);
+}
+
+// Test 2: CPU and disk rates at the default interval
+TEST(LoadAccuracyTest, CpuAndDiskRatesAtOneSecond) {
+    checkRatesAtInterval(1.0);
+}
+
+// Test 3: CPU and disk rates at a slow interval
+TEST(LoadAccuracyTest, CpuAndDiskRatesAtTwoSeconds) {
+    checkRatesAtInterval(2.0);
+}
+
+// Test 4: Network send rate over loopback TCP (or a configured remote sink)
+TEST(LoadAccuracyTest, NetworkRatesOverLoopback) {
+    const double windowSeconds = 8.0;
+    const double loadSeconds = WARMUP_SECONDS + windowSeconds + 4.0;
+    const char* remoteTarget = std::getenv("WINHKMON_LOAD_NET_TARGET");
+    const char* remoteIface = std::getenv("WINHKMON_LOAD_NET_INTERFACE");
+    bool remote = remoteTarget != nullptr && remoteIface != nullptr;
+
+    // Local run: a separate WinHKMonLoad process is the TCP sink on 127.0.0.1
+    std::unique_ptr<ChildProcess> sink;
+    std::string target;
+    std::string iface;
+    if (remote) {
+        target = remoteTarget;
+        iface = remoteIface;
+    } else {
+        iface = loopbackAlias();
+        ASSERT_FALSE(iface.empty()) << "No loopback interface found";
+        int port = 40000 + static_cast<int>(GetCurrentProcessId() % 20000);
+        target = "127.0.0.1:" + std::to_string(port);
+        sink = std::make_unique<ChildProcess>(WINHKMON_LOAD_EXE_PATH, "--net-sink " + std::to_string(port),
+                                              tempFilePath("WinHKMonLoad_sink.txt"));
+        ASSERT_TRUE(sink->started());
+        Sleep(500);  // Let the sink bind before the sender connects
+    }
+
+    std::ostringstream loadArgs;
+    loadArgs << "--net " << NET_MBPS << " --net-target " << target << " --duration " << loadSeconds;
+    ChildProcess load(WINHKMON_LOAD_EXE_PATH, loadArgs.str(), tempFilePath("WinHKMonLoad_net.txt"));
+    ASSERT_TRUE(load.started());
+    Sleep(static_cast<DWORD>(WARMUP_SECONDS * 1000));
+
+    std::string monArgs = "NET --interface \"" + iface + "\" -c -i 1 --format json";
+    ChildProcess monitor(WINHKMON_EXE_PATH, monArgs, tempFilePath("WinHKMon_net.json"));
+    ASSERT_TRUE(monitor.started());
+    Sleep(static_cast<DWORD>(windowSeconds * 1000));
+    monitor.terminate();
+
+    load.waitForExit(20000);
+    sink.reset();
+    std::map<std::string, double> achieved = parseLoadSummary(load.output());
+    ASSERT_TRUE(achieved.count("net_send_bytes_per_sec")) << load.output();
+
+    std::vector<std::string> samples = splitSamples(monitor.output());
+    ASSERT_GE(samples.size(), 3u) << monitor.output();
+
+    std::vector<double> outValues;
+    for (size_t i = 1; i < samples.size(); i++) {
+        double value = 0.0;
+        if (extractNumber(samples[i], "", "outBytesPerSec", value)) {
+            outValues.push_back(value);
+        }
+    }
+
+    // Rates must be non-zero and within 20% (TCP/IP headers add a few percent)
+    double expected = achieved["net_send_bytes_per_sec"];
+    double reported = median(outValues);
+    EXPECT_GT(reported, 0.0) << "interface " << iface;
+    EXPECT_NEAR(reported, expected, expected * 0.2) << "interface " << iface;
+}
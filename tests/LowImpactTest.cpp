@@ -0,0 +1,51 @@
+#include "WinHKMonLib/LowImpact.h"
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <stdexcept>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: LowImpact
+ *
+ * Tests for low-impact mode helpers. enterLowImpactMode() is not called here
+ * because it would lower the priority of the whole test process. The working
+ * set lock is undone at the end of its test for the same reason.
+ *
+ * Coverage:
+ * - CPU list to affinity mask conversion
+ * - Rejection of CPUs outside the mask
+ * - Working set locking
+ */
+
+// Test 1: CPU lists map to one bit per CPU
+TEST(LowImpactTest, BuildsAffinityMask) {
+    EXPECT_EQ(cpuListToAffinityMask({}), 0u);
+    EXPECT_EQ(cpuListToAffinityMask({0}), 0x1u);
+    EXPECT_EQ(cpuListToAffinityMask({0, 1, 4}), 0x13u);
+    EXPECT_EQ(cpuListToAffinityMask({63}), 0x8000000000000000ULL);
+}
+
+// Test 2: CPUs beyond one processor group are rejected
+TEST(LowImpactTest, RejectsCpuOutsideMask) {
+    EXPECT_THROW(cpuListToAffinityMask({64}), std::invalid_argument);
+}
+
+// Test 3: Locking the working set succeeds for a normal user process
+TEST(LowImpactTest, LocksWorkingSet) {
+    SIZE_T minimum = 0;
+    SIZE_T maximum = 0;
+    DWORD flags = 0;
+    ASSERT_TRUE(GetProcessWorkingSetSizeEx(GetCurrentProcess(), &minimum, &maximum, &flags));
+
+    LowImpactStatus status;
+    bool locked = lockWorkingSet(1024 * 1024, status);
+
+    EXPECT_TRUE(locked);
+    EXPECT_TRUE(status.workingSetLocked);
+    EXPECT_TRUE(status.warnings.empty());
+
+    // Drop the hard minimum so the rest of the test process is not pinned
+    EXPECT_TRUE(SetProcessWorkingSetSizeEx(GetCurrentProcess(), minimum, maximum,
+                                           QUOTA_LIMITS_HARDWS_MIN_DISABLE | QUOTA_LIMITS_HARDWS_MAX_DISABLE));
+}
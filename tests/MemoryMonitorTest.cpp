@@ -1,7 +1,12 @@
 #include "WinHKMonLib/MemoryMonitor.h"
+#include "TempTree.h"
 #include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <string>
 
 using namespace WinHKMon;
+namespace fs = std::filesystem;
 
 /**
  * Test Suite: MemoryMonitor
@@ -15,6 +20,8 @@ using namespace WinHKMon;
  * - Invariant validation (total >= available)
  * - Range validation (percentages 0-100)
  * - Error handling (API failure simulation - difficult on real systems)
+ * - Huge pages and THP from a fixture procfs/sysfs tree (Linux sources)
+ * - Huge page pools that grow after the monitor starts
  */
 
 // Test 1: getCurrentStats() returns valid data
@@ -154,3 +161,121 @@ TEST(MemoryMonitorTest, OptionalFieldsHandled) {
     }
 }
 
+
+namespace {
+
+std::string vmstat(uint64_t faults, uint64_t fallbacks, uint64_t stalls) {
+    return "nr_free_pages 2031616\nnr_anon_pages 524288\n"
+           "compact_stall " + std::to_string(stalls) + "\ncompact_fail 3\ncompact_success 9\n"
+           "thp_fault_alloc " + std::to_string(faults) + "\n"
+           "thp_fault_fallback " + std::to_string(fallbacks) + "\n"
+           "thp_fault_fallback_charge 0\nthp_collapse_alloc 12\n";
+}
+
+// A /proc with meminfo and vmstat, and the hugepages sysfs directory
+class MemoryMonitorProcTest : public TempTreeTest {
+protected:
+    MemoryMonitorProcTest()
+        : TempTreeTest("mem") {
+    }
+
+    void SetUp() override {
+        TempTreeTest::SetUp();
+        fs::create_directories(root_ / "proc");
+        writeFile(root_ / "proc" / "meminfo",
+                  "MemTotal:       16777216 kB\n"
+                  "MemFree:         4194304 kB\n"
+                  "MemAvailable:    8388608 kB\n"
+                  "SwapTotal:       2097152 kB\n"
+                  "SwapFree:        1048576 kB\n"
+                  "AnonHugePages:    614400 kB\n"
+                  "ShmemHugePages:        0 kB\n"
+                  "HugePages_Total:     512\n"
+                  "HugePages_Free:      128\n"
+                  "HugePages_Rsvd:       16\n"
+                  "HugePages_Surp:        2\n"
+                  "Hugepagesize:       2048 kB\n"
+                  "Hugetlb:         5242880 kB\n");
+        writeFile(root_ / "proc" / "vmstat", vmstat(1000, 50, 7));
+
+        writePool("hugepages-2048kB", 512, 128);
+        writePool("hugepages-1048576kB", 4, 1);
+        writePool("hugepages-32768kB", 0, 0);
+    }
+
+    void writePool(const std::string& name, uint64_t total, uint64_t free) {
+        fs::path dir = root_ / "hugepages" / name;
+        fs::create_directories(dir);
+        writeFile(dir / "nr_hugepages", std::to_string(total) + "\n");
+        writeFile(dir / "free_hugepages", std::to_string(free) + "\n");
+        writeFile(dir / "resv_hugepages", "0\n");
+        writeFile(dir / "surplus_hugepages", "0\n");
+    }
+};
+
+}  // anonymous namespace
+
+// Test 11: Huge page pools and THP usage from meminfo, other sizes from sysfs
+TEST_F(MemoryMonitorProcTest, ReadsHugePagePools) {
+    MemoryMonitor monitor((root_ / "proc").string(), (root_ / "hugepages").string());
+    MemoryStats stats = monitor.getCurrentStats();
+    ASSERT_TRUE(stats.hugePages.has_value());
+    const HugePageStats& huge = *stats.hugePages;
+    EXPECT_EQ(huge.anonHugeBytes, 614400ULL * 1024);
+
+    // Default size first; the empty 32 MB pool is not listed
+    ASSERT_EQ(huge.pools.size(), 2u);
+    EXPECT_EQ(huge.pools[0].pageBytes, 2048ULL * 1024);
+    EXPECT_EQ(huge.pools[0].totalPages, 512u);
+    EXPECT_EQ(huge.pools[0].freePages, 128u);
+    EXPECT_EQ(huge.pools[0].reservedPages, 16u);
+    EXPECT_EQ(huge.pools[0].surplusPages, 2u);
+    EXPECT_EQ(huge.pools[1].pageBytes, 1024ULL * 1024 * 1024);
+    EXPECT_EQ(huge.pools[1].totalPages, 4u);
+    EXPECT_EQ(huge.pools[1].freePages, 1u);
+
+#ifndef _WIN32
+    // Without GlobalMemoryStatusEx, RAM and swap come from the same pass
+    EXPECT_EQ(stats.totalPhysicalBytes, 16777216ULL * 1024);
+    EXPECT_EQ(stats.availablePhysicalBytes, 8388608ULL * 1024);
+    EXPECT_DOUBLE_EQ(stats.usagePercent, 50.0);
+    EXPECT_DOUBLE_EQ(stats.pageFilePercent, 50.0);
+#endif
+}
+
+// Test 12: THP fault, fallback and compaction-stall counters become rates
+TEST_F(MemoryMonitorProcTest, ComputesThpRates) {
+    MemoryMonitor monitor((root_ / "proc").string(), (root_ / "hugepages").string());
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    MemoryStats first = monitor.getCurrentStats(start);
+    ASSERT_TRUE(first.hugePages.has_value());
+    EXPECT_EQ(first.hugePages->thpFaultsPerSec, 0u);
+
+    writeFile(root_ / "proc" / "vmstat", vmstat(1400, 250, 27));
+    MemoryStats second = monitor.getCurrentStats(start + std::chrono::seconds(2));
+    ASSERT_TRUE(second.hugePages.has_value());
+    EXPECT_EQ(second.hugePages->thpFaultsPerSec, 200u);
+    EXPECT_EQ(second.hugePages->thpFallbacksPerSec, 100u);
+    EXPECT_EQ(second.hugePages->compactStallsPerSec, 10u);
+}
+
+// Test 13: A pool that was empty at start is listed once pages are allocated to it
+TEST_F(MemoryMonitorProcTest, PicksUpGrownPools) {
+    MemoryMonitor monitor((root_ / "proc").string(), (root_ / "hugepages").string());
+    MemoryStats before = monitor.getCurrentStats();
+    ASSERT_TRUE(before.hugePages.has_value());
+    EXPECT_EQ(before.hugePages->pools.size(), 2u);
+
+    writePool("hugepages-32768kB", 16, 10);
+    MemoryStats after = monitor.getCurrentStats();
+    ASSERT_TRUE(after.hugePages.has_value());
+    ASSERT_EQ(after.hugePages->pools.size(), 3u);
+    EXPECT_EQ(after.hugePages->pools[1].pageBytes, 32768ULL * 1024);
+    EXPECT_EQ(after.hugePages->pools[1].totalPages, 16u);
+    EXPECT_EQ(after.hugePages->pools[1].freePages, 10u);
+    EXPECT_EQ(after.hugePages->pools[2].pageBytes, 1024ULL * 1024 * 1024);
+
+    // Emptied again, it drops out of the list
+    writePool("hugepages-32768kB", 0, 0);
+    EXPECT_EQ(monitor.getCurrentStats().hugePages->pools.size(), 2u);
+}
@@ -0,0 +1,190 @@
+#include "WinHKMonLib/MetricsEngine.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: MetricsEngine
+ *
+ * Tests for the in-process subscription engine. Scheduler tests inject a
+ * counting collector so they do not depend on live system activity.
+ *
+ * Coverage:
+ * - Argument validation
+ * - Delivery rate per subscriber
+ * - Shared collection passes across subscribers (same frame pointer)
+ * - Same-interval subscribers added apart still share every pass
+ * - Union of due fields passed to the collector
+ * - Unsubscribe stops delivery
+ * - sample() with the built-in monitors
+ */
+
+namespace {
+
+// Collector that records the field masks it was asked for
+struct RecordingCollector {
+    std::mutex mutex;
+    std::vector<uint32_t> masks;
+
+    FieldCollector function() {
+        return [this](uint32_t fieldMask) {
+            std::lock_guard<std::mutex> lock(mutex);
+            masks.push_back(fieldMask);
+            SystemMetrics metrics;
+            metrics.timestamp = masks.size();
+            return metrics;
+        };
+    }
+};
+
+// Subscriber that keeps every frame it receives
+struct FrameLog {
+    std::mutex mutex;
+    std::vector<MetricsFrame> frames;
+
+    FrameCallback callback() {
+        return [this](const MetricsFrame& frame) {
+            std::lock_guard<std::mutex> lock(mutex);
+            frames.push_back(frame);
+        };
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return frames.size();
+    }
+};
+
+}  // anonymous namespace
+
+// Test 1: Invalid subscriptions are rejected
+TEST(MetricsEngineTest, RejectsInvalidSubscription) {
+    RecordingCollector collector;
+    MetricsEngine engine(collector.function());
+    FrameLog log;
+
+    EXPECT_THROW(engine.subscribe(0, 1.0, log.callback()), std::invalid_argument);
+    EXPECT_THROW(engine.subscribe(FIELD_CPU, 0.0, log.callback()), std::invalid_argument);
+    EXPECT_THROW(engine.subscribe(FIELD_CPU, 1.0, FrameCallback()), std::invalid_argument);
+    EXPECT_FALSE(engine.unsubscribe(12345));
+}
+
+// Test 2: Subscribers at 50 ms and 100 ms share passes
+TEST(MetricsEngineTest, SharesPassesAcrossSubscribers) {
+    RecordingCollector collector;
+    FrameLog fast;
+    FrameLog slow;
+    {
+        MetricsEngine engine(collector.function());
+        engine.subscribe(FIELD_MEMORY, 0.05, fast.callback());
+        engine.subscribe(FIELD_CPU, 0.1, slow.callback());
+        std::this_thread::sleep_for(std::chrono::milliseconds(1030));
+    }  // Engine stopped before inspecting
+
+    // ~20 and ~10 deliveries (generous bounds for loaded CI machines)
+    EXPECT_GE(fast.size(), 12u);
+    EXPECT_LE(fast.size(), 21u);
+    EXPECT_GE(slow.size(), 6u);
+    EXPECT_LE(slow.size(), 11u);
+
+    // Every slow frame is also a fast frame: one pass served both
+    std::set<const SystemMetrics*> fastFrames;
+    for (const auto& frame : fast.frames) {
+        fastFrames.insert(frame.get());
+    }
+    size_t shared = 0;
+    for (const auto& frame : slow.frames) {
+        shared += fastFrames.count(frame.get());
+    }
+    EXPECT_GE(shared + 1, slow.size());
+
+    // Collection passes equal the fast subscriber's deliveries, not the sum
+    std::lock_guard<std::mutex> lock(collector.mutex);
+    EXPECT_LE(collector.masks.size(), fast.size() + 1);
+}
+
+// Test 3: Same-interval subscribers share passes however far apart they subscribe
+TEST(MetricsEngineTest, AlignsLateSubscribersToGrid) {
+    RecordingCollector collector;
+    FrameLog first;
+    FrameLog second;
+    {
+        MetricsEngine engine(collector.function());
+        engine.subscribe(FIELD_CPU, 0.1, first.callback());
+        std::this_thread::sleep_for(std::chrono::milliseconds(130));  // Well past COALESCE_WINDOW
+        engine.subscribe(FIELD_MEMORY, 0.1, second.callback());
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+
+    ASSERT_GE(second.size(), 3u);
+    std::set<const SystemMetrics*> firstFrames;
+    for (const auto& frame : first.frames) {
+        firstFrames.insert(frame.get());
+    }
+    for (const auto& frame : second.frames) {
+        EXPECT_EQ(firstFrames.count(frame.get()), 1u);
+    }
+
+    // One pass per period, each collecting both fields
+    std::lock_guard<std::mutex> lock(collector.mutex);
+    EXPECT_EQ(collector.masks.size(), first.size());
+    EXPECT_EQ(collector.masks.back(), static_cast<uint32_t>(FIELD_CPU | FIELD_MEMORY));
+}
+
+// Test 4: The collector receives the union of due subscribers' fields
+TEST(MetricsEngineTest, CollectsUnionOfDueFields) {
+    RecordingCollector collector;
+    FrameLog a;
+    FrameLog b;
+    {
+        MetricsEngine engine(collector.function());
+        engine.subscribe(FIELD_CPU, 0.1, a.callback());
+        engine.subscribe(FIELD_NETWORK, 0.1, b.callback());
+        std::this_thread::sleep_for(std::chrono::milliseconds(350));
+    }
+
+    std::lock_guard<std::mutex> lock(collector.mutex);
+    ASSERT_FALSE(collector.masks.empty());
+    for (uint32_t mask : collector.masks) {
+        EXPECT_EQ(mask & ~static_cast<uint32_t>(FIELD_CPU | FIELD_NETWORK), 0u);
+    }
+    EXPECT_NE(std::count(collector.masks.begin(), collector.masks.end(),
+                         static_cast<uint32_t>(FIELD_CPU | FIELD_NETWORK)), 0);
+}
+
+// Test 5: No deliveries after unsubscribe returns
+TEST(MetricsEngineTest, UnsubscribeStopsDelivery) {
+    RecordingCollector collector;
+    MetricsEngine engine(collector.function());
+    FrameLog log;
+
+    MetricsEngine::SubscriptionId id = engine.subscribe(FIELD_MEMORY, 0.02, log.callback());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(engine.unsubscribe(id));
+    size_t countAtUnsubscribe = log.size();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    EXPECT_GT(countAtUnsubscribe, 0u);
+    EXPECT_EQ(log.size(), countAtUnsubscribe);
+}
+
+// Test 6: sample() with the built-in monitors returns only requested fields
+TEST(MetricsEngineTest, SampleUsesBuiltInMonitors) {
+    MetricsEngine engine;
+    MetricsFrame frame = engine.sample(FIELD_MEMORY);
+
+    ASSERT_NE(frame, nullptr);
+    ASSERT_TRUE(frame->memory.has_value());
+    EXPECT_GT(frame->memory->totalPhysicalBytes, 0u);
+    EXPECT_FALSE(frame->cpu.has_value());
+    EXPECT_FALSE(frame->network.has_value());
+    EXPECT_FALSE(frame->disks.has_value());
+    EXPECT_EQ(engine.passCount(), 1u);
+}
@@ -0,0 +1,109 @@
+#include "WinHKMonLib/NumaMonitor.h"
+#include "TempTree.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+using namespace WinHKMon;
+namespace fs = std::filesystem;
+
+/**
+ * Test Suite: NumaMonitor
+ *
+ * Tests for the NUMA metric against a fixture node tree written to a
+ * temporary directory (same layout and formats as /sys/devices/system/node).
+ *
+ * Coverage:
+ * - Node discovery (node<N> only, numeric order)
+ * - meminfo parsing (kB to bytes)
+ * - numa_hit/numa_miss/numa_foreign rates
+ * - No nodes: initialize() fails
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string meminfo(int node, uint64_t totalKb, uint64_t freeKb) {
+    std::string prefix = "Node " + std::to_string(node) + " ";
+    return prefix + "MemTotal:       " + std::to_string(totalKb) + " kB\n" +
+           prefix + "MemFree:        " + std::to_string(freeKb) + " kB\n" +
+           prefix + "MemUsed:        " + std::to_string(totalKb - freeKb) + " kB\n" +
+           prefix + "Active:          1000 kB\n" +
+           prefix + "FilePages:       4096 kB\n" +
+           prefix + "Mapped:          1024 kB\n" +
+           prefix + "AnonPages:       2048 kB\n";
+}
+
+std::string numastat(uint64_t hit, uint64_t miss, uint64_t foreign) {
+    return "numa_hit " + std::to_string(hit) + "\nnuma_miss " + std::to_string(miss) +
+           "\nnuma_foreign " + std::to_string(foreign) +
+           "\ninterleave_hit 100\nlocal_node " + std::to_string(hit) + "\nother_node 0\n";
+}
+
+void writeNode(const fs::path& root, int node, uint64_t freeKb, uint64_t hit, uint64_t miss, uint64_t foreign) {
+    fs::path dir = root / ("node" + std::to_string(node));
+    fs::create_directories(dir);
+    writeFile(dir / "meminfo", meminfo(node, 33554432, freeKb));
+    writeFile(dir / "numastat", numastat(hit, miss, foreign));
+}
+
+class NumaMonitorTest : public TempTreeTest {
+protected:
+    NumaMonitorTest()
+        : TempTreeTest("numa") {
+    }
+
+    void SetUp() override {
+        TempTreeTest::SetUp();
+        writeNode(root_, 0, 8388608, 1000, 0, 500);
+        writeNode(root_, 1, 262144, 2000, 500, 0);
+        writeNode(root_, 10, 16777216, 0, 0, 0);
+        fs::create_directories(root_ / "power");
+        writeFile(root_ / "online", "0-1,10\n");
+    }
+};
+
+}  // anonymous namespace
+
+// Test 1: Nodes in numeric order with their memory in bytes
+TEST_F(NumaMonitorTest, ReadsNodeMeminfo) {
+    NumaMonitor monitor(root_.string());
+    monitor.initialize();
+    std::vector<NumaNodeStats> nodes = monitor.getCurrentStats();
+    ASSERT_EQ(nodes.size(), 3u);
+    EXPECT_EQ(nodes[0].nodeId, 0);
+    EXPECT_EQ(nodes[1].nodeId, 1);
+    EXPECT_EQ(nodes[2].nodeId, 10);
+    EXPECT_EQ(nodes[1].totalBytes, 33554432ULL * 1024);
+    EXPECT_EQ(nodes[1].freeBytes, 262144ULL * 1024);
+    EXPECT_EQ(nodes[1].fileBytes, 4096ULL * 1024);
+    EXPECT_EQ(nodes[1].anonBytes, 2048ULL * 1024);
+}
+
+// Test 2: numastat counters become per-second rates
+TEST_F(NumaMonitorTest, ComputesNumastatRates) {
+    NumaMonitor monitor(root_.string());
+    monitor.initialize();
+    Clock::time_point start = Clock::now();
+    monitor.getCurrentStats(start);
+
+    writeNode(root_, 1, 131072, 6000, 2500, 0);
+    writeNode(root_, 0, 8388608, 3000, 0, 2500);
+    std::vector<NumaNodeStats> nodes = monitor.getCurrentStats(start + std::chrono::seconds(2));
+    ASSERT_EQ(nodes.size(), 3u);
+    EXPECT_EQ(nodes[0].hitsPerSec, 1000u);
+    EXPECT_EQ(nodes[0].foreignPerSec, 1000u);
+    EXPECT_EQ(nodes[1].hitsPerSec, 2000u);
+    EXPECT_EQ(nodes[1].missesPerSec, 1000u);
+    EXPECT_EQ(nodes[1].freeBytes, 131072ULL * 1024);
+    EXPECT_EQ(nodes[2].hitsPerSec, 0u);
+}
+
+// Test 3: Without node directories the metric is unavailable
+TEST_F(NumaMonitorTest, FailsWithoutNodes) {
+    EXPECT_THROW(NumaMonitor((root_ / "missing").string()).initialize(), std::runtime_error);
+    EXPECT_THROW(NumaMonitor((root_ / "power").string()).initialize(), std::runtime_error);
+}
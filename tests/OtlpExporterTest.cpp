@@ -0,0 +1,402 @@
+#ifdef _WIN32
+#define _WINSOCKAPI_
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "WinHKMonLib/OtlpExporter.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: OtlpExporter
+ *
+ * Tests for OTLP/HTTP metric export (--otlp). Most tests replace the HTTP
+ * POST with a recording transport; the last one posts to a local HTTP
+ * stand-in listening on the loopback interface.
+ *
+ * Coverage:
+ * - URL parsing and defaults
+ * - Host-metrics names, units, attributes and temporality
+ * - Per-series start times that restart when a counter goes backward
+ * - Several samples per request
+ * - Retry of retryable failures; dropped batches on permanent ones
+ * - submit() never blocks while the collector is stuck; the queue is bounded
+ * - Real HTTP request with a gzip body
+ */
+
+namespace {
+
+const uint64_t T0 = 1700000000000000000ull;
+
+MetricsFrame hostFrame(double cpuPercent) {
+    SystemMetrics metrics;
+    CpuStats cpu{};
+    cpu.totalUsagePercent = cpuPercent;
+    cpu.cores = {{0, cpuPercent, 3000}, {1, 50.0, 0}};
+    metrics.cpu = cpu;
+
+    MemoryStats memory{};
+    memory.totalPhysicalBytes = 16000;
+    memory.availablePhysicalBytes = 4000;
+    memory.usedPhysicalBytes = 12000;
+    memory.usagePercent = 75.0;
+    metrics.memory = memory;
+
+    DiskStats disk{};
+    disk.deviceName = "C:";
+    disk.totalSizeBytes = 1000;
+    disk.usedBytes = 250;
+    disk.freeBytes = 750;
+    disk.totalBytesRead = 111;
+    disk.totalBytesWritten = 222;
+    metrics.disks = std::vector<DiskStats>{disk};
+
+    InterfaceStats iface{};
+    iface.name = "Wi-Fi \"home\"";
+    iface.totalInOctets = 333;
+    iface.totalOutOctets = 444;
+    iface.inErrors = 5;
+    metrics.network = std::vector<InterfaceStats>{iface};
+    return std::make_shared<const SystemMetrics>(metrics);
+}
+
+size_t countOf(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) {
+        count++;
+    }
+    return count;
+}
+
+OtlpConfig fastConfig(size_t batchSamples) {
+    OtlpConfig config;
+    config.batchSamples = batchSamples;
+    config.gzip = false;
+    config.retryDelay = std::chrono::milliseconds(1);
+    return config;
+}
+
+/**
+ * @brief Minimal HTTP/1.1 server: answers each POST with a fixed status
+ */
+class HttpStandIn {
+public:
+    explicit HttpStandIn(int status) : status_(status), port_(0) {
+#ifdef _WIN32
+        WSADATA wsaData;
+        WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+        listener_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        socklen_t length = sizeof(address);
+        if (bind(listener_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(listener_, 4) != 0 ||
+            getsockname(listener_, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            throw std::runtime_error("Cannot start HTTP stand-in");
+        }
+        port_ = ntohs(address.sin_port);
+        server_ = std::thread([this] { serveOne(); });
+    }
+
+    ~HttpStandIn() {
+        if (server_.joinable()) {
+            server_.join();
+        }
+#ifdef _WIN32
+        closesocket(listener_);
+        WSACleanup();
+#else
+        close(listener_);
+#endif
+    }
+
+    uint16_t port() const { return port_; }
+
+    /**
+     * @brief Headers and body of the request served (waits for it)
+     */
+    std::pair<std::string, std::string> request() {
+        server_.join();
+        return {headers_, body_};
+    }
+
+private:
+    void serveOne() {
+        auto connection = accept(listener_, nullptr, nullptr);
+        std::string data;
+        char buffer[4096];
+        size_t headerEnd = std::string::npos;
+        size_t contentLength = 0;
+        for (;;) {
+            auto received = recv(connection, buffer, static_cast<int>(sizeof(buffer)), 0);
+            if (received <= 0) {
+                break;
+            }
+            data.append(buffer, static_cast<size_t>(received));
+            if (headerEnd == std::string::npos && (headerEnd = data.find("\r\n\r\n")) != std::string::npos) {
+                size_t field = data.find("Content-Length: ");
+                contentLength = field < headerEnd ? std::strtoul(data.c_str() + field + 16, nullptr, 10) : 0;
+            }
+            if (headerEnd != std::string::npos && data.size() >= headerEnd + 4 + contentLength) {
+                break;
+            }
+        }
+        if (headerEnd != std::string::npos) {
+            headers_ = data.substr(0, headerEnd);
+            body_ = data.substr(headerEnd + 4);
+        }
+        std::string response = "HTTP/1.1 " + std::to_string(status_) + " OK\r\nContent-Length: 0\r\n\r\n";
+        send(connection, response.data(), static_cast<int>(response.size()), 0);
+#ifdef _WIN32
+        closesocket(connection);
+#else
+        close(connection);
+#endif
+    }
+
+#ifdef _WIN32
+    SOCKET listener_;
+#else
+    int listener_;
+#endif
+    int status_;
+    uint16_t port_;
+    std::thread server_;
+    std::string headers_;
+    std::string body_;
+};
+
+}  // anonymous namespace
+
+// Test 1: Scheme, host, port and path; defaults for the last two
+TEST(OtlpExporterTest, ParsesUrl) {
+    OtlpEndpoint endpoint = parseOtlpUrl("http://collector");
+    EXPECT_EQ(endpoint.host, "collector");
+    EXPECT_EQ(endpoint.port, 4318);
+    EXPECT_EQ(endpoint.path, "/v1/metrics");
+
+    endpoint = parseOtlpUrl("http://10.0.0.5:9000/otlp/v1/metrics");
+    EXPECT_EQ(endpoint.host, "10.0.0.5");
+    EXPECT_EQ(endpoint.port, 9000);
+    EXPECT_EQ(endpoint.path, "/otlp/v1/metrics");
+
+    endpoint = parseOtlpUrl("http://[::1]:4318");
+    EXPECT_EQ(endpoint.host, "::1");
+
+    EXPECT_THROW(parseOtlpUrl("https://collector"), std::invalid_argument);
+    EXPECT_THROW(parseOtlpUrl("http://:4318"), std::invalid_argument);
+    EXPECT_THROW(parseOtlpUrl("http://collector:0"), std::invalid_argument);
+    EXPECT_THROW(parseOtlpUrl("http://collector:43x"), std::invalid_argument);
+}
+
+// Test 2: Semantic-convention names, units, attributes and temporality
+TEST(OtlpExporterTest, EncodesHostMetrics) {
+    CumulativeStarts starts(42);
+    std::string json = encodeOtlpJson({{hostFrame(25.0), T0}}, "web-01", starts);
+
+    EXPECT_NE(json.find("{\"key\":\"host.name\",\"value\":{\"stringValue\":\"web-01\"}}"), std::string::npos);
+    EXPECT_NE(json.find("{\"key\":\"service.name\",\"value\":{\"stringValue\":\"winhkmon\"}}"), std::string::npos);
+
+    // Per-core utilization as a 0-1 gauge
+    EXPECT_NE(json.find("{\"name\":\"system.cpu.utilization\",\"unit\":\"1\",\"gauge\":{\"dataPoints\":["
+                        "{\"attributes\":[{\"key\":\"cpu.logical_number\",\"value\":{\"intValue\":\"0\"}}],"
+                        "\"timeUnixNano\":\"1700000000000000000\",\"asDouble\":0.25}"),
+              std::string::npos);
+    // Only cores that report a frequency
+    EXPECT_EQ(countOf(json, "\"asInt\":\"3000000000\""), 1u);
+
+    EXPECT_NE(json.find("\"name\":\"system.memory.usage\",\"unit\":\"By\",\"sum\":{\"aggregationTemporality\":2,"
+                        "\"isMonotonic\":false"),
+              std::string::npos);
+    EXPECT_NE(json.find("\"asDouble\":0.75"), std::string::npos);
+
+    // Cumulative counters start at their origin (boot time in the exporter)
+    EXPECT_NE(json.find("\"name\":\"system.disk.io\",\"unit\":\"By\",\"sum\":{\"aggregationTemporality\":2,"
+                        "\"isMonotonic\":true,\"dataPoints\":[{\"attributes\":[{\"key\":\"system.device\","
+                        "\"value\":{\"stringValue\":\"C:\"}},{\"key\":\"disk.io.direction\",\"value\":"
+                        "{\"stringValue\":\"read\"}}],\"startTimeUnixNano\":\"42\","
+                        "\"timeUnixNano\":\"1700000000000000000\",\"asInt\":\"111\"}"),
+              std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"system.filesystem.utilization\""), std::string::npos);
+
+    EXPECT_NE(json.find("{\"stringValue\":\"Wi-Fi \\\"home\\\"\"}"), std::string::npos);
+    EXPECT_NE(json.find("{\"stringValue\":\"transmit\"}}],\"startTimeUnixNano\":\"42\","
+                        "\"timeUnixNano\":\"1700000000000000000\",\"asInt\":\"444\"}"),
+              std::string::npos);
+    // Errors only in the direction that reports them
+    EXPECT_EQ(countOf(json, "\"name\":\"system.network.errors\""), 1u);
+    EXPECT_EQ(countOf(json, "\"asInt\":\"5\""), 1u);
+
+    // Nothing for metrics without a convention, nothing for absent ones
+    SystemMetrics empty;
+    CumulativeStarts bareStarts(0);
+    std::string bare = encodeOtlpJson({{std::make_shared<const SystemMetrics>(empty), T0}}, "h", bareStarts);
+    EXPECT_NE(bare.find("\"metrics\":[]"), std::string::npos);
+}
+
+// Test 3: A batch becomes one request with one data point per sample
+TEST(OtlpExporterTest, BatchesSamples) {
+    std::vector<std::string> bodies;
+    std::mutex mutex;
+    {
+        OtlpExporter exporter(fastConfig(3), "h", [&](const std::string& body, bool) {
+            std::lock_guard<std::mutex> lock(mutex);
+            bodies.push_back(body);
+            return 200;
+        });
+        for (int i = 0; i < 7; i++) {
+            exporter.submit(hostFrame(i), T0 + static_cast<uint64_t>(i) * 1000000000ull);
+        }
+        exporter.flush();
+        EXPECT_EQ(exporter.exportedSamples(), 7u);
+        EXPECT_EQ(exporter.droppedSamples(), 0u);
+    }
+
+    // 3 + 3 + the remainder on flush
+    ASSERT_EQ(bodies.size(), 3u);
+    EXPECT_EQ(countOf(bodies[0], "\"name\":\"system.memory.limit\""), 1u);
+    EXPECT_EQ(countOf(bodies[0], "\"timeUnixNano\":\"1700000002000000000\""), 15u);
+    EXPECT_EQ(countOf(bodies[0], "\"asInt\":\"16000\""), 3u);
+    EXPECT_EQ(countOf(bodies[2], "\"asInt\":\"16000\""), 1u);
+}
+
+// Test 4: Throttling and unreachable collectors are retried; client errors are not
+TEST(OtlpExporterTest, RetriesRetryableFailures) {
+    std::vector<int> replies = {503, 0, 429, 200, 400};
+    std::atomic<size_t> calls{0};
+    OtlpExporter exporter(fastConfig(1), "h", [&](const std::string&, bool) {
+        return replies[std::min(calls++, replies.size() - 1)];
+    });
+
+    exporter.submit(hostFrame(1.0), T0);
+    exporter.flush();
+    EXPECT_EQ(calls.load(), 4u);
+    EXPECT_EQ(exporter.exportedSamples(), 1u);
+
+    exporter.submit(hostFrame(2.0), T0);
+    exporter.flush();
+    EXPECT_EQ(calls.load(), 5u);
+    EXPECT_EQ(exporter.failedExports(), 1u);
+    EXPECT_EQ(exporter.droppedSamples(), 1u);
+}
+
+// Test 5: Attempts are bounded; the batch is then dropped
+TEST(OtlpExporterTest, GivesUpAfterMaxAttempts) {
+    std::atomic<int> calls{0};
+    OtlpConfig config = fastConfig(2);
+    config.maxAttempts = 3;
+    OtlpExporter exporter(config, "h", [&](const std::string&, bool) {
+        calls++;
+        return 503;
+    });
+    exporter.submit(hostFrame(1.0), T0);
+    exporter.submit(hostFrame(2.0), T0);
+    exporter.flush();
+    EXPECT_EQ(calls.load(), 3);
+    EXPECT_EQ(exporter.failedExports(), 1u);
+    EXPECT_EQ(exporter.droppedSamples(), 2u);
+}
+
+// Test 6: A stuck collector never blocks submit(); the queue drops its oldest
+TEST(OtlpExporterTest, SubmitNeverBlocks) {
+    std::promise<void> entered;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<bool> first{true};
+    OtlpConfig config = fastConfig(1);
+    config.maxQueuedSamples = 100;
+    OtlpExporter exporter(config, "h", [&entered, &first, released](const std::string&, bool) {
+        if (first.exchange(false)) {
+            entered.set_value();
+        }
+        released.wait();
+        return 200;
+    });
+
+    // The first sample is in flight and stuck
+    exporter.submit(hostFrame(1.0), T0);
+    entered.get_future().wait();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 5000; i++) {
+        exporter.submit(hostFrame(1.0), T0);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::seconds(2));
+
+    // One sample in flight, 100 queued, the rest dropped
+    EXPECT_EQ(exporter.droppedSamples(), 5000u - 100u);
+    release.set_value();
+    exporter.flush();
+    EXPECT_EQ(exporter.exportedSamples(), 101u);
+}
+
+// Test 7: The default transport POSTs a gzip body to a real HTTP endpoint
+TEST(OtlpExporterTest, PostsToHttpCollector) {
+    HttpStandIn collector(200);
+    OtlpConfig config;
+    config.endpoint = parseOtlpUrl("http://127.0.0.1:" + std::to_string(collector.port()));
+    config.batchSamples = 2;
+
+    OtlpExporter exporter(config, "web-01");
+    exporter.submit(hostFrame(10.0), T0);
+    exporter.submit(hostFrame(20.0), T0 + 1000000000ull);
+    exporter.flush();
+    EXPECT_EQ(exporter.exportedSamples(), 2u);
+
+    auto request = collector.request();
+    EXPECT_EQ(request.first.rfind("POST /v1/metrics HTTP/1.1\r\n", 0), 0u) << request.first;
+    EXPECT_NE(request.first.find("Content-Type: application/json"), std::string::npos);
+    EXPECT_NE(request.first.find("Content-Encoding: gzip"), std::string::npos);
+    ASSERT_GE(request.second.size(), 18u);
+    EXPECT_EQ(static_cast<unsigned char>(request.second[0]), 0x1Fu);
+    EXPECT_EQ(static_cast<unsigned char>(request.second[1]), 0x8Bu);
+    EXPECT_NE(request.first.find("Content-Length: " + std::to_string(request.second.size())), std::string::npos);
+}
+
+// Test 8: A counter that goes backward restarts only its own series
+TEST(OtlpExporterTest, RestartsSeriesOnCounterReset) {
+    const uint64_t second = 1000000000ull;
+    CumulativeStarts starts(42);
+    EXPECT_EQ(starts.startFor("a", T0, 100), 42u);
+    EXPECT_EQ(starts.startFor("a", T0 + second, 150), 42u);
+    EXPECT_EQ(starts.startFor("b", T0 + second, 7), 42u);
+
+    // Reset between the last two points: the series starts at the last one
+    EXPECT_EQ(starts.startFor("a", T0 + 2 * second, 10), T0 + second);
+    EXPECT_EQ(starts.startFor("a", T0 + 3 * second, 20), T0 + second);
+    EXPECT_EQ(starts.startFor("b", T0 + 3 * second, 9), 42u);
+
+    // Through the encoder: interface octets drop, disk counters do not
+    SystemMetrics reset = *hostFrame(25.0);
+    (*reset.network)[0].totalInOctets = 3;
+    CumulativeStarts encoderStarts(42);
+    std::string json = encodeOtlpJson({{hostFrame(25.0), T0}, {std::make_shared<const SystemMetrics>(reset), T0 + second}},
+                                      "h", encoderStarts);
+    EXPECT_NE(json.find("\"startTimeUnixNano\":\"1700000000000000000\",\"timeUnixNano\":\"1700000001000000000\","
+                        "\"asInt\":\"3\""),
+              std::string::npos);
+    EXPECT_EQ(countOf(json, "\"startTimeUnixNano\":\"1700000000000000000\""), 1u);
+}
@@ -252,3 +252,226 @@ TEST(OutputFormatterTest, HandlesEmptyMetrics) {
     EXPECT_FALSE(csv.empty());
 }
 
+
+// Test actual interval reporting
+TEST(OutputFormatterTest, JsonIncludesIntervalWhenPresent) {
+    SystemMetrics metrics = createSampleMetrics();
+    metrics.intervalSeconds = 0.5;
+    
+    std::string json = formatJson(metrics, createDefaultOptions());
+    EXPECT_NE(json.find("\"intervalSeconds\": 0.500"), std::string::npos);
+}
+
+TEST(OutputFormatterTest, CsvIncludesIntervalInAdaptiveMode) {
+    SystemMetrics metrics = createSampleMetrics();
+    metrics.intervalSeconds = 2.0;
+    CliOptions opts = createDefaultOptions();
+    opts.adaptive = true;
+    
+    std::string csv = formatCsv(metrics, true, opts);
+    EXPECT_NE(csv.find("interval_sec"), std::string::npos);
+    EXPECT_NE(csv.find("2.000"), std::string::npos);
+}
+
+// Test cluster statistics (aggregate mode)
+TEST(OutputFormatterTest, IncludesClusterStatistics) {
+    SystemMetrics metrics = createSampleMetrics();
+    ClusterStats cluster{};
+    cluster.bucketStartMs = 1700000000000ULL;
+    cluster.bucketSeconds = 1.0;
+    cluster.hostCount = 24;
+    cluster.metrics.push_back({"cpu_percent", 24, 480.0, 5.0, 40.0, 20.0, 18.0, 35.0, 39.5});
+    cluster.metrics.push_back({"net_in_bytes_per_sec", 24, 2.4e6, 0.0, 5.0e5, 1.0e5, 9.0e4, 3.0e5, 4.9e5});
+    metrics.cluster = cluster;
+    
+    std::string json = formatJson(metrics, createDefaultOptions());
+    EXPECT_NE(json.find("\"cluster\": {"), std::string::npos);
+    EXPECT_NE(json.find("\"hosts\": 24"), std::string::npos);
+    EXPECT_NE(json.find("\"cpu_percent\": {\"hosts\": 24, \"sum\": 480.0"), std::string::npos);
+    EXPECT_NE(json.find("\"p99\": 39.5"), std::string::npos);
+    
+    std::string text = formatText(metrics, false, createDefaultOptions());
+    EXPECT_NE(text.find("HOSTS: 24"), std::string::npos);
+    EXPECT_NE(text.find("p90 35.0%"), std::string::npos);
+    EXPECT_NE(text.find("p99 490.0 KB/s"), std::string::npos);
+    
+    std::string line = formatText(metrics, true, createDefaultOptions());
+    EXPECT_NE(line.find("HOSTS:24"), std::string::npos);
+    
+    std::string csv = formatCsv(metrics, true, createDefaultOptions());
+    EXPECT_NE(csv.find(",hosts\n"), std::string::npos);
+    EXPECT_NE(csv.find(",24\n"), std::string::npos);
+}
+
+// Test aligned tick times (--align)
+TEST(OutputFormatterTest, IncludesAlignedTickTimes) {
+    SystemMetrics metrics = createSampleMetrics();
+    metrics.nominalTimeMs = 1700000005000ULL;   // 2023-11-14T22:13:25.000Z
+    metrics.captureTimeMs = 1700000005012ULL;
+    CliOptions opts = createDefaultOptions();
+    opts.align = true;
+    
+    std::string json = formatJson(metrics, opts);
+    EXPECT_NE(json.find("\"nominalTime\": \"2023-11-14T22:13:25.000Z\""), std::string::npos);
+    EXPECT_NE(json.find("\"captureTime\": \"2023-11-14T22:13:25.012Z\""), std::string::npos);
+    
+    std::string text = formatText(metrics, false, opts);
+    EXPECT_NE(text.find("TICK: 2023-11-14T22:13:25.000Z (captured +12 ms)"), std::string::npos);
+    
+    std::string csv = formatCsv(metrics, true, opts);
+    EXPECT_NE(csv.find(",nominal_time,capture_time\n"), std::string::npos);
+    EXPECT_NE(csv.find(",2023-11-14T22:13:25.000Z,2023-11-14T22:13:25.012Z\n"), std::string::npos);
+}
+
+// Test NDJSON: same fields as JSON on one line, string contents untouched
+TEST(OutputFormatterTest, FormatNdjsonIsOneLine) {
+    SystemMetrics metrics = createSampleMetrics();
+    InterfaceStats iface;
+    iface.name = "Ethernet 2";
+    metrics.network = std::vector<InterfaceStats>{iface};
+    std::string line = formatNdjson(metrics, createDefaultOptions());
+    
+    ASSERT_FALSE(line.empty());
+    EXPECT_EQ(line.back(), '\n');
+    EXPECT_EQ(line.find('\n'), line.size() - 1);
+    EXPECT_EQ(line.front(), '{');
+    EXPECT_NE(line.find("\"totalUsagePercent\":23.5"), std::string::npos);
+    EXPECT_NE(line.find("\"Ethernet 2\""), std::string::npos);
+}
+
+// Test: Every formatter lists every NUMA node
+TEST(OutputFormatterTest, IncludesNumaNodes) {
+    SystemMetrics metrics;
+    metrics.timestamp = 0;
+    NumaNodeStats node0{0, 32ULL << 30, 8ULL << 30, 4ULL << 30, 12ULL << 30, 5000, 0, 0};
+    NumaNodeStats node1{1, 32ULL << 30, 256ULL << 20, 1ULL << 30, 28ULL << 30, 4000, 120, 0};
+    metrics.numa = std::vector<NumaNodeStats>{node0, node1};
+    CliOptions options = createDefaultOptions();
+    
+    std::string text = formatText(metrics, false, options);
+    EXPECT_NE(text.find("NUMA: node0"), std::string::npos) << text;
+    EXPECT_NE(text.find("NUMA: node1"), std::string::npos) << text;
+    EXPECT_NE(text.find("miss 120/s"), std::string::npos) << text;
+    EXPECT_NE(formatText(metrics, true, options).find("N1:256M/120miss"), std::string::npos);
+    
+    std::string json = formatJson(metrics, options);
+    EXPECT_NE(json.find("{\"node\": 1, \"totalMB\": 32768, \"freeMB\": 256"), std::string::npos) << json;
+    
+    std::string csv = formatCsv(metrics, true, options);
+    EXPECT_NE(csv.find(",numa0_free_mb,numa0_miss_per_sec,numa0_foreign_per_sec,numa1_free_mb"),
+              std::string::npos) << csv;
+    EXPECT_NE(csv.find(",8192,0,0,256,120,0\n"), std::string::npos) << csv;
+}
+
+// Test: Huge page pools and THP rates follow the RAM section
+TEST(OutputFormatterTest, IncludesHugePages) {
+    SystemMetrics metrics;
+    metrics.timestamp = 0;
+    MemoryStats memory{};
+    memory.totalPhysicalBytes = 16ULL << 30;
+    memory.availablePhysicalBytes = 8ULL << 30;
+    HugePageStats huge{};
+    huge.pools.push_back(HugePagePoolStats{2ULL << 20, 512, 128, 16, 0});
+    huge.anonHugeBytes = 600ULL << 20;
+    huge.thpFallbacksPerSec = 40;
+    huge.compactStallsPerSec = 3;
+    memory.hugePages = huge;
+    metrics.memory = memory;
+    CliOptions options = createDefaultOptions();
+    
+    std::string text = formatText(metrics, false, options);
+    EXPECT_NE(text.find("HUGE: 2.0 MB pages  128 free / 512"), std::string::npos) << text;
+    EXPECT_NE(text.find("40 fallbacks/s  3 compaction stalls/s"), std::string::npos) << text;
+    EXPECT_NE(formatText(metrics, true, options).find("HP2M:128/512  STALL:3"), std::string::npos);
+    
+    std::string json = formatJson(metrics, options);
+    EXPECT_NE(json.find("\"pools\": [{\"pageBytes\": 2097152, \"total\": 512, \"free\": 128"),
+              std::string::npos) << json;
+    EXPECT_NE(json.find("\"anonHugeMB\": 600"), std::string::npos) << json;
+    
+    std::string csv = formatCsv(metrics, true, options);
+    EXPECT_NE(csv.find(",hugepages_free,thp_fallback_per_sec,compact_stall_per_sec"), std::string::npos) << csv;
+    EXPECT_NE(csv.find(",128,40,3\n"), std::string::npos) << csv;
+}
+
+// Helper: a 192-thread host with one hot core every 16
+SystemMetrics createManyCoreMetrics() {
+    SystemMetrics metrics;
+    metrics.timestamp = 0;
+    CpuStats cpu;
+    cpu.totalUsagePercent = 17.4;
+    cpu.averageFrequencyMhz = 3000;
+    for (int i = 0; i < 192; i++) {
+        double usage = (i % 16 == 5) ? 97.5 : static_cast<double>(i % 7) * 1.3;
+        cpu.cores.push_back({i, usage, 3000});
+    }
+    metrics.cpu = cpu;
+    return metrics;
+}
+
+// Test: Packed cores are a usage array, with frequencies only when they differ
+TEST(OutputFormatterTest, PacksCoresAsArrays) {
+    SystemMetrics metrics = createManyCoreMetrics();
+    CliOptions options = createDefaultOptions();
+    options.coreView = CoreView::PACKED;
+    
+    std::string line = formatNdjson(metrics, options);
+    EXPECT_NE(line.find("\"coreUsage\":[0.0,1.3,2.6,3.9,5.2,97.5,"), std::string::npos) << line;
+    EXPECT_EQ(line.find("\"coreFrequencyMhz\""), std::string::npos);
+    EXPECT_EQ(line.find("\"cores\""), std::string::npos);
+    
+    metrics.cpu->cores[3].frequencyMhz = 3600;
+    line = formatNdjson(metrics, options);
+    EXPECT_NE(line.find("\"coreFrequencyMhz\":[3000,3000,3000,3600,3000,"), std::string::npos) << line;
+    
+    std::string text = formatText(metrics, false, options);
+    EXPECT_NE(text.find("CORE 0-15:"), std::string::npos) << text;
+    EXPECT_NE(text.find("CORE 176-191:"), std::string::npos) << text;
+    EXPECT_NE(formatText(metrics, true, options).find("CORES:0/1/3/4/5/98/"), std::string::npos);
+}
+
+// Test: Histogram counts cores per 10% bin; top lists the busiest cores
+TEST(OutputFormatterTest, SummarizesCores) {
+    SystemMetrics metrics = createManyCoreMetrics();
+    metrics.cpu->cores[0].usagePercent = 100.0;
+    CliOptions options = createDefaultOptions();
+    
+    options.coreView = CoreView::HISTOGRAM;
+    std::string line = formatNdjson(metrics, options);
+    EXPECT_NE(line.find("\"coreSummary\":{\"count\":192,\"minPercent\":0.0,"), std::string::npos) << line;
+    EXPECT_NE(line.find("\"maxPercent\":100.0}"), std::string::npos) << line;
+    EXPECT_NE(line.find("\"coreHistogram\":{\"binPercent\":10,\"counts\":[179,0,0,0,0,0,0,0,0,13]}"),
+              std::string::npos) << line;
+    EXPECT_NE(formatText(metrics, true, options).find("HIST:179/0/0/0/0/0/0/0/0/13"), std::string::npos);
+    EXPECT_NE(formatText(metrics, false, options).find("CORES: 192  min 0.0%"), std::string::npos);
+    
+    options.coreView = CoreView::TOP;
+    options.topCores = 3;
+    line = formatNdjson(metrics, options);
+    EXPECT_NE(line.find("\"topCores\":[{\"id\":0,\"usagePercent\":100.0,\"frequencyMhz\":3000},"
+                        "{\"id\":5,\"usagePercent\":97.5,\"frequencyMhz\":3000},{\"id\":21,"),
+              std::string::npos) << line;
+    EXPECT_NE(formatText(metrics, true, options).find("TOP:#0:100.0%,#5:97.5%,#21:97.5%"), std::string::npos);
+    
+    options.coreView = CoreView::NONE;
+    line = formatNdjson(metrics, options);
+    EXPECT_EQ(line.find("core"), std::string::npos) << line;
+    EXPECT_NE(line.find("\"totalUsagePercent\":17.4"), std::string::npos);
+}
+
+// Test: Compact views shrink a 192-core sample more than 5x
+TEST(OutputFormatterTest, CompactCoresShrinkLargeHosts) {
+    SystemMetrics metrics = createManyCoreMetrics();
+    CliOptions options = createDefaultOptions();
+    size_t full = formatNdjson(metrics, options).size();
+    
+    for (CoreView view : {CoreView::PACKED, CoreView::HISTOGRAM, CoreView::TOP}) {
+        options.coreView = view;
+        size_t compact = formatNdjson(metrics, options).size();
+        EXPECT_GT(full, 5 * compact) << "view " << static_cast<int>(view) << ": " << full << " vs " << compact;
+    }
+    
+    // Default text output stays free of per-core lines
+    options.coreView = CoreView::FULL;
+    EXPECT_EQ(formatText(metrics, false, options).find("CORE"), std::string::npos);
+}
@@ -0,0 +1,109 @@
+#include "WinHKMonLib/PowerMonitor.h"
+#include "TempTree.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+using namespace WinHKMon;
+namespace fs = std::filesystem;
+
+/**
+ * Test Suite: PowerMonitor
+ *
+ * Tests for the POWER metric against a fixture powercap tree written to a
+ * temporary directory (same layout and formats as /sys/class/powercap).
+ *
+ * Coverage:
+ * - Zone discovery and naming (packages, subzones, mmio duplicates)
+ * - Watts from energy deltas, including a counter wrap
+ * - Host total: packages plus DRAM, or psys when present
+ * - No zones: initialize() fails
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint64_t RANGE = 262143328850;   // max_energy_range_uj of a typical package
+
+void writeZone(const fs::path& dir, const std::string& name, uint64_t energy) {
+    fs::create_directories(dir);
+    writeFile(dir / "name", name + "\n");
+    writeFile(dir / "max_energy_range_uj", std::to_string(RANGE) + "\n");
+    writeFile(dir / "energy_uj", std::to_string(energy) + "\n");
+}
+
+class PowerMonitorTest : public TempTreeTest {
+protected:
+    PowerMonitorTest()
+        : TempTreeTest("powercap") {
+    }
+
+    void SetUp() override {
+        TempTreeTest::SetUp();
+        fs::create_directories(root_ / "intel-rapl");   // Control type, no counter
+        writeZone(root_ / "intel-rapl:0", "package-0", RANGE - 1000000);
+        writeZone(root_ / "intel-rapl:0:0", "core", 5000000);
+        writeZone(root_ / "intel-rapl:0:1", "dram", 7000000);
+        writeZone(root_ / "intel-rapl:1", "package-1", 0);
+        writeZone(root_ / "intel-rapl-mmio:0", "package-0", 0);   // Same counter via MMIO
+    }
+};
+
+}  // anonymous namespace
+
+// Test 1: Zones are named under their package; a wrapped counter still gives watts
+TEST_F(PowerMonitorTest, ComputesWattsAcrossWrap) {
+    PowerMonitor monitor(root_.string());
+    monitor.initialize();
+    Clock::time_point start = Clock::now();
+    PowerStats first = monitor.getCurrentStats(start);
+    ASSERT_EQ(first.zones.size(), 4u);
+    EXPECT_EQ(first.zones[0].name, "package-0");
+    EXPECT_EQ(first.zones[1].name, "package-0/core");
+    EXPECT_EQ(first.zones[2].name, "package-0/dram");
+    EXPECT_EQ(first.zones[3].name, "package-1");
+    EXPECT_EQ(first.zones[0].energyMicrojoules, RANGE - 1000000);
+
+    // 2 s later: package-0 wrapped after 1 J and used 59 J more (30 W)
+    writeFile(root_ / "intel-rapl:0" / "energy_uj", "59000000\n");
+    writeFile(root_ / "intel-rapl:0:0" / "energy_uj", "45000000\n");   // 20 W
+    writeFile(root_ / "intel-rapl:0:1" / "energy_uj", "15000000\n");   // 4 W
+    writeFile(root_ / "intel-rapl:1" / "energy_uj", "40000000\n");     // 20 W
+    PowerStats second = monitor.getCurrentStats(start + std::chrono::seconds(2));
+    ASSERT_EQ(second.zones.size(), 4u);
+    EXPECT_NEAR(second.zones[0].watts, 30.0, 1e-9);
+    EXPECT_NEAR(second.zones[1].watts, 20.0, 1e-9);
+    EXPECT_NEAR(second.zones[2].watts, 4.0, 1e-9);
+    EXPECT_NEAR(second.zones[3].watts, 20.0, 1e-9);
+
+    // Packages plus DRAM; cores are inside their package
+    EXPECT_NEAR(second.hostWatts, 54.0, 1e-9);
+}
+
+// Test 2: The platform zone is the host total when it exists
+TEST_F(PowerMonitorTest, PrefersPlatformZone) {
+    writeZone(root_ / "intel-rapl:2", "psys", 0);
+    PowerMonitor monitor(root_.string());
+    monitor.initialize();
+    Clock::time_point start = Clock::now();
+    monitor.getCurrentStats(start);
+
+    writeFile(root_ / "intel-rapl:1" / "energy_uj", "10000000\n");
+    writeFile(root_ / "intel-rapl:2" / "energy_uj", "65000000\n");
+    PowerStats stats = monitor.getCurrentStats(start + std::chrono::seconds(1));
+    ASSERT_EQ(stats.zones.size(), 5u);
+    EXPECT_EQ(stats.zones[4].name, "psys");
+    EXPECT_NEAR(stats.hostWatts, 65.0, 1e-9);
+}
+
+// Test 3: Without RAPL zones the metric is unavailable
+TEST_F(PowerMonitorTest, FailsWithoutZones) {
+    EXPECT_THROW(PowerMonitor((root_ / "missing").string()).initialize(), std::runtime_error);
+
+    fs::path empty = root_ / "empty";
+    fs::create_directories(empty / "intel-rapl");
+    EXPECT_THROW(PowerMonitor(empty.string()).initialize(), std::runtime_error);
+}
@@ -0,0 +1,121 @@
+#include "WinHKMonLib/QuantileSketch.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: QuantileSketch
+ *
+ * Tests for the mergeable quantile sketch behind cluster percentiles.
+ *
+ * Coverage:
+ * - Constructor validation and empty sketch
+ * - Exact count/sum/min/max
+ * - Quantile estimates within the relative accuracy
+ * - Zeros, negative values, NaN and infinities
+ * - Merging equals adding everything to one sketch
+ */
+
+namespace {
+
+// Exact q-quantile using the same rank rule as the sketch
+double exactQuantile(std::vector<double> values, double q) {
+    std::sort(values.begin(), values.end());
+    auto rank = static_cast<size_t>(q * static_cast<double>(values.size() - 1));
+    return values[rank];
+}
+
+}  // anonymous namespace
+
+// Test 1: Accuracy must be in (0, 1); empty sketch reports zeros
+TEST(QuantileSketchTest, ValidatesAccuracyAndHandlesEmpty) {
+    EXPECT_THROW(QuantileSketch(0.0), std::invalid_argument);
+    EXPECT_THROW(QuantileSketch(1.0), std::invalid_argument);
+
+    QuantileSketch sketch;
+    EXPECT_EQ(sketch.count(), 0u);
+    EXPECT_DOUBLE_EQ(sketch.quantile(0.5), 0.0);
+    EXPECT_DOUBLE_EQ(sketch.min(), 0.0);
+    EXPECT_DOUBLE_EQ(sketch.max(), 0.0);
+}
+
+// Test 2: Count, sum, min and max are exact
+TEST(QuantileSketchTest, TracksExactAggregates) {
+    QuantileSketch sketch;
+    sketch.add(10.0);
+    sketch.add(2.5);
+    sketch.add(40.0);
+
+    EXPECT_EQ(sketch.count(), 3u);
+    EXPECT_DOUBLE_EQ(sketch.sum(), 52.5);
+    EXPECT_DOUBLE_EQ(sketch.min(), 2.5);
+    EXPECT_DOUBLE_EQ(sketch.max(), 40.0);
+    EXPECT_DOUBLE_EQ(sketch.quantile(0.0), 2.5);
+    EXPECT_DOUBLE_EQ(sketch.quantile(1.0), 40.0);
+}
+
+// Test 3: Estimates stay within the relative accuracy over a wide range
+TEST(QuantileSketchTest, EstimatesWithinRelativeAccuracy) {
+    std::mt19937 rng(42);
+    std::lognormal_distribution<double> distribution(10.0, 3.0);
+    std::vector<double> values;
+    QuantileSketch sketch(0.01);
+    for (int i = 0; i < 5000; i++) {
+        double value = distribution(rng);
+        values.push_back(value);
+        sketch.add(value);
+    }
+
+    for (double q : {0.01, 0.25, 0.5, 0.9, 0.99}) {
+        double exact = exactQuantile(values, q);
+        EXPECT_NEAR(sketch.quantile(q), exact, exact * 0.01 + 1e-9) << "q=" << q;
+    }
+}
+
+// Test 4: Zeros are counted; negatives are clamped to zero; NaN and infinities are ignored
+TEST(QuantileSketchTest, HandlesZeroNegativeAndNonFinite) {
+    QuantileSketch sketch;
+    sketch.add(0.0);
+    sketch.add(-5.0);
+    sketch.add(std::nan(""));
+    sketch.add(std::numeric_limits<double>::infinity());
+    sketch.add(-std::numeric_limits<double>::infinity());
+    sketch.add(100.0);
+
+    EXPECT_EQ(sketch.count(), 3u);
+    EXPECT_DOUBLE_EQ(sketch.sum(), 100.0);
+    EXPECT_DOUBLE_EQ(sketch.quantile(0.5), 0.0);
+    EXPECT_DOUBLE_EQ(sketch.min(), 0.0);
+    EXPECT_DOUBLE_EQ(sketch.max(), 100.0);
+    EXPECT_NEAR(sketch.quantile(1.0), 100.0, 1.0);
+}
+
+// Test 5: Merged sketches answer like one sketch over all values
+TEST(QuantileSketchTest, MergeMatchesSingleSketch) {
+    QuantileSketch all;
+    QuantileSketch left;
+    QuantileSketch right;
+    for (int i = 1; i <= 1000; i++) {
+        double value = static_cast<double>(i);
+        all.add(value);
+        (i % 3 == 0 ? left : right).add(value);
+    }
+    left.merge(right);
+
+    EXPECT_EQ(left.count(), all.count());
+    EXPECT_DOUBLE_EQ(left.sum(), all.sum());
+    EXPECT_DOUBLE_EQ(left.min(), all.min());
+    EXPECT_DOUBLE_EQ(left.max(), all.max());
+    for (double q : {0.1, 0.5, 0.9, 0.99}) {
+        EXPECT_DOUBLE_EQ(left.quantile(q), all.quantile(q));
+    }
+
+    QuantileSketch coarse(0.05);
+    EXPECT_THROW(left.merge(coarse), std::invalid_argument);
+}
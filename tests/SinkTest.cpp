@@ -0,0 +1,242 @@
+#include "WinHKMonLib/Sink.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: Sink
+ *
+ * Tests for --sink outputs fed from one shared frame.
+ *
+ * Coverage:
+ * - Parsing format[+policy]:target
+ * - One frame written by several sinks in their own formats
+ * - CSV header only at the start of a file
+ * - DROP_OLDEST drops and counts when the writer falls behind
+ * - A full BLOCK sink reports that it must wait (the event loop defers);
+ *   it drops only when a caller submits anyway
+ * - Many sinks share a bounded number of writer threads
+ * - Single-shot writes without a writer thread
+ */
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    std::string path = (std::filesystem::temp_directory_path() / name).string();
+    std::remove(path.c_str());
+    return path;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+MetricsFrame sampleFrame(double cpuPercent) {
+    SystemMetrics metrics;
+    CpuStats cpu{};
+    cpu.totalUsagePercent = cpuPercent;
+    metrics.cpu = cpu;
+    return std::make_shared<const SystemMetrics>(metrics);
+}
+
+size_t countOf(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) {
+        count++;
+    }
+    return count;
+}
+
+}  // anonymous namespace
+
+// Test 1: Format, policy and target; Windows paths keep their drive colon
+TEST(SinkTest, ParsesSinkSpec) {
+    SinkSpec spec = parseSinkSpec("ndjson+drop:C:\\logs\\whk.ndjson");
+    EXPECT_EQ(spec.format, OutputFormat::NDJSON);
+    EXPECT_EQ(spec.policy, SinkPolicy::DROP_OLDEST);
+    EXPECT_EQ(spec.target, "C:\\logs\\whk.ndjson");
+    EXPECT_EQ(describeSink(spec), "ndjson+drop:C:\\logs\\whk.ndjson");
+
+    spec = parseSinkSpec("TEXT:stdout");
+    EXPECT_EQ(spec.format, OutputFormat::TEXT);
+    EXPECT_EQ(spec.policy, SinkPolicy::BLOCK);
+
+    EXPECT_THROW(parseSinkSpec("stdout"), std::invalid_argument);
+    EXPECT_THROW(parseSinkSpec("csv:"), std::invalid_argument);
+    EXPECT_THROW(parseSinkSpec("xml:out.xml"), std::invalid_argument);
+    EXPECT_THROW(parseSinkSpec("csv+later:out.csv"), std::invalid_argument);
+
+    spec = parseSinkSpec("sqlite:C:\\WinHKMon\\history.db");
+    EXPECT_EQ(spec.format, OutputFormat::SQLITE);
+    EXPECT_EQ(describeSink(spec), "sqlite:C:\\WinHKMon\\history.db");
+    EXPECT_THROW(parseSinkSpec("sqlite:stdout"), std::invalid_argument);
+
+    CliOptions options;
+    options.format = OutputFormat::JSON;
+    ASSERT_EQ(effectiveSinks(options).size(), 1u);
+    EXPECT_EQ(effectiveSinks(options)[0].target, "stdout");
+    EXPECT_EQ(effectiveSinks(options)[0].format, OutputFormat::JSON);
+}
+
+// Test 2: Every sink writes the same frames in its own format
+TEST(SinkTest, SinksShareFrames) {
+    std::string csvPath = tempPath("WinHKMon_sink_test.csv");
+    std::string ndjsonPath = tempPath("WinHKMon_sink_test.ndjson");
+    CliOptions options;
+    options.showCpu = true;
+    options.continuous = true;
+    SinkWriterPool writers;
+    {
+        Sink csv(parseSinkSpec("csv:" + csvPath), options, writers);
+        Sink ndjson(parseSinkSpec("ndjson:" + ndjsonPath), options, writers);
+        for (double cpu : {10.0, 20.0, 30.0}) {
+            MetricsFrame frame = sampleFrame(cpu);
+            csv.submit(frame);
+            ndjson.submit(frame);
+        }
+    }
+
+    std::string csvText = readFile(csvPath);
+    EXPECT_EQ(countOf(csvText, "timestamp,"), 1u);
+    EXPECT_EQ(countOf(csvText, "\n"), 4u);
+    std::string ndjsonText = readFile(ndjsonPath);
+    EXPECT_EQ(countOf(ndjsonText, "\n"), 3u);
+    EXPECT_NE(ndjsonText.find("\"totalUsagePercent\":30.0"), std::string::npos);
+
+    // Appending continues under the existing header
+    {
+        Sink csv(parseSinkSpec("csv:" + csvPath), options, writers);
+        csv.submit(sampleFrame(40.0));
+    }
+    csvText = readFile(csvPath);
+    EXPECT_EQ(countOf(csvText, "timestamp,"), 1u);
+    EXPECT_EQ(countOf(csvText, "\n"), 5u);
+
+    std::remove(csvPath.c_str());
+    std::remove(ndjsonPath.c_str());
+}
+
+// Test 3: A stalled drop-oldest sink keeps the newest frames and counts the rest
+TEST(SinkTest, DropOldestWhenQueueFull) {
+    std::string path = tempPath("WinHKMon_sink_drop.ndjson");
+    CliOptions options;
+    options.showCpu = true;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    {
+        SinkWriterPool writers(1, [released] { released.wait(); });
+        Sink sink(parseSinkSpec("ndjson+drop:" + path), options, writers);
+        for (size_t i = 0; i < SINK_QUEUE_FRAMES + 6; i++) {
+            sink.submit(sampleFrame(static_cast<double>(i)));
+        }
+        EXPECT_EQ(sink.droppedFrames(), 6u);
+        release.set_value();
+        sink.flush();
+        EXPECT_FALSE(sink.writeFailed());
+    }
+
+    std::string text = readFile(path);
+    EXPECT_EQ(countOf(text, "\n"), SINK_QUEUE_FRAMES);
+    EXPECT_EQ(text.find("\"totalUsagePercent\":5.0"), std::string::npos);
+    EXPECT_NE(text.find("\"totalUsagePercent\":6.0"), std::string::npos);
+    std::remove(path.c_str());
+}
+
+// Test 4: A full BLOCK sink reports it must wait; a caller that submits anyway drops
+TEST(SinkTest, BlockSinkReportsFullQueue) {
+    std::string path = tempPath("WinHKMon_sink_block.ndjson");
+    CliOptions options;
+    options.showCpu = true;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    {
+        SinkWriterPool writers(1, [released] { released.wait(); });
+        Sink sink(parseSinkSpec("ndjson:" + path), options, writers);
+        Sink dropSink(parseSinkSpec("ndjson+drop:" + path + ".drop"), options, writers);
+        for (size_t i = 0; i < SINK_QUEUE_FRAMES; i++) {
+            EXPECT_FALSE(sink.mustWait());
+            sink.submit(sampleFrame(static_cast<double>(i)), false);
+            dropSink.submit(sampleFrame(static_cast<double>(i)), false);
+        }
+        // The event loop defers its next frame while this holds
+        EXPECT_TRUE(sink.mustWait());
+        EXPECT_FALSE(dropSink.mustWait());
+        EXPECT_EQ(sink.droppedFrames(), 0u);
+
+        for (size_t i = SINK_QUEUE_FRAMES; i < SINK_QUEUE_FRAMES + 3; i++) {
+            sink.submit(sampleFrame(static_cast<double>(i)), false);
+        }
+        EXPECT_EQ(sink.droppedFrames(), 3u);
+        release.set_value();
+        sink.flush();
+    }
+
+    std::string text = readFile(path);
+    EXPECT_EQ(countOf(text, "\n"), SINK_QUEUE_FRAMES);
+    EXPECT_NE(text.find("\"totalUsagePercent\":3.0"), std::string::npos);
+    std::remove(path.c_str());
+    std::remove((path + ".drop").c_str());
+}
+
+// Test 5: Six sinks are written by at most two threads, each in order
+TEST(SinkTest, SinksShareBoundedWriters) {
+    CliOptions options;
+    options.showCpu = true;
+    options.continuous = true;
+    std::atomic<int> started{0};
+    std::vector<std::string> paths;
+    {
+        SinkWriterPool writers(2, [&started] { started++; });
+        std::vector<std::unique_ptr<Sink>> sinks;
+        for (int i = 0; i < 6; i++) {
+            paths.push_back(tempPath("WinHKMon_sink_pool" + std::to_string(i) + ".ndjson"));
+            sinks.push_back(std::make_unique<Sink>(parseSinkSpec("ndjson:" + paths.back()), options, writers));
+        }
+        EXPECT_EQ(writers.threadCount(), 2u);
+        for (int frame = 0; frame < 200; frame++) {
+            MetricsFrame shared = sampleFrame(static_cast<double>(frame));
+            for (const auto& sink : sinks) {
+                sink->submit(shared);
+            }
+        }
+        sinks.clear();
+    }
+    EXPECT_LE(started.load(), 2);
+
+    for (const std::string& path : paths) {
+        std::string text = readFile(path);
+        EXPECT_EQ(countOf(text, "\n"), 200u);
+        EXPECT_LT(text.find("\"totalUsagePercent\":198.0"), text.find("\"totalUsagePercent\":199.0"));
+        std::remove(path.c_str());
+    }
+}
+
+// Test 6: A single-shot write appends one sample, with a header only in a new file
+TEST(SinkTest, WritesSampleWithoutThread) {
+    std::string path = tempPath("WinHKMon_sink_once.csv");
+    CliOptions options;
+    options.showCpu = true;
+    SinkSpec spec = parseSinkSpec("csv:" + path);
+    EXPECT_TRUE(writeSample(spec, options, *sampleFrame(10.0)));
+    EXPECT_TRUE(writeSample(spec, options, *sampleFrame(20.0)));
+
+    std::string text = readFile(path);
+    EXPECT_EQ(countOf(text, "timestamp,"), 1u);
+    EXPECT_EQ(countOf(text, "\n"), 3u);
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(writeSample(parseSinkSpec("csv:no_such_dir/x.csv"), options, *sampleFrame(10.0)));
+}
@@ -0,0 +1,259 @@
+#include "WinHKMonLib/SqliteStore.h"
+#include "WinHKMonLib/Sink.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#ifdef WINHKMON_HAVE_SQLITE
+#include <sqlite3.h>
+#endif
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: SqliteStore
+ *
+ * Tests for the SQLite sink (--sink sqlite:<db>). Results are read back
+ * through a second connection, as another process querying history would.
+ *
+ * Coverage:
+ * - Normalized tables, device dimension and WAL mode
+ * - Samples become visible per transaction (batch size and age)
+ * - Multi-row per-core inserts with single-row remainders
+ * - Device IDs survive reopening the database
+ * - A sqlite sink writes and commits on a shared writer thread
+ * - 64-core samples well above 100 per second
+ */
+
+#ifdef WINHKMON_HAVE_SQLITE
+
+namespace {
+
+std::string tempDatabase(const std::string& name) {
+    std::string path = (std::filesystem::temp_directory_path() / name).string();
+    for (const char* suffix : {"", "-wal", "-shm"}) {
+        std::remove((path + suffix).c_str());
+    }
+    return path;
+}
+
+SystemMetrics hostMetrics(size_t cores, double cpuPercent) {
+    SystemMetrics metrics;
+    CpuStats cpu{};
+    cpu.totalUsagePercent = cpuPercent;
+    cpu.averageFrequencyMhz = 2400;
+    for (size_t i = 0; i < cores; i++) {
+        cpu.cores.push_back({static_cast<int>(i), static_cast<double>(i % 100), 2400 + i});
+    }
+    metrics.cpu = cpu;
+
+    MemoryStats memory{};
+    memory.totalPhysicalBytes = 16000;
+    memory.availablePhysicalBytes = 4000;
+    memory.usagePercent = 75.0;
+    metrics.memory = memory;
+
+    DiskStats disk{};
+    disk.deviceName = "C:";
+    disk.totalSizeBytes = 1000;
+    disk.bytesReadPerSec = 42;
+    DiskStats data = disk;
+    data.deviceName = "D:";
+    metrics.disks = std::vector<DiskStats>{disk, data};
+
+    InterfaceStats iface{};
+    iface.name = "Ethernet";
+    iface.inBytesPerSec = 7;
+    metrics.network = std::vector<InterfaceStats>{iface};
+    metrics.intervalSeconds = 1.0;
+    return metrics;
+}
+
+/**
+ * @brief Read-only second connection to the same database
+ */
+class Reader {
+public:
+    explicit Reader(const std::string& path) : db_(nullptr) {
+        if (sqlite3_open_v2(path.c_str(), &db_, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+    }
+    ~Reader() { sqlite3_close(db_); }
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    // First column of the first row, as text ("" if no row)
+    std::string query(const std::string& sql) {
+        sqlite3_stmt* statement = nullptr;
+        if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &statement, nullptr) != SQLITE_OK) {
+            throw std::runtime_error(sqlite3_errmsg(db_));
+        }
+        std::string value;
+        if (sqlite3_step(statement) == SQLITE_ROW && sqlite3_column_text(statement, 0) != nullptr) {
+            value = reinterpret_cast<const char*>(sqlite3_column_text(statement, 0));
+        }
+        sqlite3_finalize(statement);
+        return value;
+    }
+
+private:
+    sqlite3* db_;
+};
+
+}  // anonymous namespace
+
+// Test 1: One row per sample, CPU, core, disk and interface, with devices as IDs
+TEST(SqliteStoreTest, WritesNormalizedTables) {
+    std::string path = tempDatabase("WinHKMon_sqlite_tables.db");
+    {
+        SqliteStore store(path, 100, 3600.0);
+        for (uint64_t i = 0; i < 3; i++) {
+            EXPECT_TRUE(store.append(hostMetrics(4, 10.0 * static_cast<double>(i)), 1700000000000 + i * 1000));
+        }
+    }
+
+    Reader reader(path);
+    EXPECT_EQ(reader.query("PRAGMA journal_mode"), "wal");
+    EXPECT_EQ(reader.query("SELECT COUNT(*) FROM samples"), "3");
+    EXPECT_EQ(reader.query("SELECT MAX(time_ms) FROM samples"), "1700000002000");
+    EXPECT_EQ(reader.query("SELECT COUNT(*) FROM cpu_core"), "12");
+    EXPECT_EQ(reader.query("SELECT freq_mhz FROM cpu_core WHERE sample_id = 2 AND core_id = 3"), "2403");
+    EXPECT_EQ(reader.query("SELECT usage_percent FROM cpu WHERE sample_id = 3"), "20.0");
+    EXPECT_EQ(reader.query("SELECT COUNT(*) FROM memory"), "3");
+    EXPECT_EQ(reader.query("SELECT COUNT(*) FROM devices"), "3");
+    EXPECT_EQ(reader.query("SELECT COUNT(*) FROM disk"), "6");
+    EXPECT_EQ(reader.query("SELECT SUM(d.read_bytes_per_sec) FROM disk d JOIN devices v ON v.id = d.device_id "
+                           "WHERE v.kind = 'disk' AND v.name = 'D:'"),
+              "126");
+    EXPECT_EQ(reader.query("SELECT v.name FROM interface i JOIN devices v ON v.id = i.device_id LIMIT 1"),
+              "Ethernet");
+}
+
+// Test 2: Samples become visible when their transaction commits
+TEST(SqliteStoreTest, BatchesTransactions) {
+    std::string path = tempDatabase("WinHKMon_sqlite_batch.db");
+    SqliteStore store(path, 10, 3600.0);
+    Reader reader(path);
+    for (int i = 0; i < 9; i++) {
+        store.append(hostMetrics(2, 1.0), 1);
+    }
+    EXPECT_EQ(store.pendingSamples(), 9u);
+    EXPECT_EQ(reader.query("SELECT COUNT(*) FROM samples"), "0");
+
+    store.append(hostMetrics(2, 1.0), 1);
+    EXPECT_EQ(store.pendingSamples(), 0u);
+    EXPECT_EQ(reader.query("SELECT COUNT(*) FROM samples"), "10");
+
+    // An old transaction commits with the next sample regardless of size
+    SqliteStore aged(tempDatabase("WinHKMon_sqlite_aged.db"), 1000, 0.1);
+    aged.append(hostMetrics(2, 1.0), 1);
+    EXPECT_EQ(aged.pendingSamples(), 1u);
+    std::this_thread::sleep_until(aged.commitDue());
+    aged.append(hostMetrics(2, 1.0), 1);
+    EXPECT_EQ(aged.pendingSamples(), 0u);
+}
+
+// Test 3: Cores go in full multi-row statements plus single-row remainders
+TEST(SqliteStoreTest, InsertsCoresInChunks) {
+    std::string path = tempDatabase("WinHKMon_sqlite_cores.db");
+    size_t cores = 2 * SQLITE_CORE_ROWS_PER_INSERT + 3;
+    {
+        SqliteStore store(path, 100, 3600.0);
+        EXPECT_TRUE(store.append(hostMetrics(cores, 50.0), 1));
+    }
+    Reader reader(path);
+    EXPECT_EQ(reader.query("SELECT COUNT(*) FROM cpu_core"), std::to_string(cores));
+    EXPECT_EQ(reader.query("SELECT MAX(core_id) FROM cpu_core"), std::to_string(cores - 1));
+    EXPECT_EQ(reader.query("SELECT SUM(usage_percent) FROM cpu_core WHERE core_id >= 128"), "87.0");
+}
+
+// Test 4: Reopening keeps device IDs and appends new samples
+TEST(SqliteStoreTest, ReopensDatabase) {
+    std::string path = tempDatabase("WinHKMon_sqlite_reopen.db");
+    {
+        SqliteStore store(path, 100, 3600.0);
+        store.append(hostMetrics(1, 1.0), 1);
+    }
+    {
+        SqliteStore store(path, 100, 3600.0);
+        store.append(hostMetrics(1, 2.0), 2);
+    }
+    Reader reader(path);
+    EXPECT_EQ(reader.query("SELECT COUNT(*) FROM samples"), "2");
+    EXPECT_EQ(reader.query("SELECT COUNT(*) FROM devices"), "3");
+    EXPECT_EQ(reader.query("SELECT COUNT(DISTINCT device_id) FROM disk"), "2");
+
+    EXPECT_THROW(SqliteStore((std::filesystem::temp_directory_path() / "no_such_dir" / "x.db").string(), 1, 1.0),
+                 std::runtime_error);
+}
+
+// Test 5: A sqlite sink commits what its writer thread inserted
+TEST(SqliteStoreTest, SinkWritesDatabase) {
+    std::string path = tempDatabase("WinHKMon_sqlite_sink.db");
+    CliOptions options;
+    options.continuous = true;
+    SinkWriterPool writers;
+    {
+        Sink sink(parseSinkSpec("sqlite:" + path), options, writers);
+        for (double cpu : {10.0, 20.0, 30.0}) {
+            sink.submit(std::make_shared<const SystemMetrics>(hostMetrics(8, cpu)));
+        }
+        sink.flush();
+        EXPECT_FALSE(sink.writeFailed());
+    }
+    Reader reader(path);
+    EXPECT_EQ(reader.query("SELECT COUNT(*) FROM samples"), "3");
+    EXPECT_EQ(reader.query("SELECT COUNT(*) FROM cpu_core"), "24");
+
+    // Single-shot writes go through the same store
+    EXPECT_TRUE(writeSample(parseSinkSpec("sqlite:" + path), options, hostMetrics(8, 40.0)));
+    EXPECT_EQ(reader.query("SELECT COUNT(*) FROM samples"), "4");
+
+    // An idle sink's pool thread commits the open transaction once it is old enough
+    options.sqliteBatchSamples = 1000;
+    options.sqliteCommitSeconds = 0.2;
+    Sink idle(parseSinkSpec("sqlite:" + path), options, writers);
+    idle.submit(std::make_shared<const SystemMetrics>(hostMetrics(8, 50.0)));
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (reader.query("SELECT COUNT(*) FROM samples") != "5" && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    EXPECT_EQ(reader.query("SELECT COUNT(*) FROM samples"), "5");
+}
+
+// Test 6: 64-core samples keep up far beyond 100 per second
+TEST(SqliteStoreTest, SustainsHighSampleRate) {
+    std::string path = tempDatabase("WinHKMon_sqlite_rate.db");
+    SystemMetrics metrics = hostMetrics(64, 50.0);
+    const int samples = 1000;
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        SqliteStore store(path, 100, 1.0);
+        for (int i = 0; i < samples; i++) {
+            ASSERT_TRUE(store.append(metrics, static_cast<uint64_t>(i)));
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // 10 s of data at 100 samples per second must take well under 10 s
+    EXPECT_LT(seconds, 5.0);
+    Reader reader(path);
+    EXPECT_EQ(reader.query("SELECT COUNT(*) FROM cpu_core"), std::to_string(samples * 64));
+}
+
+#else
+
+// Without SQLite the sink fails to open with a clear error
+TEST(SqliteStoreTest, ReportsMissingSqlite) {
+    EXPECT_FALSE(sqliteAvailable());
+    EXPECT_THROW(SqliteStore("history.db", 1, 1.0), std::runtime_error);
+}
+
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <utility>
+
+/**
+ * @file TempTree.h
+ * @brief Scratch directory trees for tests of the file-based readers
+ *
+ * The Linux collectors read procfs, sysfs and cgroupfs files under a root
+ * directory, so their tests write those files (in the kernel's formats)
+ * below a temporary directory and point the monitor at it.
+ */
+
+/**
+ * @brief Create or replace a file with the given contents
+ */
+inline void writeFile(const std::filesystem::path& path, const std::string& contents) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << contents;
+}
+
+/**
+ * @brief Fixture with an empty directory per test, removed afterwards
+ *
+ * root_ is <temp>/WinHKMon_<prefix>_<test name>, so tests of different
+ * suites and of the same suite never share files. Fixtures that fill the
+ * tree override SetUp() and call TempTreeTest::SetUp() first.
+ */
+class TempTreeTest : public ::testing::Test {
+protected:
+    explicit TempTreeTest(std::string prefix)
+        : prefix_(std::move(prefix)) {
+    }
+
+    void SetUp() override {
+        root_ = std::filesystem::temp_directory_path() /
+                ("WinHKMon_" + prefix_ + "_" +
+                 std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        std::filesystem::remove_all(root_);
+        std::filesystem::create_directories(root_);
+    }
+
+    void TearDown() override {
+        std::error_code error;
+        std::filesystem::remove_all(root_, error);
+    }
+
+    std::filesystem::path root_;
+
+private:
+    std::string prefix_;
+};
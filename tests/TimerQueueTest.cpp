@@ -0,0 +1,84 @@
+#include "WinHKMonLib/TimerQueue.h"
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: TimerQueue
+ *
+ * Tests for the deadline-ordered timers behind the event loop.
+ *
+ * Coverage:
+ * - Ordering by deadline, FIFO for equal deadlines
+ * - Only due timers run; nextDue() tracks the earliest
+ * - Cancel before and during a run
+ * - Re-arming from a callback does not run in the same pass
+ */
+
+namespace {
+
+using Clock = TimerQueue::Clock;
+const Clock::time_point T0 = Clock::time_point(std::chrono::seconds(1000));
+
+Clock::time_point at(int ms) {
+    return T0 + std::chrono::milliseconds(ms);
+}
+
+}  // anonymous namespace
+
+// Test 1: Due timers run earliest first; later ones stay pending
+TEST(TimerQueueTest, RunsDueTimersInOrder) {
+    TimerQueue timers;
+    std::string order;
+    EXPECT_FALSE(timers.nextDue().has_value());
+
+    timers.add(at(30), [&]() { order += "c"; });
+    timers.add(at(10), [&]() { order += "a"; });
+    timers.add(at(10), [&]() { order += "b"; });
+    timers.add(at(50), [&]() { order += "d"; });
+    EXPECT_EQ(*timers.nextDue(), at(10));
+
+    EXPECT_EQ(timers.runDue(at(5)), 0u);
+    EXPECT_EQ(timers.runDue(at(30)), 3u);
+    EXPECT_EQ(order, "abc");
+    EXPECT_EQ(*timers.nextDue(), at(50));
+    EXPECT_EQ(timers.size(), 1u);
+}
+
+// Test 2: Cancelled timers never run, including from an earlier callback in the same pass
+TEST(TimerQueueTest, CancelsTimers) {
+    TimerQueue timers;
+    int ran = 0;
+    uint64_t second = 0;
+    uint64_t first = timers.add(at(10), [&]() { ran++; timers.cancel(second); });
+    second = timers.add(at(20), [&]() { ran += 100; });
+    uint64_t third = timers.add(at(30), [&]() { ran += 1000; });
+
+    EXPECT_TRUE(timers.cancel(third));
+    EXPECT_FALSE(timers.cancel(third));
+    EXPECT_EQ(timers.runDue(at(100)), 1u);
+    EXPECT_EQ(ran, 1);
+    EXPECT_FALSE(timers.cancel(first));
+    EXPECT_EQ(timers.size(), 0u);
+}
+
+// Test 3: A periodic timer re-arms itself without running twice per pass
+TEST(TimerQueueTest, RearmRunsInNextPass) {
+    TimerQueue timers;
+    int ticks = 0;
+    Clock::time_point deadline = at(0);
+    std::function<void()> tick = [&]() {
+        ticks++;
+        deadline += std::chrono::milliseconds(100);
+        timers.add(deadline, tick);
+    };
+    timers.add(deadline, tick);
+
+    // Woke late: both the missed and the current deadline are due, one per pass
+    EXPECT_EQ(timers.runDue(at(150)), 1u);
+    EXPECT_EQ(timers.runDue(at(150)), 1u);
+    EXPECT_EQ(timers.runDue(at(150)), 0u);
+    EXPECT_EQ(ticks, 2);
+    EXPECT_EQ(*timers.nextDue(), at(200));
+}
@@ -0,0 +1,135 @@
+#include "WinHKMonLib/Tracer.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+using namespace WinHKMon;
+
+/**
+ * Test Suite: Tracer
+ *
+ * Tests for the self-instrumentation Tracer that records spans into
+ * per-thread buffers and exports Chrome trace-event JSON.
+ *
+ * Coverage:
+ * - No spans recorded while disabled
+ * - Complete ("X") events and thread_name metadata in the export
+ * - Separate thread IDs for spans recorded on other threads
+ * - Per-span overhead when enabled
+ * - Control characters in names escaped as valid JSON
+ */
+
+namespace {
+
+// Reset the process-wide tracer between tests
+class TracerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Tracer::instance().stop();
+        Tracer::instance().clear();
+    }
+
+    void TearDown() override {
+        Tracer::instance().stop();
+        Tracer::instance().clear();
+    }
+};
+
+size_t countOccurrences(const std::string& haystack, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = haystack.find(needle); pos != std::string::npos;
+         pos = haystack.find(needle, pos + needle.size())) {
+        count++;
+    }
+    return count;
+}
+
+}  // anonymous namespace
+
+// Test 1: Spans are not recorded while tracing is disabled
+TEST_F(TracerTest, DisabledRecordsNothing) {
+    {
+        WINHKMON_TRACE_SPAN("collect", "cpu");
+    }
+
+    std::string json = Tracer::instance().toChromeTraceJson();
+    EXPECT_EQ(json.find("\"ph\":\"X\""), std::string::npos);
+}
+
+// Test 2: Enabled spans are exported as complete events with thread names
+TEST_F(TracerTest, ExportsCompleteEventsAndThreadName) {
+    Tracer& tracer = Tracer::instance();
+    tracer.start();
+    tracer.setThreadName("main");
+    {
+        WINHKMON_TRACE_SPAN("collect", "cpu");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    {
+        WINHKMON_TRACE_SPAN("output", "format");
+    }
+    tracer.stop();
+
+    std::string json = tracer.toChromeTraceJson();
+    EXPECT_NE(json.find("\"traceEvents\":["), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"cpu\",\"cat\":\"collect\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"format\",\"cat\":\"output\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"M\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"main\"}"), std::string::npos);
+    EXPECT_EQ(countOccurrences(json, "\"ph\":\"X\""), 2u);
+}
+
+// Test 3: Spans from another thread get their own thread ID
+TEST_F(TracerTest, SeparatesThreads) {
+    Tracer& tracer = Tracer::instance();
+    tracer.start();
+    {
+        WINHKMON_TRACE_SPAN("collect", "main-span");
+    }
+    std::thread worker([&tracer]() {
+        tracer.setThreadName("writer");
+        WINHKMON_TRACE_SPAN("output", "worker-span");
+    });
+    worker.join();
+    tracer.stop();
+
+    std::string json = tracer.toChromeTraceJson();
+    EXPECT_NE(json.find("\"tid\":1"), std::string::npos);
+    EXPECT_NE(json.find("\"tid\":2"), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"writer\"}"), std::string::npos);
+}
+
+// Test 4: Recording a span stays cheap (generous bound for shared CI machines)
+TEST_F(TracerTest, SpanOverheadIsLow) {
+    Tracer& tracer = Tracer::instance();
+    tracer.start();
+
+    const int iterations = 10000;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        WINHKMON_TRACE_SPAN("bench", "span");
+    }
+    auto end = std::chrono::steady_clock::now();
+    tracer.stop();
+
+    double nsPerSpan = std::chrono::duration<double, std::nano>(end - begin).count() / iterations;
+    EXPECT_LT(nsPerSpan, 1000.0);
+    EXPECT_EQ(tracer.droppedCount(), 0u);
+}
+
+// Test 5: Control characters in thread names become \u escapes
+TEST_F(TracerTest, EscapesControlCharacters) {
+    Tracer& tracer = Tracer::instance();
+    tracer.start();
+    tracer.setThreadName("sink\tC:\\log\x01\"x\"");
+    tracer.stop();
+
+    std::string json = tracer.toChromeTraceJson();
+    EXPECT_NE(json.find("\"args\":{\"name\":\"sink\\u0009C:\\\\log\\u0001\\\"x\\\"\"}"), std::string::npos)
+        << json;
+    for (char c : json) {
+        if (c != '\n') {
+            EXPECT_GE(static_cast<unsigned char>(c), 0x20);
+        }
+    }
+}